@@ -16,6 +16,7 @@
 
 #include "thallium/platform.h"
 
+#include "thallium/core/command_buffer.h"
 #include "thallium/core/context.h"
 #include "thallium/core/debugger.h"
 #include "thallium/core/pipeline.h"
@@ -34,6 +35,9 @@
 #if defined(_THALLIUM_WSI_XLIB)
 #   include "thallium/core/wsi/xlib_window_surface.h"
 #endif
+#if defined(_THALLIUM_WSI_HEADLESS)
+#   include "thallium/core/wsi/headless_window_surface.h"
+#endif
 
 #ifdef __cplusplus
     }
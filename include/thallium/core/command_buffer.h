@@ -0,0 +1,216 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__core__command_buffer_h__
+#define __TL__core__command_buffer_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/enums.h"
+#include "thallium_decl/fwd.h"
+#include "thallium/platform.h"
+
+/**
+ * @brief A structure to represent a command buffer object.
+ *
+ * This opaque structure represents a command buffer, into which rendering commands are recorded.
+ *
+ * @sa @ref TL_CommandBufferCreate()
+ * @sa @ref TL_CommandBufferDestroy()
+ */
+typedef struct TL_CommandBuffer_t TL_CommandBuffer_t;
+
+/**
+ * @brief Create and return a handle to a new Thallium command buffer object under the given renderer.
+ *
+ * This function creates and returns a new Thallium command buffer object for use with the specified renderer.
+ *
+ * @param renderer Renderer to create the command buffer for.
+ * @return The new command buffer
+ *
+ * @sa @ref TL_CommandBuffer_t
+ */
+TL_CommandBuffer_t *TL_CommandBufferCreate(
+    const TL_Renderer_t *const renderer
+);
+
+/**
+ * @brief Free the given command buffer object.
+ *
+ * This function frees the specified command buffer object.
+ *
+ * @param command_buffer Pointer to the command buffer object to free.
+ */
+void TL_CommandBufferDestroy(
+    TL_CommandBuffer_t *const command_buffer
+);
+
+/**
+ * @brief Begin recording commands into the given command buffer.
+ *
+ * This function begins recording into the specified command buffer, discarding any commands that were previously recorded into it.
+ *
+ * @param command_buffer Command buffer to begin recording
+ * @return False if there were errors
+ */
+bool TL_CommandBufferBegin(
+    TL_CommandBuffer_t *const command_buffer
+);
+
+/**
+ * @brief Finish recording commands into the given command buffer.
+ *
+ * This function ends recording of the specified command buffer.
+ *
+ * @param command_buffer Command buffer to end recording
+ * @return False if there were errors
+ */
+bool TL_CommandBufferEnd(
+    TL_CommandBuffer_t *const command_buffer
+);
+
+/**
+ * @brief Submit the given command buffer for execution.
+ *
+ * This function submits the commands recorded into the specified command buffer to the device, and returns without waiting for them to execute.
+ * Recording must have been ended with @ref TL_CommandBufferEnd(). A command buffer cannot be submitted again until its previous submission has been
+ * waited on with @ref TL_CommandBufferWait() (which @ref TL_CommandBufferBegin() also does implicitly).
+ *
+ * @note Submissions are made to a queue shared by every command buffer of the renderer, so this function must not be called concurrently with
+ * submissions of other command buffers under the same renderer.
+ *
+ * @param command_buffer Command buffer to submit
+ * @return False if there were errors
+ */
+bool TL_CommandBufferSubmit(
+    TL_CommandBuffer_t *const command_buffer
+);
+
+/**
+ * @brief Block until the given command buffer has finished executing.
+ *
+ * This function waits until the most recent submission of the specified command buffer has finished executing on the device. It returns
+ * immediately if the command buffer has not been submitted.
+ *
+ * @param command_buffer Command buffer to wait on
+ * @return False if there were errors
+ */
+bool TL_CommandBufferWait(
+    TL_CommandBuffer_t *const command_buffer
+);
+
+/**
+ * @brief Bind a pipeline to the given command buffer.
+ *
+ * This function records a command to bind the specified pipeline for subsequent commands. The pipeline must be in the `TL_PIPELINE_STATUS_READY`
+ * state.
+ *
+ * @param command_buffer Command buffer being recorded
+ * @param pipeline Pipeline to bind
+ */
+void TL_CmdBindPipeline(
+    TL_CommandBuffer_t *const command_buffer,
+    const TL_Pipeline_t *const pipeline
+);
+
+/**
+ * @brief Set the dynamic rasterizer state of the given command buffer.
+ *
+ * This function records commands to set the cull modes, front face, rasterizer discard, depth bias and line width used by subsequent draws with
+ * pipelines created with `extended_dynamic_state`. The `depth_clamp` and `polygon_mode` members of `rasterizer` are ignored, as they are always taken
+ * from the bound pipeline.
+ *
+ * @note The renderer must have been created with the `extended_dynamic_state` [feature](@ref TL_RendererFeatures_t).
+ *
+ * @param command_buffer Command buffer being recorded
+ * @param rasterizer Rasterizer state to set
+ */
+void TL_CmdSetRasterizerState(
+    TL_CommandBuffer_t *const command_buffer,
+    const TL_PipelineRasterizerDescriptor_t *const rasterizer
+);
+
+/**
+ * @brief Set the dynamic depth test state of the given command buffer.
+ *
+ * This function records commands to set the depth test state used by subsequent draws with pipelines created with `extended_dynamic_state`.
+ *
+ * @note The renderer must have been created with the `extended_dynamic_state` [feature](@ref TL_RendererFeatures_t).
+ *
+ * @param command_buffer Command buffer being recorded
+ * @param depth_test Depth test state to set
+ */
+void TL_CmdSetDepthTestState(
+    TL_CommandBuffer_t *const command_buffer,
+    const TL_PipelineDepthTestDescriptor_t *const depth_test
+);
+
+/**
+ * @brief Set the dynamic primitive topology of the given command buffer.
+ *
+ * This function records commands to set the primitive topology (and, for strip topologies, primitive restarts) used by subsequent draws with
+ * pipelines created with `extended_dynamic_state`. The topology must be of the same class (points, lines, triangles or patches) as the one the bound
+ * pipeline was created with.
+ *
+ * @note The renderer must have been created with the `extended_dynamic_state` [feature](@ref TL_RendererFeatures_t).
+ *
+ * @param command_buffer Command buffer being recorded
+ * @param topology Primitive topology to set
+ */
+void TL_CmdSetPrimitiveTopology(
+    TL_CommandBuffer_t *const command_buffer,
+    const TL_PrimitiveTopology_t topology
+);
+
+/**
+ * @brief Update push constants with the given command buffer.
+ *
+ * This function records a command to write `size` bytes of `data` into the push constants of the pipeline most recently bound with
+ * @ref TL_CmdBindPipeline(), starting at byte `offset`. Push constants are recorded directly into the command buffer, so they are the fastest way to
+ * pass small amounts of per-draw or per-dispatch data (e.g. a transform or an object index) to shaders, without any buffers or descriptor sets.
+ *
+ * The push constant range of a pipeline is derived from the push constant blocks declared by its shaders, and is visible to every stage that declares
+ * one. The data pushed remains valid across binds of other pipelines whose shaders declare compatible push constant blocks.
+ *
+ * @note Every device supports at least 128 bytes of push constants; larger blocks only work on devices that support them.
+ *
+ * @param command_buffer Command buffer being recorded
+ * @param offset Byte offset into the push constant block (must be a multiple of 4)
+ * @param size Amount of bytes to write (must be a multiple of 4)
+ * @param data Pointer to the data to write
+ */
+void TL_CmdPushConstants(
+    TL_CommandBuffer_t *const command_buffer,
+    const uint32_t offset,
+    const uint32_t size,
+    const void *const data
+);
+
+/**
+ * @brief Dispatch compute work with the given command buffer.
+ *
+ * This function records a command to dispatch the specified amount of workgroups of the compute pipeline most recently bound with
+ * @ref TL_CmdBindPipeline().
+ *
+ * @param command_buffer Command buffer being recorded
+ * @param group_count_x Amount of workgroups to dispatch in the X dimension
+ * @param group_count_y Amount of workgroups to dispatch in the Y dimension
+ * @param group_count_z Amount of workgroups to dispatch in the Z dimension
+ */
+void TL_CmdDispatch(
+    TL_CommandBuffer_t *const command_buffer,
+    const uint32_t group_count_x,
+    const uint32_t group_count_y,
+    const uint32_t group_count_z
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -22,6 +22,7 @@
  * This opaque structure represents a graphics, compute, or ray tracing pipeline object.
  *
  * @sa @ref TL_PipelineCreate()
+ * @sa @ref TL_PipelineCreateAsync()
  * @sa @ref TL_PipelineDestroy()
  * @sa @ref TL_PipelineDescriptor_t
  */
@@ -74,6 +75,67 @@ typedef struct TL_PipelineDepthTestDescriptor_t {
     TL_CompareOp_t compare_op;
 } TL_PipelineDepthTestDescriptor_t;
 
+/**
+ * @brief A structure describing the value of a shader specialization constant.
+ *
+ * This structure sets the value of a specialization constant declared in a shader (e.g. with `layout(constant_id = N) const` in GLSL). The value is
+ * folded into the shader when the pipeline is compiled, so constants can be used to derive branch-free variants of a single shader.
+ */
+typedef struct TL_PipelineSpecializationConstant_t {
+    /// @brief The ID of the specialization constant in the shader (`constant_id` in GLSL).
+    uint32_t id;
+    /// @brief The size of the constant in bytes - 4 for `bool` (as a 32-bit value), `int`, `uint` and `float` constants, or 8 for 64-bit ones.
+    uint32_t size;
+
+    /// @brief The value of the constant, read from the member matching the type and `size` of the constant.
+    union {
+        /// @brief 32-bit boolean (0 or 1) or unsigned integer value.
+        uint32_t u32;
+        /// @brief 32-bit signed integer value.
+        int32_t i32;
+        /// @brief 32-bit floating-point value.
+        float f32;
+        /// @brief 64-bit unsigned integer value.
+        uint64_t u64;
+        /// @brief 64-bit signed integer value.
+        int64_t i64;
+        /// @brief 64-bit floating-point value.
+        double f64;
+    } value;
+} TL_PipelineSpecializationConstant_t;
+
+/**
+ * @brief A descriptor struct for a shader stage of a pipeline.
+ *
+ * This structure describes a single shader stage of a pipeline, provided either as SPIR-V code in memory or as the path to a SPIR-V file.
+ *
+ * Shader modules are shared by content: pipelines created under the same renderer from identical SPIR-V code use a single API shader module,
+ * regardless of whether the code was given in memory or loaded from a file.
+ *
+ * The resource bindings and push constant blocks declared by a pipeline's shaders are reflected from their SPIR-V code to derive its layout,
+ * so no layout needs to be described separately. Pipelines whose shaders declare the same interface share a single layout, and descriptor sets
+ * with the same bindings share a single set layout.
+ */
+typedef struct TL_PipelineShaderDescriptor_t {
+    /// @brief NULL or a pointer to the SPIR-V code of the shader.
+    const uint32_t *code;
+    /// @brief The size of `code`, in bytes (must be a multiple of 4).
+    size_t code_size;
+
+    /// @brief NULL or the path to a SPIR-V (.spv) file to load the shader from; ignored if `code` is not NULL.
+    /// The file is memory-mapped while the pipeline is being created, instead of being read into a buffer first.
+    const char *path;
+
+    /// @brief NULL or the name of the shader's entry point function - `"main"` is assumed by default.
+    const char *entry_point;
+
+    /// @brief The amount of constants in the `specialization_constants` array.
+    uint32_t specialization_constant_count;
+    /// @brief NULL or an array of [values](@ref TL_PipelineSpecializationConstant_t) for the shader's specialization constants. Constants that are
+    /// not given keep the default value declared in the shader. Pipelines with different constant values are compiled (and deduplicated) separately.
+    const TL_PipelineSpecializationConstant_t *specialization_constants;
+} TL_PipelineShaderDescriptor_t;
+
 /**
  * @brief A structure describing a pipeline object to be created.
  *
@@ -106,13 +168,79 @@ typedef struct TL_PipelineDescriptor_t {
     /// @brief NULL or an array of scissor rectangles - if NULL, any scissors must be set dynamically instead.
     /// This value is ignored in compute and ray tracing pipelines.
     TL_Rect2D_t *scissors;
+
+    /// @brief If true, most rasterizer, depth test and primitive topology state is left out of the pipeline object and must instead be set on the
+    /// command buffer with @ref TL_CmdSetRasterizerState(), @ref TL_CmdSetDepthTestState() and @ref TL_CmdSetPrimitiveTopology() after binding it.
+    /// Pipelines that only differ in that state then share one pipeline object. Only `rasterizer.depth_clamp`, `rasterizer.polygon_mode` and the
+    /// class of `primitive_topology` (points, lines, triangles or patches) are still taken from this descriptor.
+    /// This value is ignored (with a warning) if the renderer was not created with the `extended_dynamic_state` feature, and in compute and ray
+    /// tracing pipelines.
+    bool extended_dynamic_state;
+
+    /// @brief A [descriptor](@ref TL_PipelineShaderDescriptor_t) of the vertex shader.
+    /// The vertex input state is derived from the shader's input variables: each is read from a single tightly packed, per-vertex buffer binding
+    /// (binding 0), ordered by location, and must have 32-bit components. This value is ignored in compute and ray tracing pipelines.
+    TL_PipelineShaderDescriptor_t vertex_shader;
+    /// @brief A [descriptor](@ref TL_PipelineShaderDescriptor_t) of the fragment shader.
+    /// This value is ignored in compute and ray tracing pipelines.
+    TL_PipelineShaderDescriptor_t fragment_shader;
+
+    /// @brief A [descriptor](@ref TL_PipelineShaderDescriptor_t) of the compute shader; this is required in compute pipelines.
+    /// This value is ignored in graphics and ray tracing pipelines.
+    TL_PipelineShaderDescriptor_t compute_shader;
+
+    /// @brief If true, the pipeline may be named as the `base_pipeline` of other pipelines.
+    bool allow_derivatives;
+    /// @brief NULL or a pipeline of the same type, created with `allow_derivatives`, that this pipeline is a variant of. Some implementations
+    /// create derivative pipelines faster than unrelated ones, so naming a parent is worthwhile for families of similar pipelines. The base pipeline
+    /// must have finished compiling and must not be destroyed before this pipeline has been created; otherwise, it is ignored with a warning.
+    /// The base pipeline does not affect the resulting pipeline, so pipelines that only differ in it are still deduplicated.
+    /// Both this and `allow_derivatives` are ignored if the renderer was created with the `pipeline_libraries` feature, in which case graphics
+    /// pipelines are linked rather than compiled.
+    const TL_Pipeline_t *base_pipeline;
 } TL_PipelineDescriptor_t;
 
+/**
+ * @brief Feedback about the creation of a pipeline or of one of its shader stages.
+ *
+ * @sa @ref TL_PipelineCreationFeedback_t
+ */
+typedef struct TL_PipelineStageCreationFeedback_t {
+    /// @brief True if feedback was provided; the other members are only meaningful if this is true.
+    bool valid;
+    /// @brief True if creation was skipped because the result was found in the renderer's pipeline cache.
+    bool cache_hit;
+    /// @brief Time spent on creation, in nanoseconds.
+    uint64_t duration_ns;
+} TL_PipelineStageCreationFeedback_t;
+
+/**
+ * @brief Feedback about the creation of a pipeline, as retrieved with @ref TL_PipelineGetCreationFeedback().
+ *
+ * Per-stage feedback is only provided for the stages that the pipeline has, and may not be provided at all depending on the implementation (for
+ * example, pipelines linked from pipeline libraries have their stages compiled as part of the libraries rather than the pipeline).
+ */
+typedef struct TL_PipelineCreationFeedback_t {
+    /// @brief Feedback about the creation of the pipeline as a whole.
+    TL_PipelineStageCreationFeedback_t pipeline;
+
+    /// @brief Feedback about the creation of the vertex shader stage.
+    TL_PipelineStageCreationFeedback_t vertex_shader;
+    /// @brief Feedback about the creation of the fragment shader stage.
+    TL_PipelineStageCreationFeedback_t fragment_shader;
+    /// @brief Feedback about the creation of the compute shader stage.
+    TL_PipelineStageCreationFeedback_t compute_shader;
+} TL_PipelineCreationFeedback_t;
+
 /**
  * @brief Create and return a handle to a new Thallium pipeline object under the given renderer.
  *
  * This function creates and returns a new Thallium pipeline object for use with the specified renderer.
  *
+ * The full pipeline state described by `descriptor` is hashed, and pipelines created under the same renderer from equivalent descriptors share a
+ * single reference-counted API pipeline state object instead of compiling a new one. Each returned pipeline object must still be destroyed with
+ * @ref TL_PipelineDestroy().
+ *
  * @param renderer Renderer to create the pipeline for.
  * @param descriptor A pipeline descriptor struct.
  * @return The new pipeline
@@ -124,6 +252,134 @@ TL_Pipeline_t *TL_PipelineCreate(
     const TL_PipelineDescriptor_t descriptor
 );
 
+/**
+ * @brief Create several Thallium pipeline objects under the given renderer at once.
+ *
+ * This function creates one pipeline object per descriptor, like @ref TL_PipelineCreate(), but hands all of the pipelines that need compiling to
+ * the graphics API together so that the driver can compile them in parallel. This is much faster than creating the same pipelines one by one when
+ * many are created back to back (e.g. while loading a level). Deduplication behaves as it does for @ref TL_PipelineCreate(), including between
+ * descriptors within the same batch.
+ *
+ * Pipelines that could not be created are returned as NULL, without affecting the rest of the batch. Each returned pipeline object must be
+ * destroyed with @ref TL_PipelineDestroy().
+ *
+ * @param renderer Renderer to create the pipelines for.
+ * @param count Amount of descriptors in `descriptors`.
+ * @param descriptors Array of `count` pipeline descriptor structs.
+ * @param out_pipelines Array of `count` pipeline handles to populate.
+ * @return False if any of the pipelines could not be created
+ *
+ * @sa @ref TL_Pipeline_t
+ */
+bool TL_PipelineCreateBatch(
+    const TL_Renderer_t *const renderer,
+    const uint32_t count,
+    const TL_PipelineDescriptor_t *const descriptors,
+    TL_Pipeline_t **const out_pipelines
+);
+
+/**
+ * @brief Begin creating a new Thallium pipeline object under the given renderer without blocking the calling thread.
+ *
+ * This function returns a handle to a new pipeline object immediately, while the pipeline itself is compiled on an internal worker pool owned by the
+ * renderer. Compilation uses the same API pipeline cache as @ref TL_PipelineCreate().
+ *
+ * The returned pipeline starts in the `TL_PIPELINE_STATUS_PENDING` state. Use @ref TL_PipelineGetStatus() to poll it, or @ref TL_PipelineWait() to
+ * block until it has finished compiling. A pending pipeline **must not** be used for rendering, but it may be destroyed at any time - in that case,
+ * @ref TL_PipelineDestroy() waits for compilation to finish first.
+ *
+ * Any arrays referenced by `descriptor` are copied, so they do not need to outlive this call.
+ *
+ * @param renderer Renderer to create the pipeline for.
+ * @param descriptor A pipeline descriptor struct.
+ * @return The new (pending) pipeline, or NULL if the compilation job could not be queued
+ *
+ * @sa @ref TL_Pipeline_t
+ * @sa @ref TL_PipelineStatus_t
+ */
+TL_Pipeline_t *TL_PipelineCreateAsync(
+    const TL_Renderer_t *const renderer,
+    const TL_PipelineDescriptor_t descriptor
+);
+
+/**
+ * @brief Compile the pipelines recorded in a pipeline manifest in the background.
+ *
+ * This function reads the pipeline manifest file at `manifest_path` - as recorded by a renderer created with a
+ * [pipeline_manifest_path](@ref TL_RendererDescriptor_t.pipeline_manifest_path), e.g. in a previous session - and returns immediately, while the
+ * pipelines it describes are created in batches on the renderer's worker pool. Calling this function at startup moves the cost of compiling those
+ * pipelines into the loading screen: pipelines created later from equivalent descriptors share the pre-warmed pipeline objects instead of compiling
+ * new ones, and also hit the renderer's pipeline cache.
+ *
+ * Pre-warmed pipelines are kept until the renderer is destroyed. They are not themselves recorded into the renderer's pipeline manifest, so a
+ * manifest only ever lists pipelines that were actually requested during its session. Use @ref TL_PipelinePrewarmWait() to block until pre-warming
+ * has finished.
+ *
+ * @param renderer Renderer to create the pipelines for
+ * @param manifest_path Path to the pipeline manifest file to replay
+ * @return False if the manifest could not be read or its pipelines could not be queued
+ *
+ * @sa @ref TL_RendererDescriptor_t.pipeline_manifest_path
+ */
+bool TL_PipelinePrewarm(
+    const TL_Renderer_t *const renderer,
+    const char *const manifest_path
+);
+
+/**
+ * @brief Block until all pipelines queued by @ref TL_PipelinePrewarm() under the given renderer have been created.
+ *
+ * @param renderer Renderer to wait on
+ * @return The amount of pipelines pre-warmed under the renderer so far
+ */
+uint32_t TL_PipelinePrewarmWait(
+    const TL_Renderer_t *const renderer
+);
+
+/**
+ * @brief Retrieve feedback about how the given pipeline was created.
+ *
+ * This function reports how long the pipeline and each of its shader stages took to create, and whether they were found in the renderer's pipeline
+ * cache. This can be used to find out which pipelines are compiled cold, and whether a pipeline cache is actually warm. The same feedback is also
+ * logged to the renderer's debugger at verbose severity when each pipeline is created.
+ *
+ * Pipelines that share a pipeline object with an equivalent earlier pipeline report the feedback of the earlier pipeline's creation.
+ *
+ * The renderer must have been created with the `pipeline_creation_feedback` feature.
+ *
+ * @param pipeline Pipeline to query - it must have finished compiling
+ * @param out_feedback Pointer to the feedback struct to populate
+ * @return False if no feedback is available (e.g. the feature is not enabled, or the pipeline is still pending or failed)
+ */
+bool TL_PipelineGetCreationFeedback(
+    const TL_Pipeline_t *const pipeline,
+    TL_PipelineCreationFeedback_t *const out_feedback
+);
+
+/**
+ * @brief Retrieve the creation status of the given pipeline.
+ *
+ * This function returns the current status of the specified pipeline object without blocking.
+ *
+ * @param pipeline Pipeline to query
+ * @return Pipeline status
+ */
+TL_PipelineStatus_t TL_PipelineGetStatus(
+    const TL_Pipeline_t *const pipeline
+);
+
+/**
+ * @brief Block until the given pipeline has finished compiling.
+ *
+ * This function waits until the specified pipeline object is no longer in the `TL_PIPELINE_STATUS_PENDING` state, and then returns its status.
+ *
+ * @param pipeline Pipeline to wait on
+ * @return Pipeline status (either `TL_PIPELINE_STATUS_READY` or `TL_PIPELINE_STATUS_FAILED`)
+ */
+TL_PipelineStatus_t TL_PipelineWait(
+    const TL_Pipeline_t *const pipeline
+);
+
 /**
  * @brief Free the given pipeline object.
  *
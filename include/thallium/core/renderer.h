@@ -34,6 +34,36 @@ typedef struct TL_RendererFeatures_t {
 
     /// @brief The renderer can draw line primitives with a variable line width.
     bool wide_lines;
+
+    /// @brief The renderer can create pipelines whose rasterizer, depth test and primitive topology state is set on command buffers instead of
+    /// being baked into the pipeline object (see @ref TL_PipelineDescriptor_t.extended_dynamic_state).
+    bool extended_dynamic_state;
+
+    /// @brief The renderer compiles graphics pipelines as separately cached parts which are quickly linked together on creation, and re-linked with
+    /// full optimisation in the background. This reduces the stalls caused by creating pipelines that share parts with existing ones.
+    bool pipeline_libraries;
+
+    /// @brief The renderer records how long each pipeline and each of its shader stages took to create, and whether they were found in the
+    /// pipeline cache (see @ref TL_PipelineGetCreationFeedback()).
+    bool pipeline_creation_feedback;
+
+    /// @brief The renderer holds a global table of sampled images, storage buffers and samplers that shaders index by integer handle, so that
+    /// switching between resources needs no descriptor set binds. Descriptor set 0 of every pipeline is reserved for the table (see
+    /// @ref TLVK_BindlessTable_t).
+    bool bindless_resources;
+
+    /// @brief Bindings of descriptor set 1 of every pipeline are written directly into command buffers instead of being allocated and updated as
+    /// descriptor sets, which suits bindings that change with every draw or dispatch (see @ref TLVK_CommandBufferSystemPushDescriptorSet()).
+    bool push_descriptors;
+
+    /// @brief Descriptors of transient descriptor sets are written straight into a host-visible buffer instead of being allocated from descriptor
+    /// pools, and binding a set only records its offset in that buffer (see @ref TLVK_PipelineSystemAllocateDescriptorSet()). Pipelines whose
+    /// descriptor sets cannot be stored in the buffer keep using descriptor pools.
+    bool descriptor_buffers;
+
+    /// @brief Swapchains can tag each presented image and wait for it to reach the display, so that frames can be started just in time for the
+    /// next vertical blank (see @ref TLVK_SwapchainSystemDescriptor_t.frame_pacing). Requires `presentation`.
+    bool frame_pacing;
 } TL_RendererFeatures_t;
 
 /**
@@ -62,6 +92,11 @@ typedef struct TL_RendererDescriptor_t {
     /// @brief Renderer features to require
     TL_RendererFeatures_t requirements;
 
+    /// @brief NULL or the path of a pipeline manifest file to record into. If set, the descriptor of every unique pipeline created with the renderer
+    /// (including its shader code) is recorded, and the manifest is written to this path when the renderer is destroyed. The manifest can be
+    /// replayed with @ref TL_PipelinePrewarm() in later sessions to compile the same pipelines ahead of time.
+    const char *pipeline_manifest_path;
+
     /// @brief NULL or an optional descriptor for the API-specific renderer system to be created within the renderer. For example, to specify
     /// API-specific options to a Vulkan renderer, pass to this parameter a pointer to a @ref TLVK_RendererSystemDescriptor_t struct.
     void *renderer_system_descriptor;
@@ -12,11 +12,14 @@
     extern "C" {
 #endif // __cplusplus
 
+#include "thallium_decl/enums.h"
 #include "thallium_decl/fwd.h"
 #include "thallium/platform.h"
 
 #include "thallium/core/viewport.h"
 
+#include <stddef.h>
+
 /**
  * @brief A structure to represent a graphical swapchain.
  *
@@ -37,14 +40,43 @@ typedef struct TL_SwapchainDescriptor_t {
     /// @brief Resolution of images in the swapchain
     TL_Extent2D_t resolution;
 
-    /// @brief A Thallium [window surface object](@ref TL_WindowSurface_t).
+    /// @brief A Thallium [window surface object](@ref TL_WindowSurface_t) (ignored if `offscreen` is true).
     TL_WindowSurface_t *window_surface;
 
-    /// @brief NULL or an optional descriptor for the API-specific swapchain system to be created within the swapchain. For example, to specify
-    /// API-specific options to a Vulkan swapchain system, pass to this parameter a pointer to a @ref TLVK_SwapchainSystemDescriptor_t struct.
+    /// @brief Back the swapchain with plain images in device memory instead of a window surface. Offscreen swapchains keep the same frame API,
+    /// but never wait on a presentation engine or compositor, do not require the `presentation` [feature](@ref TL_RendererFeatures_t), and can be
+    /// read back with @ref TL_SwapchainReadImage(). Their images have 8-bit RGBA texels by default.
+    bool offscreen;
+
+    /// @brief Trade-off between latency and throughput that the swapchain is configured for (zero-initialise for a balanced configuration).
+    TL_SwapchainLatencyPolicy_t latency_policy;
+
+    /// @brief Delay the beginning of each frame so that it finishes just in time for the next vertical blank, minimising input-to-display latency.
+    /// Requires the `frame_pacing` [feature](@ref TL_RendererFeatures_t).
+    bool frame_pacing;
+
+    /// @brief NULL or an optional descriptor for the API-specific swapchain system to be created within the swapchain (ignored if `offscreen` is
+    /// true). For example, to specify API-specific options to a Vulkan swapchain system, pass to this parameter a pointer to a
+    /// @ref TLVK_SwapchainSystemDescriptor_t struct.
     void *swapchain_system_descriptor;
+
+    /// @brief NULL or an optional descriptor for the API-specific render target chain to be created within the swapchain (ignored unless
+    /// `offscreen` is true). For example, to specify API-specific options to a Vulkan render target chain, pass to this parameter a pointer to a
+    /// @ref TLVK_RenderTargetChainDescriptor_t struct.
+    void *render_target_chain_descriptor;
 } TL_SwapchainDescriptor_t;
 
+/**
+ * @brief A structure describing a frame begun with @ref TL_SwapchainBeginFrame().
+ */
+typedef struct TL_SwapchainFrame_t {
+    /// @brief Index of the frame in flight, which identifies the transient resources (e.g. descriptor sets) that may be used by the frame. These
+    /// are freed once the frame has finished executing, after which the index may be given to a frame of any swapchain of the renderer.
+    uint32_t frame_index;
+    /// @brief Index of the swapchain image acquired for the frame.
+    uint32_t image_index;
+} TL_SwapchainFrame_t;
+
 /**
  * @brief Create and return a new Thallium swapchain object for use with the given renderer.
  *
@@ -87,6 +119,93 @@ TL_Extent2D_t TL_SwapchainGetExtent(
     TL_Swapchain_t *const swapchain
 );
 
+/**
+ * @brief Begin a frame by acquiring the next image of the given swapchain.
+ *
+ * This function waits until the swapchain can start another frame without exceeding its frames in flight, then acquires the next image to render
+ * to. If the swapchain has become out of date (e.g. because its window was resized), it is recreated in place first and its extent is updated.
+ *
+ * False is also returned if the swapchain's surface currently has no area (e.g. because its window is minimised), in which case the frame should be
+ * skipped and attempted again later.
+ *
+ * @param swapchain Swapchain to begin a frame of
+ * @param out_frame NULL or a pointer to populate with a description of the new frame
+ * @return False if no image was acquired
+ *
+ * @sa @ref TL_SwapchainEndFrame()
+ */
+bool TL_SwapchainBeginFrame(
+    TL_Swapchain_t *const swapchain,
+    TL_SwapchainFrame_t *const out_frame
+);
+
+/**
+ * @brief End the current frame of the given swapchain by submitting its work and presenting the acquired image.
+ *
+ * This function submits `command_buffer` (which must have been recorded and ended, and must leave the acquired image ready for presentation), and
+ * then presents the acquired image once the command buffer has finished executing. The command buffer must not be submitted separately.
+ *
+ * With offscreen swapchains, nothing is presented - instead, the image is copied to host-visible memory after the command buffer, so that it can be
+ * read with @ref TL_SwapchainReadImage().
+ *
+ * @param swapchain Swapchain to end the current frame of
+ * @param command_buffer Command buffer holding the work of the frame
+ * @return False if there were errors
+ *
+ * @sa @ref TL_SwapchainBeginFrame()
+ */
+bool TL_SwapchainEndFrame(
+    TL_Swapchain_t *const swapchain,
+    TL_CommandBuffer_t *const command_buffer
+);
+
+/**
+ * @brief Resize the images of the given swapchain.
+ *
+ * This function recreates the swapchain in place at the specified resolution (e.g. after its window was resized), without waiting for the renderer
+ * to become idle. If called during a frame, the swapchain is recreated once that frame has been presented.
+ *
+ * @param swapchain Swapchain to resize
+ * @param resolution New resolution of the swapchain images
+ * @return False if there were errors
+ */
+bool TL_SwapchainResize(
+    TL_Swapchain_t *const swapchain,
+    const TL_Extent2D_t resolution
+);
+
+/**
+ * @brief Retrieve the size in bytes of the images read back from the given offscreen swapchain.
+ *
+ * @param swapchain Swapchain pointer
+ * @return Size of the tightly packed contents of one image, or 0 if the swapchain is not offscreen
+ *
+ * @sa @ref TL_SwapchainReadImage()
+ */
+size_t TL_SwapchainGetReadbackSize(
+    TL_Swapchain_t *const swapchain
+);
+
+/**
+ * @brief Read back the contents of an image of the given offscreen swapchain.
+ *
+ * This function copies the contents of image `image_index` (as an image index returned in @ref TL_SwapchainFrame_t), as rendered by the most recent
+ * frame that ended with it, into `out_data`. Only that frame is waited on, so later frames may already be in flight - e.g. the image of each frame
+ * can be read right before its index is next acquired.
+ *
+ * @param swapchain Offscreen swapchain to read from
+ * @param image_index Index of the image to read
+ * @param out_data Pointer to the memory to copy the image contents to
+ * @param size Size of `out_data` in bytes, which must be at least @ref TL_SwapchainGetReadbackSize()
+ * @return False if the image could not be read (e.g. because the swapchain is not offscreen)
+ */
+bool TL_SwapchainReadImage(
+    TL_Swapchain_t *const swapchain,
+    const uint32_t image_index,
+    void *const out_data,
+    const size_t size
+);
+
 #ifdef __cplusplus
     }
 #endif // __cplusplus
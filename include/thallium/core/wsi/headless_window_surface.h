@@ -0,0 +1,41 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__wsi__headless_window_surface__
+#define __TL__wsi__headless_window_surface__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwd.h"
+#include "thallium/platform.h"
+
+/**
+ * @brief Create a headless Thallium window surface, which is not backed by any window.
+ *
+ * This function creates a window surface for Thallium functions that does not need a display or window system, e.g. for rendering on CI runners
+ * and servers. Swapchains created for it support the full presentation path, but presented images are not displayed anywhere.
+ *
+ * With Vulkan renderers, this requires the `VK_EXT_headless_surface` instance extension, which is enabled whenever the implementation provides it
+ * (swapchains cannot be created for headless surfaces otherwise).
+ *
+ * @param width Width of the surface, used as the swapchain resolution if none was specified
+ * @param height Height of the surface, used as the swapchain resolution if none was specified
+ * @param debugger NULL or a debugger for function debugging
+ * @return Resulting window surface for use in Thallium functions.
+ */
+TL_WindowSurface_t *TL_WindowSurfaceCreateHeadless(
+    const uint32_t width,
+    const uint32_t height,
+    const TL_Debugger_t *const debugger
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
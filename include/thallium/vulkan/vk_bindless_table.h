@@ -0,0 +1,144 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__vulkan__vk_bindless_table_h__
+#define __TL__vulkan__vk_bindless_table_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwdvk.h"
+#include "thallium_decl/enumsvk.h"
+#include "thallium/platform.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief A global table of resources that shaders index by integer handle.
+ *
+ * This opaque struct holds a single descriptor set with one large array of descriptors for each @ref TLVK_BindlessResourceType_t, created with the
+ * update-after-bind and partially-bound flags of Vulkan descriptor indexing. Resources added to the table are given a handle, which shaders use to
+ * index the array of the resource's type, so that switching between resources (e.g. materials) needs no descriptor set binds - only the handles
+ * change, for example through push constants.
+ *
+ * A Vulkan renderer created with the `bindless_resources` [feature](@ref TL_RendererFeatures_t) has one table, which is bound automatically at
+ * descriptor set 0 with every pipeline that uses descriptor sets. Shaders must therefore declare the table's arrays in set 0, as:
+ *  - binding 0: a runtime-sized array of sampled images (e.g. `layout(set = 0, binding = 0) uniform texture2D textures[];`)
+ *  - binding 1: a runtime-sized array of storage buffers
+ *  - binding 2: a runtime-sized array of samplers
+ *
+ * Any of the three may be left out, and other resources must use the remaining sets.
+ *
+ * @sa @ref TLVK_BindlessTableCreate()
+ * @sa @ref TLVK_BindlessTableDestroy()
+ */
+typedef struct TLVK_BindlessTable_t TLVK_BindlessTable_t;
+
+/**
+ * @brief Create a heap-allocated Vulkan bindless table.
+ *
+ * This function creates a new bindless table under the specified renderer system, including its descriptor set layout, pool and set. The renderer
+ * system's device must have been created with the descriptor indexing features enabled for the `bindless_resources` feature. NULL will be returned
+ * if there were any errors.
+ *
+ * @param renderer_system Renderer system to create the table under
+ * @return The new bindless table
+ *
+ * @sa @ref TLVK_BindlessTable_t
+ * @sa @ref TLVK_BindlessTableDestroy()
+ */
+TLVK_BindlessTable_t *TLVK_BindlessTableCreate(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Free the given Vulkan bindless table.
+ *
+ * This function frees the specified bindless table and its descriptor set. No pipeline layout using the table's set layout may still exist.
+ *
+ * @param table NULL or the bindless table to free
+ */
+void TLVK_BindlessTableDestroy(
+    TLVK_BindlessTable_t *const table
+);
+
+/**
+ * @brief Add a sampled image to the given bindless table.
+ *
+ * This function writes a descriptor for `image_view` into a free slot of the table's sampled image array and returns the index of that slot. The
+ * descriptor can be written while command buffers using the table are being recorded or executed.
+ *
+ * @param table Bindless table to add to
+ * @param image_view Image view to add, created with `VK_IMAGE_USAGE_SAMPLED_BIT`
+ * @param image_layout Layout that the image will be in when accessed by shaders
+ * @return The image's handle, or UINT32_MAX if there were errors (e.g. the array is full)
+ */
+uint32_t TLVK_BindlessTableAddSampledImage(
+    TLVK_BindlessTable_t *const table,
+    const VkImageView image_view,
+    const VkImageLayout image_layout
+);
+
+/**
+ * @brief Add a storage buffer range to the given bindless table.
+ *
+ * This function writes a descriptor for the given range of `buffer` into a free slot of the table's storage buffer array and returns the index of
+ * that slot.
+ *
+ * @param table Bindless table to add to
+ * @param buffer Buffer to add, created with `VK_BUFFER_USAGE_STORAGE_BUFFER_BIT`
+ * @param offset Byte offset of the range in `buffer`
+ * @param range Size of the range in bytes, or `VK_WHOLE_SIZE`
+ * @return The buffer's handle, or UINT32_MAX if there were errors (e.g. the array is full)
+ */
+uint32_t TLVK_BindlessTableAddStorageBuffer(
+    TLVK_BindlessTable_t *const table,
+    const VkBuffer buffer,
+    const VkDeviceSize offset,
+    const VkDeviceSize range
+);
+
+/**
+ * @brief Add a sampler to the given bindless table.
+ *
+ * This function writes a descriptor for `sampler` into a free slot of the table's sampler array and returns the index of that slot.
+ *
+ * @param table Bindless table to add to
+ * @param sampler Sampler to add
+ * @return The sampler's handle, or UINT32_MAX if there were errors (e.g. the array is full)
+ */
+uint32_t TLVK_BindlessTableAddSampler(
+    TLVK_BindlessTable_t *const table,
+    const VkSampler sampler
+);
+
+/**
+ * @brief Release a handle of the given bindless table.
+ *
+ * This function frees the slot of the specified resource so that its handle can be reused by later additions. The descriptor in the slot is left
+ * as it is, as the table's arrays are partially bound, so no command buffer recorded after this call may access the handle. The slot is only
+ * reused once every swapchain and render target chain frame that was begun before this call has finished executing, and every command buffer system
+ * that began recording before this call has been waited on (see @ref TLVK_CommandBufferSystemWait(), which is also done when the command buffer
+ * system next begins recording or is destroyed), so work in flight can keep accessing it. Releasing a handle that is not in use (e.g. releasing it
+ * twice) is an error and has no effect.
+ *
+ * @param table Bindless table to release from
+ * @param type Type of the resource
+ * @param handle Handle returned when the resource was added
+ */
+void TLVK_BindlessTableRemove(
+    TLVK_BindlessTable_t *const table,
+    const TLVK_BindlessResourceType_t type,
+    const uint32_t handle
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -0,0 +1,296 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__vulkan__vk_command_buffer_system_h__
+#define __TL__vulkan__vk_command_buffer_system_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/core/pipeline.h"
+#include "thallium_decl/fwd.h"
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief A command buffer system to hold Vulkan command recording data.
+ *
+ * This opaque struct represents per-[command buffer](@ref TL_CommandBuffer_t) data for Vulkan command buffers, including the command pool they are
+ * allocated from.
+ *
+ * @sa @ref TLVK_CommandBufferSystemCreate()
+ * @sa @ref TLVK_CommandBufferSystemDestroy()
+ */
+typedef struct TLVK_CommandBufferSystem_t TLVK_CommandBufferSystem_t;
+
+/**
+ * @brief Create a heap-allocated Vulkan command buffer system.
+ *
+ * This function creates a new heap-allocated Vulkan command buffer system, including a
+ * [Vulkan command pool](https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkCommandPool.html) on the renderer system's graphics queue
+ * family and a primary command buffer allocated from it. NULL will be returned instead if there were any errors.
+ *
+ * @param renderer_system A valid Thallium Vulkan renderer system object
+ * @return The new Vulkan command buffer system
+ */
+TLVK_CommandBufferSystem_t *TLVK_CommandBufferSystemCreate(
+    const TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Free the given Thallium Vulkan command buffer system object.
+ *
+ * This function frees the specified command buffer system object, along with its command pool.
+ *
+ * @param command_buffer_system Pointer to the Thallium Vulkan command buffer system to free.
+ *
+ * @sa @ref TLVK_CommandBufferSystem_t
+ * @sa @ref TLVK_CommandBufferSystemCreate()
+ */
+void TLVK_CommandBufferSystemDestroy(
+    TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief Retrieve the Vulkan command buffer handle of the given command buffer system.
+ *
+ * This function returns the underlying Vulkan command buffer, so that raw Vulkan commands can be recorded alongside Thallium ones.
+ *
+ * @param command_buffer_system Command buffer system pointer
+ * @return Vulkan command buffer handle
+ */
+VkCommandBuffer TLVK_CommandBufferSystemGetHandle(
+    const TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief Begin recording the given Vulkan command buffer system.
+ *
+ * @param command_buffer_system Command buffer system to begin recording
+ * @return False if there were errors
+ *
+ * @sa @ref TL_CommandBufferBegin()
+ */
+bool TLVK_CommandBufferSystemBegin(
+    TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief End recording the given Vulkan command buffer system.
+ *
+ * @param command_buffer_system Command buffer system to end recording
+ * @return False if there were errors
+ *
+ * @sa @ref TL_CommandBufferEnd()
+ */
+bool TLVK_CommandBufferSystemEnd(
+    TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief Submit the given Vulkan command buffer system to its renderer system's graphics queue.
+ *
+ * @param command_buffer_system Command buffer system to submit
+ * @return False if there were errors
+ *
+ * @sa @ref TL_CommandBufferSubmit()
+ */
+bool TLVK_CommandBufferSystemSubmit(
+    TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief Submit the given Vulkan command buffer system to its renderer system's graphics queue, ordered against other queue work with semaphores.
+ *
+ * This function behaves like @ref TLVK_CommandBufferSystemSubmit(), except that the submission waits on `wait_semaphore` before executing the
+ * stages in `wait_stage_mask`, and signals `signal_semaphore` once it has finished executing. This is how swapchain systems order rendering
+ * between image acquisition and presentation.
+ *
+ * @param command_buffer_system Command buffer system to submit
+ * @param wait_semaphore VK_NULL_HANDLE or a binary semaphore to wait on
+ * @param wait_stage_mask Pipeline stages that wait on `wait_semaphore` (ignored if it is VK_NULL_HANDLE)
+ * @param signal_semaphore VK_NULL_HANDLE or a binary semaphore to signal
+ * @return False if there were errors
+ *
+ * @sa @ref TLVK_CommandBufferSystemSubmit()
+ */
+bool TLVK_CommandBufferSystemSubmitWithSemaphores(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const VkSemaphore wait_semaphore,
+    const VkPipelineStageFlags wait_stage_mask,
+    const VkSemaphore signal_semaphore
+);
+
+/**
+ * @brief Block until the most recent submission of the given Vulkan command buffer system has finished executing.
+ *
+ * Once the submission has been waited on, bindless table handles released since the command buffer system began recording can be reused.
+ *
+ * @param command_buffer_system Command buffer system to wait on
+ * @return False if there were errors
+ *
+ * @sa @ref TL_CommandBufferWait()
+ */
+bool TLVK_CommandBufferSystemWait(
+    TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief Record a pipeline bind into the given Vulkan command buffer system.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param pipeline_system Pipeline system to bind
+ *
+ * @sa @ref TL_CmdBindPipeline()
+ */
+void TLVK_CommandBufferSystemBindPipeline(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const TLVK_PipelineSystem_t *const pipeline_system
+);
+
+/**
+ * @brief Record dynamic rasterizer state into the given Vulkan command buffer system.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param rasterizer Rasterizer state to set
+ * @return False if nothing was recorded (e.g. because the renderer lacks the `extended_dynamic_state` [feature](@ref TL_RendererFeatures_t))
+ *
+ * @sa @ref TL_CmdSetRasterizerState()
+ */
+bool TLVK_CommandBufferSystemSetRasterizerState(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const TL_PipelineRasterizerDescriptor_t *const rasterizer
+);
+
+/**
+ * @brief Record dynamic depth test state into the given Vulkan command buffer system.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param depth_test Depth test state to set
+ * @return False if nothing was recorded (e.g. because the renderer lacks the `extended_dynamic_state` [feature](@ref TL_RendererFeatures_t))
+ *
+ * @sa @ref TL_CmdSetDepthTestState()
+ */
+bool TLVK_CommandBufferSystemSetDepthTestState(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const TL_PipelineDepthTestDescriptor_t *const depth_test
+);
+
+/**
+ * @brief Record a dynamic primitive topology into the given Vulkan command buffer system.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param topology Primitive topology to set
+ * @return False if nothing was recorded (e.g. because the renderer lacks the `extended_dynamic_state` [feature](@ref TL_RendererFeatures_t))
+ *
+ * @sa @ref TL_CmdSetPrimitiveTopology()
+ */
+bool TLVK_CommandBufferSystemSetPrimitiveTopology(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const TL_PrimitiveTopology_t topology
+);
+
+/**
+ * @brief Record a push constant update into the given Vulkan command buffer system.
+ *
+ * This function updates push constants of the pipeline layout of the most recently bound pipeline, for every shader stage that declares a push
+ * constant block.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param offset Byte offset of the range to update (must be a multiple of 4)
+ * @param size Size of the range to update in bytes (must be a multiple of 4)
+ * @param data Pointer to `size` bytes of data to push
+ *
+ * @sa @ref TL_CmdPushConstants()
+ */
+void TLVK_CommandBufferSystemPushConstants(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const uint32_t offset,
+    const uint32_t size,
+    const void *const data
+);
+
+/**
+ * @brief Record a descriptor set bind into the given Vulkan command buffer system.
+ *
+ * This function binds `set` at index `set_index` for the most recently bound pipeline, so that it is used by subsequent draws or dispatches. Sets
+ * stored in the renderer system's descriptor buffer are bound by recording their offset in the buffer with `vkCmdSetDescriptorBufferOffsetsEXT`,
+ * and others with `vkCmdBindDescriptorSets`.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param set_index Index of the descriptor set in the bound pipeline's layout
+ * @param set Descriptor set to bind, allocated with @ref TLVK_PipelineSystemAllocateDescriptorSet() for a pipeline with the same layout for the set
+ */
+void TLVK_CommandBufferSystemBindDescriptorSet(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const uint32_t set_index,
+    const TLVK_TransientDescriptorSet_t *const set
+);
+
+/**
+ * @brief Record a push descriptor update into the given Vulkan command buffer system.
+ *
+ * This function writes descriptors for descriptor set 1 of the most recently bound pipeline directly into the command buffer with
+ * [vkCmdPushDescriptorSetKHR](https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/vkCmdPushDescriptorSetKHR.html), so no descriptor
+ * set needs to be allocated or updated beforehand. The `dstSet` member of each write is ignored. The descriptors remain bound for subsequent draws or
+ * dispatches until they are pushed again or a pipeline with an incompatible layout is bound.
+ *
+ * @note The renderer must have been created with the `push_descriptors` [feature](@ref TL_RendererFeatures_t), and the shaders of the bound pipeline
+ * must use descriptor set 1, which may hold up to 32 descriptors and no runtime-sized arrays.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param write_count Amount of writes in `writes`
+ * @param writes Array of descriptor writes to push
+ */
+void TLVK_CommandBufferSystemPushDescriptorSet(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const uint32_t write_count,
+    const VkWriteDescriptorSet *const writes
+);
+
+/**
+ * @brief Record a compute dispatch into the given Vulkan command buffer system.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param group_count_x Amount of workgroups to dispatch in the X dimension
+ * @param group_count_y Amount of workgroups to dispatch in the Y dimension
+ * @param group_count_z Amount of workgroups to dispatch in the Z dimension
+ *
+ * @sa @ref TL_CmdDispatch()
+ */
+void TLVK_CommandBufferSystemDispatch(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const uint32_t group_count_x,
+    const uint32_t group_count_y,
+    const uint32_t group_count_z
+);
+
+/**
+ * @brief Record an indirect compute dispatch into the given Vulkan command buffer system.
+ *
+ * This function records a dispatch whose workgroup counts are read from a
+ * [VkDispatchIndirectCommand](https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDispatchIndirectCommand.html) in `buffer` when the
+ * command buffer executes, so that they can be computed on the GPU. A compute pipeline must have been bound beforehand.
+ *
+ * @param command_buffer_system Command buffer system being recorded
+ * @param buffer Vulkan buffer created with `VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT`
+ * @param offset Byte offset of the dispatch parameters in `buffer` (must be a multiple of 4)
+ */
+void TLVK_CommandBufferSystemDispatchIndirect(
+    TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const VkBuffer buffer,
+    const VkDeviceSize offset
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -15,6 +15,9 @@
 #include "thallium/core/pipeline.h"
 #include "thallium_decl/fwdvk.h"
 
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
 /**
  * @brief A pipeline system (AKA 'pipeline state object system') to hold Vulkan pipelining data.
  *
@@ -25,6 +28,23 @@
  */
 typedef struct TLVK_PipelineSystem_t TLVK_PipelineSystem_t;
 
+/**
+ * @brief A transient descriptor set, allocated either from descriptor pools or from the renderer system's descriptor buffer.
+ *
+ * Sets of pipelines whose layout is stored in the descriptor buffer (with the `descriptor_buffers` [feature](@ref TL_RendererFeatures_t)) have no
+ * `VkDescriptorSet` handle - they are identified by their offset in the buffer instead, and are bound by setting that offset.
+ *
+ * @sa @ref TLVK_PipelineSystemAllocateDescriptorSet()
+ * @sa @ref TLVK_CommandBufferSystemBindDescriptorSet()
+ */
+typedef struct TLVK_TransientDescriptorSet_t {
+    /// @brief Handle to the descriptor set, or VK_NULL_HANDLE if the set is stored in the descriptor buffer.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorSet.html
+    VkDescriptorSet vk_set;
+    /// @brief Offset in bytes of the set from the start of the descriptor buffer (only used if `vk_set` is VK_NULL_HANDLE).
+    VkDeviceSize buffer_offset;
+} TLVK_TransientDescriptorSet_t;
+
 // TODO: needed?
 // /**
 //  * @brief Descriptor struct to configure the creation of a Thallium pipeline system for Vulkan.
@@ -41,6 +61,18 @@ typedef struct TLVK_PipelineSystem_t TLVK_PipelineSystem_t;
  * [Vulkan pipeline state object](https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPipeline.html), and returns a handle to it. NULL
  * will be returned instead if there were any errors in pipeline creation.
  *
+ * Pipeline systems are deduplicated per renderer system: if a pipeline system was already created from an equivalent descriptor and has not yet
+ * been destroyed, its reference count is incremented and it is returned instead of compiling a new pipeline state object. This function is
+ * thread-safe.
+ *
+ * Shader modules are shared in the same way, keyed by a hash of their SPIR-V code, and are kept alive for as long as any pipeline system using
+ * them.
+ *
+ * If the renderer was created with the `pipeline_libraries` feature, graphics pipelines are instead linked from one graphics pipeline library per
+ * part (vertex input, pre-rasterization, fragment shader and fragment output), each shared between all pipelines with equivalent state for that
+ * part. The returned pipeline system is usable immediately, and a link-time optimised pipeline is compiled on the renderer's worker pool to replace
+ * it once ready.
+ *
  * @param renderer_system A valid Thallium Vulkan renderer system object
  * @param descriptor a Thallium pipeline descriptor
  * @return The new Vulkan PSO system
@@ -50,10 +82,85 @@ TLVK_PipelineSystem_t *TLVK_PipelineSystemCreate(
     const TL_PipelineDescriptor_t descriptor
 );
 
+/**
+ * @brief Create several Vulkan pipeline systems at once.
+ *
+ * This function behaves like calling @ref TLVK_PipelineSystemCreate() on each descriptor in turn, except that the pipeline state objects which
+ * need compiling are created together: one `vkCreateGraphicsPipelines` call for all new graphics pipelines and one `vkCreateComputePipelines` call
+ * for all new compute pipelines, both using the renderer system's pipeline cache. This lets the implementation compile the pipelines in parallel.
+ * Descriptors that are repeated within the batch share one pipeline system. (Graphics pipelines linked from pipeline libraries are still linked
+ * one at a time, as linking is already cheap.)
+ *
+ * @param renderer_system A valid Thallium Vulkan renderer system object
+ * @param count Amount of descriptors in `descriptors`
+ * @param descriptors Array of `count` Thallium pipeline descriptors
+ * @param out_pipeline_systems Array of `count` pointers, each populated with the new pipeline system or NULL if it could not be created
+ * @return False if any of the pipeline systems could not be created
+ */
+bool TLVK_PipelineSystemCreateBatch(
+    const TLVK_RendererSystem_t *const renderer_system,
+    const uint32_t count,
+    const TL_PipelineDescriptor_t *const descriptors,
+    TLVK_PipelineSystem_t **const out_pipeline_systems
+);
+
+/**
+ * @brief Retrieve feedback about how the given Vulkan pipeline system's pipeline state object was created.
+ *
+ * The feedback is recorded with `VkPipelineCreationFeedbackCreateInfo` when the pipeline system is created, if the renderer was created with the
+ * `pipeline_creation_feedback` feature.
+ *
+ * @param pipeline_system Pipeline system to query
+ * @param out_feedback Pointer to the feedback struct to populate
+ * @return False if no feedback was recorded
+ *
+ * @sa @ref TL_PipelineGetCreationFeedback()
+ */
+bool TLVK_PipelineSystemGetCreationFeedback(
+    const TLVK_PipelineSystem_t *const pipeline_system,
+    TL_PipelineCreationFeedback_t *const out_feedback
+);
+
+/**
+ * @brief Allocate a transient descriptor set for the given Vulkan pipeline system, and write it from packed data.
+ *
+ * This function allocates a descriptor set with the layout of set `set_index` of the pipeline system's (reflected) pipeline layout from the renderer
+ * system's descriptor pools for frame `frame`. The set is freed, along with every other set allocated for the same frame, when that frame retires.
+ * Sets can be bound with @ref TLVK_CommandBufferSystemBindDescriptorSet() to any pipeline whose shaders declare the same set.
+ *
+ * With the `descriptor_buffers` renderer feature, sets of pipelines that can use descriptor buffers are instead written directly to the frame's
+ * region of the renderer system's descriptor buffer, so no descriptor set object is allocated or updated. Such sets must be written on allocation,
+ * so `data` cannot be NULL; uniform and storage buffers in `data` must have been created with `VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT`, and their
+ * ranges cannot be `VK_WHOLE_SIZE`. Pipelines using texel buffers, acceleration structures, dynamic buffers or the bindless table keep using
+ * descriptor pools.
+ *
+ * If `data` is not NULL, every binding of the set is then written from it with one `vkUpdateDescriptorSetWithTemplate` call, using an update
+ * template created once per set layout. `data` must hold the descriptors of each binding declared by the shaders in the set, in increasing binding
+ * order and with no padding: one `VkDescriptorImageInfo` per array element for samplers, images and input attachments, one
+ * `VkDescriptorBufferInfo` for uniform and storage buffers, one `VkBufferView` for texel buffers and one `VkAccelerationStructureKHR` for
+ * acceleration structures. A runtime-sized array takes a single element.
+ *
+ * Sets reserved by the `bindless_resources` and `push_descriptors` renderer features cannot be allocated. This function is thread-safe.
+ *
+ * @param pipeline_system Pipeline system whose layout to use
+ * @param set_index Index of the descriptor set in the pipeline layout
+ * @param frame Index of the frame in flight that the set is used in, as returned when beginning the frame
+ * @param data NULL or a pointer to the packed descriptors to write
+ * @param out_set Pointer to populate with the new descriptor set
+ * @return False if there were errors
+ */
+bool TLVK_PipelineSystemAllocateDescriptorSet(
+    const TLVK_PipelineSystem_t *const pipeline_system,
+    const uint32_t set_index,
+    const uint32_t frame,
+    const void *const data,
+    TLVK_TransientDescriptorSet_t *const out_set
+);
+
 /**
  * @brief Free the given Thallium Vulkan pipeline state system object.
  *
- * This function frees the specified pipeline system object.
+ * This function releases a reference to the specified pipeline system object, and frees it once no references remain.
  *
  * @param pipeline_system Pointer to the Thallium Vulkan pipeline system to free.
  *
@@ -0,0 +1,224 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__vulkan__vk_render_target_chain_h__
+#define __TL__vulkan__vk_render_target_chain_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/core/viewport.h"
+
+#include "thallium_decl/enums.h"
+#include "thallium_decl/fwd.h"
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+#include <stddef.h>
+
+/**
+ * @brief An offscreen counterpart of Vulkan swapchain systems, whose images are plain Vulkan images in device memory.
+ *
+ * Render target chains provide the same frame API as [swapchain systems](@ref TLVK_SwapchainSystem_t), but need no window surface and never wait
+ * on a presentation engine or compositor. Ending a frame can also copy its image to host-visible memory, from which it can be read back with
+ * @ref TLVK_RenderTargetChainReadImage().
+ *
+ * @sa @ref TLVK_RenderTargetChainCreate()
+ * @sa @ref TLVK_RenderTargetChainDestroy()
+ */
+typedef struct TLVK_RenderTargetChain_t TLVK_RenderTargetChain_t;
+
+/**
+ * @brief Descriptor struct to configure the creation of a Thallium render target chain for Vulkan.
+ *
+ * This descriptor structure provides options for the creation of offscreen Vulkan render target chains.
+ */
+typedef struct TLVK_RenderTargetChainDescriptor_t {
+    /// @brief Resolution of images in the chain. Both values must be above 0 in this struct. If you are specifying this descriptor as the
+    /// `render_target_chain_descriptor` of a @ref TL_SwapchainDescriptor_t (i.e. calling @ref TL_SwapchainCreate()), then keeping this
+    /// zero-initialised will use the resolution specified to that descriptor.
+    TL_Extent2D_t resolution;
+
+    /// @brief Format of the images in the chain.
+    /// To use `VK_FORMAT_R8G8B8A8_UNORM` (which is default behaviour), set this to -1.
+    VkFormat vk_format;
+
+    /// @brief Usages of the images in addition to `VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT` and `VK_IMAGE_USAGE_TRANSFER_SRC_BIT`, which are always
+    /// included (e.g. `VK_IMAGE_USAGE_STORAGE_BIT` to render with compute shaders).
+    VkImageUsageFlags vk_image_usage;
+
+    /// @brief Trade-off between latency and throughput, which decides the amount of images (and so of frames in flight) in the chain. If you are
+    /// specifying this descriptor as the `render_target_chain_descriptor` of a @ref TL_SwapchainDescriptor_t, then keeping this
+    /// zero-initialised (balanced) will use the policy specified to that descriptor.
+    TL_SwapchainLatencyPolicy_t latency_policy;
+
+    /// @brief Copy the image of each frame to host-visible memory once it has been rendered, so that it can be read with
+    /// @ref TLVK_RenderTargetChainReadImage().
+    bool readback;
+
+    /// @brief Layout that the work of each frame leaves its image in. With `readback` enabled, the image is transitioned from this layout to
+    /// `VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL` for the copy and back again afterwards, so later frames find their image in this layout as well.
+    /// The first frame to acquire each image after the chain is created or resized finds it in `VK_IMAGE_LAYOUT_UNDEFINED` instead.
+    /// To use `VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL` (which is default behaviour), keep this zero-initialised (`VK_IMAGE_LAYOUT_UNDEFINED`).
+    VkImageLayout vk_final_layout;
+} TLVK_RenderTargetChainDescriptor_t;
+
+/**
+ * @brief Create and return a heap-allocated render target chain with Vulkan images.
+ *
+ * This function creates a new Vulkan render target chain, including its images and their memory, and returns it. If there were any errors in
+ * creation, NULL will be returned instead. Unlike swapchain systems, render target chains do not require the `presentation`
+ * [feature](@ref TL_RendererFeatures_t).
+ *
+ * @param renderer_system a valid Thallium Vulkan renderer system object
+ * @param descriptor a Thallium Vulkan render target chain descriptor
+ * @return The new render target chain
+ *
+ * @sa @ref TLVK_RenderTargetChain_t
+ * @sa @ref TLVK_RenderTargetChainDestroy()
+ * @sa @ref TLVK_RenderTargetChainDescriptor_t
+ */
+TLVK_RenderTargetChain_t *TLVK_RenderTargetChainCreate(
+    const TLVK_RendererSystem_t *const renderer_system,
+    const TLVK_RenderTargetChainDescriptor_t descriptor
+);
+
+/**
+ * @brief Free the given Thallium Vulkan render target chain object.
+ *
+ * This function waits for the frames in flight of the specified render target chain to finish executing, and then frees it.
+ *
+ * @param render_target_chain Pointer to the Thallium Vulkan render target chain to free.
+ *
+ * @sa @ref TLVK_RenderTargetChain_t
+ * @sa @ref TLVK_RenderTargetChainCreate()
+ */
+void TLVK_RenderTargetChainDestroy(
+    TLVK_RenderTargetChain_t *const render_target_chain
+);
+
+/**
+ * @brief Retrieve the extent of the given Vulkan render target chain.
+ *
+ * @param render_target_chain Render target chain pointer
+ * @return Render target chain extent
+ */
+TL_Extent2D_t TLVK_RenderTargetChainGetExtent(
+    TLVK_RenderTargetChain_t *const render_target_chain
+);
+
+/**
+ * @brief Retrieve a Vulkan image of the given Vulkan render target chain.
+ *
+ * The returned handle is only valid until the chain is next resized (see @ref TLVK_RenderTargetChainResize()), so it should be retrieved anew in
+ * each frame with the image index returned by @ref TLVK_RenderTargetChainBeginFrame().
+ *
+ * @param render_target_chain Render target chain pointer
+ * @param image_index Index of the image to retrieve
+ * @return Vulkan image handle, or VK_NULL_HANDLE if `image_index` is out of range
+ */
+VkImage TLVK_RenderTargetChainGetImage(
+    const TLVK_RenderTargetChain_t *const render_target_chain,
+    const uint32_t image_index
+);
+
+/**
+ * @brief Retrieve the size in bytes of the images read back from the given Vulkan render target chain.
+ *
+ * @param render_target_chain Render target chain pointer
+ * @return Size of the tightly packed contents of one image, or 0 if the chain was not created with `readback` enabled
+ *
+ * @sa @ref TLVK_RenderTargetChainReadImage()
+ */
+size_t TLVK_RenderTargetChainGetReadbackSize(
+    const TLVK_RenderTargetChain_t *const render_target_chain
+);
+
+/**
+ * @brief Begin a frame by acquiring the next image of the given Vulkan render target chain.
+ *
+ * This function waits until the frame that previously used the next image has finished executing, frees the transient descriptor sets allocated for
+ * that frame, and returns that image. Each frame in flight has its own image, but frame indices are shared by every swapchain and render target chain
+ * of the renderer system, so the frame index and image index may differ. Images are in the `VK_IMAGE_LAYOUT_UNDEFINED` layout when first acquired
+ * after creation or a resize, and in the layout they were left in by their previous frame otherwise.
+ *
+ * @param render_target_chain Render target chain to begin a frame of
+ * @param out_frame_index NULL or a pointer to populate with the index of the frame in flight, to be passed to
+ * @ref TLVK_PipelineSystemAllocateDescriptorSet()
+ * @param out_image_index NULL or a pointer to populate with the index of the acquired image
+ * @return False if no image was acquired
+ *
+ * @sa @ref TLVK_RenderTargetChainEndFrame()
+ */
+bool TLVK_RenderTargetChainBeginFrame(
+    TLVK_RenderTargetChain_t *const render_target_chain,
+    uint32_t *const out_frame_index,
+    uint32_t *const out_image_index
+);
+
+/**
+ * @brief End the current frame of the given Vulkan render target chain by submitting its work.
+ *
+ * This function submits `command_buffer_system` (which must have been recorded and ended). If the chain was created with `readback` enabled, the
+ * command buffer system must leave the acquired image in the chain's `vk_final_layout` layout (the offscreen counterpart of
+ * `VK_IMAGE_LAYOUT_PRESENT_SRC_KHR`), after which the image is copied to host-visible memory on the same queue. The copy transitions the image to
+ * `VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL` and back, so the image is in `vk_final_layout` again when it is next acquired (unless the chain is resized
+ * in between, after which it is in `VK_IMAGE_LAYOUT_UNDEFINED`).
+ *
+ * @param render_target_chain Render target chain to end the current frame of
+ * @param command_buffer_system Command buffer system holding the work of the frame
+ * @return False if there were errors
+ *
+ * @sa @ref TLVK_RenderTargetChainBeginFrame()
+ */
+bool TLVK_RenderTargetChainEndFrame(
+    TLVK_RenderTargetChain_t *const render_target_chain,
+    TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief Resize the images of the given Vulkan render target chain.
+ *
+ * This function waits for the frames in flight of the chain to finish executing and recreates its images at the specified resolution. If a frame
+ * is in progress, the images are recreated once that frame has ended instead. Contents that have not been read back are lost.
+ *
+ * @param render_target_chain Render target chain to resize
+ * @param resolution New resolution of the images
+ * @return False if there were errors
+ */
+bool TLVK_RenderTargetChainResize(
+    TLVK_RenderTargetChain_t *const render_target_chain,
+    const TL_Extent2D_t resolution
+);
+
+/**
+ * @brief Read back the contents of an image of the given Vulkan render target chain, as rendered by the most recent frame that ended with it.
+ *
+ * This function waits for that frame to finish executing (but not for any other frame), and then copies the image's tightly packed texels, row by
+ * row, into `out_data`. The chain must have been created with `readback` enabled.
+ *
+ * @param render_target_chain Render target chain to read from
+ * @param image_index Index of the image to read
+ * @param out_data Pointer to the memory to copy the image contents to
+ * @param size Size of `out_data` in bytes, which must be at least @ref TLVK_RenderTargetChainGetReadbackSize()
+ * @return False if the image could not be read (e.g. because no frame has been rendered to it yet)
+ */
+bool TLVK_RenderTargetChainReadImage(
+    TLVK_RenderTargetChain_t *const render_target_chain,
+    const uint32_t image_index,
+    void *const out_data,
+    const size_t size
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
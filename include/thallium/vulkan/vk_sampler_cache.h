@@ -0,0 +1,109 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__vulkan__vk_sampler_cache_h__
+#define __TL__vulkan__vk_sampler_cache_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief A reference to a Vulkan sampler shared through a renderer system's sampler cache.
+ *
+ * Samplers are immutable and usually only come in a handful of configurations, while devices may limit the amount of samplers that can exist at
+ * once (`maxSamplerAllocationCount`, which can be as low as 4000). Each renderer system therefore keeps a cache of live samplers keyed by their
+ * creation parameters, and every request for an equivalent sampler returns a reference to the same `VkSampler` handle.
+ *
+ * @sa @ref TLVK_SamplerCacheAcquire()
+ * @sa @ref TLVK_SamplerCacheRelease()
+ */
+typedef struct TLVK_Sampler_t TLVK_Sampler_t;
+
+/**
+ * @brief Usage statistics of a Vulkan renderer system's sampler cache.
+ *
+ * @sa @ref TLVK_SamplerCacheGetStats()
+ */
+typedef struct TLVK_SamplerCacheStats_t {
+    /// @brief Amount of distinct samplers currently alive in the renderer system.
+    uint32_t sampler_count;
+    /// @brief Maximum amount of samplers that can exist at once on the renderer system's device (`maxSamplerAllocationCount`).
+    uint32_t max_sampler_count;
+
+    /// @brief Amount of acquisitions that returned an existing sampler.
+    uint64_t hit_count;
+    /// @brief Amount of acquisitions that had to create a new sampler.
+    uint64_t miss_count;
+} TLVK_SamplerCacheStats_t;
+
+/**
+ * @brief Retrieve a shared Vulkan sampler with the given parameters.
+ *
+ * This function returns a reference to the renderer system's sampler created with parameters equivalent to `info`, creating it if no such sampler
+ * is alive. A warning is emitted once three quarters of the device's `maxSamplerAllocationCount` are in use, and NULL is returned instead of
+ * exceeding it. Extension structures are not supported, so the `pNext` member of `info` must be NULL. This function is thread-safe.
+ *
+ * @param renderer_system Renderer system to create the sampler under
+ * @param info Parameters of the sampler
+ * @return NULL if there were errors, otherwise a reference to the sampler
+ *
+ * @sa @ref TLVK_Sampler_t
+ * @sa @ref TLVK_SamplerCacheRelease()
+ */
+TLVK_Sampler_t *TLVK_SamplerCacheAcquire(
+    TLVK_RendererSystem_t *const renderer_system,
+    const VkSamplerCreateInfo *const info
+);
+
+/**
+ * @brief Release a reference to a shared Vulkan sampler.
+ *
+ * This function releases a reference acquired with @ref TLVK_SamplerCacheAcquire(), and destroys the sampler once no references remain. The last
+ * reference must only be released once the device has finished executing every command buffer that uses the sampler.
+ *
+ * @param sampler NULL or the sampler to release
+ *
+ * @sa @ref TLVK_SamplerCacheAcquire()
+ */
+void TLVK_SamplerCacheRelease(
+    TLVK_Sampler_t *const sampler
+);
+
+/**
+ * @brief Get the Vulkan handle of a shared sampler.
+ *
+ * @param sampler Sampler to query
+ * @return The sampler's handle, which stays valid until the last reference to the sampler is released
+ */
+VkSampler TLVK_SamplerGetHandle(
+    const TLVK_Sampler_t *const sampler
+);
+
+/**
+ * @brief Get usage statistics of a Vulkan renderer system's sampler cache.
+ *
+ * This function can be used to see how close the renderer system is to the device's sampler allocation limit.
+ *
+ * @param renderer_system Renderer system to query
+ * @param out_stats Pointer to populate with the statistics
+ */
+void TLVK_SamplerCacheGetStats(
+    TLVK_RendererSystem_t *const renderer_system,
+    TLVK_SamplerCacheStats_t *const out_stats
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
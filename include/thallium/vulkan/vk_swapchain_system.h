@@ -14,6 +14,7 @@
 
 #include "thallium/core/viewport.h"
 
+#include "thallium_decl/enums.h"
 #include "thallium_decl/fwd.h"
 #include "thallium_decl/fwdvk.h"
 #include "thallium/platform.h"
@@ -54,8 +55,20 @@ typedef struct TLVK_SwapchainSystemDescriptor_t {
     VkSurfaceFormatKHR vk_surface_format;
 
     /// @brief Explicit presentation mode to use in swapchain creation.
-    /// To automatically select optimal present mode (which is default behaviour), set this to -1.
+    /// To automatically select the present mode preferred by `latency_policy` (which is default behaviour), set this to -1.
     VkPresentModeKHR vk_present_mode;
+
+    /// @brief Trade-off between latency and throughput, which decides the amount of swapchain images, the automatically selected presentation mode
+    /// and the amount of frames in flight. If you are specifying this descriptor as an add-on to a @ref TL_SwapchainDescriptor_t, then keeping this
+    /// zero-initialised (balanced) will use the policy specified to that descriptor.
+    TL_SwapchainLatencyPolicy_t latency_policy;
+
+    /// @brief Tag each present with an ID and wait for it to be displayed on a pacing thread, so that
+    /// @ref TLVK_SwapchainSystemBeginFrame() can delay each frame to begin just in time for the next vertical blank. This minimises the time
+    /// between a frame's input being read and it being displayed. Requires the `frame_pacing` [feature](@ref TL_RendererFeatures_t). If you are
+    /// specifying this descriptor as an add-on to a @ref TL_SwapchainDescriptor_t, then keeping this false will use the setting specified to that
+    /// descriptor.
+    bool frame_pacing;
 } TLVK_SwapchainSystemDescriptor_t;
 
 /**
@@ -112,6 +125,83 @@ TL_Extent2D_t TLVK_SwapchainSystemGetExtent(
     TLVK_SwapchainSystem_t *const swapchain_system
 );
 
+/**
+ * @brief Retrieve a Vulkan image of the given Vulkan swapchain system.
+ *
+ * The returned handle is only valid until the swapchain is next recreated (see @ref TLVK_SwapchainSystemResize()), so it should be retrieved anew
+ * in each frame with the image index returned by @ref TLVK_SwapchainSystemBeginFrame().
+ *
+ * @param swapchain_system Swapchain system pointer
+ * @param image_index Index of the image to retrieve
+ * @return Vulkan image handle, or VK_NULL_HANDLE if `image_index` is out of range
+ */
+VkImage TLVK_SwapchainSystemGetImage(
+    const TLVK_SwapchainSystem_t *const swapchain_system,
+    const uint32_t image_index
+);
+
+/**
+ * @brief Begin a frame by acquiring the next image of the given Vulkan swapchain system.
+ *
+ * This function waits until the frame in flight that previously used the same synchronisation objects has finished executing, frees the transient
+ * descriptor sets allocated for it, and then acquires the next swapchain image. With frame pacing enabled, it also waits until the latest time at
+ * which the frame can begin and still be displayed at the next vertical blank it can reach. If the swapchain is out of date (e.g. because its window
+ * was resized), it is recreated in place and the acquisition is retried; if it is only suboptimal, the acquired image is used and the swapchain is
+ * recreated after it has been presented.
+ *
+ * False is returned without an error if the surface currently has a zero-sized extent (e.g. because its window is minimised), in which case the
+ * frame should be skipped and attempted again later.
+ *
+ * @param swapchain_system Swapchain system to begin a frame of
+ * @param out_frame_index NULL or a pointer to populate with the index of the frame in flight, to be passed to
+ * @ref TLVK_PipelineSystemAllocateDescriptorSet(). Frame indices are shared by every swapchain and render target chain of the renderer system, so
+ * they may differ from one frame of this swapchain to the next.
+ * @param out_image_index NULL or a pointer to populate with the index of the acquired image
+ * @return False if no image was acquired
+ *
+ * @sa @ref TLVK_SwapchainSystemEndFrame()
+ */
+bool TLVK_SwapchainSystemBeginFrame(
+    TLVK_SwapchainSystem_t *const swapchain_system,
+    uint32_t *const out_frame_index,
+    uint32_t *const out_image_index
+);
+
+/**
+ * @brief End the current frame of the given Vulkan swapchain system by submitting its work and presenting the acquired image.
+ *
+ * This function submits `command_buffer_system` (which must have been recorded and ended) to wait on the acquisition of the current image, then
+ * queues the image for presentation once that submission has finished. The command buffer system must transition the image to the
+ * `VK_IMAGE_LAYOUT_PRESENT_SRC_KHR` layout. If presentation reports the swapchain as out of date or suboptimal, it is recreated in place.
+ *
+ * @param swapchain_system Swapchain system to end the current frame of
+ * @param command_buffer_system Command buffer system holding the work of the frame
+ * @return False if there were errors
+ *
+ * @sa @ref TLVK_SwapchainSystemBeginFrame()
+ */
+bool TLVK_SwapchainSystemEndFrame(
+    TLVK_SwapchainSystem_t *const swapchain_system,
+    TLVK_CommandBufferSystem_t *const command_buffer_system
+);
+
+/**
+ * @brief Resize the given Vulkan swapchain system.
+ *
+ * This function recreates the swapchain at the specified resolution (clamped to what the surface supports), passing the current swapchain as
+ * `oldSwapchain` so that the presentation engine can reuse its resources. The replaced swapchain is not destroyed immediately, but once the
+ * frames that may still be presenting from it have finished executing, so resizing never waits for the device to become idle. If a frame is in
+ * progress, the swapchain is recreated after that frame has been presented instead.
+ *
+ * @param swapchain_system Swapchain system to resize
+ * @param resolution New resolution of the swapchain images
+ * @return False if there were errors
+ */
+bool TLVK_SwapchainSystemResize(
+    TLVK_SwapchainSystem_t *const swapchain_system,
+    const TL_Extent2D_t resolution
+);
+
 #ifdef __cplusplus
     }
 #endif // __cplusplus
@@ -94,6 +94,24 @@ typedef enum TL_DebugSourceFlags_t {
     TL_DEBUG_SOURCE_ALL_BIT =       0x3f,
 } TL_DebugSourceFlags_t;
 
+/**
+ * @brief Enumeration containing the creation states of Thallium pipeline objects.
+ *
+ * This enumeration contains the states that a pipeline object can be in while (or after) it is being created. Pipelines created with
+ * @ref TL_PipelineCreate() are always returned in a non-pending state, while pipelines created with @ref TL_PipelineCreateAsync() start as pending.
+ *
+ * @sa @ref TL_Pipeline_t
+ * @sa @ref TL_PipelineGetStatus()
+ */
+typedef enum TL_PipelineStatus_t {
+    /// @brief The pipeline is still being compiled and cannot be used yet
+    TL_PIPELINE_STATUS_PENDING,
+    /// @brief The pipeline was created successfully and is ready for use
+    TL_PIPELINE_STATUS_READY,
+    /// @brief Creation of the pipeline failed - the pipeline object must still be destroyed
+    TL_PIPELINE_STATUS_FAILED,
+} TL_PipelineStatus_t;
+
 /**
  * @brief Enumeration containing types of Thallium pipeline objects.
  *
@@ -105,7 +123,7 @@ typedef enum TL_DebugSourceFlags_t {
 typedef enum TL_PipelineType_t {
     /// @brief Represent a graphics pipeline
     TL_PIPELINE_TYPE_GRAPHICS,
-    /// @brief Represent a compute pipeline (currently unimplemented and reserved for future use)
+    /// @brief Represent a compute pipeline
     TL_PIPELINE_TYPE_COMPUTE,
     /// @brief Represent a ray tracing pipeline (currently unimplemented and reserved for future use)
     TL_PIPELINE_TYPE_RAY_TRACING,
@@ -177,6 +195,25 @@ typedef enum TL_RendererAPIFlags_t {
     TL_RENDERER_API_NULL_BIT =      0x00,
 } TL_RendererAPIFlags_t;
 
+/**
+ * @brief Enumeration containing trade-offs between latency and throughput that swapchains can be configured for.
+ *
+ * This enumeration contains policies that decide how many images a swapchain has, how they are presented, and how many frames may be in flight at
+ * once. Deeper queues of frames keep the GPU busier, at the cost of each frame reaching the display later after its work was started.
+ *
+ * @sa @ref TL_SwapchainDescriptor_t
+ */
+typedef enum TL_SwapchainLatencyPolicy_t {
+    /// @brief One more image than the minimum, mailbox presentation where available, and two frames in flight
+    TL_SWAPCHAIN_LATENCY_POLICY_BALANCED,
+    /// @brief The minimum amount of images, mailbox presentation where available, and a single frame in flight - for minimum input-to-display
+    /// latency (e.g. interactive kiosk displays)
+    TL_SWAPCHAIN_LATENCY_POLICY_LOW_LATENCY,
+    /// @brief Two more images than the minimum, mailbox presentation (or immediate presentation, which may tear) where available, and three
+    /// frames in flight - for maximum frame rate (e.g. offline rendering)
+    TL_SWAPCHAIN_LATENCY_POLICY_HIGH_THROUGHPUT,
+} TL_SwapchainLatencyPolicy_t;
+
 #ifdef __cplusplus
     }
 #endif // __cplusplus
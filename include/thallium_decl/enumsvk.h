@@ -27,6 +27,20 @@ typedef enum TLVK_PhysicalDeviceSelectionMode_t {
     TLVK_PHYSICAL_DEVICE_SELECTION_MODE_FIRST,
 } TLVK_PhysicalDeviceSelectionMode_t;
 
+/**
+ * @brief Enumeration containing the types of resources held in a Vulkan bindless table.
+ *
+ * The value of each type is also the binding index of its descriptor array in the table's descriptor set.
+ */
+typedef enum TLVK_BindlessResourceType_t {
+    /// @brief Sampled images (`VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE`), declared in shaders as e.g. `texture2D textures[]` at binding 0.
+    TLVK_BINDLESS_RESOURCE_TYPE_SAMPLED_IMAGE = 0,
+    /// @brief Storage buffers (`VK_DESCRIPTOR_TYPE_STORAGE_BUFFER`), declared in shaders as a runtime-sized array of buffer blocks at binding 1.
+    TLVK_BINDLESS_RESOURCE_TYPE_STORAGE_BUFFER = 1,
+    /// @brief Samplers (`VK_DESCRIPTOR_TYPE_SAMPLER`), declared in shaders as e.g. `sampler samplers[]` at binding 2.
+    TLVK_BINDLESS_RESOURCE_TYPE_SAMPLER = 2,
+} TLVK_BindlessResourceType_t;
+
 #ifdef __cplusplus
     }
 #endif // __cplusplus
@@ -14,6 +14,8 @@
 
 typedef struct TL_WindowSurface_t TL_WindowSurface_t;
 
+typedef struct TL_CommandBuffer_t TL_CommandBuffer_t;
+
 typedef struct TL_Context_t TL_Context_t;
 typedef struct TL_ContextDescriptor_t TL_ContextDescriptor_t;
 
@@ -32,6 +34,7 @@ typedef struct TL_RendererFeatures_t TL_RendererFeatures_t;
 
 typedef struct TL_Swapchain_t TL_Swapchain_t;
 typedef struct TL_SwapchainDescriptor_t TL_SwapchainDescriptor_t;
+typedef struct TL_SwapchainFrame_t TL_SwapchainFrame_t;
 
 typedef struct TL_Version_t TL_Version_t;
 
@@ -12,11 +12,22 @@
     extern "C" {
 #endif // __cplusplus
 
+typedef struct TLVK_BindlessTable_t TLVK_BindlessTable_t;
+
+typedef struct TLVK_CommandBufferSystem_t TLVK_CommandBufferSystem_t;
+
 typedef struct TLVK_PipelineSystem_t TLVK_PipelineSystem_t;
+typedef struct TLVK_TransientDescriptorSet_t TLVK_TransientDescriptorSet_t;
+
+typedef struct TLVK_RenderTargetChain_t TLVK_RenderTargetChain_t;
+typedef struct TLVK_RenderTargetChainDescriptor_t TLVK_RenderTargetChainDescriptor_t;
 
 typedef struct TLVK_RendererSystem_t TLVK_RendererSystem_t;
 typedef struct TLVK_RendererSystemDescriptor_t TLVK_RendererSystemDescriptor_t;
 
+typedef struct TLVK_Sampler_t TLVK_Sampler_t;
+typedef struct TLVK_SamplerCacheStats_t TLVK_SamplerCacheStats_t;
+
 typedef struct TLVK_SwapchainSystem_t TLVK_SwapchainSystem_t;
 typedef struct TLVK_SwapchainSystemDescriptor_t TLVK_SwapchainSystemDescriptor_t;
 
@@ -15,8 +15,12 @@
 #define VK_NO_PROTOTYPES
 #include <vulkan/vulkan.h>
 
+#include "thallium/vulkan/vk_bindless_table.h"
+#include "thallium/vulkan/vk_command_buffer_system.h"
 #include "thallium/vulkan/vk_pipeline_system.h"
+#include "thallium/vulkan/vk_render_target_chain.h"
 #include "thallium/vulkan/vk_renderer_system.h"
+#include "thallium/vulkan/vk_sampler_cache.h"
 #include "thallium/vulkan/vk_swapchain_system.h"
 
 #ifdef __cplusplus
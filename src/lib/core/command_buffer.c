@@ -0,0 +1,297 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "thallium/core/command_buffer.h"
+#include "types/core/command_buffer_t.h"
+
+#include "types/core/pipeline_t.h"
+#include "types/core/renderer_t.h"
+#include "utils/utils.h"
+
+#include "api_modules.h"
+
+#include <stdlib.h>
+
+static bool __CheckExtendedDynamicState(const TL_CommandBuffer_t *const command_buffer, const char *const fn);
+
+
+TL_CommandBuffer_t *TL_CommandBufferCreate(const TL_Renderer_t *const renderer) {
+    if (!renderer) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer->debugger;
+
+    TL_CommandBuffer_t *command_buffer = malloc(sizeof(TL_CommandBuffer_t));
+    if (!command_buffer) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_CommandBufferCreate");
+        return NULL;
+    }
+
+    TL_Log(debugger, "Allocated command buffer at %p", command_buffer);
+
+    command_buffer->renderer = renderer;
+
+    // creating API-appropriate command buffer system
+    switch (renderer->api) {
+
+        // create a Vulkan command buffer system...
+        case TL_RENDERER_API_VULKAN_BIT:;
+#           if defined(_THALLIUM_VULKAN_INCL)
+
+                void *renderersys = renderer->renderer_system;
+
+                TLVK_CommandBufferSystem_t *cmdsys = TLVK_CommandBufferSystemCreate(renderersys);
+                if (!cmdsys) {
+                    TL_Error(debugger, "Failed to create Vulkan command buffer system for new command buffer at %p", command_buffer);
+                    free(command_buffer);
+                    return NULL;
+                }
+
+                command_buffer->command_buffer_system = (void *) cmdsys;
+
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            free(command_buffer);
+            return NULL;
+
+    }
+
+    return command_buffer;
+}
+
+void TL_CommandBufferDestroy(TL_CommandBuffer_t *const command_buffer) {
+    if (!command_buffer) {
+        return;
+    }
+
+    switch (command_buffer->renderer->api) {
+        // destroy Vulkan command buffer system
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                TLVK_CommandBufferSystemDestroy((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    free(command_buffer);
+}
+
+bool TL_CommandBufferBegin(TL_CommandBuffer_t *const command_buffer) {
+    if (!command_buffer) {
+        return false;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                return TLVK_CommandBufferSystemBegin((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return false;
+}
+
+bool TL_CommandBufferEnd(TL_CommandBuffer_t *const command_buffer) {
+    if (!command_buffer) {
+        return false;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                return TLVK_CommandBufferSystemEnd((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return false;
+}
+
+bool TL_CommandBufferSubmit(TL_CommandBuffer_t *const command_buffer) {
+    if (!command_buffer) {
+        return false;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                return TLVK_CommandBufferSystemSubmit((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return false;
+}
+
+bool TL_CommandBufferWait(TL_CommandBuffer_t *const command_buffer) {
+    if (!command_buffer) {
+        return false;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                return TLVK_CommandBufferSystemWait((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return false;
+}
+
+void TL_CmdBindPipeline(TL_CommandBuffer_t *const command_buffer, const TL_Pipeline_t *const pipeline) {
+    if (!command_buffer || !pipeline) {
+        return;
+    }
+
+    if (TL_PipelineGetStatus(pipeline) != TL_PIPELINE_STATUS_READY) {
+        TL_Error(command_buffer->renderer->debugger, "TL_CmdBindPipeline: pipeline %p is not ready to be bound (still compiling or failed)",
+            pipeline);
+        return;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                TLVK_CommandBufferSystemBindPipeline((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system,
+                    (const TLVK_PipelineSystem_t *) pipeline->pipeline_system);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+}
+
+void TL_CmdSetRasterizerState(TL_CommandBuffer_t *const command_buffer, const TL_PipelineRasterizerDescriptor_t *const rasterizer) {
+    if (!command_buffer || !rasterizer || !__CheckExtendedDynamicState(command_buffer, "TL_CmdSetRasterizerState")) {
+        return;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                TLVK_CommandBufferSystemSetRasterizerState((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system, rasterizer);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+}
+
+void TL_CmdSetDepthTestState(TL_CommandBuffer_t *const command_buffer, const TL_PipelineDepthTestDescriptor_t *const depth_test) {
+    if (!command_buffer || !depth_test || !__CheckExtendedDynamicState(command_buffer, "TL_CmdSetDepthTestState")) {
+        return;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                TLVK_CommandBufferSystemSetDepthTestState((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system, depth_test);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+}
+
+void TL_CmdSetPrimitiveTopology(TL_CommandBuffer_t *const command_buffer, const TL_PrimitiveTopology_t topology) {
+    if (!command_buffer || !__CheckExtendedDynamicState(command_buffer, "TL_CmdSetPrimitiveTopology")) {
+        return;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                TLVK_CommandBufferSystemSetPrimitiveTopology((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system, topology);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+}
+
+void TL_CmdPushConstants(TL_CommandBuffer_t *const command_buffer, const uint32_t offset, const uint32_t size, const void *const data) {
+    if (!command_buffer || !data) {
+        return;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                TLVK_CommandBufferSystemPushConstants((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system, offset, size, data);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+}
+
+void TL_CmdDispatch(TL_CommandBuffer_t *const command_buffer, const uint32_t group_count_x, const uint32_t group_count_y,
+    const uint32_t group_count_z)
+{
+    if (!command_buffer) {
+        return;
+    }
+
+    switch (command_buffer->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                TLVK_CommandBufferSystemDispatch((TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system, group_count_x, group_count_y,
+                    group_count_z);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+}
+
+
+static bool __CheckExtendedDynamicState(const TL_CommandBuffer_t *const command_buffer, const char *const fn) {
+    if (!command_buffer->renderer->features.extended_dynamic_state) {
+        TL_Error(command_buffer->renderer->debugger, "%s: missing renderer feature 'extended_dynamic_state'", fn);
+        return false;
+    }
+
+    return true;
+}
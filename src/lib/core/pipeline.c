@@ -8,57 +8,252 @@
 #include "thallium/core/pipeline.h"
 #include "types/core/pipeline_t.h"
 
+#include "lib/core/pipeline_descriptor.h"
+#include "lib/core/pipeline_manifest.h"
 #include "types/core/renderer_t.h"
-#include "utils/io/log.h"
+#include "utils/utils.h"
 
 #include "api_modules.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+// Amount of manifest pipelines created by each pre-warming job - large enough for the driver to compile each batch in parallel, and small enough
+// for the batches to be spread over the renderer's workers
+#define __PREWARM_BATCH_SIZE 16
+
+typedef struct __PrewarmJob {
+    const TL_Renderer_t *renderer;
+
+    uint32_t count;
+    TL_PipelineDescriptor_t *descriptors;
+} __PrewarmJob;
+
+static TL_Pipeline_t *__AllocatePipeline(const TL_Renderer_t *const renderer, const TL_PipelineStatus_t status);
+
+static bool __CreatePipelineBatch(const TL_Renderer_t *const renderer, const uint32_t count, const TL_PipelineDescriptor_t *const descriptors,
+    TL_Pipeline_t **const out_pipelines, const bool record);
+
+static void *__CreatePipelineSystem(const TL_Renderer_t *const renderer, TL_PipelineDescriptor_t descriptor, TL_Pipeline_t *const pipeline);
+
+static bool __CreatePipelineSystems(const TL_Renderer_t *const renderer, const uint32_t count, TL_PipelineDescriptor_t *const descriptors,
+    void **const out_pipeline_systems, const bool record);
+
+static void __CompilePipelineJob(void *data);
+
+static void __PrewarmPipelinesJob(void *data);
+
+static void __FinishPrewarmJob(TL_Renderer_t *const renderer, TL_Pipeline_t *const *const pipelines, const uint32_t count);
+
 
 TL_Pipeline_t *TL_PipelineCreate(const TL_Renderer_t *const renderer, const TL_PipelineDescriptor_t descriptor) {
     if (!renderer) {
         return NULL;
     }
 
-    const TL_Debugger_t *debugger = renderer->debugger;
+    TL_Pipeline_t *pipeline = __AllocatePipeline(renderer, TL_PIPELINE_STATUS_READY);
+    if (!pipeline) {
+        return NULL;
+    }
 
-    TL_RendererAPIFlags_t api = renderer->api;
+    pipeline->pipeline_system = __CreatePipelineSystem(renderer, descriptor, pipeline);
+    if (!pipeline->pipeline_system) {
+        pipeline->status = TL_PIPELINE_STATUS_FAILED;
+        TL_PipelineDestroy(pipeline);
+        return NULL;
+    }
 
-    TL_Pipeline_t *pipeline = malloc(sizeof(TL_Pipeline_t));
+    return pipeline;
+}
+
+bool TL_PipelineCreateBatch(const TL_Renderer_t *const renderer, const uint32_t count, const TL_PipelineDescriptor_t *const descriptors,
+    TL_Pipeline_t **const out_pipelines)
+{
+    if (!renderer || !out_pipelines || (!descriptors && count)) {
+        return false;
+    }
+
+    return __CreatePipelineBatch(renderer, count, descriptors, out_pipelines, true);
+}
+
+TL_Pipeline_t *TL_PipelineCreateAsync(const TL_Renderer_t *const renderer, const TL_PipelineDescriptor_t descriptor) {
+    if (!renderer) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer->debugger;
+
+    TL_Pipeline_t *pipeline = __AllocatePipeline(renderer, TL_PIPELINE_STATUS_PENDING);
     if (!pipeline) {
-        TL_Fatal(debugger, "MALLOC fault in call to TL_PipelineCreate");
         return NULL;
     }
 
-    TL_Log(debugger, "Allocated pipeline at %p", pipeline);
+    // the caller's arrays may be gone by the time the job runs, so the worker compiles from its own copy
+    if (!TL_PipelineDescriptorCopy(&descriptor, &pipeline->async_descriptor, debugger)) {
+        pipeline->status = TL_PIPELINE_STATUS_FAILED;
+        TL_PipelineDestroy(pipeline);
+        return NULL;
+    }
 
-    // creating API-appropriate pipeline system
-    switch (api) {
+    if (!TL_WorkerPoolSubmit(renderer->worker_pool, __CompilePipelineJob, pipeline)) {
+        TL_Error(debugger, "Failed to queue asynchronous compilation of pipeline %p", pipeline);
 
-        // create a Vulkan pipeline system...
-        case TL_RENDERER_API_VULKAN_BIT:;
-#           if defined(_THALLIUM_VULKAN_INCL)
+        TL_PipelineDescriptorFree(&pipeline->async_descriptor);
+        pipeline->status = TL_PIPELINE_STATUS_FAILED;
+        TL_PipelineDestroy(pipeline);
+        return NULL;
+    }
 
-                void *renderersys = renderer->renderer_system;
+    TL_Log(debugger, "Queued asynchronous compilation of pipeline %p", pipeline);
 
-                TLVK_PipelineSystem_t *pipelinesys = TLVK_PipelineSystemCreate(renderersys, descriptor);
-                if (!pipelinesys) {
-                    TL_Error(debugger, "Failed to create Vulkan pipeline system for new pipeline at %p", pipeline);
-                    return NULL;
-                }
+    return pipeline;
+}
+
+bool TL_PipelinePrewarm(const TL_Renderer_t *const renderer, const char *const manifest_path) {
+    if (!renderer || !manifest_path) {
+        return false;
+    }
+
+    const TL_Debugger_t *debugger = renderer->debugger;
+
+    uint32_t count;
+    TL_PipelineDescriptor_t *descriptors;
+    if (!TL_PipelineManifestRead(manifest_path, &count, &descriptors, debugger)) {
+        TL_Error(debugger, "Failed to read pipeline manifest \"%s\" to pre-warm", manifest_path);
+        return false;
+    }
+
+    // the pre-warming members are the only ones mutated through a const handle, and are guarded by their own lock
+    TL_Renderer_t *r = (TL_Renderer_t *) renderer;
+
+    bool ret = true;
+
+    // each job takes ownership of its slice of descriptors; descriptors that could not be queued are freed here instead
+    uint32_t queued = 0;
+    while (queued < count) {
+        uint32_t batch_count = (count - queued < __PREWARM_BATCH_SIZE) ? count - queued : __PREWARM_BATCH_SIZE;
+
+        __PrewarmJob *job = malloc(sizeof(__PrewarmJob));
+        TL_PipelineDescriptor_t *batch = malloc(sizeof(TL_PipelineDescriptor_t) * batch_count);
+        if (!job || !batch) {
+            TL_Fatal(debugger, "MALLOC fault in call to TL_PipelinePrewarm");
+            free(job);
+            free(batch);
+            ret = false;
+            break;
+        }
+
+        memcpy(batch, &descriptors[queued], sizeof(TL_PipelineDescriptor_t) * batch_count);
 
-                pipeline->pipeline_system = (void *) pipelinesys;
+        job->renderer = renderer;
+        job->count = batch_count;
+        job->descriptors = batch;
 
+        TL_MutexLock(&r->prewarm_lock);
+        r->prewarm_pending++;
+        TL_MutexUnlock(&r->prewarm_lock);
+
+        if (!TL_WorkerPoolSubmit(renderer->worker_pool, __PrewarmPipelinesJob, job)) {
+            TL_Error(debugger, "Failed to queue pre-warming of pipelines from manifest \"%s\"", manifest_path);
+
+            __FinishPrewarmJob(r, NULL, 0);
+            free(job);
+            free(batch);
+            ret = false;
+            break;
+        }
+
+        queued += batch_count;
+    }
+
+    for (uint32_t i = queued; i < count; i++) {
+        TL_PipelineDescriptorFree(&descriptors[i]);
+    }
+    free(descriptors);
+
+    TL_Note(debugger, "Queued pre-warming of %d pipelines from manifest \"%s\"", queued, manifest_path);
+
+    return ret;
+}
+
+uint32_t TL_PipelinePrewarmWait(const TL_Renderer_t *const renderer) {
+    if (!renderer) {
+        return 0;
+    }
+
+    TL_Renderer_t *r = (TL_Renderer_t *) renderer;
+
+    TL_MutexLock(&r->prewarm_lock);
+    while (r->prewarm_pending) {
+        TL_CondWait(&r->prewarm_done, &r->prewarm_lock);
+    }
+    uint32_t count = r->prewarmed_pipeline_count;
+    TL_MutexUnlock(&r->prewarm_lock);
+
+    return count;
+}
+
+TL_PipelineStatus_t TL_PipelineGetStatus(const TL_Pipeline_t *const pipeline) {
+    if (!pipeline) {
+        return TL_PIPELINE_STATUS_FAILED;
+    }
+
+    // the lock is the only member mutated through a const handle, as it has to be taken to read the status safely
+    TL_Pipeline_t *p = (TL_Pipeline_t *) pipeline;
+
+    TL_MutexLock(&p->lock);
+    TL_PipelineStatus_t status = p->status;
+    TL_MutexUnlock(&p->lock);
+
+    return status;
+}
+
+TL_PipelineStatus_t TL_PipelineWait(const TL_Pipeline_t *const pipeline) {
+    if (!pipeline) {
+        return TL_PIPELINE_STATUS_FAILED;
+    }
+
+    TL_Pipeline_t *p = (TL_Pipeline_t *) pipeline;
+
+    TL_MutexLock(&p->lock);
+    while (p->status == TL_PIPELINE_STATUS_PENDING) {
+        TL_CondWait(&p->ready, &p->lock);
+    }
+    TL_PipelineStatus_t status = p->status;
+    TL_MutexUnlock(&p->lock);
+
+    return status;
+}
+
+bool TL_PipelineGetCreationFeedback(const TL_Pipeline_t *const pipeline, TL_PipelineCreationFeedback_t *const out_feedback) {
+    if (!pipeline || !out_feedback) {
+        return false;
+    }
+
+    if (!pipeline->renderer->features.pipeline_creation_feedback) {
+        TL_Error(pipeline->renderer->debugger, "TL_PipelineGetCreationFeedback: missing renderer feature 'pipeline_creation_feedback'");
+        return false;
+    }
+
+    // the pipeline system is only written once, when the status leaves TL_PIPELINE_STATUS_PENDING
+    if (TL_PipelineGetStatus(pipeline) != TL_PIPELINE_STATUS_READY) {
+        return false;
+    }
+
+    switch (pipeline->renderer->api) {
+        // query Vulkan pipeline system
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                return TLVK_PipelineSystemGetCreationFeedback((const TLVK_PipelineSystem_t *) pipeline->pipeline_system, out_feedback);
 #           endif
             break;
 
         case TL_RENDERER_API_NULL_BIT:
         default:
-            return NULL;
-
+            break;
     }
 
-    return pipeline;
+    return false;
 }
 
 void TL_PipelineDestroy(TL_Pipeline_t *const pipeline) {
@@ -66,20 +261,295 @@ void TL_PipelineDestroy(TL_Pipeline_t *const pipeline) {
         return;
     }
 
+    // a worker may still be writing to this pipeline
+    TL_PipelineWait(pipeline);
+
     TL_RendererAPIFlags_t api = pipeline->renderer->api;
 
-    switch (api) {
-        // destroy Vulkan pipeline system
-        case TL_RENDERER_API_VULKAN_BIT:
+    if (pipeline->pipeline_system) {
+        switch (api) {
+            // destroy Vulkan pipeline system
+            case TL_RENDERER_API_VULKAN_BIT:
+#               if defined(_THALLIUM_VULKAN_INCL)
+                    TLVK_PipelineSystemDestroy((TLVK_PipelineSystem_t *) pipeline->pipeline_system);
+#               endif
+                break;
+
+            case TL_RENDERER_API_NULL_BIT:
+            default:
+                break;
+        }
+    }
+
+    TL_CondDestroy(&pipeline->ready);
+    TL_MutexDestroy(&pipeline->lock);
+
+    free(pipeline);
+}
+
+
+static TL_Pipeline_t *__AllocatePipeline(const TL_Renderer_t *const renderer, const TL_PipelineStatus_t status) {
+    const TL_Debugger_t *debugger = renderer->debugger;
+
+    TL_Pipeline_t *pipeline = calloc(1, sizeof(TL_Pipeline_t));
+    if (!pipeline) {
+        TL_Fatal(debugger, "MALLOC fault in call to __AllocatePipeline");
+        return NULL;
+    }
+
+    if (!TL_MutexInit(&pipeline->lock)) {
+        free(pipeline);
+        return NULL;
+    }
+    if (!TL_CondInit(&pipeline->ready)) {
+        TL_MutexDestroy(&pipeline->lock);
+        free(pipeline);
+        return NULL;
+    }
+
+    pipeline->renderer = renderer;
+    pipeline->status = status;
+
+    TL_Log(debugger, "Allocated pipeline at %p", pipeline);
+
+    return pipeline;
+}
+
+// creating a pipeline for each descriptor at once - pipelines that could not be created are returned as NULL
+static bool __CreatePipelineBatch(const TL_Renderer_t *const renderer, const uint32_t count, const TL_PipelineDescriptor_t *const descriptors,
+    TL_Pipeline_t **const out_pipelines, const bool record)
+{
+    const TL_Debugger_t *debugger = renderer->debugger;
+
+    for (uint32_t i = 0; i < count; i++) {
+        out_pipelines[i] = NULL;
+    }
+
+    if (!count) {
+        return true;
+    }
+
+    // the descriptors are copied shallowly, as their shader code pointers are replaced while the shaders are mapped
+    TL_PipelineDescriptor_t *descriptor_copies = malloc(sizeof(TL_PipelineDescriptor_t) * count);
+    void **pipeline_systems = malloc(sizeof(void *) * count);
+    if (!descriptor_copies || !pipeline_systems) {
+        TL_Fatal(debugger, "MALLOC fault in call to __CreatePipelineBatch");
+        goto outerr;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        out_pipelines[i] = __AllocatePipeline(renderer, TL_PIPELINE_STATUS_READY);
+        if (!out_pipelines[i]) {
+            goto outerr;
+        }
+    }
+
+    memcpy(descriptor_copies, descriptors, sizeof(TL_PipelineDescriptor_t) * count);
+
+    bool ret = __CreatePipelineSystems(renderer, count, descriptor_copies, pipeline_systems, record);
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!pipeline_systems[i]) {
+            TL_Error(debugger, "Failed to create pipeline system for pipeline %d of batch", i);
+
+            out_pipelines[i]->status = TL_PIPELINE_STATUS_FAILED;
+            TL_PipelineDestroy(out_pipelines[i]);
+            out_pipelines[i] = NULL;
+            continue;
+        }
+
+        out_pipelines[i]->pipeline_system = pipeline_systems[i];
+    }
+
+    TL_Log(debugger, "Created batch of %d pipelines", count);
+
+    free(descriptor_copies);
+    free(pipeline_systems);
+
+    return ret;
+
+outerr:
+    for (uint32_t i = 0; i < count; i++) {
+        TL_PipelineDestroy(out_pipelines[i]);
+        out_pipelines[i] = NULL;
+    }
+
+    free(descriptor_copies);
+    free(pipeline_systems);
+
+    return false;
+}
+
+// creating API-appropriate pipeline system - returns NULL on failure
+static void *__CreatePipelineSystem(const TL_Renderer_t *const renderer, TL_PipelineDescriptor_t descriptor, TL_Pipeline_t *const pipeline) {
+    void *ret = NULL;
+
+    if (!__CreatePipelineSystems(renderer, 1, &descriptor, &ret, true)) {
+        TL_Error(renderer->debugger, "Failed to create pipeline system for new pipeline at %p", pipeline);
+    }
+
+    return ret;
+}
+
+// creating API-appropriate pipeline systems for each descriptor at once - failed pipeline systems are returned as NULL, and successful ones are
+// recorded into the renderer's pipeline manifest (if it has one) when `record` is true
+static bool __CreatePipelineSystems(const TL_Renderer_t *const renderer, const uint32_t count, TL_PipelineDescriptor_t *const descriptors,
+    void **const out_pipeline_systems, const bool record)
+{
+    const TL_Debugger_t *debugger = renderer->debugger;
+
+    for (uint32_t i = 0; i < count; i++) {
+        out_pipeline_systems[i] = NULL;
+    }
+
+    // shaders given as files are mapped only for as long as the API objects are being created from them. Descriptors whose shaders could not be
+    // loaded are left out of the batch, and `mapped` holds the index of each descriptor that remains.
+    TL_FileMapping_t *shader_mappings = malloc(sizeof(TL_FileMapping_t) * TL_PIPELINE_DESCRIPTOR_SHADER_COUNT * count);
+    uint32_t *mapped = malloc(sizeof(uint32_t) * count);
+    if (!shader_mappings || !mapped) {
+        TL_Fatal(debugger, "MALLOC fault in call to __CreatePipelineSystems");
+        free(shader_mappings);
+        free(mapped);
+        return false;
+    }
+
+    bool ret = true;
+
+    uint32_t mapped_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!TL_PipelineDescriptorMapShaders(&descriptors[i], &shader_mappings[TL_PIPELINE_DESCRIPTOR_SHADER_COUNT * mapped_count], debugger)) {
+            TL_Error(debugger, "Failed to load shaders for pipeline descriptor %d", i);
+            ret = false;
+            continue;
+        }
+
+        descriptors[mapped_count] = descriptors[i];
+        mapped[mapped_count++] = i;
+    }
+
+    switch (renderer->api) {
+
+        // create Vulkan pipeline systems...
+        case TL_RENDERER_API_VULKAN_BIT:;
 #           if defined(_THALLIUM_VULKAN_INCL)
-                TLVK_PipelineSystemDestroy((TLVK_PipelineSystem_t *) pipeline->pipeline_system);
+
+                void *renderersys = renderer->renderer_system;
+
+                // results are written over the front of the output array, then moved to the index of the descriptor they were created from
+                TLVK_PipelineSystem_t **pipelinesys = (TLVK_PipelineSystem_t **) out_pipeline_systems;
+                if (!TLVK_PipelineSystemCreateBatch(renderersys, mapped_count, descriptors, pipelinesys)) {
+                    TL_Error(debugger, "Failed to create some or all of a batch of %d Vulkan pipeline systems", mapped_count);
+                    ret = false;
+                }
+
+                for (uint32_t i = mapped_count; i-- > 0;) {
+                    TLVK_PipelineSystem_t *system = pipelinesys[i];
+                    pipelinesys[i] = NULL;
+                    pipelinesys[mapped[i]] = system;
+                }
+
 #           endif
             break;
 
         case TL_RENDERER_API_NULL_BIT:
         default:
             break;
+
     }
 
-    free(pipeline);
+    // descriptors are recorded while their shaders are still mapped, as the manifest stores the shader code
+    for (uint32_t i = 0; i < mapped_count; i++) {
+        if (record && renderer->pipeline_manifest && out_pipeline_systems[mapped[i]]) {
+            TL_PipelineManifestRecord(renderer->pipeline_manifest, &descriptors[i], debugger);
+        }
+
+        TL_PipelineDescriptorUnmapShaders(&shader_mappings[TL_PIPELINE_DESCRIPTOR_SHADER_COUNT * i]);
+    }
+
+    free(shader_mappings);
+    free(mapped);
+
+    return ret;
+}
+
+// runs on a renderer worker thread
+static void __CompilePipelineJob(void *data) {
+    TL_Pipeline_t *pipeline = (TL_Pipeline_t *) data;
+
+    void *pipelinesys = __CreatePipelineSystem(pipeline->renderer, pipeline->async_descriptor, pipeline);
+
+    TL_PipelineDescriptorFree(&pipeline->async_descriptor);
+
+    // a waiting thread may destroy the pipeline as soon as it is unlocked, so nothing on it may be touched after that
+    const TL_Debugger_t *debugger = pipeline->renderer->debugger;
+    TL_PipelineStatus_t status = (pipelinesys) ? TL_PIPELINE_STATUS_READY : TL_PIPELINE_STATUS_FAILED;
+
+    TL_MutexLock(&pipeline->lock);
+    pipeline->pipeline_system = pipelinesys;
+    pipeline->status = status;
+    TL_CondBroadcast(&pipeline->ready);
+    TL_MutexUnlock(&pipeline->lock);
+
+    TL_Log(debugger, "Asynchronous compilation of pipeline %p finished (status %d)", (void *) pipeline, status);
+}
+
+// runs on a renderer worker thread
+static void __PrewarmPipelinesJob(void *data) {
+    __PrewarmJob *job = (__PrewarmJob *) data;
+
+    const TL_Renderer_t *renderer = job->renderer;
+    const TL_Debugger_t *debugger = renderer->debugger;
+
+    TL_Pipeline_t **pipelines = malloc(sizeof(TL_Pipeline_t *) * job->count);
+    if (!pipelines) {
+        TL_Fatal(debugger, "MALLOC fault in call to __PrewarmPipelinesJob");
+    } else if (!__CreatePipelineBatch(renderer, job->count, job->descriptors, pipelines, false)) {
+        TL_Warn(debugger, "Failed to pre-warm some or all of a batch of %d pipelines", job->count);
+    }
+
+    __FinishPrewarmJob((TL_Renderer_t *) renderer, pipelines, (pipelines) ? job->count : 0);
+
+    for (uint32_t i = 0; i < job->count; i++) {
+        TL_PipelineDescriptorFree(&job->descriptors[i]);
+    }
+
+    free(pipelines);
+    free(job->descriptors);
+    free(job);
+}
+
+// hands the (non-NULL) pipelines over to the renderer and marks a pre-warming job as done
+static void __FinishPrewarmJob(TL_Renderer_t *const renderer, TL_Pipeline_t *const *const pipelines, const uint32_t count) {
+    TL_MutexLock(&renderer->prewarm_lock);
+
+    uint32_t total = renderer->prewarmed_pipeline_count + count;
+
+    TL_Pipeline_t **prewarmed = (count) ? realloc(renderer->prewarmed_pipelines, sizeof(TL_Pipeline_t *) * total) : NULL;
+    if (!prewarmed && count) {
+        TL_Fatal(renderer->debugger, "MALLOC fault in call to __FinishPrewarmJob");
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!pipelines[i]) {
+            continue;
+        }
+
+        // without space to keep the pipeline, it is released straight away (it still populated the pipeline cache)
+        if (!prewarmed) {
+            TL_PipelineDestroy(pipelines[i]);
+            continue;
+        }
+
+        prewarmed[renderer->prewarmed_pipeline_count++] = pipelines[i];
+    }
+
+    if (prewarmed) {
+        renderer->prewarmed_pipelines = prewarmed;
+    }
+
+    if (--renderer->prewarm_pending == 0) {
+        TL_CondBroadcast(&renderer->prewarm_done);
+    }
+
+    TL_MutexUnlock(&renderer->prewarm_lock);
 }
@@ -0,0 +1,347 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "pipeline_descriptor.h"
+
+#include "thallium/core/viewport.h"
+
+#include "utils/hash/hash.h"
+#include "utils/io/log.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void *__DuplicateArray(const void *const src, const size_t size, bool *const out_fail);
+
+static char *__DuplicateString(const char *const src, bool *const out_fail);
+
+static void __CopyShader(const TL_PipelineShaderDescriptor_t *const src, TL_PipelineShaderDescriptor_t *const dst, bool *const out_fail);
+
+static void __FreeShader(TL_PipelineShaderDescriptor_t *const shader);
+
+static void __GetShaders(TL_PipelineDescriptor_t *const descriptor, TL_PipelineShaderDescriptor_t **const out_shaders);
+
+static TL_PrimitiveTopology_t __GetTopologyClass(const TL_PrimitiveTopology_t topology);
+
+static void __WriteBytes(unsigned char **const cursor, size_t *const total, const void *const src, const size_t size);
+
+static void __WriteU32(unsigned char **const cursor, size_t *const total, const uint32_t value);
+
+static void __WriteI32(unsigned char **const cursor, size_t *const total, const int32_t value);
+
+static void __WriteF32(unsigned char **const cursor, size_t *const total, const float value);
+
+static void __WriteShader(unsigned char **const cursor, size_t *const total, const TL_PipelineShaderDescriptor_t *const shader);
+
+
+bool TL_PipelineDescriptorCopy(const TL_PipelineDescriptor_t *const src, TL_PipelineDescriptor_t *const dst,
+    const TL_Debugger_t *const debugger)
+{
+    if (!src || !dst) {
+        return false;
+    }
+
+    bool fail = false;
+
+    *dst = *src;
+
+    dst->viewports = __DuplicateArray(src->viewports, sizeof(TL_Viewport_t) * src->viewport_count, &fail);
+    dst->scissors = __DuplicateArray(src->scissors, sizeof(TL_Rect2D_t) * src->scissor_count, &fail);
+    __CopyShader(&src->vertex_shader, &dst->vertex_shader, &fail);
+    __CopyShader(&src->fragment_shader, &dst->fragment_shader, &fail);
+    __CopyShader(&src->compute_shader, &dst->compute_shader, &fail);
+
+    if (fail) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_PipelineDescriptorCopy");
+        TL_PipelineDescriptorFree(dst);
+        return false;
+    }
+
+    return true;
+}
+
+void TL_PipelineDescriptorFree(TL_PipelineDescriptor_t *const descriptor) {
+    if (!descriptor) {
+        return;
+    }
+
+    free(descriptor->viewports);
+    free(descriptor->scissors);
+    __FreeShader(&descriptor->vertex_shader);
+    __FreeShader(&descriptor->fragment_shader);
+    __FreeShader(&descriptor->compute_shader);
+
+    memset(descriptor, 0, sizeof(TL_PipelineDescriptor_t));
+}
+
+bool TL_PipelineDescriptorMapShaders(TL_PipelineDescriptor_t *const descriptor, TL_FileMapping_t *const out_mappings,
+    const TL_Debugger_t *const debugger)
+{
+    if (!descriptor || !out_mappings) {
+        return false;
+    }
+
+    TL_PipelineShaderDescriptor_t *shaders[TL_PIPELINE_DESCRIPTOR_SHADER_COUNT];
+    __GetShaders(descriptor, shaders);
+
+    memset(out_mappings, 0, sizeof(TL_FileMapping_t) * TL_PIPELINE_DESCRIPTOR_SHADER_COUNT);
+
+    for (uint32_t i = 0; i < TL_PIPELINE_DESCRIPTOR_SHADER_COUNT; i++) {
+        TL_PipelineShaderDescriptor_t *shader = shaders[i];
+
+        if (shader->code || !shader->path) {
+            continue;
+        }
+
+        if (!TL_FileMap(shader->path, &out_mappings[i], debugger)) {
+            TL_Error(debugger, "Failed to load shader from \"%s\"", shader->path);
+            TL_PipelineDescriptorUnmapShaders(out_mappings);
+            return false;
+        }
+
+        // the mapping is page-aligned, so it can be read as SPIR-V words directly
+        shader->code = (const uint32_t *) out_mappings[i].data;
+        shader->code_size = out_mappings[i].size;
+    }
+
+    return true;
+}
+
+void TL_PipelineDescriptorUnmapShaders(TL_FileMapping_t *const mappings) {
+    if (!mappings) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < TL_PIPELINE_DESCRIPTOR_SHADER_COUNT; i++) {
+        TL_FileUnmap(&mappings[i]);
+    }
+}
+
+size_t TL_PipelineDescriptorSerialize(const TL_PipelineDescriptor_t *const descriptor, void *const out) {
+    return TL_PipelineDescriptorSerializeGroups(descriptor, TL_PIPELINE_STATE_GROUP_ALL, out);
+}
+
+size_t TL_PipelineDescriptorSerializeGroups(const TL_PipelineDescriptor_t *const descriptor, const TL_PipelineStateGroupFlags_t groups,
+    void *const out)
+{
+    if (!descriptor) {
+        return 0;
+    }
+
+    // cursor stays NULL when only the size is being queried
+    unsigned char *c = (unsigned char *) out;
+    size_t n = 0;
+
+    __WriteU32(&c, &n, (uint32_t) descriptor->type);
+    __WriteU32(&c, &n, (uint32_t) groups);
+
+    // whether a pipeline can be used as a base pipeline is a property of the whole pipeline object, not of any of its parts. The base pipeline itself
+    // is not written, as derivatives are equivalent to pipelines created without one.
+    if (groups == TL_PIPELINE_STATE_GROUP_ALL) {
+        __WriteU32(&c, &n, descriptor->allow_derivatives);
+    }
+
+    if (descriptor->type == TL_PIPELINE_TYPE_COMPUTE) {
+        __WriteShader(&c, &n, &descriptor->compute_shader);
+        return n;
+    }
+
+    // everything below only applies to graphics pipelines
+    if (descriptor->type != TL_PIPELINE_TYPE_GRAPHICS) {
+        return n;
+    }
+
+    TL_PrimitiveTopology_t topology = (descriptor->primitive_topology) ? descriptor->primitive_topology : TL_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    const TL_PipelineRasterizerDescriptor_t *r = &descriptor->rasterizer;
+    const TL_PipelineDepthTestDescriptor_t *d = &descriptor->depth_test;
+
+    // with extended dynamic state, only state that cannot be set on command buffers is written, so that variants collapse into one key
+    bool eds = descriptor->extended_dynamic_state;
+
+    __WriteU32(&c, &n, eds);
+
+    if (groups & TL_PIPELINE_STATE_GROUP_VERTEX_INPUT_BIT) {
+        __WriteU32(&c, &n, (uint32_t) ((eds) ? __GetTopologyClass(topology) : topology));
+    }
+
+    if (groups & TL_PIPELINE_STATE_GROUP_PRE_RASTERIZATION_BIT) {
+        __WriteU32(&c, &n, r->depth_clamp);
+        __WriteU32(&c, &n, (uint32_t) r->polygon_mode);
+
+        if (!eds) {
+            __WriteU32(&c, &n, r->rasterizer_discard);
+            __WriteU32(&c, &n, (uint32_t) r->cull_modes);
+            __WriteU32(&c, &n, r->clockwise_front_face);
+            __WriteU32(&c, &n, r->depth_bias);
+            __WriteF32(&c, &n, r->depth_bias_constant_factor);
+            __WriteF32(&c, &n, r->depth_bias_slope_factor);
+            __WriteF32(&c, &n, r->depth_bias_clamp);
+            __WriteF32(&c, &n, r->line_width);
+        }
+
+        // a NULL array (dynamic state) is encoded as a count of 0
+        uint32_t viewport_count = (descriptor->viewports) ? descriptor->viewport_count : 0;
+        __WriteU32(&c, &n, viewport_count);
+        for (uint32_t i = 0; i < viewport_count; i++) {
+            const TL_Viewport_t *v = &descriptor->viewports[i];
+
+            __WriteF32(&c, &n, v->x);
+            __WriteF32(&c, &n, v->y);
+            __WriteF32(&c, &n, v->width);
+            __WriteF32(&c, &n, v->height);
+            __WriteF32(&c, &n, v->min_depth);
+            __WriteF32(&c, &n, v->max_depth);
+        }
+
+        uint32_t scissor_count = (descriptor->scissors) ? descriptor->scissor_count : 0;
+        __WriteU32(&c, &n, scissor_count);
+        for (uint32_t i = 0; i < scissor_count; i++) {
+            const TL_Rect2D_t *s = &descriptor->scissors[i];
+
+            __WriteI32(&c, &n, s->offset.x);
+            __WriteI32(&c, &n, s->offset.y);
+            __WriteU32(&c, &n, s->extent.width);
+            __WriteU32(&c, &n, s->extent.height);
+        }
+
+        __WriteShader(&c, &n, &descriptor->vertex_shader);
+    }
+
+    if (groups & TL_PIPELINE_STATE_GROUP_FRAGMENT_SHADER_BIT) {
+        if (!eds) {
+            __WriteU32(&c, &n, d->test_enabled);
+            __WriteU32(&c, &n, d->write_enabled);
+            __WriteU32(&c, &n, (uint32_t) d->compare_op);
+        }
+
+        __WriteShader(&c, &n, &descriptor->fragment_shader);
+    }
+
+    // TL_PIPELINE_STATE_GROUP_FRAGMENT_OUTPUT_BIT: no configurable state yet (colour blending and multisampling are fixed)
+
+    return n;
+}
+
+// returns NULL for NULL or empty arrays, otherwise a heap copy of `src` (out_fail is set if that copy could not be allocated)
+static void *__DuplicateArray(const void *const src, const size_t size, bool *const out_fail) {
+    if (!src || !size) {
+        return NULL;
+    }
+
+    void *ret = malloc(size);
+    if (!ret) {
+        *out_fail = true;
+        return NULL;
+    }
+
+    memcpy(ret, src, size);
+
+    return ret;
+}
+
+// like __DuplicateArray, but for NUL-terminated strings
+static char *__DuplicateString(const char *const src, bool *const out_fail) {
+    if (!src) {
+        return NULL;
+    }
+
+    return __DuplicateArray(src, strlen(src) + 1, out_fail);
+}
+
+static void __CopyShader(const TL_PipelineShaderDescriptor_t *const src, TL_PipelineShaderDescriptor_t *const dst, bool *const out_fail) {
+    dst->code = __DuplicateArray(src->code, src->code_size, out_fail);
+    dst->entry_point = __DuplicateString(src->entry_point, out_fail);
+    dst->path = __DuplicateString(src->path, out_fail);
+    dst->specialization_constants = __DuplicateArray(src->specialization_constants,
+        sizeof(TL_PipelineSpecializationConstant_t) * src->specialization_constant_count, out_fail);
+}
+
+static void __FreeShader(TL_PipelineShaderDescriptor_t *const shader) {
+    free((void *) shader->code);
+    free((void *) shader->entry_point);
+    free((void *) shader->path);
+    free((void *) shader->specialization_constants);
+}
+
+// populates `out_shaders` with pointers to each of the TL_PIPELINE_DESCRIPTOR_SHADER_COUNT shader descriptors in `descriptor`
+static void __GetShaders(TL_PipelineDescriptor_t *const descriptor, TL_PipelineShaderDescriptor_t **const out_shaders) {
+    out_shaders[0] = &descriptor->vertex_shader;
+    out_shaders[1] = &descriptor->fragment_shader;
+    out_shaders[2] = &descriptor->compute_shader;
+}
+
+// dynamic topologies must stay within the class of the topology the pipeline was created with, so one topology of each class is used to represent it
+static TL_PrimitiveTopology_t __GetTopologyClass(const TL_PrimitiveTopology_t topology) {
+    switch (topology) {
+        case TL_PRIMITIVE_TOPOLOGY_POINT_LIST:
+            return TL_PRIMITIVE_TOPOLOGY_POINT_LIST;
+        case TL_PRIMITIVE_TOPOLOGY_LINE_LIST:
+        case TL_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+        case TL_PRIMITIVE_TOPOLOGY_LINE_LIST_ADJACENCY:
+        case TL_PRIMITIVE_TOPOLOGY_LINE_STRIP_ADJACENCY:
+            return TL_PRIMITIVE_TOPOLOGY_LINE_LIST;
+        case TL_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+            return TL_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+        default:
+            return TL_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    }
+}
+
+static void __WriteBytes(unsigned char **const cursor, size_t *const total, const void *const src, const size_t size) {
+    if (*cursor) {
+        memcpy(*cursor, src, size);
+        *cursor += size;
+    }
+
+    *total += size;
+}
+
+static void __WriteU32(unsigned char **const cursor, size_t *const total, const uint32_t value) {
+    __WriteBytes(cursor, total, &value, sizeof(uint32_t));
+}
+
+static void __WriteI32(unsigned char **const cursor, size_t *const total, const int32_t value) {
+    __WriteBytes(cursor, total, &value, sizeof(int32_t));
+}
+
+static void __WriteF32(unsigned char **const cursor, size_t *const total, const float value) {
+    // -0.0 and 0.0 describe the same state, so they are encoded identically
+    float v = (value == 0.0f) ? 0.0f : value;
+
+    __WriteBytes(cursor, total, &v, sizeof(float));
+}
+
+static void __WriteShader(unsigned char **const cursor, size_t *const total, const TL_PipelineShaderDescriptor_t *const shader) {
+    // a NULL entry point is the same as "main"
+    const char *entry_point = (shader->entry_point) ? shader->entry_point : "main";
+    uint32_t entry_point_length = (uint32_t) strlen(entry_point);
+
+    // the code is identified by its contents (rather than e.g. its address), so that the same shader loaded twice is recognised as such - two
+    // differently seeded hashes are written instead of the code itself to keep keys small
+    uint64_t code_size = (shader->code) ? shader->code_size : 0;
+    uint64_t code_hashes[2] = {
+        TL_Hash64(shader->code, code_size, 0),
+        TL_Hash64(shader->code, code_size, 1),
+    };
+    __WriteBytes(cursor, total, &code_size, sizeof(uint64_t));
+    __WriteBytes(cursor, total, code_hashes, sizeof(code_hashes));
+
+    __WriteU32(cursor, total, entry_point_length);
+    __WriteBytes(cursor, total, entry_point, entry_point_length);
+
+    // only the bytes of each value that are actually passed to the shader are written, so unused union bytes cannot cause spurious misses
+    uint32_t constant_count = (shader->specialization_constants) ? shader->specialization_constant_count : 0;
+    __WriteU32(cursor, total, constant_count);
+    for (uint32_t i = 0; i < constant_count; i++) {
+        const TL_PipelineSpecializationConstant_t *constant = &shader->specialization_constants[i];
+        uint32_t size = (constant->size < sizeof(constant->value)) ? constant->size : sizeof(constant->value);
+
+        __WriteU32(cursor, total, constant->id);
+        __WriteU32(cursor, total, size);
+        __WriteBytes(cursor, total, &constant->value, size);
+    }
+}
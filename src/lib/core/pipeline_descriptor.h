@@ -0,0 +1,135 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__core__pipeline_descriptor_h__
+#define __TL__internal__core__pipeline_descriptor_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/core/pipeline.h"
+
+#include "utils/io/file_map.h"
+
+// amount of shader descriptors in a pipeline descriptor
+#define TL_PIPELINE_DESCRIPTOR_SHADER_COUNT 3
+
+/**
+ * @brief Flags selecting groups of pipeline state to serialize.
+ *
+ * The groups match the parts that graphics pipelines can be split into and compiled separately (e.g. as Vulkan graphics pipeline libraries), so
+ * that each part can be keyed independently of the others.
+ */
+typedef enum TL_PipelineStateGroupFlags_t {
+    /// @brief Vertex input and primitive assembly state
+    TL_PIPELINE_STATE_GROUP_VERTEX_INPUT_BIT =      0x01,
+    /// @brief Pre-rasterization shader, viewport and rasterizer state
+    TL_PIPELINE_STATE_GROUP_PRE_RASTERIZATION_BIT = 0x02,
+    /// @brief Fragment shader and depth/stencil state
+    TL_PIPELINE_STATE_GROUP_FRAGMENT_SHADER_BIT =   0x04,
+    /// @brief Colour blending and multisampling state
+    TL_PIPELINE_STATE_GROUP_FRAGMENT_OUTPUT_BIT =   0x08,
+
+    /// @brief All pipeline state
+    TL_PIPELINE_STATE_GROUP_ALL =                   0x0f,
+} TL_PipelineStateGroupFlags_t;
+
+/**
+ * @brief Deep-copy a pipeline descriptor, including any arrays it points to.
+ *
+ * This function copies `src` into `dst`, duplicating every array referenced by `src` on the heap so that `dst` does not depend on the lifetime of the
+ * caller's memory. The copy must be freed with @ref TL_PipelineDescriptorFree().
+ *
+ * @param src Descriptor to copy
+ * @param dst Pointer to the descriptor to copy into
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if there was an allocation failure (in which case `dst` is left empty)
+ */
+bool TL_PipelineDescriptorCopy(
+    const TL_PipelineDescriptor_t *const src,
+    TL_PipelineDescriptor_t *const dst,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Free the arrays owned by a pipeline descriptor created with @ref TL_PipelineDescriptorCopy().
+ *
+ * @param descriptor Descriptor to free the contents of
+ */
+void TL_PipelineDescriptorFree(
+    TL_PipelineDescriptor_t *const descriptor
+);
+
+/**
+ * @brief Load the shaders of a pipeline descriptor that are given as file paths.
+ *
+ * This function memory-maps the file of every shader descriptor in `descriptor` that has a `path` but no `code`, and points the shader's `code` at
+ * the mapping. The mappings must be kept until the descriptor is no longer used, then released with @ref TL_PipelineDescriptorUnmapShaders().
+ *
+ * @param descriptor Descriptor whose shaders to load
+ * @param out_mappings Array of `TL_PIPELINE_DESCRIPTOR_SHADER_COUNT` mappings to populate
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if a file could not be mapped (in which case no mappings are left open)
+ */
+bool TL_PipelineDescriptorMapShaders(
+    TL_PipelineDescriptor_t *const descriptor,
+    TL_FileMapping_t *const out_mappings,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Release the shader file mappings created by @ref TL_PipelineDescriptorMapShaders().
+ *
+ * @param mappings Array of `TL_PIPELINE_DESCRIPTOR_SHADER_COUNT` mappings to release
+ */
+void TL_PipelineDescriptorUnmapShaders(
+    TL_FileMapping_t *const mappings
+);
+
+/**
+ * @brief Serialize a pipeline descriptor into a canonical byte blob.
+ *
+ * This function writes every value of `descriptor` that affects the resulting pipeline object into `out`, in a fixed order and with fixed-width
+ * encodings, so that two descriptors describing the same pipeline always produce the same bytes (regardless of struct padding, pointer values or
+ * fields that are ignored for the given pipeline type). The blob is used as the key of pipeline deduplication caches.
+ *
+ * Shader code is represented by its size and two independent hashes of it rather than copied, so shaders must have been loaded (see
+ * @ref TL_PipelineDescriptorMapShaders()) beforehand.
+ *
+ * Call this function with `out` set to NULL to retrieve the required size, then again with a buffer of at least that size.
+ *
+ * @param descriptor Descriptor to serialize
+ * @param out NULL or a buffer to write the serialized descriptor into
+ * @return The size of the serialized descriptor, in bytes
+ */
+size_t TL_PipelineDescriptorSerialize(
+    const TL_PipelineDescriptor_t *const descriptor,
+    void *const out
+);
+
+/**
+ * @brief Serialize the given groups of a pipeline descriptor's state into a canonical byte blob.
+ *
+ * This function behaves like @ref TL_PipelineDescriptorSerialize(), except only the state belonging to `groups` is written. The selected groups are
+ * part of the blob, so blobs of different groups never compare equal.
+ *
+ * @param descriptor Descriptor to serialize
+ * @param groups Bitmask of state groups to serialize
+ * @param out NULL or a buffer to write the serialized state into
+ * @return The size of the serialized state, in bytes
+ */
+size_t TL_PipelineDescriptorSerializeGroups(
+    const TL_PipelineDescriptor_t *const descriptor,
+    const TL_PipelineStateGroupFlags_t groups,
+    void *const out
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
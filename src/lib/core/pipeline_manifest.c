@@ -0,0 +1,696 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "pipeline_manifest.h"
+
+#include "lib/core/pipeline_descriptor.h"
+#include "thallium/core/viewport.h"
+
+#include "utils/hash/hash.h"
+#include "utils/hash/hashmap.h"
+#include "utils/io/file_map.h"
+#include "utils/io/log.h"
+#include "utils/thread/thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Manifest files are laid out as follows (all values are native-endian, as manifests are only meant to be read back on the machine that wrote them):
+//
+//   header:    char[4] magic, u32 version, u32 shader count, u32 pipeline count
+//   shaders:   for each shader - u32 code size in bytes, code
+//   pipelines: for each pipeline - u32 record size in bytes, record
+//
+// Records store every value of a pipeline descriptor, with shaders referenced by their index in the shader table (so that shaders used by several
+// pipelines are only stored once). Base pipelines are not stored, as they only exist within a session.
+
+#define __MANIFEST_MAGIC "TLPM"
+#define __MANIFEST_VERSION 2
+
+// shader index of unused shader stages
+#define __NO_SHADER UINT32_MAX
+
+// a growable byte array - `fail` is set (and further appends ignored) once an allocation has failed
+typedef struct __ByteBuffer {
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+    bool fail;
+} __ByteBuffer;
+
+// bounds-checked cursor over a mapped manifest file - `fail` is set (and further reads return zeroes) once the end has been overrun
+typedef struct __ByteReader {
+    const unsigned char *cursor;
+    const unsigned char *end;
+    bool fail;
+} __ByteReader;
+
+// value of both dedup maps; `offset` and `size` locate the recorded key (serialized descriptor) or code in its buffer
+typedef struct __ManifestEntry {
+    size_t offset;
+    size_t size;
+    uint32_t index;
+} __ManifestEntry;
+
+typedef struct TL_PipelineManifest_t {
+    /// @brief Guards every other member of the manifest
+    TL_Mutex_t lock;
+
+    /// @brief Path of the manifest file
+    char *path;
+
+    /// @brief Shader table and pipeline records, in their file layout
+    __ByteBuffer shaders;
+    __ByteBuffer pipelines;
+    uint32_t shader_count;
+    uint32_t pipeline_count;
+
+    /// @brief Serialized descriptors of every recorded pipeline, referenced by the entries of `pipeline_map`
+    __ByteBuffer keys;
+
+    /// @brief Maps from hashes of shader code and serialized descriptors to __ManifestEntry structs
+    TL_HashMap_t shader_map;
+    TL_HashMap_t pipeline_map;
+} TL_PipelineManifest_t;
+
+
+static void __Append(__ByteBuffer *const buffer, const void *const src, const size_t size);
+
+static void __AppendU32(__ByteBuffer *const buffer, const uint32_t value);
+
+static void __AppendF32(__ByteBuffer *const buffer, const float value);
+
+static void __Read(__ByteReader *const reader, void *const dst, const size_t size);
+
+static uint32_t __ReadU32(__ByteReader *const reader);
+
+static float __ReadF32(__ByteReader *const reader);
+
+static bool __FindEntry(const TL_HashMap_t *const map, const uint64_t hash, const __ByteBuffer *const buffer, const void *const data,
+    const size_t size, uint32_t *const out_index);
+
+static bool __AddEntry(TL_HashMap_t *const map, const uint64_t hash, const size_t offset, const size_t size, const uint32_t index,
+    const TL_Debugger_t *const debugger);
+
+static void __FreeEntries(TL_HashMap_t *const map);
+
+static uint32_t __RecordShader(TL_PipelineManifest_t *const manifest, const TL_PipelineShaderDescriptor_t *const shader,
+    const TL_Debugger_t *const debugger);
+
+static void __WriteShaderRecord(__ByteBuffer *const record, const TL_PipelineShaderDescriptor_t *const shader, const uint32_t index);
+
+static void __ReadShaderRecord(__ByteReader *const reader, const TL_FileMapping_t *const mapping, const size_t *const shader_offsets,
+    const uint32_t shader_count, TL_PipelineShaderDescriptor_t *const shader, bool *const out_fail);
+
+static void *__ReadArray(__ByteReader *const reader, const uint32_t count, const size_t size, bool *const out_fail);
+
+
+TL_PipelineManifest_t *TL_PipelineManifestCreate(const char *const path, const TL_Debugger_t *const debugger) {
+    if (!path) {
+        return NULL;
+    }
+
+    TL_PipelineManifest_t *manifest = calloc(1, sizeof(TL_PipelineManifest_t));
+    if (!manifest) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_PipelineManifestCreate");
+        return NULL;
+    }
+
+    manifest->path = malloc(strlen(path) + 1);
+    if (!manifest->path) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_PipelineManifestCreate");
+        free(manifest);
+        return NULL;
+    }
+    strcpy(manifest->path, path);
+
+    if (!TL_MutexInit(&manifest->lock)) {
+        free(manifest->path);
+        free(manifest);
+        return NULL;
+    }
+
+    TL_Log(debugger, "Allocated pipeline manifest recorder at %p (writing to \"%s\")", manifest, path);
+
+    return manifest;
+}
+
+void TL_PipelineManifestDestroy(TL_PipelineManifest_t *const manifest) {
+    if (!manifest) {
+        return;
+    }
+
+    __FreeEntries(&manifest->shader_map);
+    __FreeEntries(&manifest->pipeline_map);
+
+    free(manifest->shaders.data);
+    free(manifest->pipelines.data);
+    free(manifest->keys.data);
+
+    TL_MutexDestroy(&manifest->lock);
+
+    free(manifest->path);
+    free(manifest);
+}
+
+bool TL_PipelineManifestRecord(TL_PipelineManifest_t *const manifest, const TL_PipelineDescriptor_t *const descriptor,
+    const TL_Debugger_t *const debugger)
+{
+    if (!manifest || !descriptor) {
+        return false;
+    }
+
+    // the serialized descriptor identifies equivalent pipelines, exactly as in the pipeline deduplication caches
+    size_t key_size = TL_PipelineDescriptorSerialize(descriptor, NULL);
+    void *key = malloc(key_size);
+    if (!key) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_PipelineManifestRecord");
+        return false;
+    }
+    TL_PipelineDescriptorSerialize(descriptor, key);
+
+    uint64_t hash = TL_Hash64(key, key_size, 0);
+
+    bool ret = true;
+
+    TL_MutexLock(&manifest->lock);
+
+    uint32_t existing;
+    if (__FindEntry(&manifest->pipeline_map, hash, &manifest->keys, key, key_size, &existing)) {
+        goto out;
+    }
+
+    // only the shaders used by the pipeline type are stored
+    bool compute = descriptor->type == TL_PIPELINE_TYPE_COMPUTE;
+    uint32_t vertex_shader = (compute) ? __NO_SHADER : __RecordShader(manifest, &descriptor->vertex_shader, debugger);
+    uint32_t fragment_shader = (compute) ? __NO_SHADER : __RecordShader(manifest, &descriptor->fragment_shader, debugger);
+    uint32_t compute_shader = (compute) ? __RecordShader(manifest, &descriptor->compute_shader, debugger) : __NO_SHADER;
+
+    const TL_PipelineRasterizerDescriptor_t *r = &descriptor->rasterizer;
+    const TL_PipelineDepthTestDescriptor_t *d = &descriptor->depth_test;
+
+    __ByteBuffer record = { 0 };
+
+    __AppendU32(&record, (uint32_t) descriptor->type);
+    __AppendU32(&record, (uint32_t) descriptor->primitive_topology);
+
+    __AppendU32(&record, r->depth_clamp);
+    __AppendU32(&record, r->rasterizer_discard);
+    __AppendU32(&record, (uint32_t) r->polygon_mode);
+    __AppendU32(&record, (uint32_t) r->cull_modes);
+    __AppendU32(&record, r->clockwise_front_face);
+    __AppendU32(&record, r->depth_bias);
+    __AppendF32(&record, r->depth_bias_constant_factor);
+    __AppendF32(&record, r->depth_bias_slope_factor);
+    __AppendF32(&record, r->depth_bias_clamp);
+    __AppendF32(&record, r->line_width);
+
+    __AppendU32(&record, d->test_enabled);
+    __AppendU32(&record, d->write_enabled);
+    __AppendU32(&record, (uint32_t) d->compare_op);
+
+    // a NULL array (dynamic state) is stored as a count of 0
+    uint32_t viewport_count = (descriptor->viewports) ? descriptor->viewport_count : 0;
+    __AppendU32(&record, viewport_count);
+    __Append(&record, descriptor->viewports, sizeof(TL_Viewport_t) * viewport_count);
+
+    uint32_t scissor_count = (descriptor->scissors) ? descriptor->scissor_count : 0;
+    __AppendU32(&record, scissor_count);
+    __Append(&record, descriptor->scissors, sizeof(TL_Rect2D_t) * scissor_count);
+
+    __AppendU32(&record, descriptor->extended_dynamic_state);
+    __AppendU32(&record, descriptor->allow_derivatives);
+
+    __WriteShaderRecord(&record, &descriptor->vertex_shader, vertex_shader);
+    __WriteShaderRecord(&record, &descriptor->fragment_shader, fragment_shader);
+    __WriteShaderRecord(&record, &descriptor->compute_shader, compute_shader);
+
+    size_t key_offset = manifest->keys.size;
+    __Append(&manifest->keys, key, key_size);
+
+    __AppendU32(&manifest->pipelines, (uint32_t) record.size);
+    __Append(&manifest->pipelines, record.data, record.size);
+
+    free(record.data);
+
+    if (record.fail || manifest->shaders.fail || manifest->keys.fail || manifest->pipelines.fail) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_PipelineManifestRecord");
+        ret = false;
+        goto out;
+    }
+
+    ret = __AddEntry(&manifest->pipeline_map, hash, key_offset, key_size, manifest->pipeline_count, debugger);
+    manifest->pipeline_count++;
+
+    TL_Log(debugger, "Recorded pipeline descriptor #%d in pipeline manifest at %p", manifest->pipeline_count, manifest);
+
+out:
+    TL_MutexUnlock(&manifest->lock);
+
+    free(key);
+
+    return ret;
+}
+
+bool TL_PipelineManifestWrite(TL_PipelineManifest_t *const manifest, const TL_Debugger_t *const debugger) {
+    if (!manifest) {
+        return false;
+    }
+
+    TL_MutexLock(&manifest->lock);
+
+    bool ret = false;
+
+    FILE *file = fopen(manifest->path, "wb");
+    if (!file) {
+        TL_Error(debugger, "Failed to open pipeline manifest file \"%s\" for writing", manifest->path);
+        goto out;
+    }
+
+    __ByteBuffer header = { 0 };
+    __Append(&header, __MANIFEST_MAGIC, 4);
+    __AppendU32(&header, __MANIFEST_VERSION);
+    __AppendU32(&header, manifest->shader_count);
+    __AppendU32(&header, manifest->pipeline_count);
+
+    ret = !header.fail &&
+        fwrite(header.data, 1, header.size, file) == header.size &&
+        fwrite(manifest->shaders.data, 1, manifest->shaders.size, file) == manifest->shaders.size &&
+        fwrite(manifest->pipelines.data, 1, manifest->pipelines.size, file) == manifest->pipelines.size;
+
+    free(header.data);
+
+    if (fclose(file)) {
+        ret = false;
+    }
+
+    if (!ret) {
+        TL_Error(debugger, "Failed to write pipeline manifest file \"%s\"", manifest->path);
+        goto out;
+    }
+
+    TL_Note(debugger, "Wrote %d pipeline descriptors (%d shaders) to pipeline manifest file \"%s\"", manifest->pipeline_count,
+        manifest->shader_count, manifest->path);
+
+out:
+    TL_MutexUnlock(&manifest->lock);
+
+    return ret;
+}
+
+bool TL_PipelineManifestRead(const char *const path, uint32_t *const out_count, TL_PipelineDescriptor_t **const out_descriptors,
+    const TL_Debugger_t *const debugger)
+{
+    if (!path || !out_count || !out_descriptors) {
+        return false;
+    }
+
+    *out_count = 0;
+    *out_descriptors = NULL;
+
+    TL_FileMapping_t mapping;
+    if (!TL_FileMap(path, &mapping, debugger)) {
+        TL_Error(debugger, "Failed to open pipeline manifest file \"%s\"", path);
+        return false;
+    }
+
+    __ByteReader reader = { mapping.data, (const unsigned char *) mapping.data + mapping.size, false };
+
+    size_t *shader_offsets = NULL;
+    TL_PipelineDescriptor_t *descriptors = NULL;
+    uint32_t count = 0;
+
+    char magic[4];
+    __Read(&reader, magic, 4);
+    uint32_t version = __ReadU32(&reader);
+    uint32_t shader_count = __ReadU32(&reader);
+    uint32_t pipeline_count = __ReadU32(&reader);
+
+    if (reader.fail || memcmp(magic, __MANIFEST_MAGIC, 4) || version != __MANIFEST_VERSION) {
+        TL_Error(debugger, "File \"%s\" is not a pipeline manifest, or was written by an incompatible version of Thallium", path);
+        goto outerr;
+    }
+
+    // each shader and pipeline takes at least 4 bytes, which bounds the counts before anything is allocated for them
+    size_t remaining = (size_t) (reader.end - reader.cursor);
+    if (shader_count > remaining / 4 || pipeline_count > remaining / 4) {
+        goto outcorrupt;
+    }
+
+    // both arrays get one spare element so that empty manifests never make a zero-size allocation, which may return NULL
+    shader_offsets = malloc(sizeof(size_t) * (shader_count + 1));
+    descriptors = calloc(pipeline_count + 1, sizeof(TL_PipelineDescriptor_t));
+    if (!shader_offsets || !descriptors) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_PipelineManifestRead");
+        goto outerr;
+    }
+
+    // shader code is only located here, and copied into each descriptor that uses it below
+    for (uint32_t i = 0; i < shader_count; i++) {
+        uint32_t size = __ReadU32(&reader);
+
+        shader_offsets[i] = (size_t) (reader.cursor - (const unsigned char *) mapping.data);
+        __Read(&reader, NULL, size);
+    }
+
+    if (reader.fail) {
+        goto outcorrupt;
+    }
+
+    for (; count < pipeline_count; count++) {
+        uint32_t record_size = __ReadU32(&reader);
+        if (reader.fail || record_size > (size_t) (reader.end - reader.cursor)) {
+            goto outcorrupt;
+        }
+
+        // each record is read through its own reader, so a truncated record cannot run into the next one
+        __ByteReader record = { reader.cursor, reader.cursor + record_size, false };
+        __Read(&reader, NULL, record_size);
+
+        TL_PipelineDescriptor_t *descriptor = &descriptors[count];
+        TL_PipelineRasterizerDescriptor_t *r = &descriptor->rasterizer;
+        TL_PipelineDepthTestDescriptor_t *d = &descriptor->depth_test;
+        bool fail = false;
+
+        descriptor->type = (TL_PipelineType_t) __ReadU32(&record);
+        descriptor->primitive_topology = (TL_PrimitiveTopology_t) __ReadU32(&record);
+
+        r->depth_clamp = __ReadU32(&record);
+        r->rasterizer_discard = __ReadU32(&record);
+        r->polygon_mode = (TL_PolygonMode_t) __ReadU32(&record);
+        r->cull_modes = (TL_CullModeFlags_t) __ReadU32(&record);
+        r->clockwise_front_face = __ReadU32(&record);
+        r->depth_bias = __ReadU32(&record);
+        r->depth_bias_constant_factor = __ReadF32(&record);
+        r->depth_bias_slope_factor = __ReadF32(&record);
+        r->depth_bias_clamp = __ReadF32(&record);
+        r->line_width = __ReadF32(&record);
+
+        d->test_enabled = __ReadU32(&record);
+        d->write_enabled = __ReadU32(&record);
+        d->compare_op = (TL_CompareOp_t) __ReadU32(&record);
+
+        descriptor->viewport_count = __ReadU32(&record);
+        descriptor->viewports = __ReadArray(&record, descriptor->viewport_count, sizeof(TL_Viewport_t), &fail);
+
+        descriptor->scissor_count = __ReadU32(&record);
+        descriptor->scissors = __ReadArray(&record, descriptor->scissor_count, sizeof(TL_Rect2D_t), &fail);
+
+        descriptor->extended_dynamic_state = __ReadU32(&record);
+        descriptor->allow_derivatives = __ReadU32(&record);
+
+        __ReadShaderRecord(&record, &mapping, shader_offsets, shader_count, &descriptor->vertex_shader, &fail);
+        __ReadShaderRecord(&record, &mapping, shader_offsets, shader_count, &descriptor->fragment_shader, &fail);
+        __ReadShaderRecord(&record, &mapping, shader_offsets, shader_count, &descriptor->compute_shader, &fail);
+
+        if (fail || record.fail) {
+            // the descriptor is counted so that it is freed with the others
+            count++;
+            goto outcorrupt;
+        }
+    }
+
+    TL_FileUnmap(&mapping);
+    free(shader_offsets);
+
+    *out_count = count;
+    *out_descriptors = descriptors;
+
+    TL_Log(debugger, "Read %d pipeline descriptors (%d shaders) from pipeline manifest file \"%s\"", count, shader_count, path);
+
+    return true;
+
+outcorrupt:
+    TL_Error(debugger, "Pipeline manifest file \"%s\" is truncated or corrupt", path);
+outerr:
+    for (uint32_t i = 0; i < count; i++) {
+        TL_PipelineDescriptorFree(&descriptors[i]);
+    }
+    free(descriptors);
+    free(shader_offsets);
+
+    TL_FileUnmap(&mapping);
+
+    return false;
+}
+
+
+static void __Append(__ByteBuffer *const buffer, const void *const src, const size_t size) {
+    if (buffer->fail || !size) {
+        return;
+    }
+
+    if (buffer->size + size > buffer->capacity) {
+        size_t capacity = (buffer->capacity) ? buffer->capacity : 256;
+        while (capacity < buffer->size + size) {
+            capacity *= 2;
+        }
+
+        unsigned char *data = realloc(buffer->data, capacity);
+        if (!data) {
+            buffer->fail = true;
+            return;
+        }
+
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, src, size);
+    buffer->size += size;
+}
+
+static void __AppendU32(__ByteBuffer *const buffer, const uint32_t value) {
+    __Append(buffer, &value, sizeof(uint32_t));
+}
+
+static void __AppendF32(__ByteBuffer *const buffer, const float value) {
+    __Append(buffer, &value, sizeof(float));
+}
+
+// `dst` may be NULL to skip over `size` bytes
+static void __Read(__ByteReader *const reader, void *const dst, const size_t size) {
+    if (reader->fail || size > (size_t) (reader->end - reader->cursor)) {
+        reader->fail = true;
+
+        if (dst) {
+            memset(dst, 0, size);
+        }
+
+        return;
+    }
+
+    if (dst) {
+        memcpy(dst, reader->cursor, size);
+    }
+
+    reader->cursor += size;
+}
+
+static uint32_t __ReadU32(__ByteReader *const reader) {
+    uint32_t value;
+    __Read(reader, &value, sizeof(uint32_t));
+
+    return value;
+}
+
+static float __ReadF32(__ByteReader *const reader) {
+    float value;
+    __Read(reader, &value, sizeof(float));
+
+    return value;
+}
+
+// returns true (and populates out_index) if `data` is already stored in `buffer` under `hash`
+static bool __FindEntry(const TL_HashMap_t *const map, const uint64_t hash, const __ByteBuffer *const buffer, const void *const data,
+    const size_t size, uint32_t *const out_index)
+{
+    const __ManifestEntry *entry = TL_HashMapGet(map, hash);
+
+    // on a hash collision with different data, the new data is stored again without a map entry
+    if (!entry || entry->size != size || memcmp(buffer->data + entry->offset, data, size)) {
+        return false;
+    }
+
+    *out_index = entry->index;
+
+    return true;
+}
+
+static bool __AddEntry(TL_HashMap_t *const map, const uint64_t hash, const size_t offset, const size_t size, const uint32_t index,
+    const TL_Debugger_t *const debugger)
+{
+    // a colliding entry is kept, as the data it references was recorded first
+    if (TL_HashMapGet(map, hash)) {
+        return true;
+    }
+
+    __ManifestEntry *entry = malloc(sizeof(__ManifestEntry));
+    if (!entry) {
+        TL_Fatal(debugger, "MALLOC fault in call to __AddEntry");
+        return false;
+    }
+
+    entry->offset = offset;
+    entry->size = size;
+    entry->index = index;
+
+    if (!TL_HashMapSet(map, hash, entry, debugger)) {
+        free(entry);
+        return false;
+    }
+
+    return true;
+}
+
+static void __FreeEntries(TL_HashMap_t *const map) {
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        free(map->values[i]);
+    }
+
+    TL_HashMapFree(map);
+}
+
+// adds the code of `shader` to the shader table if it is not there yet - returns its index, or __NO_SHADER if the shader has no code
+static uint32_t __RecordShader(TL_PipelineManifest_t *const manifest, const TL_PipelineShaderDescriptor_t *const shader,
+    const TL_Debugger_t *const debugger)
+{
+    if (!shader->code || !shader->code_size) {
+        return __NO_SHADER;
+    }
+
+    uint64_t hash = TL_Hash64(shader->code, shader->code_size, 0);
+
+    uint32_t index;
+    if (__FindEntry(&manifest->shader_map, hash, &manifest->shaders, shader->code, shader->code_size, &index)) {
+        return index;
+    }
+
+    __AppendU32(&manifest->shaders, (uint32_t) shader->code_size);
+    size_t offset = manifest->shaders.size;
+    __Append(&manifest->shaders, shader->code, shader->code_size);
+
+    if (manifest->shaders.fail) {
+        TL_Fatal(debugger, "MALLOC fault in call to __RecordShader");
+        return __NO_SHADER;
+    }
+
+    __AddEntry(&manifest->shader_map, hash, offset, shader->code_size, manifest->shader_count, debugger);
+
+    return manifest->shader_count++;
+}
+
+static void __WriteShaderRecord(__ByteBuffer *const record, const TL_PipelineShaderDescriptor_t *const shader, const uint32_t index) {
+    __AppendU32(record, index);
+    if (index == __NO_SHADER) {
+        return;
+    }
+
+    // a NULL entry point is stored as an empty string
+    uint32_t entry_point_length = (shader->entry_point) ? (uint32_t) strlen(shader->entry_point) : 0;
+    __AppendU32(record, entry_point_length);
+    __Append(record, shader->entry_point, entry_point_length);
+
+    // the whole value union is stored, so that it can be read back without interpreting `size`
+    uint32_t constant_count = (shader->specialization_constants) ? shader->specialization_constant_count : 0;
+    __AppendU32(record, constant_count);
+    for (uint32_t i = 0; i < constant_count; i++) {
+        const TL_PipelineSpecializationConstant_t *constant = &shader->specialization_constants[i];
+
+        __AppendU32(record, constant->id);
+        __AppendU32(record, constant->size);
+        __Append(record, &constant->value, sizeof(constant->value));
+    }
+}
+
+static void __ReadShaderRecord(__ByteReader *const reader, const TL_FileMapping_t *const mapping, const size_t *const shader_offsets,
+    const uint32_t shader_count, TL_PipelineShaderDescriptor_t *const shader, bool *const out_fail)
+{
+    uint32_t index = __ReadU32(reader);
+    if (index == __NO_SHADER) {
+        return;
+    }
+
+    if (index >= shader_count) {
+        *out_fail = true;
+        return;
+    }
+
+    const unsigned char *code = (const unsigned char *) mapping->data + shader_offsets[index];
+    uint32_t code_size;
+    memcpy(&code_size, code - sizeof(uint32_t), sizeof(uint32_t));
+
+    shader->code = __ReadArray(&(__ByteReader) { code, code + code_size, false }, 1, code_size, out_fail);
+    shader->code_size = code_size;
+
+    // the terminator of the entry point is not stored, so the string is read into a buffer one byte larger
+    uint32_t entry_point_length = __ReadU32(reader);
+    if (entry_point_length) {
+        char *entry_point = NULL;
+
+        if (entry_point_length <= (size_t) (reader->end - reader->cursor)) {
+            entry_point = malloc((size_t) entry_point_length + 1);
+        }
+        if (!entry_point) {
+            *out_fail = true;
+            return;
+        }
+
+        __Read(reader, entry_point, entry_point_length);
+        entry_point[entry_point_length] = '\0';
+
+        shader->entry_point = entry_point;
+    }
+
+    uint32_t constant_count = __ReadU32(reader);
+    if (!constant_count) {
+        return;
+    }
+
+    TL_PipelineSpecializationConstant_t *constants = NULL;
+
+    // each constant takes at least its id and size
+    if (constant_count <= (size_t) (reader->end - reader->cursor) / (sizeof(uint32_t) * 2)) {
+        constants = malloc(sizeof(TL_PipelineSpecializationConstant_t) * constant_count);
+    }
+    if (!constants) {
+        *out_fail = true;
+        return;
+    }
+
+    for (uint32_t i = 0; i < constant_count; i++) {
+        constants[i].id = __ReadU32(reader);
+        constants[i].size = __ReadU32(reader);
+        __Read(reader, &constants[i].value, sizeof(constants[i].value));
+    }
+
+    shader->specialization_constant_count = constant_count;
+    shader->specialization_constants = constants;
+}
+
+// returns a heap copy of the next `count` elements of `size` bytes, or NULL if `count` is 0 (out_fail is set if they could not be read or copied)
+static void *__ReadArray(__ByteReader *const reader, const uint32_t count, const size_t size, bool *const out_fail) {
+    if (!count) {
+        return NULL;
+    }
+
+    if (size && count > (size_t) (reader->end - reader->cursor) / size) {
+        *out_fail = true;
+        return NULL;
+    }
+
+    void *ret = malloc(size * count);
+    if (!ret) {
+        *out_fail = true;
+        return NULL;
+    }
+
+    __Read(reader, ret, size * count);
+
+    return ret;
+}
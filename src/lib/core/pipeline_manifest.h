@@ -0,0 +1,98 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__core__pipeline_manifest_h__
+#define __TL__internal__core__pipeline_manifest_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/core/pipeline.h"
+
+/**
+ * @brief An opaque, thread-safe recorder of the unique pipeline descriptors used during a session.
+ *
+ * Recorded descriptors are kept in a compact binary form, in which each distinct shader is only stored once, and are written to a manifest file
+ * that can be read back with @ref TL_PipelineManifestRead() (e.g. to compile the same pipelines ahead of time in the next session).
+ */
+typedef struct TL_PipelineManifest_t TL_PipelineManifest_t;
+
+/**
+ * @brief Create a heap-allocated pipeline manifest recorder.
+ *
+ * @param path Path of the manifest file to write in @ref TL_PipelineManifestWrite() (copied)
+ * @param debugger NULL or a debugger for function debugging
+ * @return The new recorder, or NULL if there were errors
+ */
+TL_PipelineManifest_t *TL_PipelineManifestCreate(
+    const char *const path,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Free the given pipeline manifest recorder without writing it.
+ *
+ * @param manifest Recorder to free
+ */
+void TL_PipelineManifestDestroy(
+    TL_PipelineManifest_t *const manifest
+);
+
+/**
+ * @brief Record a pipeline descriptor in the given manifest.
+ *
+ * This function adds `descriptor` to `manifest`, unless an equivalent descriptor (as determined by @ref TL_PipelineDescriptorSerialize()) has
+ * already been recorded. The descriptor's shaders must have been loaded (see @ref TL_PipelineDescriptorMapShaders()) beforehand, as their code is
+ * stored in the manifest.
+ *
+ * @param manifest Recorder to record into
+ * @param descriptor Descriptor to record
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if there was an allocation failure
+ */
+bool TL_PipelineManifestRecord(
+    TL_PipelineManifest_t *const manifest,
+    const TL_PipelineDescriptor_t *const descriptor,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Write every descriptor recorded so far to the manifest file of the given recorder, replacing any previous contents of the file.
+ *
+ * @param manifest Recorder to write
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if the file could not be written
+ */
+bool TL_PipelineManifestWrite(
+    TL_PipelineManifest_t *const manifest,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Read the pipeline descriptors stored in a manifest file.
+ *
+ * This function reads every descriptor from the manifest file at `path`. Each descriptor owns its arrays (including the code of its shaders) and
+ * must be freed with @ref TL_PipelineDescriptorFree(), after which the array itself must be freed with `free()`.
+ *
+ * @param path Path to the manifest file to read
+ * @param out_count Pointer to populate with the amount of descriptors read
+ * @param out_descriptors Pointer to populate with the heap-allocated array of descriptors read (NULL if there are none)
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if the file could not be read or is not a valid manifest
+ */
+bool TL_PipelineManifestRead(
+    const char *const path,
+    uint32_t *const out_count,
+    TL_PipelineDescriptor_t **const out_descriptors,
+    const TL_Debugger_t *const debugger
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
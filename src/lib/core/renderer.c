@@ -8,6 +8,8 @@
 #include "thallium/core/renderer.h"
 #include "types/core/renderer_t.h"
 
+#include "thallium/core/pipeline.h"
+
 #include "lib/core/context_block.h"
 #include "types/core/context_t.h"
 #include "utils/utils.h"
@@ -122,6 +124,19 @@ void TL_RendererDestroy(TL_Renderer_t *const renderer) {
 
     TL_RendererAPIFlags_t api = renderer->api;
 
+    // finish any background jobs (e.g. asynchronous pipeline compilation) while the renderer system is still alive
+    TL_WorkerPoolDestroy(renderer->worker_pool);
+
+    if (renderer->pipeline_manifest) {
+        TL_PipelineManifestWrite(renderer->pipeline_manifest, renderer->debugger);
+        TL_PipelineManifestDestroy(renderer->pipeline_manifest);
+    }
+
+    for (uint32_t i = 0; i < renderer->prewarmed_pipeline_count; i++) {
+        TL_PipelineDestroy(renderer->prewarmed_pipelines[i]);
+    }
+    free(renderer->prewarmed_pipelines);
+
     switch (api) {
         // destroy Vulkan renderer system
         case TL_RENDERER_API_VULKAN_BIT:;
@@ -137,6 +152,9 @@ void TL_RendererDestroy(TL_Renderer_t *const renderer) {
             break;
     }
 
+    TL_CondDestroy(&renderer->prewarm_done);
+    TL_MutexDestroy(&renderer->prewarm_lock);
+
     free(renderer);
 }
 
@@ -226,6 +244,35 @@ static TL_Renderer_t *__CreateRenderer(TL_Context_t *const context, const TL_Ren
     renderer->context = context;
     renderer->debugger = context->attached_debugger;
     renderer->features = descriptor.requirements;
+    renderer->worker_pool = NULL;
+    renderer->pipeline_manifest = NULL;
+    renderer->prewarm_pending = 0;
+    renderer->prewarmed_pipeline_count = 0;
+    renderer->prewarmed_pipelines = NULL;
+
+    if (!TL_MutexInit(&renderer->prewarm_lock)) {
+        free(renderer);
+        return NULL;
+    }
+    if (!TL_CondInit(&renderer->prewarm_done)) {
+        TL_MutexDestroy(&renderer->prewarm_lock);
+        free(renderer);
+        return NULL;
+    }
+
+    renderer->worker_pool = TL_WorkerPoolCreate(0, debugger);
+    if (!renderer->worker_pool) {
+        TL_Error(debugger, "Failed to create worker pool for new renderer at %p", renderer);
+        goto outerr;
+    }
+
+    if (descriptor.pipeline_manifest_path) {
+        renderer->pipeline_manifest = TL_PipelineManifestCreate(descriptor.pipeline_manifest_path, debugger);
+        if (!renderer->pipeline_manifest) {
+            TL_Error(debugger, "Failed to create pipeline manifest recorder for new renderer at %p", renderer);
+            goto outerr;
+        }
+    }
 
     // creating API-appropriate renderer system
     switch (descriptor.api) {
@@ -247,7 +294,7 @@ static TL_Renderer_t *__CreateRenderer(TL_Context_t *const context, const TL_Ren
                 TLVK_RendererSystem_t *renderersys = TLVK_RendererSystemCreate(renderer, rsdescr);
                 if (!renderersys) {
                     TL_Error(debugger, "Failed to create Vulkan renderer system for new renderer at %p", renderer);
-                    return NULL;
+                    goto outerr;
                 }
 
                 renderer->renderer_system = (void *) renderersys;
@@ -257,7 +304,7 @@ static TL_Renderer_t *__CreateRenderer(TL_Context_t *const context, const TL_Ren
 
         case TL_RENDERER_API_NULL_BIT:
         default:
-            return NULL;
+            goto outerr;
 
     }
 
@@ -273,4 +320,11 @@ static TL_Renderer_t *__CreateRenderer(TL_Context_t *const context, const TL_Ren
     TL_Note(debugger, "  Child renderer system: %p", renderer->renderer_system);
 
     return renderer;
+outerr:
+    TL_PipelineManifestDestroy(renderer->pipeline_manifest);
+    TL_WorkerPoolDestroy(renderer->worker_pool);
+    TL_CondDestroy(&renderer->prewarm_done);
+    TL_MutexDestroy(&renderer->prewarm_lock);
+    free(renderer);
+    return NULL;
 }
@@ -8,6 +8,7 @@
 #include "thallium/core/swapchain.h"
 #include "types/core/swapchain_t.h"
 
+#include "types/core/command_buffer_t.h"
 #include "types/core/renderer_t.h"
 #include "utils/utils.h"
 
@@ -25,8 +26,9 @@ TL_Swapchain_t *TL_SwapchainCreate(const TL_Renderer_t *const renderer, const TL
     TL_RendererAPIFlags_t api = renderer->api;
     TL_RendererFeatures_t features = renderer->features;
 
-    // if this bool is true then we assume swapchain creation functions are available for whatever API the renderer is using
-    if (!features.presentation) {
+    // if this bool is true then we assume swapchain creation functions are available for whatever API the renderer is using (offscreen swapchains
+    // present nothing, so they do not need it)
+    if (!descriptor.offscreen && !features.presentation) {
         TL_Error(debugger, "Failed to create swapchain: missing renderer feature 'presentation'");
         return NULL;
     }
@@ -40,6 +42,7 @@ TL_Swapchain_t *TL_SwapchainCreate(const TL_Renderer_t *const renderer, const TL
     TL_Log(debugger, "Allocated swapchain at %p", swapchain);
 
     swapchain->renderer = renderer;
+    swapchain->offscreen = descriptor.offscreen;
 
     // creating API-appropriate swapchain system
     switch (api) {
@@ -48,6 +51,50 @@ TL_Swapchain_t *TL_SwapchainCreate(const TL_Renderer_t *const renderer, const TL
         case TL_RENDERER_API_VULKAN_BIT:;
 #           if defined(_THALLIUM_VULKAN_INCL)
 
+                void *renderersys = renderer->renderer_system;
+
+                // offscreen swapchains are backed by a render target chain instead of a swapchain system
+                if (descriptor.offscreen) {
+                    TLVK_RenderTargetChainDescriptor_t rtcdescr;
+
+                    if (descriptor.render_target_chain_descriptor) {
+                        rtcdescr = *((TLVK_RenderTargetChainDescriptor_t *) descriptor.render_target_chain_descriptor);
+
+                        // fallback to descriptor.resolution
+                        if (rtcdescr.resolution.width <= 0 || rtcdescr.resolution.height <= 0) {
+                            rtcdescr.resolution = descriptor.resolution;
+                        }
+
+                        // fallback to descriptor.latency_policy
+                        if (rtcdescr.latency_policy == TL_SWAPCHAIN_LATENCY_POLICY_BALANCED) {
+                            rtcdescr.latency_policy = descriptor.latency_policy;
+                        }
+                    } else {
+                        // default render target chain descriptor configuration (used if no user-given descriptor was specified)...
+
+                        rtcdescr.resolution = descriptor.resolution;
+
+                        rtcdescr.vk_format = -1;
+                        rtcdescr.vk_image_usage = 0;
+                        rtcdescr.vk_final_layout = VK_IMAGE_LAYOUT_UNDEFINED; // frames leave images ready to render to
+
+                        rtcdescr.latency_policy = descriptor.latency_policy;
+                        rtcdescr.readback = true;
+                    }
+
+                    TLVK_RenderTargetChain_t *chain = TLVK_RenderTargetChainCreate(renderersys, rtcdescr);
+                    if (!chain) {
+                        TL_Error(debugger, "Failed to create Vulkan render target chain for new offscreen swapchain at %p", swapchain);
+                        free(swapchain);
+                        return NULL;
+                    }
+
+                    swapchain->swapchain_system = (void *) chain;
+                    swapchain->extent = TLVK_RenderTargetChainGetExtent(chain);
+
+                    break;
+                }
+
                 TLVK_SwapchainSystemDescriptor_t ssdescr;
 
                 if (descriptor.swapchain_system_descriptor) {
@@ -57,6 +104,16 @@ TL_Swapchain_t *TL_SwapchainCreate(const TL_Renderer_t *const renderer, const TL
                     if (ssdescr.resolution.width <= 0 || ssdescr.resolution.height <= 0) {
                         ssdescr.resolution = descriptor.resolution;
                     }
+
+                    // fallback to descriptor.latency_policy
+                    if (ssdescr.latency_policy == TL_SWAPCHAIN_LATENCY_POLICY_BALANCED) {
+                        ssdescr.latency_policy = descriptor.latency_policy;
+                    }
+
+                    // fallback to descriptor.frame_pacing
+                    if (!ssdescr.frame_pacing) {
+                        ssdescr.frame_pacing = descriptor.frame_pacing;
+                    }
                 } else {
                     // default swapchain system descriptor configuration (used if no user-given descriptor was specified)...
 
@@ -67,13 +124,15 @@ TL_Swapchain_t *TL_SwapchainCreate(const TL_Renderer_t *const renderer, const TL
                     // automatically select properties
                     ssdescr.vk_surface_format.format = -1;
                     ssdescr.vk_present_mode = -1;
-                }
 
-                void *renderersys = renderer->renderer_system;
+                    ssdescr.latency_policy = descriptor.latency_policy;
+                    ssdescr.frame_pacing = descriptor.frame_pacing;
+                }
 
                 TLVK_SwapchainSystem_t *swapchainsys = TLVK_SwapchainSystemCreate(renderersys, ssdescr, descriptor.window_surface);
                 if (!swapchainsys) {
                     TL_Error(debugger, "Failed to create Vulkan swapchain system for new swapchain at %p", swapchain);
+                    free(swapchain);
                     return NULL;
                 }
 
@@ -105,7 +164,11 @@ void TL_SwapchainDestroy(TL_Swapchain_t *const swapchain) {
         // destroy Vulkan swapchain system
         case TL_RENDERER_API_VULKAN_BIT:
 #           if defined(_THALLIUM_VULKAN_INCL)
-                TLVK_SwapchainSystemDestroy((TLVK_SwapchainSystem_t *) swapchain->swapchain_system);
+                if (swapchain->offscreen) {
+                    TLVK_RenderTargetChainDestroy((TLVK_RenderTargetChain_t *) swapchain->swapchain_system);
+                } else {
+                    TLVK_SwapchainSystemDestroy((TLVK_SwapchainSystem_t *) swapchain->swapchain_system);
+                }
 #           endif
             break;
 
@@ -120,3 +183,159 @@ void TL_SwapchainDestroy(TL_Swapchain_t *const swapchain) {
 TL_Extent2D_t TL_SwapchainGetExtent(TL_Swapchain_t *const swapchain) {
     return swapchain->extent;
 }
+
+bool TL_SwapchainBeginFrame(TL_Swapchain_t *const swapchain, TL_SwapchainFrame_t *const out_frame) {
+    if (!swapchain) {
+        return false;
+    }
+
+    bool result = false;
+    uint32_t frame_index = 0;
+    uint32_t image_index = 0;
+
+    switch (swapchain->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:;
+#           if defined(_THALLIUM_VULKAN_INCL)
+                if (swapchain->offscreen) {
+                    result = TLVK_RenderTargetChainBeginFrame((TLVK_RenderTargetChain_t *) swapchain->swapchain_system, &frame_index, &image_index);
+                    break;
+                }
+
+                TLVK_SwapchainSystem_t *swapchainsys = (TLVK_SwapchainSystem_t *) swapchain->swapchain_system;
+
+                result = TLVK_SwapchainSystemBeginFrame(swapchainsys, &frame_index, &image_index);
+
+                // the swapchain may have been recreated
+                swapchain->extent = TLVK_SwapchainSystemGetExtent(swapchainsys);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    if (result && out_frame) {
+        out_frame->frame_index = frame_index;
+        out_frame->image_index = image_index;
+    }
+
+    return result;
+}
+
+bool TL_SwapchainEndFrame(TL_Swapchain_t *const swapchain, TL_CommandBuffer_t *const command_buffer) {
+    if (!swapchain || !command_buffer) {
+        return false;
+    }
+
+    bool result = false;
+
+    switch (swapchain->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:;
+#           if defined(_THALLIUM_VULKAN_INCL)
+                if (swapchain->offscreen) {
+                    result = TLVK_RenderTargetChainEndFrame((TLVK_RenderTargetChain_t *) swapchain->swapchain_system,
+                        (TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system);
+                    break;
+                }
+
+                TLVK_SwapchainSystem_t *swapchainsys = (TLVK_SwapchainSystem_t *) swapchain->swapchain_system;
+
+                result = TLVK_SwapchainSystemEndFrame(swapchainsys, (TLVK_CommandBufferSystem_t *) command_buffer->command_buffer_system);
+
+                // the swapchain may have been recreated
+                swapchain->extent = TLVK_SwapchainSystemGetExtent(swapchainsys);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return result;
+}
+
+bool TL_SwapchainResize(TL_Swapchain_t *const swapchain, const TL_Extent2D_t resolution) {
+    if (!swapchain) {
+        return false;
+    }
+
+    bool result = false;
+
+    switch (swapchain->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:;
+#           if defined(_THALLIUM_VULKAN_INCL)
+                if (swapchain->offscreen) {
+                    TLVK_RenderTargetChain_t *chain = (TLVK_RenderTargetChain_t *) swapchain->swapchain_system;
+
+                    result = TLVK_RenderTargetChainResize(chain, resolution);
+
+                    swapchain->extent = TLVK_RenderTargetChainGetExtent(chain);
+                    break;
+                }
+
+                TLVK_SwapchainSystem_t *swapchainsys = (TLVK_SwapchainSystem_t *) swapchain->swapchain_system;
+
+                result = TLVK_SwapchainSystemResize(swapchainsys, resolution);
+
+                swapchain->extent = TLVK_SwapchainSystemGetExtent(swapchainsys);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return result;
+}
+
+size_t TL_SwapchainGetReadbackSize(TL_Swapchain_t *const swapchain) {
+    if (!swapchain || !swapchain->offscreen) {
+        return 0;
+    }
+
+    size_t result = 0;
+
+    switch (swapchain->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                result = TLVK_RenderTargetChainGetReadbackSize((TLVK_RenderTargetChain_t *) swapchain->swapchain_system);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return result;
+}
+
+bool TL_SwapchainReadImage(TL_Swapchain_t *const swapchain, const uint32_t image_index, void *const out_data, const size_t size) {
+    if (!swapchain) {
+        return false;
+    }
+
+    if (!swapchain->offscreen) {
+        TL_Error(swapchain->renderer->debugger, "Attempted to read image of swapchain %p, which is not offscreen", swapchain);
+        return false;
+    }
+
+    bool result = false;
+
+    switch (swapchain->renderer->api) {
+        case TL_RENDERER_API_VULKAN_BIT:
+#           if defined(_THALLIUM_VULKAN_INCL)
+                result = TLVK_RenderTargetChainReadImage((TLVK_RenderTargetChain_t *) swapchain->swapchain_system, image_index, out_data, size);
+#           endif
+            break;
+
+        case TL_RENDERER_API_NULL_BIT:
+        default:
+            break;
+    }
+
+    return result;
+}
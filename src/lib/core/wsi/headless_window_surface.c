@@ -0,0 +1,40 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "thallium/core/wsi/headless_window_surface.h"
+#include "types/core/wsi/window_surface_t.h"
+
+#include "utils/utils.h"
+
+#include "surface_platform_data.h"
+
+#include <stdlib.h>
+
+TL_WindowSurface_t *TL_WindowSurfaceCreateHeadless(const uint32_t width, const uint32_t height, const TL_Debugger_t *const debugger) {
+    TL_WindowSurface_t *surface = malloc(sizeof(TL_WindowSurface_t));
+    if (!surface) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_WindowSurfaceCreateHeadless");
+        return NULL;
+    }
+
+    surface->wsi = TL_WSI_API_HEADLESS;
+
+    // allocate platform data to hold the surface size (there are no native handles)
+    TL_WindowSurfacePlatformDataHeadless_t *platform_data = malloc(sizeof(TL_WindowSurfacePlatformDataHeadless_t));
+    if (!platform_data) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_WindowSurfaceCreateHeadless");
+        free(surface);
+        return NULL;
+    }
+
+    platform_data->width = width;
+    platform_data->height = height;
+
+    surface->platform_data = (void *) platform_data;
+
+    return surface;
+}
@@ -51,6 +51,18 @@
 
 #endif
 
+#if defined(_THALLIUM_WSI_HEADLESS)
+
+#   include <stdint.h>
+
+    // a struct which will be allocated for the platform_data member in headless window surfaces
+    typedef struct TL_WindowSurfacePlatformDataHeadless_t {
+        uint32_t width;
+        uint32_t height;
+    } TL_WindowSurfacePlatformDataHeadless_t;
+
+#endif
+
 #ifdef __cplusplus
     }
 #endif // __cplusplus
@@ -0,0 +1,356 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "vk_bindless_table.h"
+
+#include "lib/vulkan/vk_frame_timeline.h"
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include "vk_pipeline_cache_entry.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// descriptor type and array size of each resource type, indexed by TLVK_BindlessResourceType_t - these stay well within the update-after-bind limits
+// of devices that support descriptor indexing, while keeping the table's memory footprint small
+static const VkDescriptorType __DESCRIPTOR_TYPES[TLVK_BINDLESS_RESOURCE_TYPE_COUNT] = {
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+};
+static const uint32_t __CAPACITIES[TLVK_BINDLESS_RESOURCE_TYPE_COUNT] = {
+    16384,
+    16384,
+    1024,
+};
+
+
+static uint32_t __AddDescriptor(TLVK_BindlessTable_t *const table, const TLVK_BindlessResourceType_t type, const VkDescriptorImageInfo *const image,
+    const VkDescriptorBufferInfo *const buffer, const char *const fn);
+
+
+TLVK_BindlessTable_t *TLVK_BindlessTableCreate(TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+    VkDevice dev = renderer_system->vk_logical_device;
+
+    TLVK_BindlessTable_t *table = calloc(1, sizeof(TLVK_BindlessTable_t));
+    if (!table) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_BindlessTableCreate");
+        return NULL;
+    }
+
+    table->renderer_system = renderer_system;
+    TL_MutexInit(&table->lock);
+
+    VkDescriptorSetLayoutBinding bindings[TLVK_BINDLESS_RESOURCE_TYPE_COUNT];
+    VkDescriptorBindingFlags binding_flags[TLVK_BINDLESS_RESOURCE_TYPE_COUNT];
+    VkDescriptorPoolSize pool_sizes[TLVK_BINDLESS_RESOURCE_TYPE_COUNT];
+
+    for (uint32_t i = 0; i < TLVK_BINDLESS_RESOURCE_TYPE_COUNT; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = __DESCRIPTOR_TYPES[i];
+        bindings[i].descriptorCount = __CAPACITIES[i];
+        bindings[i].stageFlags = VK_SHADER_STAGE_ALL;
+        bindings[i].pImmutableSamplers = NULL;
+
+        // descriptors are written while the set is bound and in use, and unused slots may hold stale or no descriptors
+        binding_flags[i] =
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+        pool_sizes[i].type = __DESCRIPTOR_TYPES[i];
+        pool_sizes[i].descriptorCount = __CAPACITIES[i];
+
+        table->slots[i].capacity = __CAPACITIES[i];
+        table->slots[i].free_slots = malloc(sizeof(uint32_t) * __CAPACITIES[i]);
+        table->slots[i].occupied = calloc(__CAPACITIES[i], sizeof(bool));
+        if (!table->slots[i].free_slots || !table->slots[i].occupied) {
+            TL_Fatal(debugger, "MALLOC fault in call to TLVK_BindlessTableCreate");
+            goto outerr;
+        }
+    }
+
+    // the set layout is shared with pipeline layouts like any other, but is kept out of the deduplication map as only the table may create it
+    table->set_layout = calloc(1, sizeof(TLVK_DescriptorSetLayout_t));
+    if (!table->set_layout) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_BindlessTableCreate");
+        goto outerr;
+    }
+
+    table->set_layout->entry.refcount = 1;
+    table->set_layout->entry.cached = false;
+    table->set_layout->flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+
+    table->set_layout->bindings = malloc(sizeof(bindings));
+    if (!table->set_layout->bindings) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_BindlessTableCreate");
+        goto outerr;
+    }
+
+    memcpy(table->set_layout->bindings, bindings, sizeof(bindings));
+    table->set_layout->binding_count = TLVK_BINDLESS_RESOURCE_TYPE_COUNT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info;
+    binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    binding_flags_info.pNext = NULL;
+    binding_flags_info.bindingCount = TLVK_BINDLESS_RESOURCE_TYPE_COUNT;
+    binding_flags_info.pBindingFlags = binding_flags;
+
+    VkDescriptorSetLayoutCreateInfo layout_info;
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.pNext = &binding_flags_info;
+    layout_info.flags = table->set_layout->flags;
+    layout_info.bindingCount = TLVK_BINDLESS_RESOURCE_TYPE_COUNT;
+    layout_info.pBindings = bindings;
+
+    if (devfs->vkCreateDescriptorSetLayout(dev, &layout_info, NULL, &table->set_layout->vk_layout)) {
+        TL_Error(debugger, "Failed to create descriptor set layout of Vulkan bindless table %p", table);
+        goto outerr;
+    }
+
+    VkDescriptorPoolCreateInfo pool_info;
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.pNext = NULL;
+    pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    pool_info.maxSets = 1;
+    pool_info.poolSizeCount = TLVK_BINDLESS_RESOURCE_TYPE_COUNT;
+    pool_info.pPoolSizes = pool_sizes;
+
+    if (devfs->vkCreateDescriptorPool(dev, &pool_info, NULL, &table->vk_pool)) {
+        TL_Error(debugger, "Failed to create descriptor pool of Vulkan bindless table %p", table);
+        goto outerr;
+    }
+
+    VkDescriptorSetAllocateInfo alloc_info;
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.pNext = NULL;
+    alloc_info.descriptorPool = table->vk_pool;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts = &table->set_layout->vk_layout;
+
+    if (devfs->vkAllocateDescriptorSets(dev, &alloc_info, &table->vk_set)) {
+        TL_Error(debugger, "Failed to allocate descriptor set of Vulkan bindless table %p", table);
+        goto outerr;
+    }
+
+    TL_Log(debugger, "Created Vulkan bindless table at %p (%u sampled images, %u storage buffers, %u samplers)", table,
+        __CAPACITIES[TLVK_BINDLESS_RESOURCE_TYPE_SAMPLED_IMAGE], __CAPACITIES[TLVK_BINDLESS_RESOURCE_TYPE_STORAGE_BUFFER],
+        __CAPACITIES[TLVK_BINDLESS_RESOURCE_TYPE_SAMPLER]);
+
+    return table;
+
+outerr:
+    TLVK_BindlessTableDestroy(table);
+
+    return NULL;
+}
+
+void TLVK_BindlessTableDestroy(TLVK_BindlessTable_t *const table) {
+    if (!table) {
+        return;
+    }
+
+    TLVK_RendererSystem_t *renderer_system = table->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+
+    if (table->vk_pool != VK_NULL_HANDLE) {
+        devfs->vkDestroyDescriptorPool(renderer_system->vk_logical_device, table->vk_pool, NULL);
+    }
+
+    // the set layout is destroyed here unless a pipeline layout still holds a reference to it, in which case releasing that layout destroys it
+    TLVK_DescriptorSetLayout_t *set_layout = table->set_layout;
+    if (set_layout && TLVK_PipelineCacheEntryRelease(renderer_system, &renderer_system->descriptor_set_layouts, &set_layout->entry)) {
+        if (set_layout->vk_layout != VK_NULL_HANDLE) {
+            devfs->vkDestroyDescriptorSetLayout(renderer_system->vk_logical_device, set_layout->vk_layout, NULL);
+        }
+
+        free(set_layout->bindings);
+        free(set_layout);
+    }
+
+    for (uint32_t i = 0; i < TLVK_BINDLESS_RESOURCE_TYPE_COUNT; i++) {
+        free(table->slots[i].free_slots);
+        free(table->slots[i].occupied);
+        free(table->slots[i].retired);
+    }
+
+    TL_MutexDestroy(&table->lock);
+
+    free(table);
+}
+
+uint32_t TLVK_BindlessTableAddSampledImage(TLVK_BindlessTable_t *const table, const VkImageView image_view, const VkImageLayout image_layout) {
+    if (!table || image_view == VK_NULL_HANDLE) {
+        return UINT32_MAX;
+    }
+
+    VkDescriptorImageInfo image_info;
+    image_info.sampler = VK_NULL_HANDLE;
+    image_info.imageView = image_view;
+    image_info.imageLayout = image_layout;
+
+    return __AddDescriptor(table, TLVK_BINDLESS_RESOURCE_TYPE_SAMPLED_IMAGE, &image_info, NULL, "TLVK_BindlessTableAddSampledImage");
+}
+
+uint32_t TLVK_BindlessTableAddStorageBuffer(TLVK_BindlessTable_t *const table, const VkBuffer buffer, const VkDeviceSize offset,
+    const VkDeviceSize range)
+{
+    if (!table || buffer == VK_NULL_HANDLE) {
+        return UINT32_MAX;
+    }
+
+    VkDescriptorBufferInfo buffer_info;
+    buffer_info.buffer = buffer;
+    buffer_info.offset = offset;
+    buffer_info.range = range;
+
+    return __AddDescriptor(table, TLVK_BINDLESS_RESOURCE_TYPE_STORAGE_BUFFER, NULL, &buffer_info, "TLVK_BindlessTableAddStorageBuffer");
+}
+
+uint32_t TLVK_BindlessTableAddSampler(TLVK_BindlessTable_t *const table, const VkSampler sampler) {
+    if (!table || sampler == VK_NULL_HANDLE) {
+        return UINT32_MAX;
+    }
+
+    VkDescriptorImageInfo image_info;
+    image_info.sampler = sampler;
+    image_info.imageView = VK_NULL_HANDLE;
+    image_info.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    return __AddDescriptor(table, TLVK_BINDLESS_RESOURCE_TYPE_SAMPLER, &image_info, NULL, "TLVK_BindlessTableAddSampler");
+}
+
+void TLVK_BindlessTableRemove(TLVK_BindlessTable_t *const table, const TLVK_BindlessResourceType_t type, const uint32_t handle) {
+    if (!table) {
+        return;
+    }
+
+    if ((uint32_t) type >= TLVK_BINDLESS_RESOURCE_TYPE_COUNT) {
+        TL_Error(table->renderer_system->renderer->debugger, "TLVK_BindlessTableRemove: invalid resource type %d", (int) type);
+        return;
+    }
+
+    TLVK_RendererSystem_t *renderer_system = table->renderer_system;
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    TLVK_BindlessSlotList_t *list = &table->slots[type];
+
+    // frames begun after this point cannot have been recorded with the handle, so only frames up to the current one are waited on
+    uint64_t serial = TLVK_FrameTimelineGetLastSerial(renderer_system);
+
+    TL_MutexLock(&table->lock);
+
+    if (handle >= list->next || !list->occupied[handle]) {
+        TL_MutexUnlock(&table->lock);
+        TL_Error(debugger, "TLVK_BindlessTableRemove: handle %u is not in use in bindless table %p (it was never added, or was already removed)",
+            handle, table);
+        return;
+    }
+
+    if (list->retired_count == list->retired_capacity) {
+        uint32_t capacity = (list->retired_capacity) ? list->retired_capacity * 2 : 64;
+
+        TLVK_BindlessRetiredSlot_t *retired = realloc(list->retired, sizeof(TLVK_BindlessRetiredSlot_t) * capacity);
+        if (!retired) {
+            TL_MutexUnlock(&table->lock);
+            TL_Fatal(debugger, "MALLOC fault in call to TLVK_BindlessTableRemove");
+            return;
+        }
+
+        list->retired = retired;
+        list->retired_capacity = capacity;
+    }
+
+    list->occupied[handle] = false;
+    list->retired[list->retired_count].handle = handle;
+    list->retired[list->retired_count].serial = serial;
+    list->retired_count++;
+
+    TL_MutexUnlock(&table->lock);
+
+    // the slot can be reused straight away if no frame that may access it is still in flight
+    TLVK_BindlessTableCollect(table, TLVK_FrameTimelineGetOldestSerial(renderer_system));
+}
+
+void TLVK_BindlessTableCollect(TLVK_BindlessTable_t *const table, const uint64_t oldest_serial) {
+    if (!table) {
+        return;
+    }
+
+    TL_MutexLock(&table->lock);
+
+    for (uint32_t i = 0; i < TLVK_BINDLESS_RESOURCE_TYPE_COUNT; i++) {
+        TLVK_BindlessSlotList_t *list = &table->slots[i];
+
+        // released slots that are still waited on are kept in order at the front of the list
+        uint32_t kept = 0;
+        for (uint32_t r = 0; r < list->retired_count; r++) {
+            if (list->retired[r].serial < oldest_serial) {
+                // every released slot is below `next`, so the stack can never hold more than `capacity` slots
+                list->free_slots[list->free_count++] = list->retired[r].handle;
+            } else {
+                list->retired[kept++] = list->retired[r];
+            }
+        }
+
+        list->retired_count = kept;
+    }
+
+    TL_MutexUnlock(&table->lock);
+}
+
+
+static uint32_t __AddDescriptor(TLVK_BindlessTable_t *const table, const TLVK_BindlessResourceType_t type, const VkDescriptorImageInfo *const image,
+    const VkDescriptorBufferInfo *const buffer, const char *const fn)
+{
+    const TLVK_RendererSystem_t *renderer_system = table->renderer_system;
+    TLVK_BindlessSlotList_t *list = &table->slots[type];
+
+    uint32_t handle = UINT32_MAX;
+
+    TL_MutexLock(&table->lock);
+
+    // reuse released slots first, so the used part of each array stays compact
+    if (list->free_count) {
+        handle = list->free_slots[--list->free_count];
+    } else if (list->next < list->capacity) {
+        handle = list->next++;
+    }
+
+    if (handle != UINT32_MAX) {
+        list->occupied[handle] = true;
+
+        VkWriteDescriptorSet write;
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext = NULL;
+        write.dstSet = table->vk_set;
+        write.dstBinding = (uint32_t) type;
+        write.dstArrayElement = handle;
+        write.descriptorCount = 1;
+        write.descriptorType = __DESCRIPTOR_TYPES[type];
+        write.pImageInfo = image;
+        write.pBufferInfo = buffer;
+        write.pTexelBufferView = NULL;
+
+        renderer_system->devfs.vkUpdateDescriptorSets(renderer_system->vk_logical_device, 1, &write, 0, NULL);
+    }
+
+    TL_MutexUnlock(&table->lock);
+
+    if (handle == UINT32_MAX) {
+        TL_Error(renderer_system->renderer->debugger, "%s: bindless table %p is full (%u descriptors)", fn, table, list->capacity);
+    }
+
+    return handle;
+}
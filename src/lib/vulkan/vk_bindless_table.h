@@ -0,0 +1,35 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_bindless_table_h__
+#define __TL__internal__vulkan__vk_bindless_table_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/vulkan/vk_bindless_table.h"
+
+#include "types/vulkan/vk_bindless_table_t.h"
+
+/**
+ * @brief Make the released slots of the given bindless table that can no longer be in use available to later additions.
+ *
+ * A slot released with @ref TLVK_BindlessTableRemove() is only reused once every frame that was begun before its release has retired.
+ *
+ * @param table NULL or the bindless table to collect released slots of
+ * @param oldest_serial Serial of the oldest frame of the renderer system's frame timeline that has not retired yet
+ */
+void TLVK_BindlessTableCollect(
+    TLVK_BindlessTable_t *const table,
+    const uint64_t oldest_serial
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -0,0 +1,528 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "thallium/vulkan/vk_command_buffer_system.h"
+#include "types/vulkan/vk_command_buffer_system_t.h"
+
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_bindless_table_t.h"
+#include "types/vulkan/vk_pipeline_system_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include "vk_frame_timeline.h"
+
+#include <stdlib.h>
+
+// extended dynamic state commands are core in Vulkan 1.3 and otherwise come from the EXT extensions; both versions share the same signature, and
+// only one of the two will have been loaded if the device does not support Vulkan 1.3
+#define __DYNAMIC_STATE_FN(devfs, name) (((devfs)->name) ? (devfs)->name : (devfs)->name ## EXT)
+
+static bool __CheckComputePipelineBound(const TLVK_CommandBufferSystem_t *const command_buffer_system, const char *const fn);
+
+static bool __CheckExtendedDynamicState(const TLVK_CommandBufferSystem_t *const command_buffer_system, const char *const fn);
+
+// releases the frame timeline serial held by the command buffer system, if any
+static void __ReleaseSerial(TLVK_CommandBufferSystem_t *const command_buffer_system);
+
+
+TLVK_CommandBufferSystem_t *TLVK_CommandBufferSystemCreate(const TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return NULL;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    const VkDevice device = renderer_system->vk_logical_device;
+
+    TLVK_CommandBufferSystem_t *command_buffer_system = malloc(sizeof(TLVK_CommandBufferSystem_t));
+    if (!command_buffer_system) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_CommandBufferSystemCreate");
+        return NULL;
+    }
+
+    TL_Log(debugger, "Allocated memory for Vulkan command buffer system at %p", command_buffer_system);
+
+    command_buffer_system->renderer_system = renderer_system;
+    command_buffer_system->vk_command_pool = VK_NULL_HANDLE;
+    command_buffer_system->vk_command_buffer = VK_NULL_HANDLE;
+    command_buffer_system->vk_fence = VK_NULL_HANDLE;
+    command_buffer_system->pending = false;
+    command_buffer_system->serial = 0;
+    command_buffer_system->bound_pipeline = NULL;
+    command_buffer_system->bound_compute_pipeline = NULL;
+    command_buffer_system->descriptor_buffer_bound = false;
+
+    VkCommandPoolCreateInfo pool_info;
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.pNext = NULL;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pool_info.queueFamilyIndex = (uint32_t) renderer_system->vk_queues.graphics_family;
+
+    if (devfs->vkCreateCommandPool(device, &pool_info, NULL, &command_buffer_system->vk_command_pool)) {
+        TL_Error(debugger, "Failed to create Vulkan command pool for command buffer system at %p", command_buffer_system);
+        goto outerr;
+    }
+
+    VkCommandBufferAllocateInfo alloc_info;
+    alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    alloc_info.pNext = NULL;
+    alloc_info.commandPool = command_buffer_system->vk_command_pool;
+    alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc_info.commandBufferCount = 1;
+
+    if (devfs->vkAllocateCommandBuffers(device, &alloc_info, &command_buffer_system->vk_command_buffer)) {
+        TL_Error(debugger, "Failed to allocate Vulkan command buffer for command buffer system at %p", command_buffer_system);
+        goto outerr;
+    }
+
+    VkFenceCreateInfo fence_info;
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fence_info.pNext = NULL;
+    fence_info.flags = 0;
+
+    if (devfs->vkCreateFence(device, &fence_info, NULL, &command_buffer_system->vk_fence)) {
+        TL_Error(debugger, "Failed to create Vulkan fence for command buffer system at %p", command_buffer_system);
+        goto outerr;
+    }
+
+    return command_buffer_system;
+outerr:
+    TLVK_CommandBufferSystemDestroy(command_buffer_system);
+    return NULL;
+}
+
+void TLVK_CommandBufferSystemDestroy(TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    if (!command_buffer_system) {
+        return;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = command_buffer_system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const VkDevice device = renderersys->vk_logical_device;
+
+    // the command buffer cannot be freed while the device may still be executing it
+    TLVK_CommandBufferSystemWait(command_buffer_system);
+    __ReleaseSerial(command_buffer_system);
+
+    if (command_buffer_system->vk_fence != VK_NULL_HANDLE) {
+        devfs->vkDestroyFence(device, command_buffer_system->vk_fence, NULL);
+    }
+
+    // command buffers are freed along with the pool they were allocated from
+    if (command_buffer_system->vk_command_pool != VK_NULL_HANDLE) {
+        devfs->vkDestroyCommandPool(device, command_buffer_system->vk_command_pool, NULL);
+    }
+
+    free(command_buffer_system);
+}
+
+VkCommandBuffer TLVK_CommandBufferSystemGetHandle(const TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    return command_buffer_system->vk_command_buffer;
+}
+
+bool TLVK_CommandBufferSystemBegin(TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    if (!command_buffer_system) {
+        return false;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(command_buffer_system->renderer_system->devfs);
+
+    // a command buffer must not be re-recorded while it is still executing
+    TLVK_CommandBufferSystemWait(command_buffer_system);
+
+    // the serial is held from before recording, as bindless handles released after this point may still be recorded until the submission
+    __ReleaseSerial(command_buffer_system);
+    if (!TLVK_FrameTimelineHoldSerial((TLVK_RendererSystem_t *) command_buffer_system->renderer_system, &command_buffer_system->serial)) {
+        TL_Error(command_buffer_system->renderer_system->renderer->debugger, "Failed to hold frame timeline serial for command buffer system %p",
+            command_buffer_system);
+        return false;
+    }
+
+    command_buffer_system->bound_pipeline = NULL;
+    command_buffer_system->bound_compute_pipeline = NULL;
+    command_buffer_system->descriptor_buffer_bound = false;
+
+    // the command buffer is implicitly reset here as its pool was created with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+    VkCommandBufferBeginInfo begin_info;
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.pNext = NULL;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    begin_info.pInheritanceInfo = NULL;
+
+    if (devfs->vkBeginCommandBuffer(command_buffer_system->vk_command_buffer, &begin_info)) {
+        TL_Error(command_buffer_system->renderer_system->renderer->debugger, "Failed to begin Vulkan command buffer in command buffer system %p",
+            command_buffer_system);
+        return false;
+    }
+
+    return true;
+}
+
+bool TLVK_CommandBufferSystemEnd(TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    if (!command_buffer_system) {
+        return false;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(command_buffer_system->renderer_system->devfs);
+
+    if (devfs->vkEndCommandBuffer(command_buffer_system->vk_command_buffer)) {
+        TL_Error(command_buffer_system->renderer_system->renderer->debugger, "Failed to end Vulkan command buffer in command buffer system %p",
+            command_buffer_system);
+        return false;
+    }
+
+    return true;
+}
+
+bool TLVK_CommandBufferSystemSubmit(TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    return TLVK_CommandBufferSystemSubmitWithSemaphores(command_buffer_system, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+}
+
+bool TLVK_CommandBufferSystemSubmitWithSemaphores(TLVK_CommandBufferSystem_t *const command_buffer_system, const VkSemaphore wait_semaphore,
+    const VkPipelineStageFlags wait_stage_mask, const VkSemaphore signal_semaphore)
+{
+    if (!command_buffer_system) {
+        return false;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = command_buffer_system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+
+    if (command_buffer_system->pending) {
+        TL_Error(debugger, "Attempted to submit Vulkan command buffer system %p while its previous submission is still pending",
+            command_buffer_system);
+        return false;
+    }
+
+    if (!renderersys->vk_queues.graphics.size) {
+        TL_Error(debugger, "Attempted to submit Vulkan command buffer system %p without a graphics queue", command_buffer_system);
+        return false;
+    }
+
+    // the command pool was created on the graphics queue family, whose queues support both graphics and compute work
+    VkQueue queue = (VkQueue) renderersys->vk_queues.graphics.data[0];
+
+    if (devfs->vkResetFences(renderersys->vk_logical_device, 1, &command_buffer_system->vk_fence)) {
+        TL_Error(debugger, "Failed to reset fence of Vulkan command buffer system %p", command_buffer_system);
+        return false;
+    }
+
+    VkSubmitInfo submit_info;
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.pNext = NULL;
+    submit_info.waitSemaphoreCount = (wait_semaphore != VK_NULL_HANDLE);
+    submit_info.pWaitSemaphores = &wait_semaphore;
+    submit_info.pWaitDstStageMask = &wait_stage_mask;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer_system->vk_command_buffer;
+    submit_info.signalSemaphoreCount = (signal_semaphore != VK_NULL_HANDLE);
+    submit_info.pSignalSemaphores = &signal_semaphore;
+
+    if (devfs->vkQueueSubmit(queue, 1, &submit_info, command_buffer_system->vk_fence)) {
+        TL_Error(debugger, "Failed to submit Vulkan command buffer system %p", command_buffer_system);
+        return false;
+    }
+
+    command_buffer_system->pending = true;
+
+    return true;
+}
+
+bool TLVK_CommandBufferSystemWait(TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    if (!command_buffer_system) {
+        return false;
+    }
+
+    if (!command_buffer_system->pending) {
+        return true;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = command_buffer_system->renderer_system;
+
+    if (renderersys->devfs.vkWaitForFences(renderersys->vk_logical_device, 1, &command_buffer_system->vk_fence, VK_TRUE, UINT64_MAX)) {
+        TL_Error(renderersys->renderer->debugger, "Failed to wait on fence of Vulkan command buffer system %p", command_buffer_system);
+        return false;
+    }
+
+    command_buffer_system->pending = false;
+
+    // the commands cannot be executed again without being recorded anew, so nothing of the submission can still access released bindless slots
+    __ReleaseSerial(command_buffer_system);
+
+    return true;
+}
+
+void TLVK_CommandBufferSystemBindPipeline(TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const TLVK_PipelineSystem_t *const pipeline_system)
+{
+    if (!command_buffer_system || !pipeline_system) {
+        return;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(command_buffer_system->renderer_system->devfs);
+
+    VkPipeline pso = (VkPipeline) TL_AtomicLoad64(&pipeline_system->pso);
+    devfs->vkCmdBindPipeline(command_buffer_system->vk_command_buffer, pipeline_system->bind_point, pso);
+
+    // every pipeline layout with descriptor sets uses the bindless table's set, so binding it with each pipeline keeps it bound at every bind point
+    // without the caller ever binding it
+    const TLVK_BindlessTable_t *table = command_buffer_system->renderer_system->bindless_table;
+    const TLVK_PipelineLayout_t *layout = pipeline_system->layout;
+
+    if (table && layout->set_count > TLVK_BINDLESS_SET_INDEX) {
+        devfs->vkCmdBindDescriptorSets(command_buffer_system->vk_command_buffer, pipeline_system->bind_point, layout->vk_layout,
+            TLVK_BINDLESS_SET_INDEX, 1, &table->vk_set, 0, NULL);
+    }
+
+    // the descriptor buffer is bound once per recording, after which binding a set only sets its offset in the buffer
+    if (layout->descriptor_buffer && !command_buffer_system->descriptor_buffer_bound) {
+        const TLVK_DescriptorBuffer_t *buffer = &command_buffer_system->renderer_system->descriptor_allocator.buffer;
+
+        VkDescriptorBufferBindingInfoEXT binding_info;
+        binding_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+        binding_info.pNext = NULL;
+        binding_info.address = buffer->address;
+        binding_info.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+
+        devfs->vkCmdBindDescriptorBuffersEXT(command_buffer_system->vk_command_buffer, 1, &binding_info);
+        command_buffer_system->descriptor_buffer_bound = true;
+    }
+
+    command_buffer_system->bound_pipeline = pipeline_system;
+    if (pipeline_system->bind_point == VK_PIPELINE_BIND_POINT_COMPUTE) {
+        command_buffer_system->bound_compute_pipeline = pipeline_system;
+    }
+}
+
+bool TLVK_CommandBufferSystemSetRasterizerState(TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const TL_PipelineRasterizerDescriptor_t *const rasterizer)
+{
+    if (!rasterizer || !__CheckExtendedDynamicState(command_buffer_system, "TLVK_CommandBufferSystemSetRasterizerState")) {
+        return false;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(command_buffer_system->renderer_system->devfs);
+    const TL_RendererFeatures_t *rfeatures = &(command_buffer_system->renderer_system->renderer->features);
+    VkCommandBuffer cmd = command_buffer_system->vk_command_buffer;
+
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetCullMode)(cmd, (VkCullModeFlags) rasterizer->cull_modes);
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetFrontFace)(cmd, (VkFrontFace) rasterizer->clockwise_front_face);
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetRasterizerDiscardEnable)(cmd, rasterizer->rasterizer_discard);
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetDepthBiasEnable)(cmd, rasterizer->depth_bias);
+
+    // these two are core Vulkan 1.0 dynamic states
+    devfs->vkCmdSetDepthBias(cmd, rasterizer->depth_bias_constant_factor, rasterizer->depth_bias_clamp, rasterizer->depth_bias_slope_factor);
+    devfs->vkCmdSetLineWidth(cmd, (rfeatures->wide_lines) ? rasterizer->line_width : 1.0f);
+
+    return true;
+}
+
+bool TLVK_CommandBufferSystemSetDepthTestState(TLVK_CommandBufferSystem_t *const command_buffer_system,
+    const TL_PipelineDepthTestDescriptor_t *const depth_test)
+{
+    if (!depth_test || !__CheckExtendedDynamicState(command_buffer_system, "TLVK_CommandBufferSystemSetDepthTestState")) {
+        return false;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(command_buffer_system->renderer_system->devfs);
+    VkCommandBuffer cmd = command_buffer_system->vk_command_buffer;
+
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetDepthTestEnable)(cmd, depth_test->test_enabled);
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetDepthWriteEnable)(cmd, depth_test->write_enabled);
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetDepthCompareOp)(cmd, (VkCompareOp) depth_test->compare_op);
+
+    return true;
+}
+
+bool TLVK_CommandBufferSystemSetPrimitiveTopology(TLVK_CommandBufferSystem_t *const command_buffer_system, const TL_PrimitiveTopology_t topology) {
+    if (!__CheckExtendedDynamicState(command_buffer_system, "TLVK_CommandBufferSystemSetPrimitiveTopology")) {
+        return false;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(command_buffer_system->renderer_system->devfs);
+    VkCommandBuffer cmd = command_buffer_system->vk_command_buffer;
+
+    // same conversion as when baking the topology into a pipeline: the leftmost bit marks strip topologies, which use primitive restarts
+    VkPrimitiveTopology vk_topology = (topology) ? (VkPrimitiveTopology) (topology & ~0x80) : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkBool32 primitive_restart = (topology & 0x80) ? VK_TRUE : VK_FALSE;
+
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetPrimitiveTopology)(cmd, vk_topology);
+    __DYNAMIC_STATE_FN(devfs, vkCmdSetPrimitiveRestartEnable)(cmd, primitive_restart);
+
+    return true;
+}
+
+void TLVK_CommandBufferSystemPushConstants(TLVK_CommandBufferSystem_t *const command_buffer_system, const uint32_t offset, const uint32_t size,
+    const void *const data)
+{
+    if (!command_buffer_system || !data || !size) {
+        return;
+    }
+
+    const TL_Debugger_t *debugger = command_buffer_system->renderer_system->renderer->debugger;
+    const TLVK_PipelineSystem_t *pipeline_system = command_buffer_system->bound_pipeline;
+
+    if (!pipeline_system) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemPushConstants: no pipeline is bound");
+        return;
+    }
+
+    // the push constant range of every layout starts at offset 0 and is a multiple of 4 bytes long
+    const TLVK_PipelineLayout_t *layout = pipeline_system->layout;
+
+    if (offset % 4 || size % 4) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemPushConstants: offset (%u) and size (%u) must be multiples of 4", offset, size);
+        return;
+    }
+
+    if (size > layout->push_constant_size || offset > layout->push_constant_size - size) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemPushConstants: %u bytes at offset %u exceed the %u bytes of push constants of the bound pipeline",
+            size, offset, layout->push_constant_size);
+        return;
+    }
+
+    command_buffer_system->renderer_system->devfs.vkCmdPushConstants(command_buffer_system->vk_command_buffer, layout->vk_layout,
+        layout->push_constant_stages, offset, size, data);
+}
+
+void TLVK_CommandBufferSystemBindDescriptorSet(TLVK_CommandBufferSystem_t *const command_buffer_system, const uint32_t set_index,
+    const TLVK_TransientDescriptorSet_t *const set)
+{
+    if (!command_buffer_system || !set) {
+        return;
+    }
+
+    const TL_Debugger_t *debugger = command_buffer_system->renderer_system->renderer->debugger;
+    const TLVK_PipelineSystem_t *pipeline_system = command_buffer_system->bound_pipeline;
+
+    if (!pipeline_system) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemBindDescriptorSet: no pipeline is bound");
+        return;
+    }
+
+    if (set_index >= pipeline_system->layout->set_count) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemBindDescriptorSet: the shaders of the bound pipeline do not use descriptor set %u", set_index);
+        return;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(command_buffer_system->renderer_system->devfs);
+    const TLVK_PipelineLayout_t *layout = pipeline_system->layout;
+
+    // a set can only be bound to pipelines that store their sets the same way it was allocated
+    if (layout->descriptor_buffer != (set->vk_set == VK_NULL_HANDLE)) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemBindDescriptorSet: descriptor set %u was %s, but the bound pipeline's sets are %s", set_index,
+            (set->vk_set == VK_NULL_HANDLE) ? "written to the descriptor buffer" : "allocated from a descriptor pool",
+            (layout->descriptor_buffer) ? "stored in the descriptor buffer" : "allocated from descriptor pools");
+        return;
+    }
+
+    if (layout->descriptor_buffer) {
+        uint32_t buffer_index = 0;
+        devfs->vkCmdSetDescriptorBufferOffsetsEXT(command_buffer_system->vk_command_buffer, pipeline_system->bind_point, layout->vk_layout,
+            set_index, 1, &buffer_index, &set->buffer_offset);
+        return;
+    }
+
+    devfs->vkCmdBindDescriptorSets(command_buffer_system->vk_command_buffer, pipeline_system->bind_point, layout->vk_layout, set_index, 1,
+        &set->vk_set, 0, NULL);
+}
+
+void TLVK_CommandBufferSystemPushDescriptorSet(TLVK_CommandBufferSystem_t *const command_buffer_system, const uint32_t write_count,
+    const VkWriteDescriptorSet *const writes)
+{
+    if (!command_buffer_system || !writes || !write_count) {
+        return;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = command_buffer_system->renderer_system;
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    const TLVK_PipelineSystem_t *pipeline_system = command_buffer_system->bound_pipeline;
+
+    if (!renderersys->renderer->features.push_descriptors) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemPushDescriptorSet: missing renderer feature 'push_descriptors'");
+        return;
+    }
+
+    if (!pipeline_system) {
+        TL_Error(debugger, "TLVK_CommandBufferSystemPushDescriptorSet: no pipeline is bound");
+        return;
+    }
+
+    const TLVK_PipelineLayout_t *layout = pipeline_system->layout;
+
+    if (layout->set_count <= TLVK_PUSH_DESCRIPTOR_SET_INDEX ||
+        !(layout->set_layouts[TLVK_PUSH_DESCRIPTOR_SET_INDEX]->flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR))
+    {
+        TL_Error(debugger, "TLVK_CommandBufferSystemPushDescriptorSet: the shaders of the bound pipeline do not use descriptor set %d",
+            TLVK_PUSH_DESCRIPTOR_SET_INDEX);
+        return;
+    }
+
+    renderersys->devfs.vkCmdPushDescriptorSetKHR(command_buffer_system->vk_command_buffer, pipeline_system->bind_point, layout->vk_layout,
+        TLVK_PUSH_DESCRIPTOR_SET_INDEX, write_count, writes);
+}
+
+void TLVK_CommandBufferSystemDispatch(TLVK_CommandBufferSystem_t *const command_buffer_system, const uint32_t group_count_x,
+    const uint32_t group_count_y, const uint32_t group_count_z)
+{
+    if (!__CheckComputePipelineBound(command_buffer_system, "TLVK_CommandBufferSystemDispatch")) {
+        return;
+    }
+
+    command_buffer_system->renderer_system->devfs.vkCmdDispatch(command_buffer_system->vk_command_buffer, group_count_x, group_count_y,
+        group_count_z);
+}
+
+void TLVK_CommandBufferSystemDispatchIndirect(TLVK_CommandBufferSystem_t *const command_buffer_system, const VkBuffer buffer,
+    const VkDeviceSize offset)
+{
+    if (!__CheckComputePipelineBound(command_buffer_system, "TLVK_CommandBufferSystemDispatchIndirect")) {
+        return;
+    }
+
+    command_buffer_system->renderer_system->devfs.vkCmdDispatchIndirect(command_buffer_system->vk_command_buffer, buffer, offset);
+}
+
+
+static bool __CheckComputePipelineBound(const TLVK_CommandBufferSystem_t *const command_buffer_system, const char *const fn) {
+    if (!command_buffer_system) {
+        return false;
+    }
+
+    if (!command_buffer_system->bound_compute_pipeline) {
+        TL_Error(command_buffer_system->renderer_system->renderer->debugger, "%s: no compute pipeline is bound", fn);
+        return false;
+    }
+
+    return true;
+}
+
+// the dynamic state entry points are only loaded (and their device features only enabled) if the renderer feature was kept on device creation
+static bool __CheckExtendedDynamicState(const TLVK_CommandBufferSystem_t *const command_buffer_system, const char *const fn) {
+    if (!command_buffer_system) {
+        return false;
+    }
+
+    if (!command_buffer_system->renderer_system->renderer->features.extended_dynamic_state) {
+        TL_Error(command_buffer_system->renderer_system->renderer->debugger, "%s: missing renderer feature 'extended_dynamic_state'", fn);
+        return false;
+    }
+
+    return true;
+}
+
+static void __ReleaseSerial(TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    if (!command_buffer_system->serial) {
+        return;
+    }
+
+    TLVK_FrameTimelineReleaseSerial((TLVK_RendererSystem_t *) command_buffer_system->renderer_system, command_buffer_system->serial);
+    command_buffer_system->serial = 0;
+}
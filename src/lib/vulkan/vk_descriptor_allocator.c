@@ -0,0 +1,490 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "vk_descriptor_allocator.h"
+
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include <volk/volk.h>
+
+#include <stdlib.h>
+
+// amount of sets that the first pool of each frame can hold - each further pool of the frame holds twice as many, up to __MAX_POOL_SET_COUNT
+#define __MIN_POOL_SET_COUNT 64
+#define __MAX_POOL_SET_COUNT 4096
+
+typedef struct __PoolRatio {
+    VkDescriptorType type;
+    float descriptors_per_set;
+} __PoolRatio;
+
+// amount of descriptors of each type to reserve per set in new pools, based on what sets typically contain
+static const __PoolRatio __POOL_RATIOS[] = {
+    { VK_DESCRIPTOR_TYPE_SAMPLER,                0.5f },
+    { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+    { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          4.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,   1.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,   1.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         2.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         2.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f },
+    { VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,       0.5f },
+};
+
+#define __POOL_RATIO_COUNT (sizeof(__POOL_RATIOS) / sizeof(__POOL_RATIOS[0]))
+
+
+static VkDescriptorPool __GetPool(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorPoolList_t *const list);
+
+// must be called with the allocator lock held
+static TLVK_DescriptorPoolList_t *__GetFrameList(TLVK_RendererSystem_t *const renderer_system, const uint32_t frame);
+
+static bool __FindBufferMemoryType(const VkPhysicalDevice physical_device, const uint32_t type_bits, uint32_t *const out_index);
+
+
+void TLVK_DescriptorAllocatorInit(TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return;
+    }
+
+    TLVK_DescriptorAllocator_t *allocator = &renderer_system->descriptor_allocator;
+
+    allocator->frames = NULL;
+    allocator->frame_count = 0;
+
+    allocator->buffer = (TLVK_DescriptorBuffer_t) { 0 };
+
+    TL_MutexInit(&allocator->lock);
+}
+
+bool TLVK_DescriptorAllocatorCreateBuffer(TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return false;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+    VkDevice dev = renderer_system->vk_logical_device;
+
+    TLVK_DescriptorBuffer_t *buffer = &renderer_system->descriptor_allocator.buffer;
+
+    PFN_vkGetPhysicalDeviceProperties2 get_properties =
+        (vkGetPhysicalDeviceProperties2) ? vkGetPhysicalDeviceProperties2 : vkGetPhysicalDeviceProperties2KHR;
+    PFN_vkGetPhysicalDeviceFeatures2 get_features = (vkGetPhysicalDeviceFeatures2) ? vkGetPhysicalDeviceFeatures2 : vkGetPhysicalDeviceFeatures2KHR;
+    PFN_vkGetBufferDeviceAddress get_address = (devfs->vkGetBufferDeviceAddress) ? devfs->vkGetBufferDeviceAddress :
+        devfs->vkGetBufferDeviceAddressKHR;
+
+    if (!get_properties || !get_features || !get_address || !devfs->vkGetDescriptorEXT || !devfs->vkCmdBindDescriptorBuffersEXT) {
+        TL_Error(debugger, "Failed to create Vulkan descriptor buffer: descriptor buffer functions were not loaded");
+        return false;
+    }
+
+    buffer->properties = (VkPhysicalDeviceDescriptorBufferPropertiesEXT) { 0 };
+    buffer->properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+
+    VkPhysicalDeviceProperties2 properties2 = { 0 };
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &buffer->properties;
+
+    get_properties(renderer_system->vk_physical_device, &properties2);
+
+    // the device enables descriptorBufferPushDescriptors whenever it is supported alongside push descriptors (see TLVK_LogicalDeviceCreate) - push
+    // descriptors that would need a buffer of their own are not supported, so pipelines with a push descriptor set keep using pools on such devices
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT db_features = { 0 };
+    db_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2 features2 = { 0 };
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &db_features;
+
+    get_features(renderer_system->vk_physical_device, &features2);
+
+    buffer->push_descriptors = renderer_system->renderer->features.push_descriptors && db_features.descriptorBufferPushDescriptors &&
+        buffer->properties.bufferlessPushDescriptors;
+
+    // sets are bound by their offset from the start of the buffer, and a set containing samplers must lie within the sampler range
+    VkDeviceSize alignment = buffer->properties.descriptorBufferOffsetAlignment;
+    VkDeviceSize range = buffer->properties.maxResourceDescriptorBufferRange;
+    if (buffer->properties.maxSamplerDescriptorBufferRange < range) {
+        range = buffer->properties.maxSamplerDescriptorBufferRange;
+    }
+
+    buffer->frame_size = TLVK_DESCRIPTOR_BUFFER_FRAME_SIZE;
+    if (range / TLVK_DESCRIPTOR_BUFFER_REGION_COUNT < buffer->frame_size) {
+        buffer->frame_size = range / TLVK_DESCRIPTOR_BUFFER_REGION_COUNT;
+    }
+    if (alignment > 1) {
+        buffer->frame_size -= buffer->frame_size % alignment;
+    }
+
+    VkBufferCreateInfo buffer_info;
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.pNext = NULL;
+    buffer_info.flags = 0;
+    buffer_info.size = buffer->frame_size * TLVK_DESCRIPTOR_BUFFER_REGION_COUNT;
+    buffer_info.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+        VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    buffer_info.queueFamilyIndexCount = 0;
+    buffer_info.pQueueFamilyIndices = NULL;
+
+    if (devfs->vkCreateBuffer(dev, &buffer_info, NULL, &buffer->vk_buffer)) {
+        TL_Error(debugger, "Failed to create Vulkan descriptor buffer (%llu bytes)", (unsigned long long) buffer_info.size);
+        goto outerr;
+    }
+
+    VkMemoryRequirements requirements;
+    devfs->vkGetBufferMemoryRequirements(dev, buffer->vk_buffer, &requirements);
+
+    VkMemoryAllocateFlagsInfo flags_info;
+    flags_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    flags_info.pNext = NULL;
+    flags_info.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    flags_info.deviceMask = 0;
+
+    VkMemoryAllocateInfo memory_info;
+    memory_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memory_info.pNext = &flags_info;
+    memory_info.allocationSize = requirements.size;
+
+    if (!__FindBufferMemoryType(renderer_system->vk_physical_device, requirements.memoryTypeBits, &memory_info.memoryTypeIndex)) {
+        TL_Error(debugger, "Failed to create Vulkan descriptor buffer: no host-visible memory type is suitable");
+        goto outerr;
+    }
+
+    if (devfs->vkAllocateMemory(dev, &memory_info, NULL, &buffer->vk_memory)) {
+        TL_Error(debugger, "Failed to allocate memory for Vulkan descriptor buffer (%llu bytes)", (unsigned long long) requirements.size);
+        goto outerr;
+    }
+
+    if (devfs->vkBindBufferMemory(dev, buffer->vk_buffer, buffer->vk_memory, 0)) {
+        TL_Error(debugger, "Failed to bind memory of Vulkan descriptor buffer");
+        goto outerr;
+    }
+
+    if (devfs->vkMapMemory(dev, buffer->vk_memory, 0, VK_WHOLE_SIZE, 0, (void **) &buffer->mapped)) {
+        TL_Error(debugger, "Failed to map memory of Vulkan descriptor buffer");
+        goto outerr;
+    }
+
+    VkBufferDeviceAddressInfo address_info;
+    address_info.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    address_info.pNext = NULL;
+    address_info.buffer = buffer->vk_buffer;
+
+    buffer->address = get_address(dev, &address_info);
+
+    TL_Log(debugger, "Created Vulkan descriptor buffer with %d regions of %llu bytes", TLVK_DESCRIPTOR_BUFFER_REGION_COUNT,
+        (unsigned long long) buffer->frame_size);
+
+    return true;
+
+outerr:
+    if (buffer->vk_buffer != VK_NULL_HANDLE) {
+        devfs->vkDestroyBuffer(dev, buffer->vk_buffer, NULL);
+    }
+    if (buffer->vk_memory != VK_NULL_HANDLE) {
+        devfs->vkFreeMemory(dev, buffer->vk_memory, NULL);
+    }
+
+    *buffer = (TLVK_DescriptorBuffer_t) { 0 };
+
+    return false;
+}
+
+void TLVK_DescriptorAllocatorDestroy(TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return;
+    }
+
+    TLVK_DescriptorAllocator_t *allocator = &renderer_system->descriptor_allocator;
+
+    for (uint32_t i = 0; i < allocator->frame_count; i++) {
+        TLVK_DescriptorPoolList_t *list = &allocator->frames[i];
+
+        for (uint32_t p = 0; p < list->count; p++) {
+            renderer_system->devfs.vkDestroyDescriptorPool(renderer_system->vk_logical_device, list->pools[p], NULL);
+        }
+
+        free(list->pools);
+    }
+
+    free(allocator->frames);
+    allocator->frames = NULL;
+    allocator->frame_count = 0;
+
+    // freeing the memory also unmaps it
+    if (allocator->buffer.vk_buffer != VK_NULL_HANDLE) {
+        renderer_system->devfs.vkDestroyBuffer(renderer_system->vk_logical_device, allocator->buffer.vk_buffer, NULL);
+        renderer_system->devfs.vkFreeMemory(renderer_system->vk_logical_device, allocator->buffer.vk_memory, NULL);
+    }
+
+    allocator->buffer = (TLVK_DescriptorBuffer_t) { 0 };
+
+    TL_MutexDestroy(&allocator->lock);
+}
+
+VkDescriptorSet TLVK_DescriptorAllocatorAllocate(TLVK_RendererSystem_t *const renderer_system, const uint32_t frame,
+    const VkDescriptorSetLayout set_layout)
+{
+    if (!renderer_system || set_layout == VK_NULL_HANDLE) {
+        return VK_NULL_HANDLE;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    TLVK_DescriptorAllocator_t *allocator = &renderer_system->descriptor_allocator;
+
+    VkDescriptorSet set = VK_NULL_HANDLE;
+
+    TL_MutexLock(&allocator->lock);
+
+    TLVK_DescriptorPoolList_t *list = __GetFrameList(renderer_system, frame);
+    if (!list) {
+        TL_MutexUnlock(&allocator->lock);
+        return VK_NULL_HANDLE;
+    }
+
+    VkDescriptorSetAllocateInfo alloc_info;
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.pNext = NULL;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts = &set_layout;
+
+    // the current pool may be too full for this layout, in which case the next pool is tried - a set that does not even fit in a fresh pool is an
+    // error, so at most two pools are tried
+    for (uint32_t attempt = 0; attempt < 2; attempt++) {
+        alloc_info.descriptorPool = __GetPool(renderer_system, list);
+        if (alloc_info.descriptorPool == VK_NULL_HANDLE) {
+            break;
+        }
+
+        VkResult result = renderer_system->devfs.vkAllocateDescriptorSets(renderer_system->vk_logical_device, &alloc_info, &set);
+        if (result == VK_SUCCESS) {
+            break;
+        }
+
+        set = VK_NULL_HANDLE;
+
+        if (attempt || (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)) {
+            break;
+        }
+
+        list->current++;
+    }
+
+    TL_MutexUnlock(&allocator->lock);
+
+    if (set == VK_NULL_HANDLE) {
+        TL_Error(debugger, "TLVK_DescriptorAllocatorAllocate: failed to allocate descriptor set for frame %u", frame);
+    }
+
+    return set;
+}
+
+void *TLVK_DescriptorAllocatorAllocateBuffer(TLVK_RendererSystem_t *const renderer_system, const uint32_t frame, const VkDeviceSize size,
+    VkDeviceSize *const out_offset)
+{
+    if (!renderer_system || !out_offset) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    // the buffer's regions cannot be added to like pool lists, so only the lowest frame indices can write to it - these are the indices that the
+    // frame timeline hands out first, so only renderers with an unusually large amount of frames in flight at once can run out
+    if (frame >= TLVK_DESCRIPTOR_BUFFER_REGION_COUNT) {
+        TL_Error(debugger, "TLVK_DescriptorAllocatorAllocateBuffer: frame index %u out of range (the descriptor buffer has %d regions)", frame,
+            TLVK_DESCRIPTOR_BUFFER_REGION_COUNT);
+        return NULL;
+    }
+
+    TLVK_DescriptorAllocator_t *allocator = &renderer_system->descriptor_allocator;
+    TLVK_DescriptorBuffer_t *buffer = &allocator->buffer;
+
+    if (buffer->vk_buffer == VK_NULL_HANDLE) {
+        TL_Error(debugger, "TLVK_DescriptorAllocatorAllocateBuffer: renderer system %p has no descriptor buffer", renderer_system);
+        return NULL;
+    }
+
+    VkDeviceSize alignment = buffer->properties.descriptorBufferOffsetAlignment;
+    void *ret = NULL;
+
+    TL_MutexLock(&allocator->lock);
+
+    VkDeviceSize head = buffer->heads[frame];
+    if (alignment > 1 && head % alignment) {
+        head += alignment - head % alignment;
+    }
+
+    // unlike pools, the region of a frame cannot grow, as the buffer's address is bound to command buffers that may still be executing
+    if (head <= buffer->frame_size && size <= buffer->frame_size - head) {
+        buffer->heads[frame] = head + size;
+
+        *out_offset = buffer->frame_size * frame + head;
+        ret = buffer->mapped + *out_offset;
+    }
+
+    TL_MutexUnlock(&allocator->lock);
+
+    if (!ret) {
+        TL_Error(debugger, "TLVK_DescriptorAllocatorAllocateBuffer: the descriptor buffer region of frame %u is full (%llu bytes)", frame,
+            (unsigned long long) buffer->frame_size);
+    }
+
+    return ret;
+}
+
+bool TLVK_DescriptorAllocatorResetFrame(TLVK_RendererSystem_t *const renderer_system, const uint32_t frame) {
+    if (!renderer_system) {
+        return false;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    TLVK_DescriptorAllocator_t *allocator = &renderer_system->descriptor_allocator;
+
+    bool ret = true;
+
+    TL_MutexLock(&allocator->lock);
+
+    // a frame that never allocated sets has no pool list
+    if (frame < allocator->frame_count) {
+        TLVK_DescriptorPoolList_t *list = &allocator->frames[frame];
+
+        // only pools up to the current one can hold sets
+        uint32_t used_count = (list->current < list->count) ? list->current + 1 : list->count;
+
+        for (uint32_t p = 0; p < used_count; p++) {
+            if (renderer_system->devfs.vkResetDescriptorPool(renderer_system->vk_logical_device, list->pools[p], 0)) {
+                TL_Error(debugger, "Failed to reset Vulkan descriptor pool %u of frame %u", p, frame);
+                ret = false;
+            }
+        }
+
+        list->current = 0;
+    }
+
+    if (frame < TLVK_DESCRIPTOR_BUFFER_REGION_COUNT) {
+        allocator->buffer.heads[frame] = 0;
+    }
+
+    TL_MutexUnlock(&allocator->lock);
+
+    return ret;
+}
+
+
+static VkDescriptorPool __GetPool(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorPoolList_t *const list) {
+    if (list->current < list->count) {
+        return list->pools[list->current];
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    if (list->count == list->capacity) {
+        uint32_t capacity = (list->capacity) ? list->capacity * 2 : 4;
+
+        VkDescriptorPool *pools = realloc(list->pools, sizeof(VkDescriptorPool) * capacity);
+        if (!pools) {
+            TL_Fatal(debugger, "MALLOC fault in call to TLVK_DescriptorAllocatorAllocate");
+            return VK_NULL_HANDLE;
+        }
+
+        list->pools = pools;
+        list->capacity = capacity;
+    }
+
+    // each new pool of a frame is twice as large as the last, so a frame needs few pools even if it allocates many sets
+    uint32_t set_count = __MIN_POOL_SET_COUNT;
+    for (uint32_t i = 0; i < list->count && set_count < __MAX_POOL_SET_COUNT; i++) {
+        set_count *= 2;
+    }
+
+    VkDescriptorPoolSize sizes[__POOL_RATIO_COUNT];
+    for (uint32_t i = 0; i < __POOL_RATIO_COUNT; i++) {
+        sizes[i].type = __POOL_RATIOS[i].type;
+        sizes[i].descriptorCount = (uint32_t) (__POOL_RATIOS[i].descriptors_per_set * (float) set_count);
+    }
+
+    VkDescriptorPoolCreateInfo pool_info;
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.pNext = NULL;
+    pool_info.flags = 0;
+    pool_info.maxSets = set_count;
+    pool_info.poolSizeCount = __POOL_RATIO_COUNT;
+    pool_info.pPoolSizes = sizes;
+
+    VkDescriptorPool pool;
+    if (renderer_system->devfs.vkCreateDescriptorPool(renderer_system->vk_logical_device, &pool_info, NULL, &pool)) {
+        TL_Error(debugger, "Failed to create Vulkan descriptor pool");
+        return VK_NULL_HANDLE;
+    }
+
+    TL_Log(debugger, "Created Vulkan descriptor pool %u for up to %u descriptor sets", list->count, set_count);
+
+    list->pools[list->count++] = pool;
+
+    return pool;
+}
+
+static TLVK_DescriptorPoolList_t *__GetFrameList(TLVK_RendererSystem_t *const renderer_system, const uint32_t frame) {
+    TLVK_DescriptorAllocator_t *allocator = &renderer_system->descriptor_allocator;
+
+    if (frame < allocator->frame_count) {
+        return &allocator->frames[frame];
+    }
+
+    // frame indices are handed out lowest first by the frame timeline, so the array only grows as far as the most frames ever in flight at once
+    TLVK_DescriptorPoolList_t *frames = realloc(allocator->frames, sizeof(TLVK_DescriptorPoolList_t) * (frame + 1));
+    if (!frames) {
+        TL_Fatal(renderer_system->renderer->debugger, "MALLOC fault in call to TLVK_DescriptorAllocatorAllocate");
+        return NULL;
+    }
+
+    for (uint32_t i = allocator->frame_count; i <= frame; i++) {
+        frames[i] = (TLVK_DescriptorPoolList_t) { 0 };
+    }
+
+    allocator->frames = frames;
+    allocator->frame_count = frame + 1;
+
+    return &frames[frame];
+}
+
+static bool __FindBufferMemoryType(const VkPhysicalDevice physical_device, const uint32_t type_bits, uint32_t *const out_index) {
+    VkPhysicalDeviceMemoryProperties properties;
+    vkGetPhysicalDeviceMemoryProperties(physical_device, &properties);
+
+    const VkMemoryPropertyFlags required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    // device-local memory that the host can write to directly is preferred, as the device reads descriptors far more often than they are written
+    bool found = false;
+    for (uint32_t i = 0; i < properties.memoryTypeCount; i++) {
+        VkMemoryPropertyFlags flags = properties.memoryTypes[i].propertyFlags;
+
+        if (!(type_bits & (1u << i)) || (flags & required) != required) {
+            continue;
+        }
+
+        if (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+            *out_index = i;
+            return true;
+        }
+
+        if (!found) {
+            *out_index = i;
+            found = true;
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,114 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_descriptor_allocator_h__
+#define __TL__internal__vulkan__vk_descriptor_allocator_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#include "types/vulkan/vk_descriptor_allocator_t.h"
+
+/**
+ * @brief Initialise the per-frame descriptor allocator of the given renderer system.
+ *
+ * No descriptor pools are created until sets are first allocated.
+ *
+ * @param renderer_system Renderer system whose allocator to initialise
+ */
+void TLVK_DescriptorAllocatorInit(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Create the descriptor buffer of the per-frame descriptor allocator of the given renderer system.
+ *
+ * This function creates a host-visible buffer with `TLVK_DESCRIPTOR_BUFFER_REGION_COUNT` regions, one for each of the lowest frame indices, which
+ * descriptors are written to directly by pipeline layouts created for descriptor buffers. The renderer system's device must have been created with
+ * the `descriptor_buffers` feature enabled.
+ *
+ * @param renderer_system Renderer system whose allocator to create the buffer for (its allocator must have been initialised)
+ * @return False if there were errors, in which case the allocator is left without a buffer
+ */
+bool TLVK_DescriptorAllocatorCreateBuffer(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Destroy every descriptor pool, and the descriptor buffer, of the per-frame descriptor allocator of the given renderer system.
+ *
+ * Every descriptor set allocated from the allocator is freed with its pool or buffer, so none of them may still be in use by the device.
+ *
+ * @param renderer_system Renderer system whose allocator to destroy
+ */
+void TLVK_DescriptorAllocatorDestroy(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Allocate a descriptor set that lives until the given frame retires.
+ *
+ * This function allocates a descriptor set with the given layout from the pools of frame `frame`. Sets are allocated linearly, moving on to the next
+ * pool (and creating a larger one if there is none) when the current pool runs out - there is no way to free an individual set, as every set of the
+ * frame is freed at once by @ref TLVK_DescriptorAllocatorResetFrame(). This function is thread-safe.
+ *
+ * @param renderer_system Renderer system to allocate under
+ * @param frame Index of the frame in flight to allocate for, as given by the renderer system's frame timeline
+ * @param set_layout Layout of the descriptor set to allocate
+ * @return The new descriptor set, or VK_NULL_HANDLE if there were errors
+ */
+VkDescriptorSet TLVK_DescriptorAllocatorAllocate(
+    TLVK_RendererSystem_t *const renderer_system,
+    const uint32_t frame,
+    const VkDescriptorSetLayout set_layout
+);
+
+/**
+ * @brief Reserve space for a descriptor set in the region of the descriptor buffer of the given frame.
+ *
+ * This function reserves `size` bytes, aligned to the device's `descriptorBufferOffsetAlignment`, in the region of frame `frame` of the
+ * allocator's descriptor buffer. Like sets allocated from pools, the space is reserved linearly and only freed once the frame is reset by
+ * @ref TLVK_DescriptorAllocatorResetFrame(). This function is thread-safe.
+ *
+ * @param renderer_system Renderer system to allocate under (its allocator must have a descriptor buffer)
+ * @param frame Index of the frame in flight to allocate for (less than `TLVK_DESCRIPTOR_BUFFER_REGION_COUNT`)
+ * @param size Size in bytes of the descriptor set layout, as given by `vkGetDescriptorSetLayoutSizeEXT`
+ * @param out_offset Pointer to populate with the offset of the reserved space from the start of the buffer
+ * @return A host pointer to the reserved space, or NULL if there were errors (e.g. the region of the frame is full)
+ */
+void *TLVK_DescriptorAllocatorAllocateBuffer(
+    TLVK_RendererSystem_t *const renderer_system,
+    const uint32_t frame,
+    const VkDeviceSize size,
+    VkDeviceSize *const out_offset
+);
+
+/**
+ * @brief Free every descriptor set allocated for the given frame.
+ *
+ * This function resets each pool that the frame allocated sets from with a single `vkResetDescriptorPool` call, keeping the pools for reuse by later
+ * allocations for the same frame, and rewinds the frame's region of the descriptor buffer. It must only be called once the device has finished
+ * executing every command buffer that uses the frame's sets, which the renderer system's frame timeline does when retiring the frame. This function
+ * is thread-safe.
+ *
+ * @param renderer_system Renderer system whose allocator to reset
+ * @param frame Index of the frame to reset, as given by the renderer system's frame timeline
+ * @return False if there were errors
+ */
+bool TLVK_DescriptorAllocatorResetFrame(
+    TLVK_RendererSystem_t *const renderer_system,
+    const uint32_t frame
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -9,7 +9,7 @@
 
 #include "lib/vulkan/vk_context_block.h"
 #include "types/vulkan/vk_renderer_system_t.h"
-#include "utils/io/log.h"
+#include "utils/utils.h"
 
 #include <volk/volk.h>
 
@@ -70,6 +70,21 @@ static void __EnumerateRequiredExtensions(const TL_RendererFeatures_t requiremen
 static void __UpdateRendererFeaturesWithSupported(TL_RendererFeatures_t *const features, carray_t extensions,
     const VkPhysicalDeviceFeatures *device_feats, const TL_Debugger_t *const debugger);
 
+static void __UpdateRendererFeaturesWithLoaded(TL_RendererFeatures_t *const features, const TLVK_FuncSet_t *const funcset,
+    const TL_Debugger_t *const debugger);
+
+static bool __HasExtension(const carray_t extensions, const char *const name);
+
+static bool __HasDescriptorIndexingFeatures(const VkPhysicalDevice physical_device,
+    const VkPhysicalDeviceDescriptorIndexingFeatures *const required);
+
+static bool __HasDescriptorBufferFeatures(const VkPhysicalDevice physical_device, bool *const out_push_descriptors);
+
+static bool __HasPresentWaitFeatures(const VkPhysicalDevice physical_device);
+
+static bool __HasExtendedDynamicStateFeatures(const VkPhysicalDevice physical_device, const carray_t extensions, bool *const out_eds,
+    bool *const out_eds2);
+
 static VkPhysicalDeviceFeatures __ValidateDeviceFeatures(const VkPhysicalDevice physical_device, VkPhysicalDeviceFeatures features,
     bool *const out_missing_flag, const TL_Debugger_t *const debugger);
 
@@ -90,6 +105,49 @@ VkDevice TLVK_LogicalDeviceCreate(const VkPhysicalDevice physical_device, const
 
     __UpdateRendererFeaturesWithSupported(out_rfeatures, extensions, &features, debugger);
 
+    // descriptor indexing features needed by the bindless table - shaders index its arrays non-uniformly, and descriptors are written while the
+    // table is bound
+    VkPhysicalDeviceDescriptorIndexingFeatures di_features = { 0 };
+    di_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    di_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    di_features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+    di_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    di_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    di_features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    di_features.descriptorBindingPartiallyBound = VK_TRUE;
+    di_features.runtimeDescriptorArray = VK_TRUE;
+
+    if (out_rfeatures->bindless_resources && !__HasDescriptorIndexingFeatures(physical_device, &di_features)) {
+        out_rfeatures->bindless_resources = false;
+        TL_Error(debugger,
+            "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device features) - 'bindless_resources' was disabled!");
+    }
+
+    // descriptor buffer features - push descriptor sets can only be used alongside descriptor buffers if the device supports it, otherwise
+    // pipelines with a push descriptor set keep using descriptor pools
+    bool db_push_descriptors = false;
+    if (out_rfeatures->descriptor_buffers && !__HasDescriptorBufferFeatures(physical_device, &db_push_descriptors)) {
+        out_rfeatures->descriptor_buffers = false;
+        TL_Error(debugger,
+            "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device features) - 'descriptor_buffers' was disabled!");
+    }
+
+    // extended dynamic state features - only the EXT extensions that expose their feature bit have it enabled, as Vulkan 1.3 devices provide the
+    // same commands in core with no feature to enable
+    bool eds_enable = false;
+    bool eds2_enable = false;
+    if (out_rfeatures->extended_dynamic_state && !__HasExtendedDynamicStateFeatures(physical_device, extensions, &eds_enable, &eds2_enable)) {
+        out_rfeatures->extended_dynamic_state = false;
+        TL_Error(debugger,
+            "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device features) - 'extended_dynamic_state' was disabled!");
+    }
+
+    if (out_rfeatures->frame_pacing && !__HasPresentWaitFeatures(physical_device)) {
+        out_rfeatures->frame_pacing = false;
+        TL_Error(debugger,
+            "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device features) - 'frame_pacing' was disabled!");
+    }
+
     VkDeviceCreateInfo device_create_info;
     device_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     device_create_info.pNext = NULL;
@@ -104,6 +162,54 @@ VkDevice TLVK_LogicalDeviceCreate(const VkPhysicalDevice physical_device, const
 
     device_create_info.pEnabledFeatures = &features;
 
+    // extension feature structs - these must outlive the vkCreateDevice call below
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT eds_features = { 0 };
+    eds_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+    eds_features.extendedDynamicState = VK_TRUE;
+    VkPhysicalDeviceExtendedDynamicState2FeaturesEXT eds2_features = { 0 };
+    eds2_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+    eds2_features.extendedDynamicState2 = VK_TRUE;
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT gpl_features = { 0 };
+    gpl_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+    gpl_features.graphicsPipelineLibrary = VK_TRUE;
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT db_features = { 0 };
+    db_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+    db_features.descriptorBuffer = VK_TRUE;
+    db_features.descriptorBufferPushDescriptors = (out_rfeatures->push_descriptors && db_push_descriptors) ? VK_TRUE : VK_FALSE;
+    VkPhysicalDeviceBufferDeviceAddressFeatures bda_features = { 0 };
+    bda_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    bda_features.bufferDeviceAddress = VK_TRUE;
+    VkPhysicalDevicePresentIdFeaturesKHR pid_features = { 0 };
+    pid_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    pid_features.presentId = VK_TRUE;
+    VkPhysicalDevicePresentWaitFeaturesKHR pw_features = { 0 };
+    pw_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+    pw_features.presentWait = VK_TRUE;
+
+    // the extended dynamic state extensions must have their features enabled explicitly (the Vulkan 1.3 core equivalents need no enabling)
+    if (out_rfeatures->extended_dynamic_state) {
+        if (eds_enable) {
+            TLVK_AppendPNext(&device_create_info.pNext, &eds_features);
+        }
+        if (eds2_enable) {
+            TLVK_AppendPNext(&device_create_info.pNext, &eds2_features);
+        }
+    }
+    if (out_rfeatures->pipeline_libraries) {
+        TLVK_AppendPNext(&device_create_info.pNext, &gpl_features);
+    }
+    if (out_rfeatures->bindless_resources) {
+        TLVK_AppendPNext(&device_create_info.pNext, &di_features);
+    }
+    if (out_rfeatures->descriptor_buffers) {
+        TLVK_AppendPNext(&device_create_info.pNext, &db_features);
+        TLVK_AppendPNext(&device_create_info.pNext, &bda_features);
+    }
+    if (out_rfeatures->frame_pacing) {
+        TLVK_AppendPNext(&device_create_info.pNext, &pid_features);
+        TLVK_AppendPNext(&device_create_info.pNext, &pw_features);
+    }
+
     // array of unique indices
     carray_t unique_family_indices = carraynew(6);
         carraypush(&unique_family_indices, queue_families.graphics);
@@ -177,6 +283,9 @@ VkDevice TLVK_LogicalDeviceCreate(const VkPhysicalDevice physical_device, const
     // load vulkan functions from the new device
     (*out_funcset) = TLVK_LoaderFuncSetLoad(device);
 
+    // some features can only be confirmed once their functions have been loaded
+    __UpdateRendererFeaturesWithLoaded(out_rfeatures, out_funcset, debugger);
+
     if (out_queues) {
         // init arrays to be empty
         out_queues->graphics.size = 0;
@@ -437,6 +546,58 @@ static void __EnumerateRequiredExtensions(const TL_RendererFeatures_t requiremen
         __DEFINE_REQUIRED_EXTENSION(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
     }
 
+    // renderers with extended dynamic state
+    if (requirements.extended_dynamic_state) {
+        // these are promoted to Vulkan 1.3, but are still requested so that older devices and drivers can provide them
+        __DEFINE_REQUIRED_EXTENSION(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+        __DEFINE_REQUIRED_EXTENSION(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+    }
+
+    // renderers with graphics pipeline libraries
+    if (requirements.pipeline_libraries) {
+        __DEFINE_REQUIRED_EXTENSION(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+        __DEFINE_REQUIRED_EXTENSION(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    }
+
+    // renderers with pipeline creation feedback
+    if (requirements.pipeline_creation_feedback) {
+        // promoted to Vulkan 1.3, but still requested so that older devices and drivers can provide it
+        __DEFINE_REQUIRED_EXTENSION(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+    }
+
+    // renderers with push descriptors
+    if (requirements.push_descriptors) {
+        __DEFINE_REQUIRED_EXTENSION(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    }
+
+    // renderers with a bindless resource table
+    if (requirements.bindless_resources) {
+        // promoted to Vulkan 1.2 (and its maintenance3 dependency to Vulkan 1.1), but still requested so that older devices and drivers can
+        // provide them
+        __DEFINE_REQUIRED_EXTENSION(VK_KHR_MAINTENANCE_3_EXTENSION_NAME);
+        __DEFINE_REQUIRED_EXTENSION(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    }
+
+    // renderers with descriptor buffers
+    if (requirements.descriptor_buffers) {
+        __DEFINE_REQUIRED_EXTENSION(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+
+        // dependencies of VK_EXT_descriptor_buffer - all promoted to core, but still requested so that older devices and drivers can provide
+        // them (the descriptor indexing ones are already requested for a bindless table)
+        __DEFINE_REQUIRED_EXTENSION(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+        __DEFINE_REQUIRED_EXTENSION(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+        if (!requirements.bindless_resources) {
+            __DEFINE_REQUIRED_EXTENSION(VK_KHR_MAINTENANCE_3_EXTENSION_NAME);
+            __DEFINE_REQUIRED_EXTENSION(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        }
+    }
+
+    // renderers with frame pacing
+    if (requirements.presentation && requirements.frame_pacing) {
+        __DEFINE_REQUIRED_EXTENSION(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        __DEFINE_REQUIRED_EXTENSION(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    }
+
     *out_extension_count = count_ret;
 }
 
@@ -469,6 +630,225 @@ static void __UpdateRendererFeaturesWithSupported(TL_RendererFeatures_t *const f
             features->wide_lines = false;
         }
     }
+
+    // pipeline_libraries feature availability
+    // (the graphicsPipelineLibrary device feature is mandatory when the extension is supported, so only the extensions are checked)
+    if (features->pipeline_libraries) {
+        bool pl =
+            __HasExtension(extensions, VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+            __HasExtension(extensions, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+        if (!pl) {
+            features->pipeline_libraries = false;
+            TL_Error(debugger,
+                "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device extensions) - 'pipeline_libraries' was disabled!");
+        }
+    }
+
+    // pipeline_creation_feedback feature availability
+    if (features->pipeline_creation_feedback) {
+        if (!__HasExtension(extensions, VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME)) {
+            features->pipeline_creation_feedback = false;
+            TL_Error(debugger,
+                "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device extensions) - 'pipeline_creation_feedback' was disabled!");
+        }
+    }
+
+    // push_descriptors feature availability
+    if (features->push_descriptors) {
+        if (!__HasExtension(extensions, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)) {
+            features->push_descriptors = false;
+            TL_Error(debugger,
+                "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device extensions) - 'push_descriptors' was disabled!");
+        }
+    }
+
+    // bindless_resources feature availability (the descriptor indexing device features are checked separately)
+    if (features->bindless_resources) {
+        bool br =
+            __HasExtension(extensions, VK_KHR_MAINTENANCE_3_EXTENSION_NAME) &&
+            __HasExtension(extensions, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+        if (!br) {
+            features->bindless_resources = false;
+            TL_Error(debugger,
+                "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device extensions) - 'bindless_resources' was disabled!");
+        }
+    }
+
+    // descriptor_buffers feature availability (the descriptor buffer device features are checked separately)
+    if (features->descriptor_buffers) {
+        bool db =
+            __HasExtension(extensions, VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) &&
+            __HasExtension(extensions, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME) &&
+            __HasExtension(extensions, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME) &&
+            __HasExtension(extensions, VK_KHR_MAINTENANCE_3_EXTENSION_NAME) &&
+            __HasExtension(extensions, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+        if (!db) {
+            features->descriptor_buffers = false;
+            TL_Error(debugger,
+                "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device extensions) - 'descriptor_buffers' was disabled!");
+        }
+    }
+
+    // frame_pacing feature availability (the present id and present wait device features are checked separately)
+    if (features->frame_pacing) {
+        bool fp =
+            features->presentation &&
+            __HasExtension(extensions, VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+            __HasExtension(extensions, VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+        if (!fp) {
+            features->frame_pacing = false;
+            TL_Error(debugger,
+                "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device extensions) - 'frame_pacing' was disabled!");
+        }
+    }
+}
+
+static void __UpdateRendererFeaturesWithLoaded(TL_RendererFeatures_t *const features, const TLVK_FuncSet_t *const funcset,
+    const TL_Debugger_t *const debugger)
+{
+    // extended_dynamic_state feature availability
+    // either the core 1.3 or the EXT entry points are enough; vkCmdSetPrimitiveRestartEnable is from the second extension, so both are checked.
+    if (features->extended_dynamic_state) {
+        bool eds = funcset->vkCmdSetCullMode || funcset->vkCmdSetCullModeEXT;
+        bool eds2 = funcset->vkCmdSetPrimitiveRestartEnable || funcset->vkCmdSetPrimitiveRestartEnableEXT;
+
+        if (!eds || !eds2) {
+            features->extended_dynamic_state = false;
+            TL_Error(debugger,
+                "When creating Vulkan device: RENDERER FEATURE UNAVAILABLE (missing device extensions) - 'extended_dynamic_state' was disabled!");
+        }
+    }
+}
+
+static bool __HasExtension(const carray_t extensions, const char *const name) {
+    for (uint32_t i = 0; i < extensions.size; i++) {
+        if (!strcmp((const char *) extensions.data[i], name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool __HasDescriptorIndexingFeatures(const VkPhysicalDevice physical_device,
+    const VkPhysicalDeviceDescriptorIndexingFeatures *const required)
+{
+    // vkGetPhysicalDeviceFeatures2 is core in Vulkan 1.1; otherwise the KHR extension version may have been loaded instead
+    PFN_vkGetPhysicalDeviceFeatures2 get_features = (vkGetPhysicalDeviceFeatures2) ? vkGetPhysicalDeviceFeatures2 : vkGetPhysicalDeviceFeatures2KHR;
+    if (!get_features) {
+        return false;
+    }
+
+    VkPhysicalDeviceDescriptorIndexingFeatures available = { 0 };
+    available.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features2 = { 0 };
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &available;
+
+    get_features(physical_device, &features2);
+
+    return
+        (!required->shaderSampledImageArrayNonUniformIndexing || available.shaderSampledImageArrayNonUniformIndexing) &&
+        (!required->shaderStorageBufferArrayNonUniformIndexing || available.shaderStorageBufferArrayNonUniformIndexing) &&
+        (!required->descriptorBindingSampledImageUpdateAfterBind || available.descriptorBindingSampledImageUpdateAfterBind) &&
+        (!required->descriptorBindingStorageBufferUpdateAfterBind || available.descriptorBindingStorageBufferUpdateAfterBind) &&
+        (!required->descriptorBindingUpdateUnusedWhilePending || available.descriptorBindingUpdateUnusedWhilePending) &&
+        (!required->descriptorBindingPartiallyBound || available.descriptorBindingPartiallyBound) &&
+        (!required->runtimeDescriptorArray || available.runtimeDescriptorArray);
+}
+
+static bool __HasDescriptorBufferFeatures(const VkPhysicalDevice physical_device, bool *const out_push_descriptors) {
+    PFN_vkGetPhysicalDeviceFeatures2 get_features = (vkGetPhysicalDeviceFeatures2) ? vkGetPhysicalDeviceFeatures2 : vkGetPhysicalDeviceFeatures2KHR;
+    if (!get_features) {
+        return false;
+    }
+
+    VkPhysicalDeviceBufferDeviceAddressFeatures bda_available = { 0 };
+    bda_available.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT db_available = { 0 };
+    db_available.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+    db_available.pNext = &bda_available;
+
+    VkPhysicalDeviceFeatures2 features2 = { 0 };
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &db_available;
+
+    get_features(physical_device, &features2);
+
+    *out_push_descriptors = db_available.descriptorBufferPushDescriptors;
+
+    return db_available.descriptorBuffer && bda_available.bufferDeviceAddress;
+}
+
+static bool __HasPresentWaitFeatures(const VkPhysicalDevice physical_device) {
+    PFN_vkGetPhysicalDeviceFeatures2 get_features = (vkGetPhysicalDeviceFeatures2) ? vkGetPhysicalDeviceFeatures2 : vkGetPhysicalDeviceFeatures2KHR;
+    if (!get_features) {
+        return false;
+    }
+
+    VkPhysicalDevicePresentWaitFeaturesKHR pw_available = { 0 };
+    pw_available.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+    VkPhysicalDevicePresentIdFeaturesKHR pid_available = { 0 };
+    pid_available.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    pid_available.pNext = &pw_available;
+
+    VkPhysicalDeviceFeatures2 features2 = { 0 };
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &pid_available;
+
+    get_features(physical_device, &features2);
+
+    return pid_available.presentId && pw_available.presentWait;
+}
+
+static bool __HasExtendedDynamicStateFeatures(const VkPhysicalDevice physical_device, const carray_t extensions, bool *const out_eds,
+    bool *const out_eds2)
+{
+    PFN_vkGetPhysicalDeviceFeatures2 get_features = (vkGetPhysicalDeviceFeatures2) ? vkGetPhysicalDeviceFeatures2 : vkGetPhysicalDeviceFeatures2KHR;
+    if (!get_features) {
+        return false;
+    }
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physical_device, &props);
+
+    VkPhysicalDeviceExtendedDynamicState2FeaturesEXT eds2_available = { 0 };
+    eds2_available.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT eds_available = { 0 };
+    eds_available.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2 features2 = { 0 };
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+    // extension feature structs may only be chained if their extension is supported
+    if (__HasExtension(extensions, VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME)) {
+        eds2_available.pNext = features2.pNext;
+        features2.pNext = &eds2_available;
+    }
+    if (__HasExtension(extensions, VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME)) {
+        eds_available.pNext = features2.pNext;
+        features2.pNext = &eds_available;
+    }
+
+    get_features(physical_device, &features2);
+
+    *out_eds = eds_available.extendedDynamicState;
+    *out_eds2 = eds2_available.extendedDynamicState2;
+
+    // Vulkan 1.3 devices support every command used by the renderer in core, whether or not the extension features are exposed
+    if (VK_API_VERSION_MINOR(props.apiVersion) >= 3 || VK_API_VERSION_MAJOR(props.apiVersion) > 1) {
+        return true;
+    }
+
+    return *out_eds && *out_eds2;
 }
 
 static VkPhysicalDeviceFeatures __ValidateDeviceFeatures(const VkPhysicalDevice physical_device, VkPhysicalDeviceFeatures features,
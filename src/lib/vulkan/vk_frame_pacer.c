@@ -0,0 +1,241 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "vk_frame_pacer.h"
+
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include <stdlib.h>
+
+// longest time the pacing thread blocks waiting on one present, so that it notices swapchain changes and shutdown in a timely manner
+#define __PRESENT_WAIT_TIMEOUT_NS 100000000ull
+
+// measurements older than this many refresh intervals are not trusted to predict the next vertical blank (e.g. after the application paused)
+#define __MAX_STALE_INTERVALS 64
+
+static void __PacerMain(void *arg);
+
+// fold `sample` into the running average `average` with a weight of 1/8.
+static uint64_t __Average(const uint64_t average, const uint64_t sample);
+
+
+TLVK_FramePacer_t *TLVK_FramePacerCreate(const TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    if (!renderer_system->devfs.vkWaitForPresentKHR) {
+        TL_Error(debugger, "Attempted to create a Vulkan frame pacer without vkWaitForPresentKHR (is the 'frame_pacing' feature enabled?)");
+        return NULL;
+    }
+
+    TLVK_FramePacer_t *pacer = calloc(1, sizeof(TLVK_FramePacer_t));
+    if (!pacer) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_FramePacerCreate");
+        return NULL;
+    }
+
+    pacer->renderer_system = renderer_system;
+    pacer->running = true;
+    pacer->vk_swapchain = VK_NULL_HANDLE;
+    pacer->vk_waiting_swapchain = VK_NULL_HANDLE;
+
+    if (!TL_MutexInit(&pacer->lock)) {
+        TL_Error(debugger, "Failed to initialise lock of Vulkan frame pacer %p", pacer);
+
+        free(pacer);
+        return NULL;
+    }
+
+    if (!TL_CondInit(&pacer->wake)) {
+        TL_Error(debugger, "Failed to initialise condition variable of Vulkan frame pacer %p", pacer);
+
+        TL_MutexDestroy(&pacer->lock);
+        free(pacer);
+        return NULL;
+    }
+
+    if (!TL_ThreadCreate(&pacer->thread, __PacerMain, pacer)) {
+        TL_Error(debugger, "Failed to start pacing thread of Vulkan frame pacer %p", pacer);
+
+        TL_CondDestroy(&pacer->wake);
+        TL_MutexDestroy(&pacer->lock);
+        free(pacer);
+
+        return NULL;
+    }
+
+    TL_Log(debugger, "Created Vulkan frame pacer at %p", pacer);
+
+    return pacer;
+}
+
+void TLVK_FramePacerDestroy(TLVK_FramePacer_t *const pacer) {
+    if (!pacer) {
+        return;
+    }
+
+    TL_MutexLock(&pacer->lock);
+    pacer->running = false;
+    TL_CondBroadcast(&pacer->wake);
+    TL_MutexUnlock(&pacer->lock);
+
+    // the thread never blocks on a present for longer than __PRESENT_WAIT_TIMEOUT_NS, so this cannot hang
+    TL_ThreadJoin(&pacer->thread);
+
+    TL_CondDestroy(&pacer->wake);
+    TL_MutexDestroy(&pacer->lock);
+
+    free(pacer);
+}
+
+void TLVK_FramePacerSetSwapchain(TLVK_FramePacer_t *const pacer, const VkSwapchainKHR swapchain) {
+    if (!pacer) {
+        return;
+    }
+
+    TL_MutexLock(&pacer->lock);
+
+    pacer->vk_swapchain = swapchain;
+
+    // present IDs keep increasing across swapchains, so dropping the pending ones is all it takes to stop waiting on the old swapchain
+    pacer->completed_id = pacer->queued_id;
+
+    TL_MutexUnlock(&pacer->lock);
+}
+
+bool TLVK_FramePacerIsWaitingOn(TLVK_FramePacer_t *const pacer, const VkSwapchainKHR swapchain) {
+    if (!pacer) {
+        return false;
+    }
+
+    TL_MutexLock(&pacer->lock);
+    bool waiting = (pacer->vk_waiting_swapchain == swapchain);
+    TL_MutexUnlock(&pacer->lock);
+
+    return waiting;
+}
+
+void TLVK_FramePacerWait(TLVK_FramePacer_t *const pacer, const uint64_t present_id) {
+    if (!pacer) {
+        return;
+    }
+
+    TL_MutexLock(&pacer->lock);
+
+    uint64_t now = TL_GetMonotonicTime();
+    uint64_t start = now;
+
+    uint64_t interval = pacer->refresh_interval;
+    uint64_t latency = pacer->frame_latency;
+    uint64_t last = pacer->completed_time;
+
+    if (interval && latency && last && now - last < interval * __MAX_STALE_INTERVALS) {
+        // a little slack absorbs jitter in the measured latency
+        uint64_t lead = latency + interval / 8;
+
+        // vertical blanks are assumed to continue at the measured interval from the last one a present was displayed at, so the earliest one a
+        // frame beginning now can make is found by rounding up to the next multiple of the interval
+        uint64_t reachable = now + lead;
+        uint64_t vblank = last + ((reachable - last + interval - 1) / interval) * interval;
+
+        start = vblank - lead;
+    }
+
+    pacer->begin_times[present_id % TLVK_FRAME_PACER_HISTORY] = start;
+
+    TL_MutexUnlock(&pacer->lock);
+
+    if (start > now) {
+        TL_SleepUntil(start);
+    }
+}
+
+void TLVK_FramePacerQueuePresent(TLVK_FramePacer_t *const pacer, const uint64_t present_id) {
+    if (!pacer) {
+        return;
+    }
+
+    TL_MutexLock(&pacer->lock);
+
+    if (present_id > pacer->queued_id) {
+        pacer->queued_id = present_id;
+        TL_CondBroadcast(&pacer->wake);
+    }
+
+    TL_MutexUnlock(&pacer->lock);
+}
+
+
+static void __PacerMain(void *arg) {
+    TLVK_FramePacer_t *pacer = (TLVK_FramePacer_t *) arg;
+
+    const TLVK_RendererSystem_t *renderersys = pacer->renderer_system;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    TL_MutexLock(&pacer->lock);
+
+    while (pacer->running) {
+        if (pacer->vk_swapchain == VK_NULL_HANDLE || pacer->completed_id >= pacer->queued_id) {
+            TL_CondWait(&pacer->wake, &pacer->lock);
+            continue;
+        }
+
+        // presents are waited on in order so that each one can be timed; waiting on an ID whose image was discarded (e.g. by mailbox
+        // presentation) returns once a later one has been displayed
+        VkSwapchainKHR swapchain = pacer->vk_swapchain;
+        uint64_t id = pacer->completed_id + 1;
+
+        pacer->vk_waiting_swapchain = swapchain;
+
+        TL_MutexUnlock(&pacer->lock);
+        VkResult result = renderersys->devfs.vkWaitForPresentKHR(dev, swapchain, id, __PRESENT_WAIT_TIMEOUT_NS);
+        uint64_t now = TL_GetMonotonicTime();
+        TL_MutexLock(&pacer->lock);
+
+        pacer->vk_waiting_swapchain = VK_NULL_HANDLE;
+
+        // the pending presents were dropped if the swapchain was replaced in the meantime
+        if (result == VK_TIMEOUT || swapchain != pacer->vk_swapchain || id <= pacer->completed_id) {
+            continue;
+        }
+
+        if (result == VK_SUCCESS) {
+            // consecutive presents are displayed at least one vertical blank apart; samples far above the estimate come from frames that missed
+            // a vertical blank, so they are left out of it
+            if (pacer->completed_time && id == pacer->completed_id + 1) {
+                uint64_t delta = now - pacer->completed_time;
+
+                if (!pacer->refresh_interval) {
+                    pacer->refresh_interval = delta;
+                } else if (delta < pacer->refresh_interval + pacer->refresh_interval / 2) {
+                    pacer->refresh_interval = __Average(pacer->refresh_interval, delta);
+                }
+            }
+
+            uint64_t begin = pacer->begin_times[id % TLVK_FRAME_PACER_HISTORY];
+            if (begin && begin < now) {
+                pacer->frame_latency = (pacer->frame_latency) ? __Average(pacer->frame_latency, now - begin) : now - begin;
+            }
+
+            pacer->completed_time = now;
+        }
+
+        // presents that failed (e.g. because the swapchain went out of date) are given up on
+        pacer->completed_id = id;
+    }
+
+    TL_MutexUnlock(&pacer->lock);
+}
+
+static uint64_t __Average(const uint64_t average, const uint64_t sample) {
+    return average - average / 8 + sample / 8;
+}
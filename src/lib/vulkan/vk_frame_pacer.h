@@ -0,0 +1,99 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_frame_pacer_h__
+#define __TL__internal__vulkan__vk_frame_pacer_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#include "types/vulkan/vk_frame_pacer_t.h"
+
+/**
+ * @brief Create a heap-allocated frame pacer and start its pacing thread.
+ *
+ * The renderer system's device must have been created with the `frame_pacing` feature enabled.
+ *
+ * @param renderer_system Renderer system whose device to wait on presents with
+ * @return The new frame pacer, or NULL if there were errors
+ */
+TLVK_FramePacer_t *TLVK_FramePacerCreate(
+    const TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Stop the pacing thread of the given frame pacer and free it.
+ *
+ * @param pacer Frame pacer to destroy
+ */
+void TLVK_FramePacerDestroy(
+    TLVK_FramePacer_t *const pacer
+);
+
+/**
+ * @brief Set the swapchain whose presents the given frame pacer waits on.
+ *
+ * Presents queued to the previous swapchain are no longer waited on (as waiting on presents of a retired swapchain is not allowed), but the timing
+ * measured from them is kept.
+ *
+ * @param pacer Frame pacer
+ * @param swapchain VK_NULL_HANDLE or the new swapchain
+ */
+void TLVK_FramePacerSetSwapchain(
+    TLVK_FramePacer_t *const pacer,
+    const VkSwapchainKHR swapchain
+);
+
+/**
+ * @brief Check whether the pacing thread of the given frame pacer is currently waiting on a present of the given swapchain.
+ *
+ * A swapchain must not be destroyed while this is the case.
+ *
+ * @param pacer Frame pacer
+ * @param swapchain Swapchain to check
+ * @return True if the swapchain is in use by the pacing thread
+ */
+bool TLVK_FramePacerIsWaitingOn(
+    TLVK_FramePacer_t *const pacer,
+    const VkSwapchainKHR swapchain
+);
+
+/**
+ * @brief Delay the calling thread until the latest time at which a frame can begin and still be displayed at the earliest vertical blank it can
+ * reach.
+ *
+ * The delay is derived from the measured refresh interval and the measured time frames take from beginning to being displayed, and is never longer
+ * than one refresh interval. No delay is made until enough presents have been displayed to measure both. The time at which this function returns is
+ * recorded as the begin time of the frame that will be presented with `present_id`.
+ *
+ * @param pacer Frame pacer
+ * @param present_id Present ID the frame about to begin will be presented with
+ */
+void TLVK_FramePacerWait(
+    TLVK_FramePacer_t *const pacer,
+    const uint64_t present_id
+);
+
+/**
+ * @brief Have the pacing thread of the given frame pacer wait for a present to be displayed.
+ *
+ * @param pacer Frame pacer
+ * @param present_id Present ID the image was queued for presentation with (to the pacer's current swapchain)
+ */
+void TLVK_FramePacerQueuePresent(
+    TLVK_FramePacer_t *const pacer,
+    const uint64_t present_id
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
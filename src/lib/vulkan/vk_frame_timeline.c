@@ -0,0 +1,229 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "vk_frame_timeline.h"
+
+#include "lib/vulkan/vk_bindless_table.h"
+#include "lib/vulkan/vk_descriptor_allocator.h"
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include <stdlib.h>
+
+
+// must be called with the timeline lock held
+static uint64_t __GetOldestSerial(const TLVK_FrameTimeline_t *const timeline);
+
+
+void TLVK_FrameTimelineInit(TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return;
+    }
+
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    timeline->serials = NULL;
+    timeline->slot_count = 0;
+    timeline->slot_capacity = 0;
+    timeline->holds = NULL;
+    timeline->hold_count = 0;
+    timeline->hold_capacity = 0;
+    timeline->last_serial = 0;
+
+    TL_MutexInit(&timeline->lock);
+}
+
+void TLVK_FrameTimelineDestroy(TLVK_RendererSystem_t *const renderer_system) {
+    if (!renderer_system) {
+        return;
+    }
+
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    free(timeline->serials);
+    timeline->serials = NULL;
+    timeline->slot_count = 0;
+    timeline->slot_capacity = 0;
+
+    free(timeline->holds);
+    timeline->holds = NULL;
+    timeline->hold_count = 0;
+    timeline->hold_capacity = 0;
+
+    TL_MutexDestroy(&timeline->lock);
+}
+
+bool TLVK_FrameTimelineBeginFrame(TLVK_RendererSystem_t *const renderer_system, uint32_t *const out_frame) {
+    if (!renderer_system || !out_frame) {
+        return false;
+    }
+
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    bool ret = true;
+
+    TL_MutexLock(&timeline->lock);
+
+    uint32_t frame = 0;
+    while (frame < timeline->slot_count && timeline->serials[frame]) {
+        frame++;
+    }
+
+    if (frame == timeline->slot_count) {
+        if (timeline->slot_count == timeline->slot_capacity) {
+            uint32_t capacity = (timeline->slot_capacity) ? timeline->slot_capacity * 2 : 4;
+
+            uint64_t *serials = realloc(timeline->serials, sizeof(uint64_t) * capacity);
+            if (!serials) {
+                TL_Fatal(renderer_system->renderer->debugger, "MALLOC fault in call to TLVK_FrameTimelineBeginFrame");
+                ret = false;
+                goto out;
+            }
+
+            timeline->serials = serials;
+            timeline->slot_capacity = capacity;
+        }
+
+        timeline->slot_count++;
+    }
+
+    timeline->serials[frame] = ++timeline->last_serial;
+    *out_frame = frame;
+
+out:
+    TL_MutexUnlock(&timeline->lock);
+
+    return ret;
+}
+
+void TLVK_FrameTimelineRetireFrame(TLVK_RendererSystem_t *const renderer_system, const uint32_t frame) {
+    if (!renderer_system) {
+        return;
+    }
+
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    TL_MutexLock(&timeline->lock);
+
+    if (frame >= timeline->slot_count || !timeline->serials[frame]) {
+        TL_MutexUnlock(&timeline->lock);
+        TL_Error(renderer_system->renderer->debugger, "TLVK_FrameTimelineRetireFrame: frame %u is not in flight", frame);
+        return;
+    }
+
+    // the slot stays claimed until the frame's descriptor sets are freed, so that no frame that reuses the index can allocate sets before then
+    TLVK_DescriptorAllocatorResetFrame(renderer_system, frame);
+
+    timeline->serials[frame] = 0;
+    uint64_t oldest = __GetOldestSerial(timeline);
+
+    TL_MutexUnlock(&timeline->lock);
+
+    TLVK_BindlessTableCollect(renderer_system->bindless_table, oldest);
+}
+
+bool TLVK_FrameTimelineHoldSerial(TLVK_RendererSystem_t *const renderer_system, uint64_t *const out_serial) {
+    if (!renderer_system || !out_serial) {
+        return false;
+    }
+
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    bool ret = true;
+
+    TL_MutexLock(&timeline->lock);
+
+    if (timeline->hold_count == timeline->hold_capacity) {
+        uint32_t capacity = (timeline->hold_capacity) ? timeline->hold_capacity * 2 : 4;
+
+        uint64_t *holds = realloc(timeline->holds, sizeof(uint64_t) * capacity);
+        if (!holds) {
+            TL_Fatal(renderer_system->renderer->debugger, "MALLOC fault in call to TLVK_FrameTimelineHoldSerial");
+            ret = false;
+            goto out;
+        }
+
+        timeline->holds = holds;
+        timeline->hold_capacity = capacity;
+    }
+
+    timeline->holds[timeline->hold_count++] = ++timeline->last_serial;
+    *out_serial = timeline->last_serial;
+
+out:
+    TL_MutexUnlock(&timeline->lock);
+
+    return ret;
+}
+
+void TLVK_FrameTimelineReleaseSerial(TLVK_RendererSystem_t *const renderer_system, const uint64_t serial) {
+    if (!renderer_system) {
+        return;
+    }
+
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    TL_MutexLock(&timeline->lock);
+
+    uint32_t i = 0;
+    while (i < timeline->hold_count && timeline->holds[i] != serial) {
+        i++;
+    }
+
+    if (i == timeline->hold_count) {
+        TL_MutexUnlock(&timeline->lock);
+        TL_Error(renderer_system->renderer->debugger, "TLVK_FrameTimelineReleaseSerial: serial %llu is not held", (unsigned long long) serial);
+        return;
+    }
+
+    // holds are unordered, so the last one can fill the gap
+    timeline->holds[i] = timeline->holds[--timeline->hold_count];
+    uint64_t oldest = __GetOldestSerial(timeline);
+
+    TL_MutexUnlock(&timeline->lock);
+
+    TLVK_BindlessTableCollect(renderer_system->bindless_table, oldest);
+}
+
+uint64_t TLVK_FrameTimelineGetLastSerial(TLVK_RendererSystem_t *const renderer_system) {
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    TL_MutexLock(&timeline->lock);
+    uint64_t ret = timeline->last_serial;
+    TL_MutexUnlock(&timeline->lock);
+
+    return ret;
+}
+
+uint64_t TLVK_FrameTimelineGetOldestSerial(TLVK_RendererSystem_t *const renderer_system) {
+    TLVK_FrameTimeline_t *timeline = &renderer_system->frame_timeline;
+
+    TL_MutexLock(&timeline->lock);
+    uint64_t ret = __GetOldestSerial(timeline);
+    TL_MutexUnlock(&timeline->lock);
+
+    return ret;
+}
+
+
+static uint64_t __GetOldestSerial(const TLVK_FrameTimeline_t *const timeline) {
+    uint64_t oldest = timeline->last_serial + 1;
+
+    for (uint32_t i = 0; i < timeline->slot_count; i++) {
+        if (timeline->serials[i] && timeline->serials[i] < oldest) {
+            oldest = timeline->serials[i];
+        }
+    }
+    for (uint32_t i = 0; i < timeline->hold_count; i++) {
+        if (timeline->holds[i] < oldest) {
+            oldest = timeline->holds[i];
+        }
+    }
+
+    return oldest;
+}
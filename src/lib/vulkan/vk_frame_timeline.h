@@ -0,0 +1,123 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_frame_timeline_h__
+#define __TL__internal__vulkan__vk_frame_timeline_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#include "types/vulkan/vk_frame_timeline_t.h"
+
+/**
+ * @brief Initialise the frame timeline of the given renderer system.
+ *
+ * @param renderer_system Renderer system whose timeline to initialise
+ */
+void TLVK_FrameTimelineInit(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Free the frame timeline of the given renderer system. Every frame begun on it should have been retired.
+ *
+ * @param renderer_system Renderer system whose timeline to free
+ */
+void TLVK_FrameTimelineDestroy(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Begin a new frame on the frame timeline of the given renderer system.
+ *
+ * This function claims the lowest free frame slot, so that frame indices stay small however many swapchains and render target chains are in use,
+ * and gives the frame the next serial. This function is thread-safe.
+ *
+ * @param renderer_system Renderer system whose timeline to begin a frame on
+ * @param out_frame Pointer to populate with the index of the frame's slot
+ * @return False if there were errors
+ */
+bool TLVK_FrameTimelineBeginFrame(
+    TLVK_RendererSystem_t *const renderer_system,
+    uint32_t *const out_frame
+);
+
+/**
+ * @brief Retire a frame of the frame timeline of the given renderer system, freeing its slot for later frames.
+ *
+ * This function must only be called once the device has finished executing every submission made for the frame (i.e. once the fence that the frame
+ * was submitted with has signalled), or if nothing was submitted for it. The descriptor sets allocated for the frame are freed, and bindless table
+ * slots that were released while the frame (or any older frame) was in flight are made available again once all of those frames have retired. This
+ * function is thread-safe.
+ *
+ * @param renderer_system Renderer system whose timeline to retire a frame of
+ * @param frame Index of the frame's slot, as returned by @ref TLVK_FrameTimelineBeginFrame()
+ */
+void TLVK_FrameTimelineRetireFrame(
+    TLVK_RendererSystem_t *const renderer_system,
+    const uint32_t frame
+);
+
+/**
+ * @brief Hold a new serial on the frame timeline of the given renderer system, without claiming a frame slot.
+ *
+ * Held serials keep resources from being reused like frames in flight do, for work that is submitted outside of swapchain and render target chain
+ * frames. This function is thread-safe.
+ *
+ * @param renderer_system Renderer system whose timeline to hold a serial on
+ * @param out_serial Pointer to populate with the held serial
+ * @return False if there were errors
+ */
+bool TLVK_FrameTimelineHoldSerial(
+    TLVK_RendererSystem_t *const renderer_system,
+    uint64_t *const out_serial
+);
+
+/**
+ * @brief Release a serial held on the frame timeline of the given renderer system.
+ *
+ * Like @ref TLVK_FrameTimelineRetireFrame(), this function must only be called once the device has finished executing every submission made
+ * under the serial, and makes bindless table slots available again once nothing older is in flight. This function is thread-safe.
+ *
+ * @param renderer_system Renderer system whose timeline to release a serial of
+ * @param serial Serial returned by @ref TLVK_FrameTimelineHoldSerial()
+ */
+void TLVK_FrameTimelineReleaseSerial(
+    TLVK_RendererSystem_t *const renderer_system,
+    const uint64_t serial
+);
+
+/**
+ * @brief Retrieve the serial of the most recently begun frame (or held serial) of the given renderer system, or 0 if there is none yet.
+ *
+ * @param renderer_system Renderer system whose timeline to query
+ * @return Serial of the most recent frame
+ */
+uint64_t TLVK_FrameTimelineGetLastSerial(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+/**
+ * @brief Retrieve the serial of the oldest frame (or held serial) of the given renderer system that has not retired yet.
+ *
+ * Every frame with a lower serial has retired. If no frame is in flight, the serial that the next frame will be given is returned instead.
+ *
+ * @param renderer_system Renderer system whose timeline to query
+ * @return Serial of the oldest frame in flight
+ */
+uint64_t TLVK_FrameTimelineGetOldestSerial(
+    TLVK_RendererSystem_t *const renderer_system
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
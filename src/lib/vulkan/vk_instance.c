@@ -19,6 +19,7 @@
 #define __DEFINE_REQUIRED_FLAG(flag) ret |= flag
 #define __DEFINE_REQUIRED_LAYER(name) if (out_layer_names) { out_layer_names[count_ret] = name; } count_ret++
 #define __DEFINE_REQUIRED_EXTENSION(name) if (out_extension_names) { out_extension_names[count_ret] = name; } count_ret++
+#define __DEFINE_OPTIONAL_EXTENSION(name) __DEFINE_REQUIRED_EXTENSION(name)
 
 #define __IF_EXTENSION_ENABLED(ext, fn)                     \
 for (uint32_t i = 0; i < extensions.size; i++) {            \
@@ -43,6 +44,12 @@ static void __EnumerateRequiredInstanceLayers(const TL_RendererFeatures_t requir
 static void __EnumerateRequiredInstanceExtensions(const TL_RendererFeatures_t requirements, const bool debug_utils,
     uint32_t *const out_extension_count, const char **out_extension_names);
 
+static void __EnumerateOptionalInstanceExtensions(const TL_RendererFeatures_t requirements, uint32_t *const out_extension_count,
+    const char **out_extension_names);
+
+static void __AppendOptionalInstanceExtensions(carray_t *const extensions, const uint32_t count, const char *const *const names,
+    const TL_Debugger_t *const debugger);
+
 static void __UpdateRendererFeaturesWithSupported(TL_RendererFeatures_t *const features, carray_t extensions, carray_t layers,
     const TL_Debugger_t *const debugger);
 
@@ -93,6 +100,14 @@ VkInstance TLVK_InstanceCreate(const VkApplicationInfo application_info, const V
         TL_Error(debugger, "Missing extensions for Vulkan instance, some features may not be available");
     }
 
+    // optional extensions are enabled if available, without their absence being treated as an error
+    uint32_t optional_extension_count = 0;
+    __EnumerateOptionalInstanceExtensions(*requirements, &optional_extension_count, NULL);
+    const char *optional_extensions[optional_extension_count + 1]; // never zero-sized
+    __EnumerateOptionalInstanceExtensions(*requirements, &optional_extension_count, optional_extensions);
+
+    __AppendOptionalInstanceExtensions(&extensions, optional_extension_count, optional_extensions, debugger);
+
     // disable any renderer features if they could not be used
     __UpdateRendererFeaturesWithSupported(requirements, extensions, layers, debugger);
 
@@ -343,12 +358,62 @@ static void __EnumerateRequiredInstanceExtensions(const TL_RendererFeatures_t re
             __DEFINE_REQUIRED_EXTENSION(VK_KHR_XCB_SURFACE_EXTENSION_NAME);
             __DEFINE_REQUIRED_EXTENSION(VK_KHR_XLIB_SURFACE_EXTENSION_NAME);
 #       endif
+    }
+
+    *out_extension_count = count_ret;
+}
+
+// Get the instance extensions that are enabled alongside the given features if available, but are not needed to support them
+static void __EnumerateOptionalInstanceExtensions(const TL_RendererFeatures_t requirements, uint32_t *const out_extension_count,
+    const char **out_extension_names)
+{
+    if (!out_extension_count) {
+        return;
+    }
+
+    uint32_t count_ret = 0;
 
+    if (requirements.presentation) {
+#       if defined(_THALLIUM_WSI_HEADLESS)
+            // windowless surface extension (e.g. for servers without a display), which most implementations do not provide
+            __DEFINE_OPTIONAL_EXTENSION(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME);
+#       endif
     }
 
     *out_extension_count = count_ret;
 }
 
+// append each of the given extensions that the implementation provides to `extensions`
+static void __AppendOptionalInstanceExtensions(carray_t *const extensions, const uint32_t count, const char *const *const names,
+    const TL_Debugger_t *const debugger)
+{
+    if (!count) {
+        return;
+    }
+
+    uint32_t available_count;
+    vkEnumerateInstanceExtensionProperties(NULL, &available_count, NULL);
+    VkExtensionProperties available[available_count + 1]; // never zero-sized
+    vkEnumerateInstanceExtensionProperties(NULL, &available_count, available);
+
+    for (uint32_t i = 0; i < count; i++) {
+        bool found = false;
+
+        for (uint32_t j = 0; j < available_count; j++) {
+            if (!strcmp(names[i], available[j].extensionName)) {
+                found = true;
+                break;
+            }
+        }
+
+        if (found) {
+            carraypush(extensions, (carrayval_t) names[i]);
+        } else {
+            TL_Log(debugger, "Optional extension \"%s\" is not available and was not enabled", names[i]);
+        }
+    }
+}
+
 static void __UpdateRendererFeaturesWithSupported(TL_RendererFeatures_t *const features, carray_t extensions, carray_t layers,
     const TL_Debugger_t *const debugger)
 {
@@ -358,6 +423,7 @@ static void __UpdateRendererFeaturesWithSupported(TL_RendererFeatures_t *const f
 #       if defined(_UNIX)
             bool pc = false;
 #       endif
+        bool ph = false;
 
         // look for surface extension
         for (uint32_t i = 0; i < extensions.size; i++) {
@@ -368,15 +434,20 @@ static void __UpdateRendererFeaturesWithSupported(TL_RendererFeatures_t *const f
                 continue;
             }
 
+            if (!strcmp((const char *) curext_name, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME)) {
+                ph = true;
+                continue;
+            }
+
 #           if defined(_WIN32)
                 if (!strcmp((const char *) curext_name, VK_KHR_WIN32_SURFACE_EXTENSION_NAME)) {
                     pb = true;
-                    break;
+                    continue;
                 }
 #           elif defined(_APPLE)
                 if (!strcmp((const char *) curext_name, VK_EXT_METAL_SURFACE_EXTENSION_NAME)) {
                     pb = true;
-                    break;
+                    continue;
                 }
 #           elif defined(_UNIX)
                 if (!strcmp((const char *) curext_name, VK_KHR_XCB_SURFACE_EXTENSION_NAME)) {
@@ -390,12 +461,14 @@ static void __UpdateRendererFeaturesWithSupported(TL_RendererFeatures_t *const f
 #           endif
         }
 
-        // if any of the listed extensions above were not found then disable presentation
-        if (!pa || !pb
-#           if defined(_UNIX)
-                || !pc
-#           endif
-        ) {
+        // each window system's surfaces are only created if its own extension is enabled (see __CreateVkSurface in vk_swapchain_system.c), so
+        // presenting only needs one of them - on servers without a window system, that may be the headless surface extension alone
+        bool any_wsi = pb || ph;
+#       if defined(_UNIX)
+            any_wsi = any_wsi || pc;
+#       endif
+
+        if (!pa || !any_wsi) {
             features->presentation = false;
             TL_Error(debugger,
                 "When creating Vulkan instance: RENDERER FEATURE UNAVAILABLE (missing instance extensions) - 'presentation' was disabled!");
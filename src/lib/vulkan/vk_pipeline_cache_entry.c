@@ -0,0 +1,77 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "vk_pipeline_cache_entry.h"
+
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include <string.h>
+
+TLVK_PipelineCacheEntry_t *TLVK_PipelineCacheEntryAcquire(TLVK_RendererSystem_t *const renderer_system, TL_HashMap_t *const map,
+    const uint64_t hash, const void *const key, const size_t key_size)
+{
+    TL_MutexLock(&renderer_system->pipeline_systems_lock);
+
+    TLVK_PipelineCacheEntry_t *ret = TL_HashMapGet(map, hash);
+
+    // a matching hash with a different key is a collision; the new object is then created uncached
+    if (ret && (ret->key_size != key_size || memcmp(ret->key, key, key_size))) {
+        ret = NULL;
+    }
+
+    if (ret) {
+        ret->refcount++;
+    }
+
+    TL_MutexUnlock(&renderer_system->pipeline_systems_lock);
+
+    return ret;
+}
+
+TLVK_PipelineCacheEntry_t *TLVK_PipelineCacheEntryInsert(TLVK_RendererSystem_t *const renderer_system, TL_HashMap_t *const map,
+    TLVK_PipelineCacheEntry_t *const entry, const TL_Debugger_t *const debugger)
+{
+    TL_MutexLock(&renderer_system->pipeline_systems_lock);
+
+    TLVK_PipelineCacheEntry_t *ret = TL_HashMapGet(map, entry->hash);
+
+    if (!ret) {
+        entry->cached = TL_HashMapSet(map, entry->hash, entry, debugger);
+        ret = entry;
+    } else if (ret->key_size == entry->key_size && !memcmp(ret->key, entry->key, entry->key_size)) {
+        ret->refcount++;
+    } else {
+        TL_Note(debugger, "Vulkan pipeline object at %p has a hash collision (0x%016llx) and will not be shared", entry,
+            (unsigned long long) entry->hash);
+        ret = entry;
+    }
+
+    TL_MutexUnlock(&renderer_system->pipeline_systems_lock);
+
+    return ret;
+}
+
+void TLVK_PipelineCacheEntryRetain(TLVK_RendererSystem_t *const renderer_system, TLVK_PipelineCacheEntry_t *const entry) {
+    TL_MutexLock(&renderer_system->pipeline_systems_lock);
+    entry->refcount++;
+    TL_MutexUnlock(&renderer_system->pipeline_systems_lock);
+}
+
+bool TLVK_PipelineCacheEntryRelease(TLVK_RendererSystem_t *const renderer_system, TL_HashMap_t *const map, TLVK_PipelineCacheEntry_t *const entry) {
+    TL_MutexLock(&renderer_system->pipeline_systems_lock);
+
+    bool last = !--entry->refcount;
+    if (last && entry->cached) {
+        TL_HashMapRemove(map, entry->hash);
+        entry->cached = false;
+    }
+
+    TL_MutexUnlock(&renderer_system->pipeline_systems_lock);
+
+    return last;
+}
@@ -0,0 +1,93 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_pipeline_cache_entry_h__
+#define __TL__internal__vulkan__vk_pipeline_cache_entry_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwd.h"
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#include "types/vulkan/vk_pipeline_cache_entry_t.h"
+#include "utils/hash/hashmap.h"
+
+/**
+ * @brief Look up a live object in one of the renderer system's deduplication maps.
+ *
+ * This function returns the entry registered in `map` under `hash`, with its reference count incremented, if it was created from the same key.
+ * Otherwise (including on a hash collision), NULL is returned.
+ *
+ * @param renderer_system Renderer system owning `map`
+ * @param map Deduplication map to search
+ * @param hash Hash of `key`
+ * @param key Serialized state of the object being looked up
+ * @param key_size Size of `key` in bytes
+ * @return NULL or a new reference to an equivalent object
+ */
+TLVK_PipelineCacheEntry_t *TLVK_PipelineCacheEntryAcquire(
+    TLVK_RendererSystem_t *const renderer_system,
+    TL_HashMap_t *const map,
+    const uint64_t hash,
+    const void *const key,
+    const size_t key_size
+);
+
+/**
+ * @brief Register a newly created object in one of the renderer system's deduplication maps.
+ *
+ * This function registers `entry` in `map`, unless an equivalent object was registered first - in that case, a new reference to that object is
+ * returned instead, and the caller should release `entry`. If another object with the same hash but a different key is registered, `entry` is
+ * returned without being registered.
+ *
+ * @param renderer_system Renderer system owning `map`
+ * @param map Deduplication map to register in
+ * @param entry Entry of the new object, with a reference count of 1
+ * @param debugger NULL or a debugger for function debugging
+ * @return The entry of the object to use
+ */
+TLVK_PipelineCacheEntry_t *TLVK_PipelineCacheEntryInsert(
+    TLVK_RendererSystem_t *const renderer_system,
+    TL_HashMap_t *const map,
+    TLVK_PipelineCacheEntry_t *const entry,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Add a reference to a shared object.
+ *
+ * @param renderer_system Renderer system owning the object's deduplication map
+ * @param entry Entry of the object
+ */
+void TLVK_PipelineCacheEntryRetain(
+    TLVK_RendererSystem_t *const renderer_system,
+    TLVK_PipelineCacheEntry_t *const entry
+);
+
+/**
+ * @brief Release a reference to a shared object.
+ *
+ * This function decrements the reference count of `entry`, and unregisters it from `map` once no references remain.
+ *
+ * @param renderer_system Renderer system owning `map`
+ * @param map Deduplication map the object may be registered in
+ * @param entry Entry of the object
+ * @return True if the last reference was released, in which case the caller must free the object
+ */
+bool TLVK_PipelineCacheEntryRelease(
+    TLVK_RendererSystem_t *const renderer_system,
+    TL_HashMap_t *const map,
+    TLVK_PipelineCacheEntry_t *const entry
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
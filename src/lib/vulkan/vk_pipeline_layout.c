@@ -0,0 +1,841 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "vk_pipeline_layout.h"
+
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_bindless_table_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include "vk_pipeline_cache_entry.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// amount of words each binding occupies in a serialized layout
+#define __BINDING_WORD_COUNT 4
+
+// descriptor update templates are core in Vulkan 1.1 and otherwise come from the KHR extension; both versions share the same signature
+#define __UPDATE_TEMPLATE_FN(devfs, name) (((devfs)->name) ? (devfs)->name : (devfs)->name ## KHR)
+
+// buffer device addresses are core in Vulkan 1.2 and otherwise come from the KHR extension
+#define __BUFFER_ADDRESS_FN(devfs) (((devfs)->vkGetBufferDeviceAddress) ? (devfs)->vkGetBufferDeviceAddress : (devfs)->vkGetBufferDeviceAddressKHR)
+
+typedef struct __MergedBinding {
+    uint32_t set;
+    uint32_t binding;
+    uint32_t type;
+    uint32_t count;
+    uint32_t stages;
+} __MergedBinding;
+
+
+static int __CompareBindings(const void *a, const void *b);
+static bool __MergeBindings(const TL_SpirvReflection_t *const *const reflections, const uint32_t reflection_count, __MergedBinding *const out,
+    uint32_t *const out_count, const TL_Debugger_t *const debugger);
+static TLVK_DescriptorSetLayout_t *__AcquireSetLayout(TLVK_RendererSystem_t *const renderer_system, const uint32_t *const key, const size_t key_size,
+    const VkDescriptorSetLayoutCreateFlags flags, const __MergedBinding *const bindings, const uint32_t binding_count);
+static void __ReleaseSetLayout(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorSetLayout_t *const layout);
+static bool __CheckBindlessBindings(const __MergedBinding *const bindings, const uint32_t binding_count, const TL_Debugger_t *const debugger);
+static bool __CheckPushDescriptorBindings(const __MergedBinding *const bindings, const uint32_t binding_count, const TL_Debugger_t *const debugger);
+static size_t __GetDescriptorDataSize(const VkDescriptorType type);
+static void __CreateUpdateTemplate(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorSetLayout_t *const layout);
+static bool __CanUseDescriptorBuffer(const TLVK_RendererSystem_t *const renderer_system, const __MergedBinding *const bindings,
+    const uint32_t binding_count, const uint32_t set_count);
+static size_t __GetDescriptorBufferSize(const TLVK_RendererSystem_t *const renderer_system, const VkDescriptorType type);
+static bool __QueryBufferLayout(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorSetLayout_t *const layout);
+
+
+TLVK_PipelineLayout_t *TLVK_PipelineLayoutAcquire(TLVK_RendererSystem_t *const renderer_system, const TL_SpirvReflection_t *const *const reflections,
+    const uint32_t reflection_count)
+{
+    if (!renderer_system || (!reflections && reflection_count)) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    __MergedBinding *bindings = NULL;
+    uint32_t *key = NULL;
+    TLVK_PipelineLayout_t *layout = NULL;
+
+    uint32_t total_binding_count = 0;
+    uint32_t push_constant_size = 0;
+    VkShaderStageFlags push_constant_stages = 0;
+
+    // a single push constant range covering the largest block is visible to every stage that declares one
+    for (uint32_t i = 0; i < reflection_count; i++) {
+        total_binding_count += reflections[i]->binding_count;
+
+        if (reflections[i]->push_constant_size) {
+            push_constant_stages |= (VkShaderStageFlags) reflections[i]->stage;
+
+            if (reflections[i]->push_constant_size > push_constant_size) {
+                push_constant_size = reflections[i]->push_constant_size;
+            }
+        }
+    }
+
+    push_constant_size = (push_constant_size + 3) & ~3u;
+
+    if (push_constant_size > renderer_system->vk_device_limits.maxPushConstantsSize) {
+        TL_Error(debugger, "When creating Vulkan pipeline layout: shaders use %u bytes of push constants, but the device supports at most %u",
+            push_constant_size, renderer_system->vk_device_limits.maxPushConstantsSize);
+        return NULL;
+    }
+
+    if (total_binding_count) {
+        bindings = malloc(sizeof(__MergedBinding) * total_binding_count);
+        if (!bindings) {
+            TL_Fatal(debugger, "MALLOC fault in call to TLVK_PipelineLayoutAcquire");
+            goto outerr;
+        }
+    }
+
+    uint32_t binding_count;
+    if (!__MergeBindings(reflections, reflection_count, bindings, &binding_count, debugger)) {
+        goto outerr;
+    }
+
+    // bindings are sorted by set, so the last binding has the highest set index
+    uint32_t set_count = binding_count ? bindings[binding_count - 1].set + 1 : 0;
+    if (set_count > TLVK_MAX_DESCRIPTOR_SETS) {
+        TL_Error(debugger, "When creating Vulkan pipeline layout: shaders use descriptor set %u, but at most %d sets are supported", set_count - 1,
+            TLVK_MAX_DESCRIPTOR_SETS);
+        goto outerr;
+    }
+
+    // either every set of the layout is stored in the descriptor buffer or none is, as pipelines cannot mix descriptor buffers and descriptor sets
+    bool descriptor_buffer = __CanUseDescriptorBuffer(renderer_system, bindings, binding_count, set_count);
+
+    // the key holds the set count and push constant range, followed by the creation flags, binding count and bindings of each set in turn - the
+    // part of the key describing each set is then reused as the key of its descriptor set layout
+    size_t key_word_count = 3 + 2 * set_count + binding_count * __BINDING_WORD_COUNT;
+    key = malloc(sizeof(uint32_t) * key_word_count);
+    if (!key) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_PipelineLayoutAcquire");
+        goto outerr;
+    }
+
+    size_t set_key_offsets[TLVK_MAX_DESCRIPTOR_SETS + 1];
+    uint32_t set_binding_offsets[TLVK_MAX_DESCRIPTOR_SETS + 1];
+
+    size_t w = 0;
+    key[w++] = set_count;
+    key[w++] = push_constant_size;
+    key[w++] = (uint32_t) push_constant_stages;
+
+    uint32_t b = 0;
+    for (uint32_t s = 0; s < set_count; s++) {
+        set_key_offsets[s] = w;
+        set_binding_offsets[s] = b;
+
+        bool push = s == TLVK_PUSH_DESCRIPTOR_SET_INDEX && renderer_system->renderer->features.push_descriptors;
+        key[w++] =
+            ((push) ? (uint32_t) VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0) |
+            ((descriptor_buffer) ? (uint32_t) VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0);
+
+        size_t count_word = w++;
+        uint32_t set_binding_count = 0;
+
+        for (; b < binding_count && bindings[b].set == s; b++, set_binding_count++) {
+            key[w++] = bindings[b].binding;
+            key[w++] = bindings[b].type;
+            key[w++] = bindings[b].count;
+            key[w++] = bindings[b].stages;
+        }
+
+        key[count_word] = set_binding_count;
+    }
+
+    set_key_offsets[set_count] = w;
+    set_binding_offsets[set_count] = b;
+
+    uint64_t hash = TL_Hash64(key, sizeof(uint32_t) * key_word_count, 0);
+
+    TLVK_PipelineLayout_t *existing = (TLVK_PipelineLayout_t *) TLVK_PipelineCacheEntryAcquire(renderer_system, &renderer_system->pipeline_layouts,
+        hash, key, sizeof(uint32_t) * key_word_count);
+    if (existing) {
+        free(bindings);
+        free(key);
+        return existing;
+    }
+
+    layout = calloc(1, sizeof(TLVK_PipelineLayout_t));
+    if (!layout) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_PipelineLayoutAcquire");
+        goto outerr;
+    }
+
+    layout->push_constant_size = push_constant_size;
+    layout->push_constant_stages = push_constant_stages;
+    layout->descriptor_buffer = descriptor_buffer;
+
+    if (push_constant_size > TLVK_PUSH_CONSTANTS_PORTABLE_SIZE) {
+        TL_Warn(debugger, "Vulkan pipeline layout at %p uses %u bytes of push constants, more than the %d bytes guaranteed on all devices", layout,
+            push_constant_size, TLVK_PUSH_CONSTANTS_PORTABLE_SIZE);
+    }
+
+    VkDescriptorSetLayout vk_set_layouts[TLVK_MAX_DESCRIPTOR_SETS];
+
+    for (uint32_t s = 0; s < set_count; s++) {
+        const __MergedBinding *set_bindings = &bindings[set_binding_offsets[s]];
+        uint32_t set_binding_count = set_binding_offsets[s + 1] - set_binding_offsets[s];
+
+        // with a bindless table, its set is used in place of whatever the shaders declare there (a subset of the table, if anything)
+        if (s == TLVK_BINDLESS_SET_INDEX && renderer_system->bindless_table) {
+            if (!__CheckBindlessBindings(set_bindings, set_binding_count, debugger)) {
+                goto outerr;
+            }
+
+            layout->set_layouts[s] = renderer_system->bindless_table->set_layout;
+            TLVK_PipelineCacheEntryRetain(renderer_system, &layout->set_layouts[s]->entry);
+        } else {
+            VkDescriptorSetLayoutCreateFlags flags = (VkDescriptorSetLayoutCreateFlags) key[set_key_offsets[s]];
+
+            if ((flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) &&
+                !__CheckPushDescriptorBindings(set_bindings, set_binding_count, debugger))
+            {
+                goto outerr;
+            }
+
+            layout->set_layouts[s] = __AcquireSetLayout(renderer_system, &key[set_key_offsets[s]],
+                sizeof(uint32_t) * (set_key_offsets[s + 1] - set_key_offsets[s]), flags, set_bindings, set_binding_count);
+            if (!layout->set_layouts[s]) {
+                goto outerr;
+            }
+        }
+
+        layout->set_count = s + 1;
+        vk_set_layouts[s] = layout->set_layouts[s]->vk_layout;
+    }
+
+    VkPushConstantRange push_constant_range;
+    push_constant_range.stageFlags = push_constant_stages;
+    push_constant_range.offset = 0;
+    push_constant_range.size = push_constant_size;
+
+    VkPipelineLayoutCreateInfo layout_info;
+    layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_info.pNext = NULL;
+    layout_info.flags = 0;
+    layout_info.setLayoutCount = set_count;
+    layout_info.pSetLayouts = vk_set_layouts;
+    layout_info.pushConstantRangeCount = push_constant_size ? 1 : 0;
+    layout_info.pPushConstantRanges = &push_constant_range;
+
+    if (renderer_system->devfs.vkCreatePipelineLayout(renderer_system->vk_logical_device, &layout_info, NULL, &layout->vk_layout)) {
+        TL_Error(debugger, "Failed to create Vulkan pipeline layout");
+        goto outerr;
+    }
+
+    layout->entry.refcount = 1;
+    layout->entry.cached = false;
+    layout->entry.hash = hash;
+    layout->entry.key = key;
+    layout->entry.key_size = sizeof(uint32_t) * key_word_count;
+
+    free(bindings);
+
+    TL_Log(debugger, "Created Vulkan pipeline layout at %p (%u descriptor sets%s, %u bytes of push constants)", layout, set_count,
+        (descriptor_buffer) ? " in descriptor buffer" : "", push_constant_size);
+
+    existing = (TLVK_PipelineLayout_t *) TLVK_PipelineCacheEntryInsert(renderer_system, &renderer_system->pipeline_layouts, &layout->entry, debugger);
+    if (existing != layout) {
+        TLVK_PipelineLayoutRelease(renderer_system, layout);
+    }
+
+    return existing;
+
+outerr:
+    if (layout) {
+        for (uint32_t s = 0; s < layout->set_count; s++) {
+            __ReleaseSetLayout(renderer_system, layout->set_layouts[s]);
+        }
+
+        free(layout);
+    }
+
+    free(key);
+    free(bindings);
+
+    return NULL;
+}
+
+void TLVK_PipelineLayoutRelease(TLVK_RendererSystem_t *const renderer_system, TLVK_PipelineLayout_t *const layout) {
+    if (!renderer_system || !layout) {
+        return;
+    }
+
+    if (!TLVK_PipelineCacheEntryRelease(renderer_system, &renderer_system->pipeline_layouts, &layout->entry)) {
+        return;
+    }
+
+    renderer_system->devfs.vkDestroyPipelineLayout(renderer_system->vk_logical_device, layout->vk_layout, NULL);
+
+    for (uint32_t s = 0; s < layout->set_count; s++) {
+        __ReleaseSetLayout(renderer_system, layout->set_layouts[s]);
+    }
+
+    free(layout->entry.key);
+    free(layout);
+}
+
+void TLVK_DescriptorSetLayoutWrite(const TLVK_RendererSystem_t *const renderer_system, const TLVK_DescriptorSetLayout_t *const layout,
+    const VkDescriptorSet set, const void *const data)
+{
+    if (!renderer_system || !layout || set == VK_NULL_HANDLE || !data || !layout->binding_count) {
+        return;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+
+    if (layout->vk_update_template != VK_NULL_HANDLE) {
+        __UPDATE_TEMPLATE_FN(devfs, vkUpdateDescriptorSetWithTemplate)(renderer_system->vk_logical_device, set, layout->vk_update_template, data);
+        return;
+    }
+
+    // without templates, each binding is written with its own VkWriteDescriptorSet pointing into the packed data
+    VkWriteDescriptorSet writes[layout->binding_count];
+    VkWriteDescriptorSetAccelerationStructureKHR as_writes[layout->binding_count];
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < layout->binding_count; i++) {
+        const VkDescriptorSetLayoutBinding *binding = &layout->bindings[i];
+        const void *binding_data = (const char *) data + offset;
+
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].pNext = NULL;
+        writes[i].dstSet = set;
+        writes[i].dstBinding = binding->binding;
+        writes[i].dstArrayElement = 0;
+        writes[i].descriptorCount = binding->descriptorCount;
+        writes[i].descriptorType = binding->descriptorType;
+        writes[i].pImageInfo = NULL;
+        writes[i].pBufferInfo = NULL;
+        writes[i].pTexelBufferView = NULL;
+
+        switch (binding->descriptorType) {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                writes[i].pBufferInfo = binding_data;
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                writes[i].pTexelBufferView = binding_data;
+                break;
+
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                as_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+                as_writes[i].pNext = NULL;
+                as_writes[i].accelerationStructureCount = binding->descriptorCount;
+                as_writes[i].pAccelerationStructures = binding_data;
+                writes[i].pNext = &as_writes[i];
+                break;
+
+            default:
+                writes[i].pImageInfo = binding_data;
+                break;
+        }
+
+        offset += binding->descriptorCount * __GetDescriptorDataSize(binding->descriptorType);
+    }
+
+    devfs->vkUpdateDescriptorSets(renderer_system->vk_logical_device, layout->binding_count, writes, 0, NULL);
+}
+
+bool TLVK_DescriptorSetLayoutWriteBuffer(const TLVK_RendererSystem_t *const renderer_system, const TLVK_DescriptorSetLayout_t *const layout,
+    void *const dst, const void *const data)
+{
+    if (!renderer_system || !layout || !dst || !data || !layout->binding_offsets) {
+        return false;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT *properties = &renderer_system->descriptor_allocator.buffer.properties;
+    VkDevice dev = renderer_system->vk_logical_device;
+
+    const unsigned char *src = data;
+
+    for (uint32_t i = 0; i < layout->binding_count; i++) {
+        const VkDescriptorSetLayoutBinding *binding = &layout->bindings[i];
+        unsigned char *binding_dst = (unsigned char *) dst + layout->binding_offsets[i];
+        size_t descriptor_size = __GetDescriptorBufferSize(renderer_system, binding->descriptorType);
+
+        // some devices store an array of combined image samplers as an array of images followed by an array of samplers, in which case each
+        // descriptor returned by vkGetDescriptorEXT is split in two
+        bool split = binding->descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER && !properties->combinedImageSamplerDescriptorSingleArray;
+
+        for (uint32_t e = 0; e < binding->descriptorCount; e++) {
+            const VkDescriptorImageInfo *image_info = (const VkDescriptorImageInfo *) src;
+            const VkDescriptorBufferInfo *buffer_info = (const VkDescriptorBufferInfo *) src;
+
+            VkDescriptorGetInfoEXT get_info;
+            get_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+            get_info.pNext = NULL;
+            get_info.type = binding->descriptorType;
+
+            VkDescriptorAddressInfoEXT address_info;
+
+            switch (binding->descriptorType) {
+                case VK_DESCRIPTOR_TYPE_SAMPLER:
+                    get_info.data.pSampler = &image_info->sampler;
+                    break;
+                case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+                    get_info.data.pCombinedImageSampler = image_info;
+                    break;
+                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                    get_info.data.pSampledImage = image_info;
+                    break;
+                case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                    get_info.data.pStorageImage = image_info;
+                    break;
+                case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                    get_info.data.pInputAttachmentImage = image_info;
+                    break;
+
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: {
+                    if (buffer_info->range == VK_WHOLE_SIZE) {
+                        TL_Error(debugger, "When writing descriptor set to Vulkan descriptor buffer: the range of binding %u cannot be VK_WHOLE_SIZE",
+                            binding->binding);
+                        return false;
+                    }
+
+                    VkBufferDeviceAddressInfo buffer_address_info;
+                    buffer_address_info.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+                    buffer_address_info.pNext = NULL;
+                    buffer_address_info.buffer = buffer_info->buffer;
+
+                    address_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+                    address_info.pNext = NULL;
+                    address_info.address = __BUFFER_ADDRESS_FN(devfs)(dev, &buffer_address_info) + buffer_info->offset;
+                    address_info.range = buffer_info->range;
+                    address_info.format = VK_FORMAT_UNDEFINED;
+
+                    if (binding->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+                        get_info.data.pUniformBuffer = &address_info;
+                    } else {
+                        get_info.data.pStorageBuffer = &address_info;
+                    }
+                    break;
+                }
+
+                // pipeline layouts with any other descriptor type are never created for descriptor buffers
+                default:
+                    TL_Error(debugger, "When writing descriptor set to Vulkan descriptor buffer: unsupported descriptor type at binding %u",
+                        binding->binding);
+                    return false;
+            }
+
+            if (split) {
+                unsigned char combined[descriptor_size];
+                devfs->vkGetDescriptorEXT(dev, &get_info, descriptor_size, combined);
+
+                size_t image_size = properties->sampledImageDescriptorSize;
+                size_t sampler_size = properties->samplerDescriptorSize;
+
+                memcpy(binding_dst + e * image_size, combined, image_size);
+                memcpy(binding_dst + binding->descriptorCount * image_size + e * sampler_size, combined + image_size, sampler_size);
+            } else {
+                devfs->vkGetDescriptorEXT(dev, &get_info, descriptor_size, binding_dst + e * descriptor_size);
+            }
+
+            src += __GetDescriptorDataSize(binding->descriptorType);
+        }
+    }
+
+    return true;
+}
+
+
+static int __CompareBindings(const void *a, const void *b) {
+    const __MergedBinding *lhs = a;
+    const __MergedBinding *rhs = b;
+
+    if (lhs->set != rhs->set) {
+        return (lhs->set < rhs->set) ? -1 : 1;
+    }
+
+    if (lhs->binding != rhs->binding) {
+        return (lhs->binding < rhs->binding) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+static bool __MergeBindings(const TL_SpirvReflection_t *const *const reflections, const uint32_t reflection_count, __MergedBinding *const out,
+    uint32_t *const out_count, const TL_Debugger_t *const debugger)
+{
+    uint32_t n = 0;
+
+    for (uint32_t r = 0; r < reflection_count; r++) {
+        for (uint32_t i = 0; i < reflections[r]->binding_count; i++) {
+            const TL_SpirvBinding_t *binding = &reflections[r]->bindings[i];
+
+            out[n].set = binding->set;
+            out[n].binding = binding->binding;
+            out[n].type = (uint32_t) binding->type;
+            out[n].count = binding->count;
+            out[n].stages = (uint32_t) reflections[r]->stage;
+            n++;
+        }
+    }
+
+    if (n) {
+        qsort(out, n, sizeof(__MergedBinding), __CompareBindings);
+    }
+
+    // bindings declared by several stages are combined into one binding visible to each of them
+    uint32_t merged = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (merged && out[merged - 1].set == out[i].set && out[merged - 1].binding == out[i].binding) {
+            __MergedBinding *prev = &out[merged - 1];
+
+            if (prev->type != out[i].type) {
+                TL_Error(debugger, "When creating Vulkan pipeline layout: shader stages declare different resource types at set %u, binding %u",
+                    out[i].set, out[i].binding);
+                return false;
+            }
+
+            prev->stages |= out[i].stages;
+
+            // a runtime-sized array in any stage makes the binding runtime-sized, otherwise the largest declared array is used
+            if (!prev->count || !out[i].count) {
+                prev->count = 0;
+            } else if (out[i].count > prev->count) {
+                prev->count = out[i].count;
+            }
+
+            continue;
+        }
+
+        out[merged++] = out[i];
+    }
+
+    *out_count = merged;
+
+    return true;
+}
+
+static TLVK_DescriptorSetLayout_t *__AcquireSetLayout(TLVK_RendererSystem_t *const renderer_system, const uint32_t *const key, const size_t key_size,
+    const VkDescriptorSetLayoutCreateFlags flags, const __MergedBinding *const bindings, const uint32_t binding_count)
+{
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    uint64_t hash = TL_Hash64(key, key_size, 0);
+
+    TLVK_DescriptorSetLayout_t *existing = (TLVK_DescriptorSetLayout_t *) TLVK_PipelineCacheEntryAcquire(renderer_system,
+        &renderer_system->descriptor_set_layouts, hash, key, key_size);
+    if (existing) {
+        return existing;
+    }
+
+    TLVK_DescriptorSetLayout_t *layout = calloc(1, sizeof(TLVK_DescriptorSetLayout_t));
+    if (!layout) {
+        TL_Fatal(debugger, "MALLOC fault in call to __AcquireSetLayout");
+        return NULL;
+    }
+
+    layout->entry.key = malloc(key_size);
+    if (binding_count) {
+        layout->bindings = malloc(sizeof(VkDescriptorSetLayoutBinding) * binding_count);
+    }
+    if (!layout->entry.key || (binding_count && !layout->bindings)) {
+        TL_Fatal(debugger, "MALLOC fault in call to __AcquireSetLayout");
+        goto outerr;
+    }
+
+    memcpy(layout->entry.key, key, key_size);
+    layout->entry.key_size = key_size;
+    layout->entry.hash = hash;
+    layout->entry.refcount = 1;
+    layout->entry.cached = false;
+
+    layout->flags = flags;
+    layout->binding_count = binding_count;
+
+    for (uint32_t i = 0; i < binding_count; i++) {
+        layout->bindings[i].binding = bindings[i].binding;
+        layout->bindings[i].descriptorType = (VkDescriptorType) bindings[i].type;
+        // runtime-sized arrays are given a single descriptor, as variable descriptor counts are not used
+        layout->bindings[i].descriptorCount = bindings[i].count ? bindings[i].count : 1;
+        layout->bindings[i].stageFlags = (VkShaderStageFlags) bindings[i].stages;
+        layout->bindings[i].pImmutableSamplers = NULL;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layout_info;
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.pNext = NULL;
+    layout_info.flags = flags;
+    layout_info.bindingCount = binding_count;
+    layout_info.pBindings = layout->bindings;
+
+    if (renderer_system->devfs.vkCreateDescriptorSetLayout(renderer_system->vk_logical_device, &layout_info, NULL, &layout->vk_layout)) {
+        TL_Error(debugger, "Failed to create Vulkan descriptor set layout (%u bindings)", binding_count);
+        goto outerr;
+    }
+
+    // push descriptor sets are never written with vkUpdateDescriptorSetWithTemplate, so they need no template
+    if (!(flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR)) {
+        __CreateUpdateTemplate(renderer_system, layout);
+
+        if ((flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT) && !__QueryBufferLayout(renderer_system, layout)) {
+            renderer_system->devfs.vkDestroyDescriptorSetLayout(renderer_system->vk_logical_device, layout->vk_layout, NULL);
+            goto outerr;
+        }
+    }
+
+    TL_Log(debugger, "Created Vulkan descriptor set layout at %p (%u bindings)", layout, binding_count);
+
+    existing = (TLVK_DescriptorSetLayout_t *) TLVK_PipelineCacheEntryInsert(renderer_system, &renderer_system->descriptor_set_layouts, &layout->entry,
+        debugger);
+    if (existing != layout) {
+        __ReleaseSetLayout(renderer_system, layout);
+    }
+
+    return existing;
+
+outerr:
+    free(layout->binding_offsets);
+    free(layout->bindings);
+    free(layout->entry.key);
+    free(layout);
+
+    return NULL;
+}
+
+static void __ReleaseSetLayout(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorSetLayout_t *const layout) {
+    if (!TLVK_PipelineCacheEntryRelease(renderer_system, &renderer_system->descriptor_set_layouts, &layout->entry)) {
+        return;
+    }
+
+    if (layout->vk_update_template != VK_NULL_HANDLE) {
+        __UPDATE_TEMPLATE_FN(&renderer_system->devfs, vkDestroyDescriptorUpdateTemplate)(renderer_system->vk_logical_device,
+            layout->vk_update_template, NULL);
+    }
+
+    renderer_system->devfs.vkDestroyDescriptorSetLayout(renderer_system->vk_logical_device, layout->vk_layout, NULL);
+
+    free(layout->binding_offsets);
+    free(layout->bindings);
+    free(layout->entry.key);
+    free(layout);
+}
+
+static bool __CheckBindlessBindings(const __MergedBinding *const bindings, const uint32_t binding_count, const TL_Debugger_t *const debugger) {
+    // the binding index of each array of the table equals its resource type
+    static const VkDescriptorType expected[TLVK_BINDLESS_RESOURCE_TYPE_COUNT] = {
+        [TLVK_BINDLESS_RESOURCE_TYPE_SAMPLED_IMAGE] = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+        [TLVK_BINDLESS_RESOURCE_TYPE_STORAGE_BUFFER] = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        [TLVK_BINDLESS_RESOURCE_TYPE_SAMPLER] = VK_DESCRIPTOR_TYPE_SAMPLER,
+    };
+
+    for (uint32_t i = 0; i < binding_count; i++) {
+        if (bindings[i].binding >= TLVK_BINDLESS_RESOURCE_TYPE_COUNT || bindings[i].type != (uint32_t) expected[bindings[i].binding]) {
+            TL_Error(debugger, "When creating Vulkan pipeline layout: set %d is reserved for the bindless table, but shaders declare a different "
+                "resource at binding %u", TLVK_BINDLESS_SET_INDEX, bindings[i].binding);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool __CheckPushDescriptorBindings(const __MergedBinding *const bindings, const uint32_t binding_count, const TL_Debugger_t *const debugger) {
+    uint32_t descriptor_count = 0;
+
+    for (uint32_t i = 0; i < binding_count; i++) {
+        if (!bindings[i].count) {
+            TL_Error(debugger, "When creating Vulkan pipeline layout: set %d holds push descriptors, so binding %u cannot be a runtime-sized array",
+                TLVK_PUSH_DESCRIPTOR_SET_INDEX, bindings[i].binding);
+            return false;
+        }
+
+        descriptor_count += bindings[i].count;
+    }
+
+    if (descriptor_count > TLVK_PUSH_DESCRIPTORS_PORTABLE_COUNT) {
+        TL_Error(debugger, "When creating Vulkan pipeline layout: set %d holds %u push descriptors, but only %d are supported on all devices",
+            TLVK_PUSH_DESCRIPTOR_SET_INDEX, descriptor_count, TLVK_PUSH_DESCRIPTORS_PORTABLE_COUNT);
+        return false;
+    }
+
+    return true;
+}
+
+static size_t __GetDescriptorDataSize(const VkDescriptorType type) {
+    switch (type) {
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+            return sizeof(VkDescriptorBufferInfo);
+
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            return sizeof(VkBufferView);
+
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+            return sizeof(VkAccelerationStructureKHR);
+
+        default:
+            return sizeof(VkDescriptorImageInfo);
+    }
+}
+
+static void __CreateUpdateTemplate(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorSetLayout_t *const layout) {
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < layout->binding_count; i++) {
+        offset += layout->bindings[i].descriptorCount * __GetDescriptorDataSize(layout->bindings[i].descriptorType);
+    }
+
+    layout->update_data_size = offset;
+    layout->vk_update_template = VK_NULL_HANDLE;
+
+    // sets can still be written one binding at a time if the device has no update templates, and sets in descriptor buffers are written with
+    // vkGetDescriptorEXT instead
+    if (!layout->binding_count || (layout->flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT) ||
+        !__UPDATE_TEMPLATE_FN(devfs, vkCreateDescriptorUpdateTemplate))
+    {
+        return;
+    }
+
+    VkDescriptorUpdateTemplateEntry entries[layout->binding_count];
+
+    offset = 0;
+    for (uint32_t i = 0; i < layout->binding_count; i++) {
+        size_t stride = __GetDescriptorDataSize(layout->bindings[i].descriptorType);
+
+        entries[i].dstBinding = layout->bindings[i].binding;
+        entries[i].dstArrayElement = 0;
+        entries[i].descriptorCount = layout->bindings[i].descriptorCount;
+        entries[i].descriptorType = layout->bindings[i].descriptorType;
+        entries[i].offset = offset;
+        entries[i].stride = stride;
+
+        offset += layout->bindings[i].descriptorCount * stride;
+    }
+
+    VkDescriptorUpdateTemplateCreateInfo template_info;
+    template_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    template_info.pNext = NULL;
+    template_info.flags = 0;
+    template_info.descriptorUpdateEntryCount = layout->binding_count;
+    template_info.pDescriptorUpdateEntries = entries;
+    template_info.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    template_info.descriptorSetLayout = layout->vk_layout;
+    // the remaining members are only used by push descriptor templates
+    template_info.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    template_info.pipelineLayout = VK_NULL_HANDLE;
+    template_info.set = 0;
+
+    if (__UPDATE_TEMPLATE_FN(devfs, vkCreateDescriptorUpdateTemplate)(renderer_system->vk_logical_device, &template_info, NULL,
+        &layout->vk_update_template))
+    {
+        TL_Warn(renderer_system->renderer->debugger, "Failed to create update template for Vulkan descriptor set layout %p; its sets will be written "
+            "one binding at a time", layout);
+        layout->vk_update_template = VK_NULL_HANDLE;
+    }
+}
+
+static bool __CanUseDescriptorBuffer(const TLVK_RendererSystem_t *const renderer_system, const __MergedBinding *const bindings,
+    const uint32_t binding_count, const uint32_t set_count)
+{
+    const TLVK_DescriptorBuffer_t *buffer = &renderer_system->descriptor_allocator.buffer;
+
+    if (buffer->vk_buffer == VK_NULL_HANDLE || !set_count) {
+        return false;
+    }
+
+    // the bindless table's set lives in its own update-after-bind pool
+    if (renderer_system->bindless_table) {
+        return false;
+    }
+
+    bool push = renderer_system->renderer->features.push_descriptors && set_count > TLVK_PUSH_DESCRIPTOR_SET_INDEX;
+    if (push && !buffer->push_descriptors) {
+        return false;
+    }
+
+    // texel buffers and acceleration structures are passed as handles that cannot be turned into descriptor buffer addresses, and dynamic buffers
+    // are not allowed in descriptor buffers at all - push descriptors are still written with vkCmdPushDescriptorSetKHR, so any type is allowed
+    for (uint32_t i = 0; i < binding_count; i++) {
+        if (push && bindings[i].set == TLVK_PUSH_DESCRIPTOR_SET_INDEX) {
+            continue;
+        }
+
+        switch ((VkDescriptorType) bindings[i].type) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static size_t __GetDescriptorBufferSize(const TLVK_RendererSystem_t *const renderer_system, const VkDescriptorType type) {
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT *properties = &renderer_system->descriptor_allocator.buffer.properties;
+    bool robust = renderer_system->vk_device_features.robustBufferAccess;
+
+    switch (type) {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+            return properties->samplerDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            return properties->combinedImageSamplerDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            return properties->sampledImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            return properties->storageImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+            return properties->inputAttachmentDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            return (robust) ? properties->robustUniformBufferDescriptorSize : properties->uniformBufferDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            return (robust) ? properties->robustStorageBufferDescriptorSize : properties->storageBufferDescriptorSize;
+        default:
+            return 0;
+    }
+}
+
+static bool __QueryBufferLayout(TLVK_RendererSystem_t *const renderer_system, TLVK_DescriptorSetLayout_t *const layout) {
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+    VkDevice dev = renderer_system->vk_logical_device;
+
+    devfs->vkGetDescriptorSetLayoutSizeEXT(dev, layout->vk_layout, &layout->buffer_size);
+
+    if (!layout->binding_count) {
+        return true;
+    }
+
+    layout->binding_offsets = malloc(sizeof(VkDeviceSize) * layout->binding_count);
+    if (!layout->binding_offsets) {
+        TL_Fatal(renderer_system->renderer->debugger, "MALLOC fault in call to __AcquireSetLayout");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < layout->binding_count; i++) {
+        devfs->vkGetDescriptorSetLayoutBindingOffsetEXT(dev, layout->vk_layout, layout->bindings[i].binding, &layout->binding_offsets[i]);
+    }
+
+    return true;
+}
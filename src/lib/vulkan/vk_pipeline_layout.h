@@ -0,0 +1,104 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_pipeline_layout_h__
+#define __TL__internal__vulkan__vk_pipeline_layout_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#include "types/vulkan/vk_pipeline_layout_t.h"
+#include "utils/spirv/spirv_reflect.h"
+
+/**
+ * @brief Retrieve a shared Vulkan pipeline layout for the given reflected shader stages.
+ *
+ * This function merges the resource bindings and push constant blocks of every given stage into one interface, and returns a reference to the
+ * renderer system's pipeline layout for it - creating the layout, and any descriptor set layouts it needs, if no live layout has the same
+ * interface. Descriptor set layouts are shared in the same way, so pipelines whose shaders declare the same set share its layout, and descriptor
+ * sets allocated for one such pipeline can be bound with any other. The returned reference must be released with
+ * @ref TLVK_PipelineLayoutRelease(). This function is thread-safe.
+ *
+ * Two sets are reserved by renderer features: with `bindless_resources`, set `TLVK_BINDLESS_SET_INDEX` is always the layout of the bindless table,
+ * and with `push_descriptors`, set `TLVK_PUSH_DESCRIPTOR_SET_INDEX` is created as a push descriptor set. With `descriptor_buffers`, the layout's sets
+ * are created for the renderer system's descriptor buffer if each of them can be stored in it (see `descriptor_buffer` in
+ * @ref TLVK_PipelineLayout_t).
+ *
+ * @param renderer_system Renderer system to create the layout under
+ * @param reflections Array of `reflection_count` pointers to the reflections of each shader stage of the pipeline
+ * @param reflection_count Amount of shader stages (may be 0, for an empty layout)
+ * @return NULL if there were errors (e.g. two stages declare different resources at the same binding), otherwise a reference to the layout
+ */
+TLVK_PipelineLayout_t *TLVK_PipelineLayoutAcquire(
+    TLVK_RendererSystem_t *const renderer_system,
+    const TL_SpirvReflection_t *const *const reflections,
+    const uint32_t reflection_count
+);
+
+/**
+ * @brief Release a reference to a shared Vulkan pipeline layout.
+ *
+ * This function releases a reference acquired with @ref TLVK_PipelineLayoutAcquire(), and destroys the layout once no references remain, along
+ * with its references to its descriptor set layouts.
+ *
+ * @param renderer_system Renderer system the layout was created under
+ * @param layout NULL or the pipeline layout to release
+ */
+void TLVK_PipelineLayoutRelease(
+    TLVK_RendererSystem_t *const renderer_system,
+    TLVK_PipelineLayout_t *const layout
+);
+
+/**
+ * @brief Write every binding of a descriptor set from packed data.
+ *
+ * This function writes the descriptors of `set` from `data`, which holds the descriptors of each binding of `layout` in increasing binding order,
+ * with no padding - `descriptorCount` consecutive `VkDescriptorImageInfo` structs for samplers, images and input attachments,
+ * `VkDescriptorBufferInfo` structs for uniform and storage buffers, `VkBufferView` handles for texel buffers, or `VkAccelerationStructureKHR`
+ * handles for acceleration structures. The set is written with a single `vkUpdateDescriptorSetWithTemplate` call using the layout's update template,
+ * or with one `VkWriteDescriptorSet` per binding if the device does not support update templates.
+ *
+ * @param renderer_system Renderer system the layout was created under
+ * @param layout Layout of `set` (must not be a push descriptor set layout)
+ * @param set Descriptor set to write
+ * @param data Pointer to `layout->update_data_size` bytes of packed descriptor data
+ */
+void TLVK_DescriptorSetLayoutWrite(
+    const TLVK_RendererSystem_t *const renderer_system,
+    const TLVK_DescriptorSetLayout_t *const layout,
+    const VkDescriptorSet set,
+    const void *const data
+);
+
+/**
+ * @brief Write every binding of a descriptor set in a descriptor buffer from packed data.
+ *
+ * This function writes the descriptors of a set with the given layout to `dst` with `vkGetDescriptorEXT`, from the same packed data as
+ * @ref TLVK_DescriptorSetLayoutWrite(). As descriptors in a descriptor buffer refer to buffers by device address, uniform and storage buffers must
+ * have been created with `VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT`, and their ranges cannot be `VK_WHOLE_SIZE`.
+ *
+ * @param renderer_system Renderer system the layout was created under
+ * @param layout Layout of the set (must have been created with `VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT`)
+ * @param dst Host pointer to `layout->buffer_size` bytes of the descriptor buffer to write the set to
+ * @param data Pointer to `layout->update_data_size` bytes of packed descriptor data
+ * @return False if there were errors
+ */
+bool TLVK_DescriptorSetLayoutWriteBuffer(
+    const TLVK_RendererSystem_t *const renderer_system,
+    const TLVK_DescriptorSetLayout_t *const layout,
+    void *const dst,
+    const void *const data
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -8,16 +8,33 @@
 #include "thallium/vulkan/vk_pipeline_system.h"
 #include "types/vulkan/vk_pipeline_system_t.h"
 
+#include "lib/core/pipeline_descriptor.h"
+#include "types/core/pipeline_t.h"
 #include "types/core/renderer_t.h"
+#include "types/vulkan/vk_bindless_table_t.h"
 #include "types/vulkan/vk_renderer_system_t.h"
 #include "utils/utils.h"
 
+#include "vk_descriptor_allocator.h"
+#include "vk_pipeline_cache_entry.h"
+#include "vk_pipeline_layout.h"
+#include "vk_shader_module.h"
+
 #include <stdlib.h>
+#include <string.h>
+
+// upper bound on the amount of dynamic states a graphics pipeline can enable
+#define __MAX_DYNAMIC_STATE_COUNT 16
+
+// upper bound on the amount of vertex attributes derived from a vertex shader (the minimum guaranteed by Vulkan for maxVertexInputAttributes)
+#define __MAX_VERTEX_ATTRIBUTE_COUNT 16
 
 // See https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkGraphicsPipelineCreateInfo.html
 typedef struct __GraphicsPipelineConfig {
     uint32_t shader_stage_count;
     VkPipelineShaderStageCreateInfo *shader_stages;
+    VkVertexInputBindingDescription *vertex_bindings;
+    VkVertexInputAttributeDescription *vertex_attributes;
     VkPipelineVertexInputStateCreateInfo vertex_input_info;
     VkPipelineInputAssemblyStateCreateInfo input_assembly_info;
     VkPipelineTessellationStateCreateInfo tessellation_info;
@@ -26,19 +43,118 @@ typedef struct __GraphicsPipelineConfig {
     VkPipelineMultisampleStateCreateInfo multisample_info;
     VkPipelineDepthStencilStateCreateInfo depth_stencil_info;
     VkPipelineColorBlendStateCreateInfo colour_blend_info;
-    VkDynamicState *dynamic_states;
+    VkDynamicState dynamic_states[__MAX_DYNAMIC_STATE_COUNT];
     VkPipelineDynamicStateCreateInfo dynamic_state_info;
+    VkPipelineLayout layout;
 } __GraphicsPipelineConfig;
 
+// state of a pipeline system in a batch, between being prepared and having its pipeline state object compiled
+typedef struct __PipelineSystemBuild {
+    // NULL, or the new pipeline system being built
+    TLVK_PipelineSystem_t *pipeline_system;
+    // true if an earlier descriptor in the batch is identical, in which case its pipeline system is shared instead
+    bool duplicate;
+    uint32_t duplicate_of;
+
+    TL_PipelineDescriptor_t descriptor;
+    VkPipelineShaderStageCreateInfo stages[TLVK_PIPELINE_MAX_SHADER_STAGES];
+    uint32_t stage_count;
+    __GraphicsPipelineConfig config;
+
+    // NULL, or creation feedback chained into the pipeline's create info (see https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/
+    // VkPipelineCreationFeedbackCreateInfo.html)
+    const void *feedback_pnext;
+    VkPipelineCreationFeedbackCreateInfo feedback_info;
+    VkPipelineCreationFeedback feedback;
+    VkPipelineCreationFeedback stage_feedbacks[TLVK_PIPELINE_MAX_SHADER_STAGES];
+
+    // creation flags (derivative and descriptor buffer bits) and VK_NULL_HANDLE or the pipeline object to derive from (see
+    // https://registry.khronos.org/vulkan/specs/1.3-extensions/html/vkspec.html#pipelines-pipeline-derivatives)
+    VkPipelineCreateFlags flags;
+    VkPipeline base_pso;
+
+    VkPipeline pso;
+} __PipelineSystemBuild;
+
+
+static bool __PreparePipelineSystem(TLVK_RendererSystem_t *const renderer_system, __PipelineSystemBuild *const builds, const uint32_t index,
+    const TL_PipelineDescriptor_t *const pdescriptor, TLVK_PipelineSystem_t **const out_existing);
+
+static TLVK_PipelineSystem_t *__FinishPipelineSystem(TLVK_RendererSystem_t *const renderer_system, __PipelineSystemBuild *const build);
+
+static void __AbortPipelineSystem(TLVK_RendererSystem_t *const renderer_system, __PipelineSystemBuild *const build);
+
+static void __FreeBuildState(__PipelineSystemBuild *const build);
+
+static void __RecordCreationFeedback(const __PipelineSystemBuild *const build, TLVK_PipelineSystem_t *const pipeline_system,
+    const TL_Debugger_t *const debugger);
+
+static TL_PipelineStageCreationFeedback_t __ConvertCreationFeedback(const VkPipelineCreationFeedback *const feedback);
+
+static bool __AcquireShaderStages(TLVK_RendererSystem_t *const renderer_system, TLVK_PipelineSystem_t *const pipeline_system,
+    const TL_PipelineDescriptor_t *const descriptor, VkPipelineShaderStageCreateInfo *const out_stages, uint32_t *const out_stage_count);
+
+static void __FreeShaderStages(VkPipelineShaderStageCreateInfo *const stages, const uint32_t stage_count);
+
+static const VkSpecializationInfo *__ConfigureSpecialization(const TL_PipelineShaderDescriptor_t *const shader, const TL_Debugger_t *const debugger,
+    bool *const out_fail);
+
+static TLVK_PipelineLayout_t *__AcquirePipelineLayout(TLVK_RendererSystem_t *const renderer_system,
+    const TLVK_PipelineSystem_t *const pipeline_system);
+
+static bool __ConfigureVertexInput(__GraphicsPipelineConfig *const config, const TL_SpirvReflection_t *const reflection,
+    const TL_Debugger_t *const debugger);
+
+static TLVK_PipelineLibrary_t *__AcquirePipelineLibrary(TLVK_RendererSystem_t *const renderer_system, const TL_PipelineDescriptor_t *const descriptor,
+    const TL_PipelineStateGroupFlags_t part, const __GraphicsPipelineConfig *const config, const TLVK_PipelineLayout_t *const layout);
+
+static void __ReleasePipelineLibrary(TLVK_RendererSystem_t *const renderer_system, TLVK_PipelineLibrary_t *const library);
+
+static VkPipeline __CreateLinkedGraphicsPipeline(TLVK_RendererSystem_t *const renderer_system, const TL_PipelineDescriptor_t *const descriptor,
+    const __GraphicsPipelineConfig *const config, const TLVK_PipelineLayout_t *const layout, const void *const pnext,
+    TLVK_PipelineLibrary_t **const out_libraries);
+
+static void __OptimisePipelineJob(void *data);
 
 static __GraphicsPipelineConfig __ConfigureGraphicsPipeline(const TL_PipelineDescriptor_t descriptor, const TL_RendererFeatures_t *features);
 
-static VkPipeline __CreateGraphicsPipeline(const TLVK_FuncSet_t *devfs, const VkDevice device, const __GraphicsPipelineConfig config);
+static VkPipeline __GetBasePipeline(const TLVK_RendererSystem_t *const renderer_system, const TLVK_PipelineSystem_t *const pipeline_system,
+    const TL_Pipeline_t *const base_pipeline);
+
+static VkComputePipelineCreateInfo __DescribeComputePipeline(const VkPipelineShaderStageCreateInfo *const stage, const VkPipelineLayout layout,
+    const VkPipelineCreateFlags flags, const VkPipeline base, const void *const pnext);
+
+static VkGraphicsPipelineCreateInfo __DescribeGraphicsPipeline(const __GraphicsPipelineConfig *const config, const VkPipelineCreateFlags flags,
+    const VkPipeline base, const void *const pnext);
+
+static VkPipeline __CreateGraphicsPipeline(const TLVK_FuncSet_t *devfs, const VkDevice device, const VkPipelineCache cache,
+    const __GraphicsPipelineConfig *const config, const VkPipelineCreateFlags flags, const void *const pnext);
+
+static VkPipeline __LinkGraphicsPipeline(const TLVK_FuncSet_t *devfs, const VkDevice device, const VkPipelineCache cache,
+    TLVK_PipelineLibrary_t *const *const libraries, const VkPipelineLayout layout, const VkPipelineCreateFlags flags, const void *const pnext);
 
 
 TLVK_PipelineSystem_t *TLVK_PipelineSystemCreate(const TLVK_RendererSystem_t *const renderer_system, const TL_PipelineDescriptor_t descriptor) {
-    if (!renderer_system) {
-        return NULL;
+    TLVK_PipelineSystem_t *pipeline_system = NULL;
+
+    TLVK_PipelineSystemCreateBatch(renderer_system, 1, &descriptor, &pipeline_system);
+
+    return pipeline_system;
+}
+
+bool TLVK_PipelineSystemCreateBatch(const TLVK_RendererSystem_t *const renderer_system, const uint32_t count,
+    const TL_PipelineDescriptor_t *const descriptors, TLVK_PipelineSystem_t **const out_pipeline_systems)
+{
+    if (!renderer_system || !out_pipeline_systems || (!descriptors && count)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        out_pipeline_systems[i] = NULL;
+    }
+
+    if (!count) {
+        return true;
     }
 
     const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
@@ -47,60 +163,966 @@ TLVK_PipelineSystem_t *TLVK_PipelineSystemCreate(const TLVK_RendererSystem_t *co
     const VkDevice device = renderer_system->vk_logical_device;
     const TL_RendererFeatures_t *rfeatures = &(renderer_system->renderer->features);
 
+    // the deduplication maps are the only part of the renderer system that is modified by pipeline creation
+    TLVK_RendererSystem_t *rs = (TLVK_RendererSystem_t *) renderer_system;
+
+    __PipelineSystemBuild *builds = calloc(count, sizeof(__PipelineSystemBuild));
+    VkGraphicsPipelineCreateInfo *graphics_infos = malloc(sizeof(VkGraphicsPipelineCreateInfo) * count);
+    VkComputePipelineCreateInfo *compute_infos = malloc(sizeof(VkComputePipelineCreateInfo) * count);
+    uint32_t *graphics_builds = malloc(sizeof(uint32_t) * count);
+    uint32_t *compute_builds = malloc(sizeof(uint32_t) * count);
+    VkPipeline *psos = malloc(sizeof(VkPipeline) * count);
+    if (!builds || !graphics_infos || !compute_infos || !graphics_builds || !compute_builds || !psos) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_PipelineSystemCreateBatch");
+        free(builds);
+        free(graphics_infos);
+        free(compute_infos);
+        free(graphics_builds);
+        free(compute_builds);
+        free(psos);
+        return false;
+    }
+
+    bool ret = true;
+
+    // every pipeline is prepared before any is compiled, so that their pipeline state objects can be created together
+    for (uint32_t i = 0; i < count; i++) {
+        if (!__PreparePipelineSystem(rs, builds, i, &descriptors[i], &out_pipeline_systems[i])) {
+            ret = false;
+        }
+    }
+
+    uint32_t graphics_count = 0;
+    uint32_t compute_count = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        __PipelineSystemBuild *build = &builds[i];
+        TLVK_PipelineSystem_t *pipeline_system = build->pipeline_system;
+
+        if (!pipeline_system) {
+            continue;
+        }
+
+        switch (build->descriptor.type) {
+            case TL_PIPELINE_TYPE_GRAPHICS:
+                // linking from libraries is already cheap, and each library part has to be deduplicated before the next pipeline is linked
+                if (rfeatures->pipeline_libraries) {
+                    // a linked pipeline has no shader stages of its own, so only whole-pipeline feedback is recorded
+                    build->feedback_info.pipelineStageCreationFeedbackCount = 0;
+
+                    build->pso = __CreateLinkedGraphicsPipeline(rs, &build->descriptor, &build->config, pipeline_system->layout,
+                        build->feedback_pnext, pipeline_system->libraries);
+                    pipeline_system->vk_fast_pso = build->pso;
+                } else {
+                    graphics_infos[graphics_count] = __DescribeGraphicsPipeline(&build->config, build->flags, build->base_pso,
+                        build->feedback_pnext);
+                    graphics_builds[graphics_count++] = i;
+                }
+                break;
+            case TL_PIPELINE_TYPE_COMPUTE:
+                compute_infos[compute_count] = __DescribeComputePipeline(&build->stages[0], pipeline_system->layout->vk_layout, build->flags,
+                    build->base_pso, build->feedback_pnext);
+                compute_builds[compute_count++] = i;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // the pipelines are compiled without holding the lock, so unrelated pipelines can be compiled concurrently. Implementations may compile the
+    // pipelines of a single call in parallel; those that fail are returned as VK_NULL_HANDLE while the rest are still created.
+    if (graphics_count) {
+        memset(psos, 0, sizeof(VkPipeline) * graphics_count);
+
+        if (devfs->vkCreateGraphicsPipelines(device, renderer_system->vk_pipeline_cache, graphics_count, graphics_infos, NULL, psos)) {
+            TL_Error(debugger, "Failed to create some or all of a batch of %u Vulkan graphics pipelines", graphics_count);
+        }
+
+        for (uint32_t i = 0; i < graphics_count; i++) {
+            builds[graphics_builds[i]].pso = psos[i];
+        }
+    }
+    if (compute_count) {
+        memset(psos, 0, sizeof(VkPipeline) * compute_count);
+
+        if (devfs->vkCreateComputePipelines(device, renderer_system->vk_pipeline_cache, compute_count, compute_infos, NULL, psos)) {
+            TL_Error(debugger, "Failed to create some or all of a batch of %u Vulkan compute pipelines", compute_count);
+        }
+
+        for (uint32_t i = 0; i < compute_count; i++) {
+            builds[compute_builds[i]].pso = psos[i];
+        }
+    }
+
+    if (count > 1) {
+        TL_Log(debugger, "Compiled batch of %u Vulkan pipelines (%u graphics, %u compute in single calls)", count, graphics_count, compute_count);
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (builds[i].pipeline_system) {
+            out_pipeline_systems[i] = __FinishPipelineSystem(rs, &builds[i]);
+            if (!out_pipeline_systems[i]) {
+                ret = false;
+            }
+        }
+    }
+
+    // descriptors repeated within the batch share the pipeline system of their first occurrence, if it could be created
+    for (uint32_t i = 0; i < count; i++) {
+        if (!builds[i].duplicate) {
+            continue;
+        }
+
+        TLVK_PipelineSystem_t *original = out_pipeline_systems[builds[i].duplicate_of];
+        if (original) {
+            TLVK_PipelineCacheEntryRetain(rs, &original->entry);
+        }
+
+        out_pipeline_systems[i] = original;
+    }
+
+    free(builds);
+    free(graphics_infos);
+    free(compute_infos);
+    free(graphics_builds);
+    free(compute_builds);
+    free(psos);
+
+    return ret;
+}
+
+bool TLVK_PipelineSystemGetCreationFeedback(const TLVK_PipelineSystem_t *const pipeline_system, TL_PipelineCreationFeedback_t *const out_feedback) {
+    if (!pipeline_system || !out_feedback) {
+        return false;
+    }
+
+    // the implementation is allowed to not provide feedback even when it was requested
+    if (!pipeline_system->feedback.pipeline.valid) {
+        return false;
+    }
+
+    *out_feedback = pipeline_system->feedback;
+
+    return true;
+}
+
+bool TLVK_PipelineSystemAllocateDescriptorSet(const TLVK_PipelineSystem_t *const pipeline_system, const uint32_t set_index, const uint32_t frame,
+    const void *const data, TLVK_TransientDescriptorSet_t *const out_set)
+{
+    if (!pipeline_system || !out_set) {
+        return false;
+    }
+
+    TLVK_RendererSystem_t *renderersys = (TLVK_RendererSystem_t *) pipeline_system->renderer_system;
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    const TLVK_PipelineLayout_t *layout = pipeline_system->layout;
+
+    if (set_index >= layout->set_count) {
+        TL_Error(debugger, "TLVK_PipelineSystemAllocateDescriptorSet: the shaders of pipeline system %p do not use descriptor set %u",
+            pipeline_system, set_index);
+        return false;
+    }
+
+    const TLVK_DescriptorSetLayout_t *set_layout = layout->set_layouts[set_index];
+
+    if ((renderersys->bindless_table && set_layout == renderersys->bindless_table->set_layout) ||
+        (set_layout->flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR))
+    {
+        TL_Error(debugger, "TLVK_PipelineSystemAllocateDescriptorSet: descriptor set %u is reserved by a renderer feature", set_index);
+        return false;
+    }
+
+    // sets in the descriptor buffer are plain memory, so writing the descriptors is all there is to creating them
+    if (layout->descriptor_buffer) {
+        if (!data && set_layout->binding_count) {
+            TL_Error(debugger, "TLVK_PipelineSystemAllocateDescriptorSet: descriptor set %u is stored in the descriptor buffer, so it must be "
+                "written on allocation", set_index);
+            return false;
+        }
+
+        VkDeviceSize offset;
+        void *dst = TLVK_DescriptorAllocatorAllocateBuffer(renderersys, frame, set_layout->buffer_size, &offset);
+        if (!dst) {
+            return false;
+        }
+
+        if (set_layout->binding_count && !TLVK_DescriptorSetLayoutWriteBuffer(renderersys, set_layout, dst, data)) {
+            return false;
+        }
+
+        out_set->vk_set = VK_NULL_HANDLE;
+        out_set->buffer_offset = offset;
+
+        return true;
+    }
+
+    VkDescriptorSet set = TLVK_DescriptorAllocatorAllocate(renderersys, frame, set_layout->vk_layout);
+    if (set == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    if (data) {
+        TLVK_DescriptorSetLayoutWrite(renderersys, set_layout, set, data);
+    }
+
+    out_set->vk_set = set;
+    out_set->buffer_offset = 0;
+
+    return true;
+}
+
+void TLVK_PipelineSystemDestroy(TLVK_PipelineSystem_t *const pipeline_system) {
+    if (!pipeline_system) {
+        return;
+    }
+
+    TLVK_RendererSystem_t *renderersys = (TLVK_RendererSystem_t *) pipeline_system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const VkDevice device = renderersys->vk_logical_device;
+
+    if (!TLVK_PipelineCacheEntryRelease(renderersys, &renderersys->pipeline_systems, &pipeline_system->entry)) {
+        return;
+    }
+
+    // no references remain, so no optimisation job can still be running on this pipeline system
+    VkPipeline pso = (VkPipeline) TL_AtomicLoad64(&pipeline_system->pso);
+    if (pso != pipeline_system->vk_fast_pso) {
+        devfs->vkDestroyPipeline(device, pso, NULL);
+    }
+    if (pipeline_system->vk_fast_pso != VK_NULL_HANDLE) {
+        devfs->vkDestroyPipeline(device, pipeline_system->vk_fast_pso, NULL);
+    }
+
+    for (uint32_t i = 0; i < TLVK_PIPELINE_LIBRARY_PART_COUNT; i++) {
+        __ReleasePipelineLibrary(renderersys, pipeline_system->libraries[i]);
+    }
+    for (uint32_t i = 0; i < TLVK_PIPELINE_MAX_SHADER_STAGES; i++) {
+        TLVK_ShaderModuleRelease(renderersys, pipeline_system->shader_modules[i]);
+    }
+
+    TLVK_PipelineLayoutRelease(renderersys, pipeline_system->layout);
+
+    free(pipeline_system->entry.key);
+    free(pipeline_system);
+}
+
+
+// looks the pipeline up in the deduplication map and in the builds before it in the batch, and otherwise allocates a new pipeline system in
+// `builds[index]` and acquires everything it needs except its pipeline state object. Returns false on failure; `out_existing` is set if an existing
+// pipeline system was found in the deduplication map.
+static bool __PreparePipelineSystem(TLVK_RendererSystem_t *const renderer_system, __PipelineSystemBuild *const builds, const uint32_t index,
+    const TL_PipelineDescriptor_t *const pdescriptor, TLVK_PipelineSystem_t **const out_existing)
+{
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    const TL_RendererFeatures_t *rfeatures = &(renderer_system->renderer->features);
+
+    __PipelineSystemBuild *build = &builds[index];
+
+    // options depending on unavailable renderer features are turned off before hashing, so the fallback pipelines are deduplicated correctly
+    build->descriptor = *pdescriptor;
+    if (build->descriptor.extended_dynamic_state && !rfeatures->extended_dynamic_state) {
+        TL_Warn(debugger, "Pipeline descriptor requested extended dynamic state, but the renderer feature 'extended_dynamic_state' is not enabled; "
+            "state will be baked into the pipeline instead");
+        build->descriptor.extended_dynamic_state = false;
+    }
+
+    const TL_PipelineDescriptor_t *descriptor = &build->descriptor;
+
+    if (descriptor->type != TL_PIPELINE_TYPE_GRAPHICS && descriptor->type != TL_PIPELINE_TYPE_COMPUTE) {
+        TL_Error(debugger, "When creating Vulkan pipeline system: pipeline descriptor specified invalid pipeline type %d", descriptor->type);
+        return false;
+    }
+
+    size_t key_size = TL_PipelineDescriptorSerialize(descriptor, NULL);
+    void *key = malloc(key_size);
+    if (!key) {
+        TL_Fatal(debugger, "MALLOC fault in call to __PreparePipelineSystem");
+        return false;
+    }
+    TL_PipelineDescriptorSerialize(descriptor, key);
+
+    uint64_t hash = TL_Hash64(key, key_size, 0);
+
+    // pipeline systems being built in this batch are not in the deduplication map yet
+    for (uint32_t i = 0; i < index; i++) {
+        const TLVK_PipelineSystem_t *other = builds[i].pipeline_system;
+
+        if (other && other->entry.hash == hash && other->entry.key_size == key_size && !memcmp(other->entry.key, key, key_size)) {
+            build->duplicate = true;
+            build->duplicate_of = i;
+
+            free(key);
+            return true;
+        }
+    }
+
+    TLVK_PipelineSystem_t *existing = (TLVK_PipelineSystem_t *) TLVK_PipelineCacheEntryAcquire(renderer_system, &renderer_system->pipeline_systems,
+        hash, key, key_size);
+    if (existing) {
+        TL_Log(debugger, "Reusing Vulkan pipeline system at %p (hash 0x%016llx)", existing, (unsigned long long) hash);
+
+        *out_existing = existing;
+
+        free(key);
+        return true;
+    }
+
     TLVK_PipelineSystem_t *pipeline_system = malloc(sizeof(TLVK_PipelineSystem_t));
     if (!pipeline_system) {
-        TL_Fatal(debugger, "MALLOC fault in call to TLVK_PipelineSystemCreate");
-        return NULL;
+        TL_Fatal(debugger, "MALLOC fault in call to __PreparePipelineSystem");
+        free(key);
+        return false;
     }
 
     TL_Log(debugger, "Allocated memory for Vulkan pipeline system at %p", pipeline_system);
 
+    pipeline_system->entry.refcount = 1;
+    pipeline_system->entry.cached = false;
+    pipeline_system->entry.hash = hash;
+    pipeline_system->entry.key = key;
+    pipeline_system->entry.key_size = key_size;
+
     pipeline_system->renderer_system = renderer_system;
+    pipeline_system->vk_fast_pso = VK_NULL_HANDLE;
+    pipeline_system->derivable = false;
+    pipeline_system->layout = NULL;
+    memset(&pipeline_system->feedback, 0, sizeof(TL_PipelineCreationFeedback_t));
+    for (uint32_t i = 0; i < TLVK_PIPELINE_LIBRARY_PART_COUNT; i++) {
+        pipeline_system->libraries[i] = NULL;
+    }
+    for (uint32_t i = 0; i < TLVK_PIPELINE_MAX_SHADER_STAGES; i++) {
+        pipeline_system->shader_modules[i] = NULL;
+    }
 
-    VkPipeline pso;
-    switch (descriptor.type) {
+    build->pipeline_system = pipeline_system;
+    build->pso = VK_NULL_HANDLE;
+
+    if (!__AcquireShaderStages(renderer_system, pipeline_system, descriptor, build->stages, &build->stage_count)) {
+        TL_Error(debugger, "Failed to create Vulkan shader modules for pipeline system at %p", pipeline_system);
+        __AbortPipelineSystem(renderer_system, build);
+        return false;
+    }
+
+    pipeline_system->layout = __AcquirePipelineLayout(renderer_system, pipeline_system);
+    if (!pipeline_system->layout) {
+        TL_Error(debugger, "Failed to create Vulkan pipeline layout for pipeline system at %p", pipeline_system);
+        __AbortPipelineSystem(renderer_system, build);
+        return false;
+    }
+
+    switch (descriptor->type) {
         case TL_PIPELINE_TYPE_GRAPHICS:
-            pso = __CreateGraphicsPipeline(devfs, device, __ConfigureGraphicsPipeline(descriptor, rfeatures));
+            build->config = __ConfigureGraphicsPipeline(*descriptor, rfeatures);
+            build->config.shader_stage_count = build->stage_count;
+            build->config.shader_stages = build->stages;
+            build->config.layout = pipeline_system->layout->vk_layout;
+
+            // the dynamic states are held by the config itself, so they must be pointed to where it is finally stored
+            build->config.dynamic_state_info.pDynamicStates = build->config.dynamic_states;
+
+            if (pipeline_system->shader_modules[0] &&
+                !__ConfigureVertexInput(&build->config, &pipeline_system->shader_modules[0]->reflection, debugger))
+            {
+                TL_Error(debugger, "Failed to derive vertex input state for pipeline system at %p", pipeline_system);
+                __AbortPipelineSystem(renderer_system, build);
+                return false;
+            }
+
+            pipeline_system->bind_point = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            break;
+        case TL_PIPELINE_TYPE_COMPUTE:
+            pipeline_system->bind_point = VK_PIPELINE_BIND_POINT_COMPUTE;
             break;
         default:
-            TL_Error(debugger, "When creating Vulkan pipeline system: pipeline descriptor specified invalid pipeline type %d", descriptor.type);
-            goto outerr;
+            break;
+    }
+
+    // pipelines must be created for descriptor buffers to have their sets bound from one
+    if (pipeline_system->layout->descriptor_buffer) {
+        build->flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    }
+
+    // derivatives only apply to pipelines that are compiled as a whole, rather than linked from libraries
+    if (descriptor->type == TL_PIPELINE_TYPE_COMPUTE || !rfeatures->pipeline_libraries) {
+        if (descriptor->allow_derivatives) {
+            build->flags |= VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
+            pipeline_system->derivable = true;
+        }
+
+        build->base_pso = __GetBasePipeline(renderer_system, pipeline_system, descriptor->base_pipeline);
+        if (build->base_pso) {
+            build->flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+        }
     }
 
-    if (pso == VK_NULL_HANDLE) {
+    // the feedback structs are written by the implementation when the pipeline is compiled, so they are kept in the build until then
+    if (rfeatures->pipeline_creation_feedback) {
+        build->feedback_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+        build->feedback_info.pNext = NULL;
+        build->feedback_info.pPipelineCreationFeedback = &build->feedback;
+        build->feedback_info.pipelineStageCreationFeedbackCount = build->stage_count;
+        build->feedback_info.pPipelineStageCreationFeedbacks = build->stage_feedbacks;
+
+        build->feedback_pnext = &build->feedback_info;
+    }
+
+    return true;
+}
+
+// publishes a prepared pipeline system once its pipeline state object has been compiled (or frees it, if compilation failed) - returns the
+// pipeline system to use, which may be an equivalent one published by another thread in the meantime
+static TLVK_PipelineSystem_t *__FinishPipelineSystem(TLVK_RendererSystem_t *const renderer_system, __PipelineSystemBuild *const build) {
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    TLVK_PipelineSystem_t *pipeline_system = build->pipeline_system;
+
+    if (build->pso == VK_NULL_HANDLE) {
         TL_Error(debugger, "Failed to create Vulkan pipeline object for pipeline system at %p", pipeline_system);
-        goto outerr;
+        __AbortPipelineSystem(renderer_system, build);
+        return NULL;
+    }
+    TL_AtomicStore64(&pipeline_system->pso, (uint64_t) build->pso);
+
+    if (build->feedback_pnext) {
+        __RecordCreationFeedback(build, pipeline_system, debugger);
+    }
+
+    __FreeBuildState(build);
+    build->pipeline_system = NULL;
+
+    // another thread may have created an equivalent pipeline system while this one was compiling, in which case that one is kept
+    TLVK_PipelineSystem_t *existing = (TLVK_PipelineSystem_t *) TLVK_PipelineCacheEntryInsert(renderer_system, &renderer_system->pipeline_systems,
+        &pipeline_system->entry, debugger);
+    if (existing != pipeline_system) {
+        TL_Log(debugger, "Discarding duplicate Vulkan pipeline system at %p in favour of %p", pipeline_system, existing);
+
+        TLVK_PipelineSystemDestroy(pipeline_system);
+        return existing;
+    }
+
+    // a fast-linked pipeline is usable straight away, but may run slower than a fully optimised one; the optimised pipeline is linked in the
+    // background and swapped in when it is ready. The job holds its own reference so that the pipeline system outlives it.
+    if (pipeline_system->vk_fast_pso != VK_NULL_HANDLE) {
+        TLVK_PipelineCacheEntryRetain(renderer_system, &pipeline_system->entry);
+
+        if (!TL_WorkerPoolSubmit(renderer_system->renderer->worker_pool, __OptimisePipelineJob, pipeline_system)) {
+            TL_Warn(debugger, "Failed to queue link-time optimisation of Vulkan pipeline system at %p; the fast-linked pipeline will be kept",
+                pipeline_system);
+            TLVK_PipelineCacheEntryRelease(renderer_system, &renderer_system->pipeline_systems, &pipeline_system->entry);
+        }
     }
 
     return pipeline_system;
-outerr:
+}
+
+// frees a prepared pipeline system that will not be published, along with everything it acquired
+static void __AbortPipelineSystem(TLVK_RendererSystem_t *const renderer_system, __PipelineSystemBuild *const build) {
+    TLVK_PipelineSystem_t *pipeline_system = build->pipeline_system;
+
+    __FreeBuildState(build);
+
+    for (uint32_t i = 0; i < TLVK_PIPELINE_LIBRARY_PART_COUNT; i++) {
+        __ReleasePipelineLibrary(renderer_system, pipeline_system->libraries[i]);
+    }
+    for (uint32_t i = 0; i < TLVK_PIPELINE_MAX_SHADER_STAGES; i++) {
+        TLVK_ShaderModuleRelease(renderer_system, pipeline_system->shader_modules[i]);
+    }
+    TLVK_PipelineLayoutRelease(renderer_system, pipeline_system->layout);
+
+    free(pipeline_system->entry.key);
     free(pipeline_system);
-    return NULL;
+
+    build->pipeline_system = NULL;
 }
 
-void TLVK_PipelineSystemDestroy(TLVK_PipelineSystem_t *const pipeline_system) {
-    if (!pipeline_system) {
+// frees the creation-time state held by a build (its shader stage and graphics pipeline descriptions)
+static void __FreeBuildState(__PipelineSystemBuild *const build) {
+    __FreeShaderStages(build->stages, build->stage_count);
+    build->stage_count = 0;
+
+    free(build->config.vertex_bindings);
+    build->config.vertex_bindings = NULL;
+    build->config.vertex_attributes = NULL;
+}
+
+// copies the feedback written by the implementation into the pipeline system, and reports it to the debugger
+static void __RecordCreationFeedback(const __PipelineSystemBuild *const build, TLVK_PipelineSystem_t *const pipeline_system,
+    const TL_Debugger_t *const debugger)
+{
+    TL_PipelineCreationFeedback_t *feedback = &pipeline_system->feedback;
+
+    feedback->pipeline = __ConvertCreationFeedback(&build->feedback);
+
+    // stage feedback is written in the same order as the stages were given
+    for (uint32_t i = 0; i < build->feedback_info.pipelineStageCreationFeedbackCount; i++) {
+        TL_PipelineStageCreationFeedback_t stage_feedback = __ConvertCreationFeedback(&build->stage_feedbacks[i]);
+
+        switch (build->stages[i].stage) {
+            case VK_SHADER_STAGE_VERTEX_BIT:
+                feedback->vertex_shader = stage_feedback;
+                break;
+            case VK_SHADER_STAGE_FRAGMENT_BIT:
+                feedback->fragment_shader = stage_feedback;
+                break;
+            case VK_SHADER_STAGE_COMPUTE_BIT:
+                feedback->compute_shader = stage_feedback;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (!feedback->pipeline.valid) {
+        TL_Log(debugger, "No creation feedback was provided for Vulkan pipeline system at %p", pipeline_system);
         return;
     }
 
-    const TLVK_RendererSystem_t *renderersys = pipeline_system->renderer_system;
-    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
-    const VkDevice device = renderersys->vk_logical_device;
+    TL_Log(debugger, "Created pipeline for Vulkan pipeline system at %p in %.3f ms (pipeline cache %s)", pipeline_system,
+        (double) feedback->pipeline.duration_ns / 1000000.0, (feedback->pipeline.cache_hit) ? "hit" : "miss");
 
-    devfs->vkDestroyPipeline(device, pipeline_system->pso, NULL);
+    const struct { const char *name; const TL_PipelineStageCreationFeedback_t *feedback; } stages[] = {
+        { "vertex", &feedback->vertex_shader },
+        { "fragment", &feedback->fragment_shader },
+        { "compute", &feedback->compute_shader },
+    };
 
-    free(pipeline_system);
+    for (uint32_t i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+        if (stages[i].feedback->valid) {
+            TL_Log(debugger, "  - %s stage: %.3f ms (pipeline cache %s)", stages[i].name, (double) stages[i].feedback->duration_ns / 1000000.0,
+                (stages[i].feedback->cache_hit) ? "hit" : "miss");
+        }
+    }
+}
+
+static TL_PipelineStageCreationFeedback_t __ConvertCreationFeedback(const VkPipelineCreationFeedback *const feedback) {
+    TL_PipelineStageCreationFeedback_t ret;
+
+    ret.valid = (feedback->flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) != 0;
+    ret.cache_hit = ret.valid && (feedback->flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT);
+    ret.duration_ns = (ret.valid) ? feedback->duration : 0;
+
+    return ret;
+}
+
+// acquires a shared shader module for each shader stage used by the pipeline type into `pipeline_system->shader_modules`, and describes the stages
+// in `out_stages` (to be freed with __FreeShaderStages) - on failure, any modules that were acquired are left in `pipeline_system` to be released by
+// the caller, and `out_stage_count` still counts the stages described so far
+static bool __AcquireShaderStages(TLVK_RendererSystem_t *const renderer_system, TLVK_PipelineSystem_t *const pipeline_system,
+    const TL_PipelineDescriptor_t *const descriptor, VkPipelineShaderStageCreateInfo *const out_stages, uint32_t *const out_stage_count)
+{
+    const TL_PipelineShaderDescriptor_t *shaders[TLVK_PIPELINE_MAX_SHADER_STAGES] = { NULL };
+    VkShaderStageFlagBits shader_stages[TLVK_PIPELINE_MAX_SHADER_STAGES] = { 0 };
+
+    switch (descriptor->type) {
+        case TL_PIPELINE_TYPE_GRAPHICS:
+            // graphics shaders are optional for now, as pipelines without them were accepted before shader support was added
+            if (descriptor->vertex_shader.code) {
+                shaders[0] = &descriptor->vertex_shader;
+                shader_stages[0] = VK_SHADER_STAGE_VERTEX_BIT;
+            }
+            if (descriptor->fragment_shader.code) {
+                shaders[1] = &descriptor->fragment_shader;
+                shader_stages[1] = VK_SHADER_STAGE_FRAGMENT_BIT;
+            }
+            break;
+        case TL_PIPELINE_TYPE_COMPUTE:
+            shaders[0] = &descriptor->compute_shader;
+            shader_stages[0] = VK_SHADER_STAGE_COMPUTE_BIT;
+            break;
+        default:
+            break;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    *out_stage_count = 0;
+
+    for (uint32_t i = 0; i < TLVK_PIPELINE_MAX_SHADER_STAGES; i++) {
+        if (!shaders[i]) {
+            continue;
+        }
+
+        TLVK_ShaderModule_t *module = TLVK_ShaderModuleAcquire(renderer_system, shaders[i]);
+        if (!module) {
+            return false;
+        }
+        pipeline_system->shader_modules[i] = module;
+
+        bool fail = false;
+        const VkSpecializationInfo *specialization = __ConfigureSpecialization(shaders[i], debugger, &fail);
+        if (fail) {
+            return false;
+        }
+
+        uint32_t n = (*out_stage_count)++;
+
+        out_stages[n].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        out_stages[n].pNext = NULL;
+        out_stages[n].flags = 0;
+        out_stages[n].stage = shader_stages[i];
+        out_stages[n].module = module->vk_module;
+        out_stages[n].pName = (shaders[i]->entry_point) ? shaders[i]->entry_point : "main";
+        out_stages[n].pSpecializationInfo = specialization;
+    }
+
+    return true;
+}
+
+static void __FreeShaderStages(VkPipelineShaderStageCreateInfo *const stages, const uint32_t stage_count) {
+    for (uint32_t i = 0; i < stage_count; i++) {
+        free((void *) stages[i].pSpecializationInfo);
+        stages[i].pSpecializationInfo = NULL;
+    }
+}
+
+// returns NULL if the shader has no specialization constants, otherwise a heap-allocated specialization info (with its map entries and data in
+// the same allocation) - out_fail is set if the constants are invalid or could not be allocated
+static const VkSpecializationInfo *__ConfigureSpecialization(const TL_PipelineShaderDescriptor_t *const shader, const TL_Debugger_t *const debugger,
+    bool *const out_fail)
+{
+    if (!shader->specialization_constants || !shader->specialization_constant_count) {
+        return NULL;
+    }
+
+    uint32_t count = shader->specialization_constant_count;
+
+    size_t data_size = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t size = shader->specialization_constants[i].size;
+
+        if (size != 4 && size != 8) {
+            TL_Error(debugger, "Specialization constant %d has invalid size %d (must be 4 or 8 bytes)", shader->specialization_constants[i].id,
+                size);
+            *out_fail = true;
+            return NULL;
+        }
+
+        data_size += size;
+    }
+
+    VkSpecializationInfo *info = malloc(sizeof(VkSpecializationInfo) + sizeof(VkSpecializationMapEntry) * count + data_size);
+    if (!info) {
+        TL_Fatal(debugger, "MALLOC fault in call to __ConfigureSpecialization");
+        *out_fail = true;
+        return NULL;
+    }
+
+    VkSpecializationMapEntry *entries = (VkSpecializationMapEntry *) (info + 1);
+    unsigned char *data = (unsigned char *) (entries + count);
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const TL_PipelineSpecializationConstant_t *constant = &shader->specialization_constants[i];
+
+        entries[i].constantID = constant->id;
+        entries[i].offset = offset;
+        entries[i].size = constant->size;
+
+        memcpy(data + offset, &constant->value, constant->size);
+        offset += constant->size;
+    }
+
+    info->mapEntryCount = count;
+    info->pMapEntries = entries;
+    info->dataSize = data_size;
+    info->pData = data;
+
+    return info;
 }
 
+// returns a reference to the shared pipeline layout for the reflected interfaces of the shader modules acquired by the pipeline system
+static TLVK_PipelineLayout_t *__AcquirePipelineLayout(TLVK_RendererSystem_t *const renderer_system,
+    const TLVK_PipelineSystem_t *const pipeline_system)
+{
+    const TL_SpirvReflection_t *reflections[TLVK_PIPELINE_MAX_SHADER_STAGES];
+    uint32_t reflection_count = 0;
+
+    for (uint32_t i = 0; i < TLVK_PIPELINE_MAX_SHADER_STAGES; i++) {
+        if (pipeline_system->shader_modules[i]) {
+            reflections[reflection_count++] = &pipeline_system->shader_modules[i]->reflection;
+        }
+    }
+
+    return TLVK_PipelineLayoutAcquire(renderer_system, reflections, reflection_count);
+}
+
+// derives the vertex input state from the inputs of the vertex shader: every input is sourced from a single, tightly packed per-vertex binding
+// (binding 0), in location order - the binding and attribute descriptions are allocated together in `config->vertex_bindings`
+static bool __ConfigureVertexInput(__GraphicsPipelineConfig *const config, const TL_SpirvReflection_t *const reflection,
+    const TL_Debugger_t *const debugger)
+{
+    uint32_t attribute_count = 0;
+    for (uint32_t i = 0; i < reflection->input_count; i++) {
+        attribute_count += reflection->inputs[i].location_count;
+    }
+
+    if (!attribute_count) {
+        return true;
+    }
+
+    if (attribute_count > __MAX_VERTEX_ATTRIBUTE_COUNT) {
+        TL_Error(debugger, "Vertex shader uses %u input locations, but at most %d are supported", attribute_count, __MAX_VERTEX_ATTRIBUTE_COUNT);
+        return false;
+    }
+
+    VkVertexInputBindingDescription *binding = malloc(sizeof(VkVertexInputBindingDescription) +
+        sizeof(VkVertexInputAttributeDescription) * attribute_count);
+    if (!binding) {
+        TL_Fatal(debugger, "MALLOC fault in call to __ConfigureVertexInput");
+        return false;
+    }
+
+    VkVertexInputAttributeDescription *attributes = (VkVertexInputAttributeDescription *) (binding + 1);
+
+    // inputs are reflected in declaration order, so they are sorted by location before offsets are assigned
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < reflection->input_count; i++) {
+        const TL_SpirvInput_t *input = &reflection->inputs[i];
+
+        // only 32-bit components are supported; the formats for 1 to 4 of them are consecutive in VkFormat
+        VkFormat first_format;
+        switch (input->scalar_type) {
+            case TL_SPIRV_SCALAR_TYPE_FLOAT:
+                first_format = VK_FORMAT_R32_SFLOAT;
+                break;
+            case TL_SPIRV_SCALAR_TYPE_SINT:
+                first_format = VK_FORMAT_R32_SINT;
+                break;
+            default:
+                first_format = VK_FORMAT_R32_UINT;
+                break;
+        }
+
+        if (input->component_width != 32) {
+            TL_Error(debugger, "Vertex shader input at location %u has %u-bit components, but only 32-bit components are supported", input->location,
+                input->component_width);
+            free(binding);
+            return false;
+        }
+
+        for (uint32_t l = 0; l < input->location_count; l++) {
+            VkVertexInputAttributeDescription attribute;
+            attribute.location = input->location + l;
+            attribute.binding = 0;
+            attribute.format = (VkFormat) (first_format + 3 * (input->component_count - 1));
+            attribute.offset = input->component_count * 4;
+
+            uint32_t j = n++;
+            while (j && attributes[j - 1].location > attribute.location) {
+                attributes[j] = attributes[j - 1];
+                j--;
+            }
+            attributes[j] = attribute;
+        }
+    }
+
+    // offsets are now accumulated over the sorted attributes, each of which currently holds its own size
+    uint32_t stride = 0;
+    for (uint32_t i = 0; i < attribute_count; i++) {
+        uint32_t size = attributes[i].offset;
+        attributes[i].offset = stride;
+        stride += size;
+    }
+
+    binding->binding = 0;
+    binding->stride = stride;
+    binding->inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    config->vertex_bindings = binding;
+    config->vertex_attributes = attributes;
+    config->vertex_input_info.vertexBindingDescriptionCount = 1;
+    config->vertex_input_info.pVertexBindingDescriptions = binding;
+    config->vertex_input_info.vertexAttributeDescriptionCount = attribute_count;
+    config->vertex_input_info.pVertexAttributeDescriptions = attributes;
+
+    return true;
+}
+
+// returns a reference to the graphics pipeline library for one part of the given pipeline state, compiling it if no equivalent one is alive
+static TLVK_PipelineLibrary_t *__AcquirePipelineLibrary(TLVK_RendererSystem_t *const renderer_system, const TL_PipelineDescriptor_t *const descriptor,
+    const TL_PipelineStateGroupFlags_t part, const __GraphicsPipelineConfig *const config, const TLVK_PipelineLayout_t *const layout)
+{
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    // state derived from shader reflection rather than the descriptor is appended to the key of the parts that it is compiled into
+    const void *derived = NULL;
+    size_t derived_size = 0;
+    if (part == TL_PIPELINE_STATE_GROUP_VERTEX_INPUT_BIT && config->vertex_bindings) {
+        derived = config->vertex_bindings;
+        derived_size = sizeof(VkVertexInputBindingDescription) +
+            sizeof(VkVertexInputAttributeDescription) * config->vertex_input_info.vertexAttributeDescriptionCount;
+    } else if (part == TL_PIPELINE_STATE_GROUP_PRE_RASTERIZATION_BIT || part == TL_PIPELINE_STATE_GROUP_FRAGMENT_SHADER_BIT) {
+        derived = layout->entry.key;
+        derived_size = layout->entry.key_size;
+    }
+
+    // every library linked into a pipeline must agree on whether descriptor buffers are used, so the creation flags are part of each key
+    VkPipelineCreateFlags flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    if (layout->descriptor_buffer) {
+        flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    }
+
+    // only the state belonging to this part is serialized, so e.g. pipelines that only differ in depth testing share their vertex input library
+    size_t descriptor_key_size = TL_PipelineDescriptorSerializeGroups(descriptor, part, NULL);
+    size_t key_size = descriptor_key_size + derived_size + sizeof(VkPipelineCreateFlags);
+    void *key = malloc(key_size);
+    if (!key) {
+        TL_Fatal(debugger, "MALLOC fault in call to __AcquirePipelineLibrary");
+        return NULL;
+    }
+    TL_PipelineDescriptorSerializeGroups(descriptor, part, key);
+    if (derived_size) {
+        memcpy((unsigned char *) key + descriptor_key_size, derived, derived_size);
+    }
+    memcpy((unsigned char *) key + descriptor_key_size + derived_size, &flags, sizeof(VkPipelineCreateFlags));
+
+    uint64_t hash = TL_Hash64(key, key_size, 0);
+
+    TLVK_PipelineLibrary_t *existing = (TLVK_PipelineLibrary_t *) TLVK_PipelineCacheEntryAcquire(renderer_system,
+        &renderer_system->pipeline_libraries, hash, key, key_size);
+    if (existing) {
+        free(key);
+        return existing;
+    }
+
+    TLVK_PipelineLibrary_t *library = malloc(sizeof(TLVK_PipelineLibrary_t));
+    if (!library) {
+        TL_Fatal(debugger, "MALLOC fault in call to __AcquirePipelineLibrary");
+        free(key);
+        return NULL;
+    }
+
+    library->entry.refcount = 1;
+    library->entry.cached = false;
+    library->entry.hash = hash;
+    library->entry.key = key;
+    library->entry.key_size = key_size;
+
+    // the implementation ignores any fixed-function state outside of the part being compiled, but shader stages must only be given to the part
+    // they belong to
+    __GraphicsPipelineConfig part_config = *config;
+    VkPipelineShaderStageCreateInfo part_stages[TLVK_PIPELINE_MAX_SHADER_STAGES];
+    part_config.shader_stage_count = 0;
+    part_config.shader_stages = part_stages;
+    for (uint32_t i = 0; i < config->shader_stage_count; i++) {
+        bool fragment = (config->shader_stages[i].stage == VK_SHADER_STAGE_FRAGMENT_BIT);
+
+        if ((fragment && part == TL_PIPELINE_STATE_GROUP_FRAGMENT_SHADER_BIT) ||
+            (!fragment && part == TL_PIPELINE_STATE_GROUP_PRE_RASTERIZATION_BIT))
+        {
+            part_stages[part_config.shader_stage_count++] = config->shader_stages[i];
+        }
+    }
+
+    // (the TL_PipelineStateGroupFlags_t bits equal the VkGraphicsPipelineLibraryFlagBitsEXT bits)
+    VkGraphicsPipelineLibraryCreateInfoEXT library_info;
+    library_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    library_info.pNext = NULL;
+    library_info.flags = (VkGraphicsPipelineLibraryFlagsEXT) part;
+
+    library->vk_library = __CreateGraphicsPipeline(&renderer_system->devfs, renderer_system->vk_logical_device, renderer_system->vk_pipeline_cache,
+        &part_config, flags, &library_info);
+    if (library->vk_library == VK_NULL_HANDLE) {
+        TL_Error(debugger, "Failed to create Vulkan graphics pipeline library (part 0x%02x)", part);
+        free(key);
+        free(library);
+        return NULL;
+    }
+
+    TL_Log(debugger, "Compiled Vulkan graphics pipeline library at %p (part 0x%02x, hash 0x%016llx)", library, part, (unsigned long long) hash);
+
+    existing = (TLVK_PipelineLibrary_t *) TLVK_PipelineCacheEntryInsert(renderer_system, &renderer_system->pipeline_libraries, &library->entry,
+        debugger);
+    if (existing != library) {
+        __ReleasePipelineLibrary(renderer_system, library);
+    }
+
+    return existing;
+}
+
+static void __ReleasePipelineLibrary(TLVK_RendererSystem_t *const renderer_system, TLVK_PipelineLibrary_t *const library) {
+    if (!library) {
+        return;
+    }
+
+    if (!TLVK_PipelineCacheEntryRelease(renderer_system, &renderer_system->pipeline_libraries, &library->entry)) {
+        return;
+    }
+
+    renderer_system->devfs.vkDestroyPipeline(renderer_system->vk_logical_device, library->vk_library, NULL);
+
+    free(library->entry.key);
+    free(library);
+}
+
+// acquires a library for each part of the pipeline into `out_libraries` and fast-links them - returns VK_NULL_HANDLE on failure, in which case any
+// libraries that were acquired are left in `out_libraries` to be released by the caller
+static VkPipeline __CreateLinkedGraphicsPipeline(TLVK_RendererSystem_t *const renderer_system, const TL_PipelineDescriptor_t *const descriptor,
+    const __GraphicsPipelineConfig *const config, const TLVK_PipelineLayout_t *const layout, const void *const pnext,
+    TLVK_PipelineLibrary_t **const out_libraries)
+{
+    static const TL_PipelineStateGroupFlags_t parts[TLVK_PIPELINE_LIBRARY_PART_COUNT] = {
+        TL_PIPELINE_STATE_GROUP_VERTEX_INPUT_BIT,
+        TL_PIPELINE_STATE_GROUP_PRE_RASTERIZATION_BIT,
+        TL_PIPELINE_STATE_GROUP_FRAGMENT_SHADER_BIT,
+        TL_PIPELINE_STATE_GROUP_FRAGMENT_OUTPUT_BIT,
+    };
+
+    for (uint32_t i = 0; i < TLVK_PIPELINE_LIBRARY_PART_COUNT; i++) {
+        out_libraries[i] = __AcquirePipelineLibrary(renderer_system, descriptor, parts[i], config, layout);
+        if (!out_libraries[i]) {
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    VkPipelineCreateFlags flags = (layout->descriptor_buffer) ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0;
+
+    return __LinkGraphicsPipeline(&renderer_system->devfs, renderer_system->vk_logical_device, renderer_system->vk_pipeline_cache, out_libraries,
+        layout->vk_layout, flags, pnext);
+}
+
+// runs on a renderer worker thread, holding a reference to the pipeline system given as `data`
+static void __OptimisePipelineJob(void *data) {
+    TLVK_PipelineSystem_t *pipeline_system = (TLVK_PipelineSystem_t *) data;
+    TLVK_RendererSystem_t *renderersys = (TLVK_RendererSystem_t *) pipeline_system->renderer_system;
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+
+    // skip the work if every pipeline using the pipeline system was destroyed before the job got to run
+    TL_MutexLock(&renderersys->pipeline_systems_lock);
+    bool orphaned = (pipeline_system->entry.refcount == 1);
+    TL_MutexUnlock(&renderersys->pipeline_systems_lock);
+
+    if (!orphaned) {
+        VkPipelineCreateFlags flags = VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT;
+        if (pipeline_system->layout->descriptor_buffer) {
+            flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        }
+
+        VkPipeline pso = __LinkGraphicsPipeline(&renderersys->devfs, renderersys->vk_logical_device, renderersys->vk_pipeline_cache,
+            pipeline_system->libraries, pipeline_system->layout->vk_layout, flags, NULL);
+
+        if (pso != VK_NULL_HANDLE) {
+            TL_AtomicStore64(&pipeline_system->pso, (uint64_t) pso);
+            TL_Log(debugger, "Swapped in link-time optimised pipeline for Vulkan pipeline system at %p", pipeline_system);
+        } else {
+            TL_Warn(debugger, "Failed to link optimised pipeline for Vulkan pipeline system at %p; the fast-linked pipeline will be kept",
+                pipeline_system);
+        }
+    }
+
+    TLVK_PipelineSystemDestroy(pipeline_system);
+}
 
 static __GraphicsPipelineConfig __ConfigureGraphicsPipeline(const TL_PipelineDescriptor_t descriptor, const TL_RendererFeatures_t *features) {
     __GraphicsPipelineConfig config = { 0 };
 
-    // TODO: shader modules
+    // shader stages are filled in by the caller, which holds the references to their shader modules
     config.shader_stage_count = 0;
     config.shader_stages = NULL;
 
-    // TODO: vertex bindings and attributes
+    // vertex bindings and attributes are derived from the vertex shader by the caller, if there is one
+    config.vertex_bindings = NULL;
+    config.vertex_attributes = NULL;
     config.vertex_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     config.vertex_input_info.vertexBindingDescriptionCount = 0;
     config.vertex_input_info.pVertexBindingDescriptions = NULL;
@@ -182,51 +1204,152 @@ static __GraphicsPipelineConfig __ConfigureGraphicsPipeline(const TL_PipelineDes
     // config.colour_blend_info.blendConstants[2] =
     // config.colour_blend_info.blendConstants[3] =
 
-    config.dynamic_states = calloc(8, sizeof(VkDynamicState)); // 8 is just arbitrary, scale this as necessary when other dynamic states are supported
     uint32_t n = 0;
     if (!config.viewport_info.pViewports)
         config.dynamic_states[n++] = VK_DYNAMIC_STATE_VIEWPORT;
     if (!config.viewport_info.pScissors)
         config.dynamic_states[n++] = VK_DYNAMIC_STATE_SCISSOR;
 
+    // with extended dynamic state, the values configured above for these states are ignored and set on the command buffer instead.
+    // (the VK_DYNAMIC_STATE_*_EXT enumerators of the extensions share these values)
+    if (descriptor.extended_dynamic_state) {
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_CULL_MODE;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_FRONT_FACE;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_DEPTH_BIAS;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_LINE_WIDTH;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE;
+        config.dynamic_states[n++] = VK_DYNAMIC_STATE_DEPTH_COMPARE_OP;
+    }
+
     config.dynamic_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    config.dynamic_state_info.pDynamicStates = config.dynamic_states;
+    config.dynamic_state_info.pDynamicStates = NULL; // pointed to `dynamic_states` by the caller, once the config has been stored
     config.dynamic_state_info.dynamicStateCount = n;
 
     return config;
 }
 
-static VkPipeline __CreateGraphicsPipeline(const TLVK_FuncSet_t *devfs, const VkDevice device, const __GraphicsPipelineConfig config) {
+// returns the pipeline object that a pipeline system should be derived from, or VK_NULL_HANDLE if `base_pipeline` is NULL or cannot be used
+static VkPipeline __GetBasePipeline(const TLVK_RendererSystem_t *const renderer_system, const TLVK_PipelineSystem_t *const pipeline_system,
+    const TL_Pipeline_t *const base_pipeline)
+{
+    if (!base_pipeline) {
+        return VK_NULL_HANDLE;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    if (base_pipeline->renderer != renderer_system->renderer || TL_PipelineGetStatus(base_pipeline) != TL_PIPELINE_STATUS_READY) {
+        TL_Warn(debugger, "Base pipeline %p of pipeline system at %p is not a compiled pipeline of the same renderer; it will be ignored",
+            base_pipeline, pipeline_system);
+        return VK_NULL_HANDLE;
+    }
+
+    const TLVK_PipelineSystem_t *base_system = (const TLVK_PipelineSystem_t *) base_pipeline->pipeline_system;
+
+    if (!base_system->derivable || base_system->bind_point != pipeline_system->bind_point) {
+        TL_Warn(debugger, "Base pipeline %p of pipeline system at %p was not created with 'allow_derivatives', or is of a different type; it will "
+            "be ignored", base_pipeline, pipeline_system);
+        return VK_NULL_HANDLE;
+    }
+
+    return (VkPipeline) TL_AtomicLoad64(&base_system->pso);
+}
+
+static VkComputePipelineCreateInfo __DescribeComputePipeline(const VkPipelineShaderStageCreateInfo *const stage, const VkPipelineLayout layout,
+    const VkPipelineCreateFlags flags, const VkPipeline base, const void *const pnext)
+{
+    VkComputePipelineCreateInfo pipelineInfo;
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.pNext = pnext;
+    pipelineInfo.flags = flags;
+    pipelineInfo.stage = *stage;
+    pipelineInfo.layout = layout;
+    pipelineInfo.basePipelineIndex = -1;
+    pipelineInfo.basePipelineHandle = base;
+
+    return pipelineInfo;
+}
+
+// the returned create info points into `config`, which must outlive it
+static VkGraphicsPipelineCreateInfo __DescribeGraphicsPipeline(const __GraphicsPipelineConfig *const config, const VkPipelineCreateFlags flags,
+    const VkPipeline base, const void *const pnext)
+{
     VkGraphicsPipelineCreateInfo pipelineInfo;
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.pNext = VK_NULL_HANDLE;
-    pipelineInfo.flags = 0;
-    pipelineInfo.stageCount = config.shader_stage_count;
-    pipelineInfo.pStages = config.shader_stages;
-    pipelineInfo.pVertexInputState = &config.vertex_input_info;
-    pipelineInfo.pInputAssemblyState = &config.input_assembly_info;
-    pipelineInfo.pTessellationState = &config.tessellation_info;
-    pipelineInfo.pViewportState = &config.viewport_info;
-    pipelineInfo.pRasterizationState = &config.rasterizer_info;
-    pipelineInfo.pMultisampleState = &config.multisample_info;
-    pipelineInfo.pDepthStencilState = &config.depth_stencil_info;
-    pipelineInfo.pColorBlendState = &config.colour_blend_info;
-    pipelineInfo.pDynamicState = &config.dynamic_state_info;
-
-    // TODO: pipeline layout
-    pipelineInfo.layout = VK_NULL_HANDLE;
+    pipelineInfo.pNext = pnext;
+    pipelineInfo.flags = flags;
+    pipelineInfo.stageCount = config->shader_stage_count;
+    pipelineInfo.pStages = config->shader_stages;
+    pipelineInfo.pVertexInputState = &config->vertex_input_info;
+    pipelineInfo.pInputAssemblyState = &config->input_assembly_info;
+    pipelineInfo.pTessellationState = &config->tessellation_info;
+    pipelineInfo.pViewportState = &config->viewport_info;
+    pipelineInfo.pRasterizationState = &config->rasterizer_info;
+    pipelineInfo.pMultisampleState = &config->multisample_info;
+    pipelineInfo.pDepthStencilState = &config->depth_stencil_info;
+    pipelineInfo.pColorBlendState = &config->colour_blend_info;
+    pipelineInfo.pDynamicState = &config->dynamic_state_info;
+
+    pipelineInfo.layout = config->layout;
     // TODO: render pass
     pipelineInfo.renderPass = VK_NULL_HANDLE;
     pipelineInfo.subpass = 0;
 
+    pipelineInfo.basePipelineIndex = -1;
+    pipelineInfo.basePipelineHandle = base;
+
+    return pipelineInfo;
+}
+
+static VkPipeline __CreateGraphicsPipeline(const TLVK_FuncSet_t *devfs, const VkDevice device, const VkPipelineCache cache,
+    const __GraphicsPipelineConfig *const config, const VkPipelineCreateFlags flags, const void *const pnext)
+{
+    VkGraphicsPipelineCreateInfo pipelineInfo = __DescribeGraphicsPipeline(config, flags, VK_NULL_HANDLE, pnext);
+
+    VkPipeline pipeline;
+
+    if (devfs->vkCreateGraphicsPipelines(device, cache, 1, &pipelineInfo, NULL, &pipeline)) {
+        return VK_NULL_HANDLE;
+    }
+
+    return pipeline;
+}
+
+// links a complete graphics pipeline from one library of each part
+static VkPipeline __LinkGraphicsPipeline(const TLVK_FuncSet_t *devfs, const VkDevice device, const VkPipelineCache cache,
+    TLVK_PipelineLibrary_t *const *const libraries, const VkPipelineLayout layout, const VkPipelineCreateFlags flags, const void *const pnext)
+{
+    VkPipeline vk_libraries[TLVK_PIPELINE_LIBRARY_PART_COUNT];
+    for (uint32_t i = 0; i < TLVK_PIPELINE_LIBRARY_PART_COUNT; i++) {
+        vk_libraries[i] = libraries[i]->vk_library;
+    }
+
+    VkPipelineLibraryCreateInfoKHR library_info;
+    library_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    library_info.pNext = pnext;
+    library_info.libraryCount = TLVK_PIPELINE_LIBRARY_PART_COUNT;
+    library_info.pLibraries = vk_libraries;
+
+    // all state is taken from the libraries
+    VkGraphicsPipelineCreateInfo pipelineInfo = { 0 };
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.pNext = &library_info;
+    pipelineInfo.flags = flags;
+    pipelineInfo.layout = layout;
+
     pipelineInfo.basePipelineIndex = -1;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
     VkPipeline pipeline;
 
-    if (devfs->vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &pipeline)) {
+    if (devfs->vkCreateGraphicsPipelines(device, cache, 1, &pipelineInfo, NULL, &pipeline)) {
         return VK_NULL_HANDLE;
     }
 
-    return VK_NULL_HANDLE;
+    return pipeline;
 }
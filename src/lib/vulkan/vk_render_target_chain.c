@@ -0,0 +1,771 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "thallium/vulkan/vk_render_target_chain.h"
+#include "types/vulkan/vk_render_target_chain_t.h"
+
+#include "lib/vulkan/vk_frame_timeline.h"
+#include "thallium/vulkan/vk_command_buffer_system.h"
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include <volk/volk.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t __PickTargetCount(const TL_SwapchainLatencyPolicy_t policy);
+
+static uint32_t __GetFormatTexelSize(const VkFormat format);
+
+static bool __FindMemoryType(const VkPhysicalDevice physical_device, const uint32_t type_bits, const VkMemoryPropertyFlags required,
+    const VkMemoryPropertyFlags preferred, uint32_t *const out_index);
+
+static bool __CreateTargets(TLVK_RenderTargetChain_t *const chain);
+
+static bool __CreateReadback(TLVK_RenderTargetChain_t *const chain, TLVK_RenderTarget_t *const target);
+
+static void __DestroyTargets(TLVK_RenderTargetChain_t *const chain);
+
+static bool __WaitTargets(TLVK_RenderTargetChain_t *const chain);
+
+static bool __RecreateTargets(TLVK_RenderTargetChain_t *const chain);
+
+// retire the frame claimed on the renderer system's frame timeline by `target`, if any.
+static void __RetireTarget(const TLVK_RendererSystem_t *const renderer_system, TLVK_RenderTarget_t *const target);
+
+
+TLVK_RenderTargetChain_t *TLVK_RenderTargetChainCreate(const TLVK_RendererSystem_t *const renderer_system,
+    const TLVK_RenderTargetChainDescriptor_t descriptor)
+{
+    if (!renderer_system) {
+        return NULL;
+    }
+
+    const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    VkDevice dev = renderer_system->vk_logical_device;
+
+    if (descriptor.resolution.width == 0 || descriptor.resolution.height == 0) {
+        TL_Error(debugger, "When attempting to create Vulkan render target chain: resolution must be above 0 (got %dx%d)",
+            descriptor.resolution.width, descriptor.resolution.height);
+        return NULL;
+    }
+
+    VkFormat format = ((int) descriptor.vk_format != -1) ? descriptor.vk_format : VK_FORMAT_R8G8B8A8_UNORM;
+
+    if (descriptor.readback && !__GetFormatTexelSize(format)) {
+        TL_Error(debugger, "When attempting to create Vulkan render target chain: readback is not supported for images of format %d", format);
+        return NULL;
+    }
+
+    TLVK_RenderTargetChain_t *chain = malloc(sizeof(TLVK_RenderTargetChain_t));
+    if (!chain) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_RenderTargetChainCreate");
+        return NULL;
+    }
+
+    TL_Log(debugger, "Allocated memory for Vulkan render target chain at %p", chain);
+
+    memset(chain, 0, sizeof(TLVK_RenderTargetChain_t));
+
+    chain->renderer_system = renderer_system;
+    chain->descriptor = descriptor;
+    chain->format = format;
+
+    if (chain->descriptor.vk_final_layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+        chain->descriptor.vk_final_layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    }
+
+    chain->target_count = __PickTargetCount(descriptor.latency_policy);
+
+    for (uint32_t i = 0; i < TLVK_FRAMES_IN_FLIGHT; i++) {
+        chain->targets[i].renderer_frame = UINT32_MAX;
+    }
+
+    VkCommandPoolCreateInfo pool_info;
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.pNext = NULL;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pool_info.queueFamilyIndex = (uint32_t) renderer_system->vk_queues.graphics_family;
+
+    if (devfs->vkCreateCommandPool(dev, &pool_info, NULL, &chain->vk_command_pool)) {
+        TL_Error(debugger, "Failed to create Vulkan command pool for render target chain at %p", chain);
+        goto outerr;
+    }
+
+    VkFenceCreateInfo fence_info;
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fence_info.pNext = NULL;
+    fence_info.flags = 0;
+
+    for (uint32_t i = 0; i < chain->target_count; i++) {
+        if (devfs->vkCreateFence(dev, &fence_info, NULL, &chain->targets[i].vk_fence)) {
+            TL_Error(debugger, "Failed to create frame fence for Vulkan render target chain at %p", chain);
+            goto outerr;
+        }
+    }
+
+    if (!__CreateTargets(chain)) {
+        TL_Error(debugger, "Failed to create images of Vulkan render target chain at %p", chain);
+        goto outerr;
+    }
+
+    TL_Log(debugger, "Created Vulkan render target chain at %p", chain);
+    TL_Log(debugger, "  With extent resolution %dx%d", chain->extent.width, chain->extent.height);
+    TL_Log(debugger, "  Image count %d", chain->target_count);
+
+    return chain;
+outerr:
+    TLVK_RenderTargetChainDestroy(chain);
+    return NULL;
+}
+
+void TLVK_RenderTargetChainDestroy(TLVK_RenderTargetChain_t *const render_target_chain) {
+    if (!render_target_chain) {
+        return;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = render_target_chain->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    VkDevice dev = renderersys->vk_logical_device;
+
+    // nothing may be destroyed while frames are executing
+    __WaitTargets(render_target_chain);
+    __DestroyTargets(render_target_chain);
+
+    for (uint32_t i = 0; i < render_target_chain->target_count; i++) {
+        if (render_target_chain->targets[i].vk_fence != VK_NULL_HANDLE) {
+            devfs->vkDestroyFence(dev, render_target_chain->targets[i].vk_fence, NULL);
+        }
+    }
+
+    // readback command buffers are freed along with the pool they were allocated from
+    if (render_target_chain->vk_command_pool != VK_NULL_HANDLE) {
+        devfs->vkDestroyCommandPool(dev, render_target_chain->vk_command_pool, NULL);
+    }
+
+    free(render_target_chain);
+}
+
+TL_Extent2D_t TLVK_RenderTargetChainGetExtent(TLVK_RenderTargetChain_t *const render_target_chain) {
+    VkExtent2D vk = render_target_chain->extent;
+    TL_Extent2D_t tl = { vk.width, vk.height };
+
+    return tl;
+}
+
+VkImage TLVK_RenderTargetChainGetImage(const TLVK_RenderTargetChain_t *const render_target_chain, const uint32_t image_index) {
+    if (!render_target_chain || image_index >= render_target_chain->target_count) {
+        return VK_NULL_HANDLE;
+    }
+
+    return render_target_chain->targets[image_index].vk_image;
+}
+
+size_t TLVK_RenderTargetChainGetReadbackSize(const TLVK_RenderTargetChain_t *const render_target_chain) {
+    if (!render_target_chain) {
+        return 0;
+    }
+
+    return (size_t) render_target_chain->readback_size;
+}
+
+bool TLVK_RenderTargetChainBeginFrame(TLVK_RenderTargetChain_t *const render_target_chain, uint32_t *const out_frame_index,
+    uint32_t *const out_image_index)
+{
+    if (!render_target_chain) {
+        return false;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = render_target_chain->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    if (render_target_chain->frame_active) {
+        TL_Error(debugger, "Attempted to begin a frame of Vulkan render target chain %p while its previous frame has not been ended",
+            render_target_chain);
+        return false;
+    }
+
+    if (render_target_chain->needs_recreate) {
+        if (!__RecreateTargets(render_target_chain)) {
+            return false;
+        }
+    }
+
+    uint32_t index = (uint32_t) (render_target_chain->frame_number % render_target_chain->target_count);
+    TLVK_RenderTarget_t *target = &render_target_chain->targets[index];
+
+    // the frame that last rendered to this image must have finished before the image and its descriptor sets can be reused
+    if (target->pending) {
+        if (devfs->vkWaitForFences(dev, 1, &target->vk_fence, VK_TRUE, UINT64_MAX)) {
+            TL_Error(debugger, "Failed to wait on frame fence of Vulkan render target chain %p", render_target_chain);
+            return false;
+        }
+
+        target->pending = false;
+    }
+
+    // retiring the frame on the renderer system's timeline also frees its descriptor sets
+    __RetireTarget(renderersys, target);
+
+    // descriptor sets are allocated from a renderer-wide frame index rather than the chain's own, as other chains and swapchains allocate from
+    // the same pools
+    if (!TLVK_FrameTimelineBeginFrame((TLVK_RendererSystem_t *) renderersys, &target->renderer_frame)) {
+        target->renderer_frame = UINT32_MAX;
+        return false;
+    }
+
+    render_target_chain->frame_active = true;
+
+    if (out_frame_index) {
+        *out_frame_index = target->renderer_frame;
+    }
+    if (out_image_index) {
+        *out_image_index = index;
+    }
+
+    return true;
+}
+
+bool TLVK_RenderTargetChainEndFrame(TLVK_RenderTargetChain_t *const render_target_chain,
+    TLVK_CommandBufferSystem_t *const command_buffer_system)
+{
+    if (!render_target_chain || !command_buffer_system) {
+        return false;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = render_target_chain->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    if (!render_target_chain->frame_active) {
+        TL_Error(debugger, "Attempted to end a frame of Vulkan render target chain %p without beginning one", render_target_chain);
+        return false;
+    }
+
+    TLVK_RenderTarget_t *target = &render_target_chain->targets[render_target_chain->frame_number % render_target_chain->target_count];
+
+    render_target_chain->frame_active = false;
+
+    // there is no presentation engine to wait on, so the frame's work needs no semaphores. nothing was submitted if this fails, so the frame
+    // retires without waiting when its image is next acquired.
+    if (!TLVK_CommandBufferSystemSubmit(command_buffer_system)) {
+        TL_Error(debugger, "Failed to submit frame of Vulkan render target chain %p", render_target_chain);
+        return false;
+    }
+
+    // the readback copy is submitted after the frame's work on the same queue, and signals the frame fence once both have finished (an empty
+    // submission does the same without readback)
+    VkSubmitInfo submit_info;
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.pNext = NULL;
+    submit_info.waitSemaphoreCount = 0;
+    submit_info.pWaitSemaphores = NULL;
+    submit_info.pWaitDstStageMask = NULL;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &target->vk_readback_command_buffer;
+    submit_info.signalSemaphoreCount = 0;
+    submit_info.pSignalSemaphores = NULL;
+
+    bool readback = (target->vk_readback_command_buffer != VK_NULL_HANDLE);
+    bool ret = true;
+
+    // the fence is only reset once the frame's work has been submitted, so that a failed submission cannot leave it unsignalled for the next
+    // frame with this image to wait on forever
+    if (devfs->vkResetFences(dev, 1, &target->vk_fence) ||
+        devfs->vkQueueSubmit((VkQueue) renderersys->vk_queues.graphics.data[0], readback, readback ? &submit_info : NULL, target->vk_fence))
+    {
+        TL_Error(debugger, "Failed to submit frame fence of Vulkan render target chain %p", render_target_chain);
+
+        // the frame's work was submitted, but only the queue going idle can now tell when it has finished (and its readback, if any, is lost)
+        devfs->vkQueueWaitIdle((VkQueue) renderersys->vk_queues.graphics.data[0]);
+        ret = false;
+    } else {
+        target->pending = true;
+        target->rendered = true;
+    }
+
+    render_target_chain->frame_number++;
+
+    // a failed recreation is not an error of this frame, as it is attempted again when the next frame begins
+    if (render_target_chain->needs_recreate) {
+        __RecreateTargets(render_target_chain);
+    }
+
+    return ret;
+}
+
+bool TLVK_RenderTargetChainResize(TLVK_RenderTargetChain_t *const render_target_chain, const TL_Extent2D_t resolution) {
+    if (!render_target_chain) {
+        return false;
+    }
+
+    if (resolution.width == 0 || resolution.height == 0) {
+        TL_Error(render_target_chain->renderer_system->renderer->debugger,
+            "Attempted to resize Vulkan render target chain %p to a zero-sized extent", render_target_chain);
+        return false;
+    }
+
+    render_target_chain->descriptor.resolution = resolution;
+
+    // the image acquired for the current frame must stay alive until the frame has been submitted
+    if (render_target_chain->frame_active) {
+        render_target_chain->needs_recreate = true;
+        return true;
+    }
+
+    return __RecreateTargets(render_target_chain);
+}
+
+bool TLVK_RenderTargetChainReadImage(TLVK_RenderTargetChain_t *const render_target_chain, const uint32_t image_index, void *const out_data,
+    const size_t size)
+{
+    if (!render_target_chain || !out_data) {
+        return false;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = render_target_chain->renderer_system;
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+
+    if (!render_target_chain->descriptor.readback) {
+        TL_Error(debugger, "Attempted to read image of Vulkan render target chain %p, which was created without readback", render_target_chain);
+        return false;
+    }
+
+    if (image_index >= render_target_chain->target_count) {
+        TL_Error(debugger, "Attempted to read image %d of Vulkan render target chain %p, which only has %d images", image_index,
+            render_target_chain, render_target_chain->target_count);
+        return false;
+    }
+
+    if (size < render_target_chain->readback_size) {
+        TL_Error(debugger, "Attempted to read image of Vulkan render target chain %p into %llu bytes, but %llu bytes are required",
+            render_target_chain, (unsigned long long) size, (unsigned long long) render_target_chain->readback_size);
+        return false;
+    }
+
+    TLVK_RenderTarget_t *target = &render_target_chain->targets[image_index];
+
+    if (!target->rendered) {
+        TL_Error(debugger, "Attempted to read image %d of Vulkan render target chain %p before any frame was rendered to it", image_index,
+            render_target_chain);
+        return false;
+    }
+
+    // only the frame that rendered to this image is waited on, so other frames in flight keep executing while the image is read
+    if (target->pending) {
+        if (renderersys->devfs.vkWaitForFences(renderersys->vk_logical_device, 1, &target->vk_fence, VK_TRUE, UINT64_MAX)) {
+            TL_Error(debugger, "Failed to wait on frame fence of Vulkan render target chain %p", render_target_chain);
+            return false;
+        }
+
+        target->pending = false;
+    }
+
+    // the frame is not retired here, as it is still recording if the image belongs to the current frame - the next frame to acquire the image (or
+    // the next wait on every target) retires it instead
+    memcpy(out_data, target->readback_mapped, (size_t) render_target_chain->readback_size);
+
+    return true;
+}
+
+
+static uint32_t __PickTargetCount(const TL_SwapchainLatencyPolicy_t policy) {
+    switch (policy) {
+        case TL_SWAPCHAIN_LATENCY_POLICY_LOW_LATENCY:
+            return 1;
+        case TL_SWAPCHAIN_LATENCY_POLICY_HIGH_THROUGHPUT:
+            return TLVK_FRAMES_IN_FLIGHT;
+        case TL_SWAPCHAIN_LATENCY_POLICY_BALANCED:
+        default:
+            return 2;
+    }
+}
+
+// Get the size in bytes of one texel of the given format, or 0 if readback of the format is not supported.
+static uint32_t __GetFormatTexelSize(const VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_R8_SRGB:
+            return 1;
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R8G8_SRGB:
+        case VK_FORMAT_R16_SFLOAT:
+            return 2;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+        case VK_FORMAT_R16G16_SFLOAT:
+        case VK_FORMAT_R32_SFLOAT:
+            return 4;
+        case VK_FORMAT_R16G16B16A16_UNORM:
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+        case VK_FORMAT_R32G32_SFLOAT:
+            return 8;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+// `preferred` property flags are used to pick between the memory types that have every `required` flag.
+static bool __FindMemoryType(const VkPhysicalDevice physical_device, const uint32_t type_bits, const VkMemoryPropertyFlags required,
+    const VkMemoryPropertyFlags preferred, uint32_t *const out_index)
+{
+    VkPhysicalDeviceMemoryProperties properties;
+    vkGetPhysicalDeviceMemoryProperties(physical_device, &properties);
+
+    bool found = false;
+    for (uint32_t i = 0; i < properties.memoryTypeCount; i++) {
+        VkMemoryPropertyFlags flags = properties.memoryTypes[i].propertyFlags;
+
+        if (!(type_bits & (1u << i)) || (flags & required) != required) {
+            continue;
+        }
+
+        if ((flags & preferred) == preferred) {
+            *out_index = i;
+            return true;
+        }
+
+        if (!found) {
+            *out_index = i;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+static bool __CreateTargets(TLVK_RenderTargetChain_t *const chain) {
+    const TLVK_RendererSystem_t *renderersys = chain->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    chain->extent.width = chain->descriptor.resolution.width;
+    chain->extent.height = chain->descriptor.resolution.height;
+    chain->readback_size = (chain->descriptor.readback) ?
+        (VkDeviceSize) chain->extent.width * chain->extent.height * __GetFormatTexelSize(chain->format) : 0;
+
+    VkImageCreateInfo image_info;
+    image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.pNext = NULL;
+    image_info.flags = 0;
+    image_info.imageType = VK_IMAGE_TYPE_2D;
+    image_info.format = chain->format;
+    image_info.extent.width = chain->extent.width;
+    image_info.extent.height = chain->extent.height;
+    image_info.extent.depth = 1;
+    image_info.mipLevels = 1;
+    image_info.arrayLayers = 1;
+    image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | chain->descriptor.vk_image_usage;
+    image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image_info.queueFamilyIndexCount = 0;
+    image_info.pQueueFamilyIndices = NULL;
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    for (uint32_t i = 0; i < chain->target_count; i++) {
+        TLVK_RenderTarget_t *target = &chain->targets[i];
+
+        target->rendered = false;
+
+        if (devfs->vkCreateImage(dev, &image_info, NULL, &target->vk_image)) {
+            TL_Error(debugger, "Failed to create Vulkan image %d of render target chain %p", i, chain);
+            goto outerr;
+        }
+
+        VkMemoryRequirements requirements;
+        devfs->vkGetImageMemoryRequirements(dev, target->vk_image, &requirements);
+
+        VkMemoryAllocateInfo memory_info;
+        memory_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        memory_info.pNext = NULL;
+        memory_info.allocationSize = requirements.size;
+
+        if (!__FindMemoryType(renderersys->vk_physical_device, requirements.memoryTypeBits, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            &memory_info.memoryTypeIndex))
+        {
+            TL_Error(debugger, "Failed to create Vulkan image %d of render target chain %p: no memory type is suitable", i, chain);
+            goto outerr;
+        }
+
+        if (devfs->vkAllocateMemory(dev, &memory_info, NULL, &target->vk_image_memory)) {
+            TL_Error(debugger, "Failed to allocate memory for Vulkan image %d of render target chain %p (%llu bytes)", i, chain,
+                (unsigned long long) requirements.size);
+            goto outerr;
+        }
+
+        if (devfs->vkBindImageMemory(dev, target->vk_image, target->vk_image_memory, 0)) {
+            TL_Error(debugger, "Failed to bind memory of Vulkan image %d of render target chain %p", i, chain);
+            goto outerr;
+        }
+
+        if (chain->descriptor.readback && !__CreateReadback(chain, target)) {
+            goto outerr;
+        }
+    }
+
+    return true;
+
+outerr:
+    __DestroyTargets(chain);
+    return false;
+}
+
+static bool __CreateReadback(TLVK_RenderTargetChain_t *const chain, TLVK_RenderTarget_t *const target) {
+    const TLVK_RendererSystem_t *renderersys = chain->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    VkBufferCreateInfo buffer_info;
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.pNext = NULL;
+    buffer_info.flags = 0;
+    buffer_info.size = chain->readback_size;
+    buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    buffer_info.queueFamilyIndexCount = 0;
+    buffer_info.pQueueFamilyIndices = NULL;
+
+    if (devfs->vkCreateBuffer(dev, &buffer_info, NULL, &target->vk_readback_buffer)) {
+        TL_Error(debugger, "Failed to create Vulkan readback buffer of render target chain %p (%llu bytes)", chain,
+            (unsigned long long) buffer_info.size);
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    devfs->vkGetBufferMemoryRequirements(dev, target->vk_readback_buffer, &requirements);
+
+    VkMemoryAllocateInfo memory_info;
+    memory_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memory_info.pNext = NULL;
+    memory_info.allocationSize = requirements.size;
+
+    // the host only ever reads this memory, which is much faster from cached memory
+    if (!__FindMemoryType(renderersys->vk_physical_device, requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+        &memory_info.memoryTypeIndex))
+    {
+        TL_Error(debugger, "Failed to create Vulkan readback buffer of render target chain %p: no host-visible memory type is suitable", chain);
+        return false;
+    }
+
+    if (devfs->vkAllocateMemory(dev, &memory_info, NULL, &target->vk_readback_memory)) {
+        TL_Error(debugger, "Failed to allocate memory for Vulkan readback buffer of render target chain %p (%llu bytes)", chain,
+            (unsigned long long) requirements.size);
+        return false;
+    }
+
+    if (devfs->vkBindBufferMemory(dev, target->vk_readback_buffer, target->vk_readback_memory, 0)) {
+        TL_Error(debugger, "Failed to bind memory of Vulkan readback buffer of render target chain %p", chain);
+        return false;
+    }
+
+    if (devfs->vkMapMemory(dev, target->vk_readback_memory, 0, VK_WHOLE_SIZE, 0, &target->readback_mapped)) {
+        TL_Error(debugger, "Failed to map memory of Vulkan readback buffer of render target chain %p", chain);
+        return false;
+    }
+
+    // the copy is the same in every frame, so it is only recorded once for each image
+    VkCommandBufferAllocateInfo alloc_info;
+    alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    alloc_info.pNext = NULL;
+    alloc_info.commandPool = chain->vk_command_pool;
+    alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc_info.commandBufferCount = 1;
+
+    if (devfs->vkAllocateCommandBuffers(dev, &alloc_info, &target->vk_readback_command_buffer)) {
+        TL_Error(debugger, "Failed to allocate Vulkan readback command buffer of render target chain %p", chain);
+        return false;
+    }
+
+    VkCommandBuffer cmd = target->vk_readback_command_buffer;
+
+    VkCommandBufferBeginInfo begin_info;
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.pNext = NULL;
+    begin_info.flags = 0;
+    begin_info.pInheritanceInfo = NULL;
+
+    if (devfs->vkBeginCommandBuffer(cmd, &begin_info)) {
+        TL_Error(debugger, "Failed to begin Vulkan readback command buffer of render target chain %p", chain);
+        return false;
+    }
+
+    // the frame's work was submitted earlier on the same queue and left the image in the chain's final layout, so its writes only need to be made
+    // visible to the copy along with the transition
+    VkImageMemoryBarrier image_barrier;
+    image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barrier.pNext = NULL;
+    image_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    image_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    image_barrier.oldLayout = chain->descriptor.vk_final_layout;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.image = target->vk_image;
+    image_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_barrier.subresourceRange.baseMipLevel = 0;
+    image_barrier.subresourceRange.levelCount = 1;
+    image_barrier.subresourceRange.baseArrayLayer = 0;
+    image_barrier.subresourceRange.layerCount = 1;
+
+    devfs->vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, NULL, 0, NULL, 1, &image_barrier);
+
+    VkBufferImageCopy region;
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset.x = 0;
+    region.imageOffset.y = 0;
+    region.imageOffset.z = 0;
+    region.imageExtent.width = chain->extent.width;
+    region.imageExtent.height = chain->extent.height;
+    region.imageExtent.depth = 1;
+
+    devfs->vkCmdCopyImageToBuffer(cmd, target->vk_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, target->vk_readback_buffer, 1, &region);
+
+    // the image goes back to the final layout for the next frame that uses it, which only has to wait for the copy to finish reading it
+    image_barrier.srcAccessMask = 0;
+    image_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_barrier.newLayout = chain->descriptor.vk_final_layout;
+
+    // signalling the frame fence does not make the copied data available to the host by itself
+    VkBufferMemoryBarrier host_barrier;
+    host_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    host_barrier.pNext = NULL;
+    host_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    host_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    host_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    host_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    host_barrier.buffer = target->vk_readback_buffer;
+    host_barrier.offset = 0;
+    host_barrier.size = VK_WHOLE_SIZE;
+
+    devfs->vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0, 0, NULL, 1,
+        &host_barrier, 1, &image_barrier);
+
+    if (devfs->vkEndCommandBuffer(cmd)) {
+        TL_Error(debugger, "Failed to end Vulkan readback command buffer of render target chain %p", chain);
+        return false;
+    }
+
+    return true;
+}
+
+static void __DestroyTargets(TLVK_RenderTargetChain_t *const chain) {
+    const TLVK_RendererSystem_t *renderersys = chain->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    VkDevice dev = renderersys->vk_logical_device;
+
+    for (uint32_t i = 0; i < chain->target_count; i++) {
+        TLVK_RenderTarget_t *target = &chain->targets[i];
+
+        if (target->vk_readback_command_buffer != VK_NULL_HANDLE) {
+            devfs->vkFreeCommandBuffers(dev, chain->vk_command_pool, 1, &target->vk_readback_command_buffer);
+        }
+        if (target->vk_readback_buffer != VK_NULL_HANDLE) {
+            devfs->vkDestroyBuffer(dev, target->vk_readback_buffer, NULL);
+        }
+        if (target->vk_readback_memory != VK_NULL_HANDLE) {
+            devfs->vkFreeMemory(dev, target->vk_readback_memory, NULL); // implicitly unmapped
+        }
+        if (target->vk_image != VK_NULL_HANDLE) {
+            devfs->vkDestroyImage(dev, target->vk_image, NULL);
+        }
+        if (target->vk_image_memory != VK_NULL_HANDLE) {
+            devfs->vkFreeMemory(dev, target->vk_image_memory, NULL);
+        }
+
+        target->vk_readback_command_buffer = VK_NULL_HANDLE;
+        target->vk_readback_buffer = VK_NULL_HANDLE;
+        target->vk_readback_memory = VK_NULL_HANDLE;
+        target->readback_mapped = NULL;
+        target->vk_image = VK_NULL_HANDLE;
+        target->vk_image_memory = VK_NULL_HANDLE;
+        target->rendered = false;
+    }
+}
+
+static bool __WaitTargets(TLVK_RenderTargetChain_t *const chain) {
+    const TLVK_RendererSystem_t *renderersys = chain->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    VkDevice dev = renderersys->vk_logical_device;
+
+    bool result = true;
+
+    for (uint32_t i = 0; i < chain->target_count; i++) {
+        TLVK_RenderTarget_t *target = &chain->targets[i];
+
+        if (target->pending) {
+            if (devfs->vkWaitForFences(dev, 1, &target->vk_fence, VK_TRUE, UINT64_MAX)) {
+                result = false;
+                continue;
+            }
+
+            target->pending = false;
+        }
+
+        __RetireTarget(renderersys, target);
+    }
+
+    return result;
+}
+
+static bool __RecreateTargets(TLVK_RenderTargetChain_t *const chain) {
+    const TL_Debugger_t *debugger = chain->renderer_system->renderer->debugger;
+
+    // unlike swapchain images, nothing outside of the chain's own frames can be using the images, so only those frames are waited on
+    if (!__WaitTargets(chain)) {
+        TL_Error(debugger, "Failed to wait on frame fences of Vulkan render target chain %p", chain);
+        return false;
+    }
+
+    __DestroyTargets(chain);
+
+    if (!__CreateTargets(chain)) {
+        TL_Error(debugger, "Failed to recreate images of Vulkan render target chain %p", chain);
+        chain->needs_recreate = true;
+        return false;
+    }
+
+    chain->needs_recreate = false;
+
+    TL_Log(debugger, "Recreated images of Vulkan render target chain %p with extent resolution %dx%d", chain, chain->extent.width,
+        chain->extent.height);
+
+    return true;
+}
+
+static void __RetireTarget(const TLVK_RendererSystem_t *const renderer_system, TLVK_RenderTarget_t *const target) {
+    if (target->renderer_frame == UINT32_MAX) {
+        return;
+    }
+
+    TLVK_FrameTimelineRetireFrame((TLVK_RendererSystem_t *) renderer_system, target->renderer_frame);
+    target->renderer_frame = UINT32_MAX;
+}
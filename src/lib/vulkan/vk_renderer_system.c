@@ -6,6 +6,7 @@
  */
 
 #include "thallium/vulkan/vk_renderer_system.h"
+#include "thallium/vulkan/vk_bindless_table.h"
 #include "types/vulkan/vk_renderer_system_t.h"
 
 #include "types/core/context_t.h"
@@ -13,7 +14,9 @@
 #include "utils/io/log.h"
 
 #include "vk_context_block.h"
+#include "vk_descriptor_allocator.h"
 #include "vk_device.h"
+#include "vk_frame_timeline.h"
 
 #include <volk/volk.h>
 
@@ -53,10 +56,12 @@ TLVK_RendererSystem_t *TLVK_RendererSystemCreate(TL_Renderer_t *const renderer,
     renderer_system->vk_physical_device = physdev;
 
     VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physdev, &props);
+
+    renderer_system->vk_device_limits = props.limits;
 
     // print information about the selected physical device
     if (debugger) {
-        vkGetPhysicalDeviceProperties(physdev, &props);
 
         TL_Note(debugger, "Vulkan renderer system %p physical device selection - this renderer system will use the following GPU:", renderer_system);
         TL_Note(debugger, "  %s", props.deviceName);
@@ -105,12 +110,57 @@ TLVK_RendererSystem_t *TLVK_RendererSystemCreate(TL_Renderer_t *const renderer,
     }
     renderer_system->vk_logical_device = dev;
 
+    // features that turned out to be unavailable were disabled while creating the device
+    renderer->features = rendfeatures;
+
     // store queue family indices
     renderer_system->vk_queues.graphics_family = qf.graphics;
     renderer_system->vk_queues.compute_family = qf.compute;
     renderer_system->vk_queues.transfer_family = qf.transfer;
     renderer_system->vk_queues.present_family = qf.present;
 
+    // the driver synchronises access to the pipeline cache internally, so one cache can be shared by synchronous and asynchronous creation
+    VkPipelineCacheCreateInfo pipeline_cache_info;
+    pipeline_cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipeline_cache_info.pNext = NULL;
+    pipeline_cache_info.flags = 0;
+    pipeline_cache_info.initialDataSize = 0;
+    pipeline_cache_info.pInitialData = NULL;
+
+    if (renderer_system->devfs.vkCreatePipelineCache(dev, &pipeline_cache_info, NULL, &renderer_system->vk_pipeline_cache)) {
+        TL_Warn(debugger, "Failed to create Vulkan pipeline cache in renderer system %p; pipelines will be compiled without one", renderer_system);
+        renderer_system->vk_pipeline_cache = VK_NULL_HANDLE;
+    }
+
+    renderer_system->pipeline_systems = (TL_HashMap_t) { 0 };
+    renderer_system->pipeline_libraries = (TL_HashMap_t) { 0 };
+    renderer_system->shader_modules = (TL_HashMap_t) { 0 };
+    renderer_system->pipeline_layouts = (TL_HashMap_t) { 0 };
+    renderer_system->descriptor_set_layouts = (TL_HashMap_t) { 0 };
+    renderer_system->samplers = (TL_HashMap_t) { 0 };
+    TL_MutexInit(&renderer_system->pipeline_systems_lock);
+
+    TL_AtomicStore64(&renderer_system->sampler_count, 0);
+    TL_AtomicStore64(&renderer_system->sampler_cache_hits, 0);
+    TL_AtomicStore64(&renderer_system->sampler_cache_misses, 0);
+
+    TLVK_FrameTimelineInit(renderer_system);
+    TLVK_DescriptorAllocatorInit(renderer_system);
+
+    if (renderer->features.descriptor_buffers && !TLVK_DescriptorAllocatorCreateBuffer(renderer_system)) {
+        renderer->features.descriptor_buffers = false;
+        TL_Error(debugger, "Failed to create descriptor buffer in Vulkan renderer system %p - 'descriptor_buffers' was disabled!", renderer_system);
+    }
+
+    renderer_system->bindless_table = NULL;
+    if (renderer->features.bindless_resources) {
+        renderer_system->bindless_table = TLVK_BindlessTableCreate(renderer_system);
+        if (!renderer_system->bindless_table) {
+            renderer->features.bindless_resources = false;
+            TL_Error(debugger, "Failed to create bindless table in Vulkan renderer system %p - 'bindless_resources' was disabled!", renderer_system);
+        }
+    }
+
     if (debugger) {
         TL_Log(debugger, "Created Vulkan device object at %p in Thallium Vulkan renderer system %p", dev, renderer_system);
 
@@ -150,6 +200,23 @@ void TLVK_RendererSystemDestroy(TLVK_RendererSystem_t *const renderer_system) {
 
     const TLVK_FuncSet_t *devfs = &(renderer_system->devfs);
 
+    // the bindless table releases its set layout through the deduplication maps, so it goes before them and their lock
+    TLVK_BindlessTableDestroy(renderer_system->bindless_table);
+    TLVK_DescriptorAllocatorDestroy(renderer_system);
+    TLVK_FrameTimelineDestroy(renderer_system);
+
+    TL_HashMapFree(&renderer_system->pipeline_systems);
+    TL_HashMapFree(&renderer_system->pipeline_libraries);
+    TL_HashMapFree(&renderer_system->shader_modules);
+    TL_HashMapFree(&renderer_system->pipeline_layouts);
+    TL_HashMapFree(&renderer_system->descriptor_set_layouts);
+    TL_HashMapFree(&renderer_system->samplers);
+    TL_MutexDestroy(&renderer_system->pipeline_systems_lock);
+
+    if (renderer_system->vk_pipeline_cache != VK_NULL_HANDLE) {
+        devfs->vkDestroyPipelineCache(renderer_system->vk_logical_device, renderer_system->vk_pipeline_cache, NULL);
+    }
+
     devfs->vkDestroyDevice(renderer_system->vk_logical_device, NULL);
 
     carrayfree(&renderer_system->device_extensions);
@@ -0,0 +1,179 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "thallium/vulkan/vk_sampler_cache.h"
+#include "types/vulkan/vk_sampler_t.h"
+
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include "vk_pipeline_cache_entry.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// amount of 32-bit words in a serialized sampler key (every member of VkSamplerCreateInfo after pNext)
+#define __SAMPLER_KEY_WORD_COUNT 16
+
+
+static void __SerializeSampler(const VkSamplerCreateInfo *const info, uint32_t *const key);
+
+static uint32_t __FloatBits(const float value);
+
+
+TLVK_Sampler_t *TLVK_SamplerCacheAcquire(TLVK_RendererSystem_t *const renderer_system, const VkSamplerCreateInfo *const info) {
+    if (!renderer_system || !info) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    if (info->pNext) {
+        TL_Error(debugger, "When acquiring Vulkan sampler: extension structures (pNext) are not supported by the sampler cache");
+        return NULL;
+    }
+
+    uint32_t *key = malloc(sizeof(uint32_t) * __SAMPLER_KEY_WORD_COUNT);
+    if (!key) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_SamplerCacheAcquire");
+        return NULL;
+    }
+    __SerializeSampler(info, key);
+
+    size_t key_size = sizeof(uint32_t) * __SAMPLER_KEY_WORD_COUNT;
+    uint64_t hash = TL_Hash64(key, key_size, 0);
+
+    TLVK_Sampler_t *existing = (TLVK_Sampler_t *) TLVK_PipelineCacheEntryAcquire(renderer_system, &renderer_system->samplers, hash, key, key_size);
+    if (existing) {
+        TL_AtomicAdd64(&renderer_system->sampler_cache_hits, 1);
+        free(key);
+        return existing;
+    }
+
+    TL_AtomicAdd64(&renderer_system->sampler_cache_misses, 1);
+
+    // the slot is reserved before creating the sampler, so that concurrent acquisitions can never exceed the limit between them
+    uint32_t max_count = renderer_system->vk_device_limits.maxSamplerAllocationCount;
+    uint32_t count = (uint32_t) TL_AtomicAdd64(&renderer_system->sampler_count, 1);
+    if (count > max_count) {
+        TL_AtomicSub64(&renderer_system->sampler_count, 1);
+        TL_Error(debugger, "When acquiring Vulkan sampler: the device's sampler allocation limit (%u) has been reached", max_count);
+        free(key);
+        return NULL;
+    }
+    if (count == max_count - max_count / 4) {
+        TL_Warn(debugger, "%u of the device's %u sampler allocations are in use in Vulkan renderer system %p", count, max_count, renderer_system);
+    }
+
+    TLVK_Sampler_t *sampler = malloc(sizeof(TLVK_Sampler_t));
+    if (!sampler) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_SamplerCacheAcquire");
+        TL_AtomicSub64(&renderer_system->sampler_count, 1);
+        free(key);
+        return NULL;
+    }
+
+    sampler->entry.refcount = 1;
+    sampler->entry.cached = false;
+    sampler->entry.hash = hash;
+    sampler->entry.key = key;
+    sampler->entry.key_size = key_size;
+
+    sampler->renderer_system = renderer_system;
+
+    if (renderer_system->devfs.vkCreateSampler(renderer_system->vk_logical_device, info, NULL, &sampler->vk_sampler)) {
+        TL_Error(debugger, "Failed to create Vulkan sampler");
+        TL_AtomicSub64(&renderer_system->sampler_count, 1);
+        free(key);
+        free(sampler);
+        return NULL;
+    }
+
+    TL_Log(debugger, "Created Vulkan sampler at %p (hash 0x%016llx, %u live)", sampler, (unsigned long long) hash, count);
+
+    existing = (TLVK_Sampler_t *) TLVK_PipelineCacheEntryInsert(renderer_system, &renderer_system->samplers, &sampler->entry, debugger);
+    if (existing != sampler) {
+        TLVK_SamplerCacheRelease(sampler);
+    }
+
+    return existing;
+}
+
+void TLVK_SamplerCacheRelease(TLVK_Sampler_t *const sampler) {
+    if (!sampler) {
+        return;
+    }
+
+    TLVK_RendererSystem_t *renderer_system = sampler->renderer_system;
+
+    if (!TLVK_PipelineCacheEntryRelease(renderer_system, &renderer_system->samplers, &sampler->entry)) {
+        return;
+    }
+
+    renderer_system->devfs.vkDestroySampler(renderer_system->vk_logical_device, sampler->vk_sampler, NULL);
+    TL_AtomicSub64(&renderer_system->sampler_count, 1);
+
+    free(sampler->entry.key);
+    free(sampler);
+}
+
+VkSampler TLVK_SamplerGetHandle(const TLVK_Sampler_t *const sampler) {
+    if (!sampler) {
+        return VK_NULL_HANDLE;
+    }
+
+    return sampler->vk_sampler;
+}
+
+void TLVK_SamplerCacheGetStats(TLVK_RendererSystem_t *const renderer_system, TLVK_SamplerCacheStats_t *const out_stats) {
+    if (!renderer_system || !out_stats) {
+        return;
+    }
+
+    // the counters are only read atomically one by one, so the statistics are approximate while other threads acquire or release samplers
+    out_stats->sampler_count = (uint32_t) TL_AtomicLoad64(&renderer_system->sampler_count);
+    out_stats->max_sampler_count = renderer_system->vk_device_limits.maxSamplerAllocationCount;
+    out_stats->hit_count = TL_AtomicLoad64(&renderer_system->sampler_cache_hits);
+    out_stats->miss_count = TL_AtomicLoad64(&renderer_system->sampler_cache_misses);
+}
+
+
+static void __SerializeSampler(const VkSamplerCreateInfo *const info, uint32_t *const key) {
+    bool uses_border =
+        info->addressModeU == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER ||
+        info->addressModeV == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER ||
+        info->addressModeW == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+
+    // members that the device ignores are zeroed, so that samplers differing only in those share one handle
+    key[0] = info->flags;
+    key[1] = info->magFilter;
+    key[2] = info->minFilter;
+    key[3] = info->mipmapMode;
+    key[4] = info->addressModeU;
+    key[5] = info->addressModeV;
+    key[6] = info->addressModeW;
+    key[7] = __FloatBits(info->mipLodBias);
+    key[8] = info->anisotropyEnable;
+    key[9] = info->anisotropyEnable ? __FloatBits(info->maxAnisotropy) : 0;
+    key[10] = info->compareEnable;
+    key[11] = info->compareEnable ? info->compareOp : 0;
+    key[12] = __FloatBits(info->minLod);
+    key[13] = __FloatBits(info->maxLod);
+    key[14] = uses_border ? info->borderColor : 0;
+    key[15] = info->unnormalizedCoordinates;
+}
+
+static uint32_t __FloatBits(const float value) {
+    // normalise -0.0 to 0.0 so that both produce the same key
+    float v = (value == 0.0f) ? 0.0f : value;
+
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(float));
+
+    return bits;
+}
@@ -0,0 +1,116 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "vk_shader_module.h"
+
+#include "types/core/renderer_t.h"
+#include "types/vulkan/vk_renderer_system_t.h"
+#include "utils/utils.h"
+
+#include "vk_pipeline_cache_entry.h"
+
+#include <stdlib.h>
+
+// collision check for a shader module: rather than keeping a copy of the code, the size and a second, differently seeded hash are compared
+typedef struct __ShaderModuleKey {
+    uint64_t code_size;
+    uint64_t check_hash;
+} __ShaderModuleKey;
+
+
+TLVK_ShaderModule_t *TLVK_ShaderModuleAcquire(TLVK_RendererSystem_t *const renderer_system, const TL_PipelineShaderDescriptor_t *const shader) {
+    if (!renderer_system || !shader) {
+        return NULL;
+    }
+
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+
+    if (!shader->code || !shader->code_size) {
+        TL_Error(debugger, "When creating Vulkan shader module: no shader code was specified");
+        return NULL;
+    }
+
+    __ShaderModuleKey *key = malloc(sizeof(__ShaderModuleKey));
+    if (!key) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_ShaderModuleAcquire");
+        return NULL;
+    }
+    key->code_size = shader->code_size;
+    key->check_hash = TL_Hash64(shader->code, shader->code_size, 1);
+
+    uint64_t hash = TL_Hash64(shader->code, shader->code_size, 0);
+
+    TLVK_ShaderModule_t *existing = (TLVK_ShaderModule_t *) TLVK_PipelineCacheEntryAcquire(renderer_system, &renderer_system->shader_modules,
+        hash, key, sizeof(__ShaderModuleKey));
+    if (existing) {
+        free(key);
+        return existing;
+    }
+
+    TLVK_ShaderModule_t *module = malloc(sizeof(TLVK_ShaderModule_t));
+    if (!module) {
+        TL_Fatal(debugger, "MALLOC fault in call to TLVK_ShaderModuleAcquire");
+        free(key);
+        return NULL;
+    }
+
+    module->entry.refcount = 1;
+    module->entry.cached = false;
+    module->entry.hash = hash;
+    module->entry.key = key;
+    module->entry.key_size = sizeof(__ShaderModuleKey);
+
+    // reflection is done here rather than per pipeline, so that each distinct module is only ever parsed once
+    if (!TL_SpirvReflect(shader->code, shader->code_size, &module->reflection, debugger)) {
+        TL_Error(debugger, "Failed to reflect SPIR-V code of Vulkan shader module");
+        free(key);
+        free(module);
+        return NULL;
+    }
+
+    // the code is passed straight through, so code mapped from a file is read by the driver without being copied first
+    VkShaderModuleCreateInfo module_info;
+    module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    module_info.pNext = NULL;
+    module_info.flags = 0;
+    module_info.codeSize = shader->code_size;
+    module_info.pCode = shader->code;
+
+    if (renderer_system->devfs.vkCreateShaderModule(renderer_system->vk_logical_device, &module_info, NULL, &module->vk_module)) {
+        TL_Error(debugger, "Failed to create Vulkan shader module (%llu bytes of code)", (unsigned long long) shader->code_size);
+        TL_SpirvReflectionFree(&module->reflection);
+        free(key);
+        free(module);
+        return NULL;
+    }
+
+    TL_Log(debugger, "Created Vulkan shader module at %p (hash 0x%016llx)", module, (unsigned long long) hash);
+
+    existing = (TLVK_ShaderModule_t *) TLVK_PipelineCacheEntryInsert(renderer_system, &renderer_system->shader_modules, &module->entry, debugger);
+    if (existing != module) {
+        TLVK_ShaderModuleRelease(renderer_system, module);
+    }
+
+    return existing;
+}
+
+void TLVK_ShaderModuleRelease(TLVK_RendererSystem_t *const renderer_system, TLVK_ShaderModule_t *const module) {
+    if (!renderer_system || !module) {
+        return;
+    }
+
+    if (!TLVK_PipelineCacheEntryRelease(renderer_system, &renderer_system->shader_modules, &module->entry)) {
+        return;
+    }
+
+    renderer_system->devfs.vkDestroyShaderModule(renderer_system->vk_logical_device, module->vk_module, NULL);
+
+    TL_SpirvReflectionFree(&module->reflection);
+
+    free(module->entry.key);
+    free(module);
+}
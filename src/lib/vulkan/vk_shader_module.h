@@ -0,0 +1,54 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_shader_module_h__
+#define __TL__internal__vulkan__vk_shader_module_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/core/pipeline.h"
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#include "types/vulkan/vk_shader_module_t.h"
+
+/**
+ * @brief Retrieve a shared Vulkan shader module for the given SPIR-V code.
+ *
+ * This function returns a reference to the renderer system's shader module for the code of `shader`, creating it if no live module was created from
+ * identical code. Modules are keyed by the contents of the code, so the same SPIR-V loaded from different memory or files shares one module. The
+ * code is reflected when the module is first created, and the result is kept in the module's `reflection` member. The returned reference must be
+ * released with @ref TLVK_ShaderModuleRelease(). This function is thread-safe.
+ *
+ * @param renderer_system Renderer system to create the module under
+ * @param shader Shader descriptor - its code must already be loaded
+ * @return NULL if there were errors, otherwise a reference to the shader module
+ */
+TLVK_ShaderModule_t *TLVK_ShaderModuleAcquire(
+    TLVK_RendererSystem_t *const renderer_system,
+    const TL_PipelineShaderDescriptor_t *const shader
+);
+
+/**
+ * @brief Release a reference to a shared Vulkan shader module.
+ *
+ * This function releases a reference acquired with @ref TLVK_ShaderModuleAcquire(), and destroys the module once no references remain.
+ *
+ * @param renderer_system Renderer system the module was created under
+ * @param module NULL or the shader module to release
+ */
+void TLVK_ShaderModuleRelease(
+    TLVK_RendererSystem_t *const renderer_system,
+    TLVK_ShaderModule_t *const module
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -12,6 +12,9 @@
 
 #include "lib/core/wsi/surface_platform_data.h"
 #include "lib/vulkan/vk_context_block.h"
+#include "lib/vulkan/vk_frame_pacer.h"
+#include "lib/vulkan/vk_frame_timeline.h"
+#include "thallium/vulkan/vk_command_buffer_system.h"
 #include "types/core/renderer_t.h"
 #include "types/core/wsi/window_surface_t.h"
 #include "types/vulkan/vk_renderer_system_t.h"
@@ -20,39 +23,51 @@
 #include <volk/volk.h>
 
 #include <stdlib.h>
+#include <string.h>
 
-/**
- * @brief A struct containing information about what swapchains from a certain device can support.
- *
- * This struct contains info about what swapchains from a certain VkPhysicalDevice can support.
- */
-typedef struct __SwapchainSupportInfo_t {
-    /// @brief Basic surface capabilities supported - min/max images in swapchain, min/max size of images, etc
-    VkSurfaceCapabilitiesKHR caps;
-
-    /// @brief Supported surface formats (pixel format, colour space)
-    VkSurfaceFormatKHR *formats;
-    /// @brief Amount of elements in array `formats`
-    uint32_t format_count;
 
-    /// @brief Available presentation modes (fifo, mailbox, etc)
-    VkPresentModeKHR *present_modes;
-    /// @brief Amount of elements in array `present_modes`
-    uint32_t present_mode_count;
-} __SwapchainSupportInfo_t;
+static VkSurfaceKHR __CreateVkSurface(const TLVK_RendererSystem_t *const renderer_system, const TL_WindowSurface_t *const tl_surface);
 
-
-static VkSurfaceKHR __CreateVkSurface(const VkInstance instance, const TL_WindowSurface_t *const tl_surface, const TL_Debugger_t *const debugger);
+// check if the instance-level extension `name` was enabled on the instance of `renderer_system`.
+static bool __IsInstanceExtensionEnabled(const TLVK_RendererSystem_t *const renderer_system, const char *const name);
 
 // information gathered when creating the swapchain will be stored in `system` (e.g. extent, format, etc).
 static VkSwapchainKHR __CreateVkSwapchain(TLVK_SwapchainSystem_t *system, const VkDevice dev, const TLVK_FuncSet_t *devfs, const VkSurfaceKHR surface,
-    const __SwapchainSupportInfo_t support_info, const TLVK_LogicalDeviceQueues_t queues, const TLVK_SwapchainSystemDescriptor_t descriptor);
+    const TLVK_SurfaceSupport_t *const support, const TLVK_LogicalDeviceQueues_t queues, const TLVK_SwapchainSystemDescriptor_t descriptor,
+    const VkSwapchainKHR old_swapchain);
+
+// retrieve the images of the current swapchain of `system` and create a present semaphore for each of them.
+static bool __CreateImages(TLVK_SwapchainSystem_t *const system);
+
+static bool __CreateFrames(TLVK_SwapchainSystem_t *const system);
+
+// retire the frame claimed on the renderer system's frame timeline by `frame`, if any.
+static void __RetireFrame(const TLVK_RendererSystem_t *const renderer_system, TLVK_SwapchainFrame_t *const frame);
+
+// give up on the current frame of `system` after its work failed to be submitted, leaving its synchronisation objects and image fit for reuse.
+static void __AbandonFrame(TLVK_SwapchainSystem_t *const system, TLVK_SwapchainFrame_t *const frame);
+
+// recreate the swapchain of `system` in place, retiring the current one.
+static bool __RecreateSwapchain(TLVK_SwapchainSystem_t *const system);
 
-static __SwapchainSupportInfo_t __GetSwapchainSupportInfo(const VkPhysicalDevice physical_device, const VkSurfaceKHR surface);
+// destroy every retired swapchain whose frames have finished executing, or all of them if `all` is true.
+static void __DestroyRetiredSwapchains(TLVK_SwapchainSystem_t *const system, const bool all);
+
+static void __DestroySemaphores(const TLVK_RendererSystem_t *const renderer_system, VkSemaphore *const semaphores, const uint32_t count);
+
+// query the capabilities of the surface of `system`, as well as its formats and present modes unless they are already cached.
+static bool __UpdateSurfaceSupport(TLVK_SwapchainSystem_t *const system);
+
+static void __InvalidateSurfaceSupport(TLVK_SwapchainSystem_t *const system);
 
 static VkSurfaceFormatKHR __PickSwapSurfaceFormat(const VkSurfaceFormatKHR *const formats, const uint32_t format_count);
 
-static VkPresentModeKHR __PickSwapPresentMode(const VkPresentModeKHR *const modes, const uint32_t mode_count);
+static VkPresentModeKHR __PickSwapPresentMode(const VkPresentModeKHR *const modes, const uint32_t mode_count,
+    const TL_SwapchainLatencyPolicy_t policy);
+
+static uint32_t __PickSwapImageCount(const VkSurfaceCapabilitiesKHR caps, const TL_SwapchainLatencyPolicy_t policy);
+
+static uint32_t __PickFramesInFlight(const TL_SwapchainLatencyPolicy_t policy);
 
 static VkExtent2D __PickSwapExtent(const VkSurfaceCapabilitiesKHR caps, const uint32_t width, const uint32_t height);
 
@@ -91,9 +106,29 @@ TLVK_SwapchainSystem_t *TLVK_SwapchainSystemCreate(const TLVK_RendererSystem_t *
 
     swapchain_system->col_image_count = 0;
     swapchain_system->col_images = NULL;
+    swapchain_system->present_semaphores = NULL;
+    swapchain_system->support = (TLVK_SurfaceSupport_t) { 0 };
 
     swapchain_system->renderer_system = renderer_system;
 
+    swapchain_system->descriptor = descriptor;
+    swapchain_system->frames_in_flight = __PickFramesInFlight(descriptor.latency_policy);
+    swapchain_system->frame_number = 0;
+    swapchain_system->image_index = 0;
+    swapchain_system->frame_active = false;
+    swapchain_system->needs_recreate = false;
+    swapchain_system->retired = NULL;
+    swapchain_system->retired_count = 0;
+    swapchain_system->pacer = NULL;
+    swapchain_system->present_id = 0;
+
+    for (uint32_t i = 0; i < TLVK_FRAMES_IN_FLIGHT; i++) {
+        swapchain_system->frames[i].vk_acquire_semaphore = VK_NULL_HANDLE;
+        swapchain_system->frames[i].vk_fence = VK_NULL_HANDLE;
+        swapchain_system->frames[i].pending = false;
+        swapchain_system->frames[i].renderer_frame = UINT32_MAX;
+    }
+
     swapchain_system->vk_instance = instance;
 
     VkSurfaceKHR surface;
@@ -103,7 +138,7 @@ TLVK_SwapchainSystem_t *TLVK_SwapchainSystemCreate(const TLVK_RendererSystem_t *
         surface = descriptor.vk_surface;
     } else {
         // if no surface was directly passed, we create a new one for the window (passed via Thallium window surface `window_surface`)
-        surface = __CreateVkSurface(instance, window_surface, debugger);
+        surface = __CreateVkSurface(renderer_system, window_surface);
         if (surface == VK_NULL_HANDLE) {
             TL_Error(debugger, "Failed to create Vulkan surface for new swapchain system at %p", swapchain_system);
             return NULL;
@@ -112,9 +147,25 @@ TLVK_SwapchainSystem_t *TLVK_SwapchainSystemCreate(const TLVK_RendererSystem_t *
 
     swapchain_system->vk_surface = surface;
 
-    __SwapchainSupportInfo_t support_info = __GetSwapchainSupportInfo(physdev, surface);
+#   if defined(_THALLIUM_WSI_HEADLESS)
+        // headless surfaces have no window to take their extent from, so fall back to the size they were created with
+        if (!descriptor.vk_surface && window_surface->wsi == TL_WSI_API_HEADLESS &&
+            (descriptor.resolution.width == 0 || descriptor.resolution.height == 0))
+        {
+            TL_WindowSurfacePlatformDataHeadless_t *headless_native = (TL_WindowSurfacePlatformDataHeadless_t *) window_surface->platform_data;
+
+            swapchain_system->descriptor.resolution.width = headless_native->width;
+            swapchain_system->descriptor.resolution.height = headless_native->height;
+        }
+#   endif
 
-    VkSwapchainKHR swapchain = __CreateVkSwapchain(swapchain_system, dev, devfs, surface, support_info, queues, descriptor);
+    if (!__UpdateSurfaceSupport(swapchain_system)) {
+        TL_Error(debugger, "Failed to query surface support for Vulkan swapchain system %p", swapchain_system);
+        goto out_err;
+    }
+
+    VkSwapchainKHR swapchain = __CreateVkSwapchain(swapchain_system, dev, devfs, surface, &swapchain_system->support, queues,
+        swapchain_system->descriptor, VK_NULL_HANDLE);
     if (swapchain == VK_NULL_HANDLE) {
         TL_Error(debugger, "Failed to create Vulkan swapchain object in swapchain system %p", swapchain_system);
         goto out_err;
@@ -122,14 +173,25 @@ TLVK_SwapchainSystem_t *TLVK_SwapchainSystemCreate(const TLVK_RendererSystem_t *
     swapchain_system->vk_swapchain = swapchain;
 
     // retrieve image handles
-    devfs->vkGetSwapchainImagesKHR(dev, swapchain, &swapchain_system->col_image_count, NULL);
-    VkImage *images = malloc(sizeof(VkImage) * swapchain_system->col_image_count);
-    if (!images) {
-        TL_Fatal(debugger, "MALLOC fault in call to TLVK_SwapchainSystemCreate");
-        goto out_err;
+    if (!__CreateImages(swapchain_system)) {
+        goto out_err_swapchain;
+    }
+
+    if (!__CreateFrames(swapchain_system)) {
+        TL_Error(debugger, "Failed to create frame synchronisation objects in swapchain system %p", swapchain_system);
+        goto out_err_swapchain;
+    }
+
+    // frame pacing is optional, so the swapchain is still usable without it
+    if (descriptor.frame_pacing) {
+        if (!renderer_system->renderer->features.frame_pacing) {
+            TL_Warn(debugger, "Frame pacing was requested for Vulkan swapchain system %p, but the renderer is missing the 'frame_pacing' feature",
+                swapchain_system);
+        } else {
+            swapchain_system->pacer = TLVK_FramePacerCreate(renderer_system);
+            TLVK_FramePacerSetSwapchain(swapchain_system->pacer, swapchain);
+        }
     }
-    swapchain_system->col_images = images;
-    devfs->vkGetSwapchainImagesKHR(dev, swapchain, &swapchain_system->col_image_count, images);
 
     // debug output
     if (debugger) {
@@ -145,9 +207,18 @@ TLVK_SwapchainSystem_t *TLVK_SwapchainSystemCreate(const TLVK_RendererSystem_t *
     }
 
     return swapchain_system;
+out_err_swapchain:
+    for (uint32_t i = 0; i < TLVK_FRAMES_IN_FLIGHT; i++) {
+        devfs->vkDestroySemaphore(dev, swapchain_system->frames[i].vk_acquire_semaphore, NULL);
+        devfs->vkDestroyFence(dev, swapchain_system->frames[i].vk_fence, NULL);
+    }
+
+    __DestroySemaphores(renderer_system, swapchain_system->present_semaphores, swapchain_system->col_image_count);
+    free(swapchain_system->col_images);
+
+    devfs->vkDestroySwapchainKHR(dev, swapchain, NULL);
 out_err:
-    free(support_info.formats);
-    free(support_info.present_modes);
+    __InvalidateSurfaceSupport(swapchain_system);
 
     free(swapchain_system);
     return NULL;
@@ -160,10 +231,38 @@ void TLVK_SwapchainSystemDestroy(TLVK_SwapchainSystem_t *const swapchain_system)
 
     const TLVK_RendererSystem_t *renderersys = swapchain_system->renderer_system;
     const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    VkDevice dev = renderersys->vk_logical_device;
+
+    // the pacing thread must be stopped before the swapchains it may be waiting on are destroyed
+    TLVK_FramePacerDestroy(swapchain_system->pacer);
+
+    // nothing may be destroyed while frames are executing or being presented
+    for (uint32_t i = 0; i < TLVK_FRAMES_IN_FLIGHT; i++) {
+        TLVK_SwapchainFrame_t *frame = &swapchain_system->frames[i];
 
-    devfs->vkDestroySwapchainKHR(renderersys->vk_logical_device, swapchain_system->vk_swapchain, NULL);
+        if (frame->pending) {
+            devfs->vkWaitForFences(dev, 1, &frame->vk_fence, VK_TRUE, UINT64_MAX);
+        }
+
+        __RetireFrame(renderersys, frame);
+
+        devfs->vkDestroySemaphore(dev, frame->vk_acquire_semaphore, NULL);
+        devfs->vkDestroyFence(dev, frame->vk_fence, NULL);
+    }
+
+    if (renderersys->vk_queues.present.size) {
+        devfs->vkQueueWaitIdle((VkQueue) renderersys->vk_queues.present.data[0]);
+    }
+
+    __DestroyRetiredSwapchains(swapchain_system, true);
+    free(swapchain_system->retired);
+
+    __DestroySemaphores(renderersys, swapchain_system->present_semaphores, swapchain_system->col_image_count);
+
+    devfs->vkDestroySwapchainKHR(dev, swapchain_system->vk_swapchain, NULL);
     vkDestroySurfaceKHR(swapchain_system->vk_instance, swapchain_system->vk_surface, NULL);
 
+    __InvalidateSurfaceSupport(swapchain_system);
     free(swapchain_system->col_images);
 
     free(swapchain_system);
@@ -176,15 +275,252 @@ TL_Extent2D_t TLVK_SwapchainSystemGetExtent(TLVK_SwapchainSystem_t *const swapch
     return tl;
 }
 
+VkImage TLVK_SwapchainSystemGetImage(const TLVK_SwapchainSystem_t *const swapchain_system, const uint32_t image_index) {
+    if (!swapchain_system || image_index >= swapchain_system->col_image_count) {
+        return VK_NULL_HANDLE;
+    }
+
+    return swapchain_system->col_images[image_index];
+}
+
+bool TLVK_SwapchainSystemBeginFrame(TLVK_SwapchainSystem_t *const swapchain_system, uint32_t *const out_frame_index,
+    uint32_t *const out_image_index)
+{
+    if (!swapchain_system) {
+        return false;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = swapchain_system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    if (swapchain_system->frame_active) {
+        TL_Error(debugger, "Attempted to begin a frame of Vulkan swapchain system %p while its previous frame has not been ended", swapchain_system);
+        return false;
+    }
 
-static VkSurfaceKHR __CreateVkSurface(const VkInstance instance, const TL_WindowSurface_t *const tl_surface, const TL_Debugger_t *const debugger) {
+    uint32_t frame_index = (uint32_t) (swapchain_system->frame_number % swapchain_system->frames_in_flight);
+    TLVK_SwapchainFrame_t *frame = &swapchain_system->frames[frame_index];
+
+    // the frame that last used this index must have finished before its synchronisation objects and descriptor sets can be reused
+    if (frame->pending) {
+        if (devfs->vkWaitForFences(dev, 1, &frame->vk_fence, VK_TRUE, UINT64_MAX)) {
+            TL_Error(debugger, "Failed to wait on frame fence of Vulkan swapchain system %p", swapchain_system);
+            return false;
+        }
+
+        frame->pending = false;
+    }
+
+    // retiring the frame on the renderer system's timeline also frees its descriptor sets
+    __RetireFrame(renderersys, frame);
+
+    // descriptor sets are allocated from a renderer-wide frame index rather than this swapchain's own, as other swapchains and render target
+    // chains allocate from the same pools
+    if (!TLVK_FrameTimelineBeginFrame((TLVK_RendererSystem_t *) renderersys, &frame->renderer_frame)) {
+        frame->renderer_frame = UINT32_MAX;
+        return false;
+    }
+
+    // with frame pacing, the frame begins as late as it can while still making the next vertical blank it can reach
+    TLVK_FramePacerWait(swapchain_system->pacer, swapchain_system->present_id + 1);
+
+    __DestroyRetiredSwapchains(swapchain_system, false);
+
+    if (swapchain_system->needs_recreate || swapchain_system->vk_swapchain == VK_NULL_HANDLE) {
+        if (!__RecreateSwapchain(swapchain_system)) {
+            goto out_retire;
+        }
+    }
+
+    uint32_t image_index;
+
+    // a freshly recreated swapchain is only given one more attempt, so that a surface which keeps changing cannot stall the caller
+    for (uint32_t attempt = 0; ; attempt++) {
+        VkResult result = devfs->vkAcquireNextImageKHR(dev, swapchain_system->vk_swapchain, UINT64_MAX, frame->vk_acquire_semaphore,
+            VK_NULL_HANDLE, &image_index);
+
+        // the acquire semaphore is left unsignalled when no image is acquired, so it can be used again after recreating the swapchain
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+            // the surface's properties may have changed along with its size (e.g. after moving to another display)
+            __InvalidateSurfaceSupport(swapchain_system);
+
+            if (attempt > 0) {
+                swapchain_system->needs_recreate = true;
+                goto out_retire;
+            }
+
+            if (!__RecreateSwapchain(swapchain_system)) {
+                goto out_retire;
+            }
+
+            continue;
+        }
+
+        // an image acquired from a suboptimal swapchain can still be presented, so the swapchain is only recreated after this frame
+        if (result == VK_SUBOPTIMAL_KHR) {
+            swapchain_system->needs_recreate = true;
+        } else if (result != VK_SUCCESS) {
+            if (result == VK_ERROR_SURFACE_LOST_KHR) {
+                __InvalidateSurfaceSupport(swapchain_system);
+            }
+
+            TL_Error(debugger, "Failed to acquire next image of Vulkan swapchain system %p (VkResult %d)", swapchain_system, result);
+            goto out_retire;
+        }
+
+        break;
+    }
+
+    swapchain_system->image_index = image_index;
+    swapchain_system->frame_active = true;
+
+    if (out_frame_index) {
+        *out_frame_index = frame->renderer_frame;
+    }
+    if (out_image_index) {
+        *out_image_index = image_index;
+    }
+
+    return true;
+
+out_retire:
+    // nothing was submitted for the frame, so it retires straight away
+    __RetireFrame(renderersys, frame);
+
+    return false;
+}
+
+bool TLVK_SwapchainSystemEndFrame(TLVK_SwapchainSystem_t *const swapchain_system, TLVK_CommandBufferSystem_t *const command_buffer_system) {
+    if (!swapchain_system || !command_buffer_system) {
+        return false;
+    }
+
+    const TLVK_RendererSystem_t *renderersys = swapchain_system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    if (!swapchain_system->frame_active) {
+        TL_Error(debugger, "Attempted to end a frame of Vulkan swapchain system %p without beginning one", swapchain_system);
+        return false;
+    }
+
+    if (!renderersys->vk_queues.present.size) {
+        TL_Error(debugger, "Attempted to present Vulkan swapchain system %p without a present queue", swapchain_system);
+        return false;
+    }
+
+    TLVK_SwapchainFrame_t *frame = &swapchain_system->frames[swapchain_system->frame_number % swapchain_system->frames_in_flight];
+    uint32_t image_index = swapchain_system->image_index;
+    VkSemaphore present_semaphore = swapchain_system->present_semaphores[image_index];
+
+    swapchain_system->frame_active = false;
+
+    // the image may be cleared or copied to as well as rendered to, so transfers must also wait for it to be acquired
+    if (!TLVK_CommandBufferSystemSubmitWithSemaphores(command_buffer_system, frame->vk_acquire_semaphore,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, present_semaphore))
+    {
+        TL_Error(debugger, "Failed to submit frame of Vulkan swapchain system %p", swapchain_system);
+
+        __AbandonFrame(swapchain_system, frame);
+        return false;
+    }
+
+    bool ret = true;
+
+    // an empty submission signals its fence once all work previously submitted to the queue has finished, which tracks the frame without taking
+    // over the fence of the command buffer system. the fence is only reset once the frame's work has been submitted, so that a failed submission
+    // cannot leave it unsignalled for the next frame with this index to wait on forever.
+    if (devfs->vkResetFences(dev, 1, &frame->vk_fence) ||
+        devfs->vkQueueSubmit((VkQueue) renderersys->vk_queues.graphics.data[0], 0, NULL, frame->vk_fence))
+    {
+        TL_Error(debugger, "Failed to submit frame fence of Vulkan swapchain system %p", swapchain_system);
+
+        // the frame's work was submitted, so its image can still be presented, but only the queue going idle can now tell when it has finished
+        devfs->vkQueueWaitIdle((VkQueue) renderersys->vk_queues.graphics.data[0]);
+        ret = false;
+    } else {
+        frame->pending = true;
+    }
+
+    uint64_t present_id = ++swapchain_system->present_id;
+
+    VkPresentIdKHR present_id_info;
+    present_id_info.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+    present_id_info.pNext = NULL;
+    present_id_info.swapchainCount = 1;
+    present_id_info.pPresentIds = &present_id;
+
+    VkPresentInfoKHR present_info;
+    present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    present_info.pNext = (swapchain_system->pacer) ? &present_id_info : NULL;
+    present_info.waitSemaphoreCount = 1;
+    present_info.pWaitSemaphores = &present_semaphore;
+    present_info.swapchainCount = 1;
+    present_info.pSwapchains = &swapchain_system->vk_swapchain;
+    present_info.pImageIndices = &image_index;
+    present_info.pResults = NULL;
+
+    VkResult result = devfs->vkQueuePresentKHR((VkQueue) renderersys->vk_queues.present.data[0], &present_info);
+
+    swapchain_system->frame_number++;
+
+    if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+        TLVK_FramePacerQueuePresent(swapchain_system->pacer, present_id);
+    }
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_ERROR_SURFACE_LOST_KHR) {
+        __InvalidateSurfaceSupport(swapchain_system);
+    }
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        swapchain_system->needs_recreate = true;
+    } else if (result != VK_SUCCESS) {
+        TL_Error(debugger, "Failed to present image of Vulkan swapchain system %p (VkResult %d)", swapchain_system, result);
+        return false;
+    }
+
+    // a failed recreation is not an error of this frame, as it is attempted again when the next frame begins
+    if (swapchain_system->needs_recreate) {
+        __RecreateSwapchain(swapchain_system);
+    }
+
+    return ret;
+}
+
+bool TLVK_SwapchainSystemResize(TLVK_SwapchainSystem_t *const swapchain_system, const TL_Extent2D_t resolution) {
+    if (!swapchain_system) {
+        return false;
+    }
+
+    swapchain_system->descriptor.resolution = resolution;
+
+    // the image acquired for the current frame must be presented before its swapchain is retired
+    if (swapchain_system->frame_active) {
+        swapchain_system->needs_recreate = true;
+        return true;
+    }
+
+    return __RecreateSwapchain(swapchain_system);
+}
+
+
+static VkSurfaceKHR __CreateVkSurface(const TLVK_RendererSystem_t *const renderer_system, const TL_WindowSurface_t *const tl_surface) {
     if (!tl_surface || !tl_surface->platform_data) {
         return VK_NULL_HANDLE;
     }
 
+    const TL_Debugger_t *debugger = renderer_system->renderer->debugger;
+    VkInstance instance = renderer_system->vk_context->vk_instance;
+
     TL_WSI_API_t wsiapi = tl_surface->wsi;
 
-    VkSurfaceKHR surface;
+    // the presentation feature only needs one window system's surface extension, so each surface function is only called if its extension was
+    // actually enabled (see __UpdateRendererFeaturesWithSupported in vk_instance.c)
+    VkSurfaceKHR surface = VK_NULL_HANDLE;
+    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
 
     switch (wsiapi) {
         default:
@@ -202,7 +538,13 @@ static VkSurfaceKHR __CreateVkSurface(const VkInstance instance, const TL_Window
                 cocoa_mt_create_info.flags = 0;
                 cocoa_mt_create_info.pLayer = (CAMetalLayer *) cocoa_native->mt_layer; // note a CAMetalLayer forward decl is provided by Vulkan.
 
-                vkCreateMetalSurfaceEXT(instance, &cocoa_mt_create_info, NULL, &surface);
+                if (!vkCreateMetalSurfaceEXT || !__IsInstanceExtensionEnabled(renderer_system, VK_EXT_METAL_SURFACE_EXTENSION_NAME)) {
+                    TL_Error(debugger, "Attempted to create a Vulkan surface for Cocoa window, but VK_EXT_metal_surface is not enabled on the "
+                        "instance");
+                    return VK_NULL_HANDLE;
+                }
+
+                result = vkCreateMetalSurfaceEXT(instance, &cocoa_mt_create_info, NULL, &surface);
 
                 break;
 #           else
@@ -224,7 +566,12 @@ static VkSurfaceKHR __CreateVkSurface(const VkInstance instance, const TL_Window
                 xcb_create_info.connection = xcb_native->connection;
                 xcb_create_info.window = xcb_native->window;
 
-                vkCreateXcbSurfaceKHR(instance, &xcb_create_info, NULL, &surface);
+                if (!vkCreateXcbSurfaceKHR || !__IsInstanceExtensionEnabled(renderer_system, VK_KHR_XCB_SURFACE_EXTENSION_NAME)) {
+                    TL_Error(debugger, "Attempted to create a Vulkan surface for XCB window, but VK_KHR_xcb_surface is not enabled on the instance");
+                    return VK_NULL_HANDLE;
+                }
+
+                result = vkCreateXcbSurfaceKHR(instance, &xcb_create_info, NULL, &surface);
 
                 break;
 #           else
@@ -246,7 +593,13 @@ static VkSurfaceKHR __CreateVkSurface(const VkInstance instance, const TL_Window
                 xlib_create_info.dpy = xlib_native->display;
                 xlib_create_info.window = xlib_native->window;
 
-                vkCreateXlibSurfaceKHR(instance, &xlib_create_info, NULL, &surface);
+                if (!vkCreateXlibSurfaceKHR || !__IsInstanceExtensionEnabled(renderer_system, VK_KHR_XLIB_SURFACE_EXTENSION_NAME)) {
+                    TL_Error(debugger, "Attempted to create a Vulkan surface for Xlib window, but VK_KHR_xlib_surface is not enabled on the "
+                        "instance");
+                    return VK_NULL_HANDLE;
+                }
+
+                result = vkCreateXlibSurfaceKHR(instance, &xlib_create_info, NULL, &surface);
 
                 break;
 #           else
@@ -255,32 +608,74 @@ static VkSurfaceKHR __CreateVkSurface(const VkInstance instance, const TL_Window
                     "Recompile Thallium with the -DTHALLIUM_WSI_XLIB=ON flag!");
                 return VK_NULL_HANDLE;
 #           endif
+
+        // ---------------- headless window surface ----------------
+        case TL_WSI_API_HEADLESS:;
+#           if defined(_THALLIUM_WSI_HEADLESS)
+                VkHeadlessSurfaceCreateInfoEXT headless_create_info;
+                headless_create_info.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+                headless_create_info.pNext = NULL;
+                headless_create_info.flags = 0;
+
+                if (!vkCreateHeadlessSurfaceEXT || !__IsInstanceExtensionEnabled(renderer_system, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME)) {
+                    TL_Error(debugger, "Attempted to create a headless Vulkan surface, but VK_EXT_headless_surface is not enabled on the "
+                        "instance");
+                    return VK_NULL_HANDLE;
+                }
+
+                result = vkCreateHeadlessSurfaceEXT(instance, &headless_create_info, NULL, &surface);
+
+                break;
+#           else
+                // Thallium headless support not compiled
+                TL_Error(debugger, "Attempted to create a headless Vulkan surface, but Thallium headless support was not compiled; "
+                    "Recompile Thallium with the -DTHALLIUM_WSI_HEADLESS=ON flag!");
+                return VK_NULL_HANDLE;
+#           endif
+    }
+
+    if (result) {
+        TL_Error(debugger, "Failed to create Vulkan surface for window surface %p (VkResult %d)", tl_surface, result);
+        return VK_NULL_HANDLE;
     }
 
     return surface;
 }
 
+static bool __IsInstanceExtensionEnabled(const TLVK_RendererSystem_t *const renderer_system, const char *const name) {
+    carray_t extensions = renderer_system->vk_context->instance_extensions;
+
+    for (uint32_t i = 0; i < extensions.size; i++) {
+        if (!strcmp((const char *) extensions.data[i], name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 static VkSwapchainKHR __CreateVkSwapchain(TLVK_SwapchainSystem_t *system, const VkDevice dev, const TLVK_FuncSet_t *devfs, const VkSurfaceKHR surface,
-    const __SwapchainSupportInfo_t support_info, const TLVK_LogicalDeviceQueues_t queues, const TLVK_SwapchainSystemDescriptor_t descriptor)
+    const TLVK_SurfaceSupport_t *const support, const TLVK_LogicalDeviceQueues_t queues, const TLVK_SwapchainSystemDescriptor_t descriptor,
+    const VkSwapchainKHR old_swapchain)
 {
     // automatically select surface format if not explicitly chosen
     VkSurfaceFormatKHR surface_format = ((int) descriptor.vk_surface_format.format != -1) ?
-        descriptor.vk_surface_format : __PickSwapSurfaceFormat(support_info.formats, support_info.format_count);
+        descriptor.vk_surface_format : __PickSwapSurfaceFormat(support->formats, support->format_count);
     system->col_format = surface_format.format;
 
     // automatically select present mode if not explicitly chosen
     VkPresentModeKHR present_mode = ((int) descriptor.vk_present_mode != -1) ?
-        descriptor.vk_present_mode : __PickSwapPresentMode(support_info.present_modes, support_info.present_mode_count);
+        descriptor.vk_present_mode : __PickSwapPresentMode(support->present_modes, support->present_mode_count, descriptor.latency_policy);
 
     // clamp swap extent to capabilities
-    VkExtent2D extent = __PickSwapExtent(support_info.caps, descriptor.resolution.width, descriptor.resolution.height);
+    VkExtent2D extent = __PickSwapExtent(support->caps, descriptor.resolution.width, descriptor.resolution.height);
     system->extent = extent;
 
-    // get min image from support info
-    uint32_t min_img_count = support_info.caps.minImageCount + 1;
+    // more images let more frames queue up for presentation, at the cost of each frame being displayed later
+    uint32_t min_img_count = __PickSwapImageCount(support->caps, descriptor.latency_policy);
 
     // transformation applied before presentation
-    uint32_t pre_trans = support_info.caps.currentTransform; // no image transformation
+    uint32_t pre_trans = support->caps.currentTransform; // no image transformation
 
     VkSwapchainCreateInfoKHR create_info;
     create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -321,7 +716,8 @@ static VkSwapchainKHR __CreateVkSwapchain(TLVK_SwapchainSystem_t *system, const
     create_info.presentMode = present_mode;
     create_info.clipped = VK_TRUE;
 
-    create_info.oldSwapchain = VK_NULL_HANDLE; // TODO: Swapchain recreation: https://trello.com/c/l1Fe6hcf
+    // when recreating, handing over the old swapchain lets the presentation engine reuse its resources
+    create_info.oldSwapchain = old_swapchain;
 
     // create swapchain
     VkSwapchainKHR swapchain;
@@ -332,27 +728,317 @@ static VkSwapchainKHR __CreateVkSwapchain(TLVK_SwapchainSystem_t *system, const
     return swapchain;
 }
 
-static __SwapchainSupportInfo_t __GetSwapchainSupportInfo(const VkPhysicalDevice physical_device, const VkSurfaceKHR surface) {
-    __SwapchainSupportInfo_t details;
+static bool __CreateImages(TLVK_SwapchainSystem_t *const system) {
+    const TLVK_RendererSystem_t *renderersys = system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    uint32_t image_count = 0;
+    devfs->vkGetSwapchainImagesKHR(dev, system->vk_swapchain, &image_count, NULL);
+
+    VkImage *images = malloc(sizeof(VkImage) * image_count);
+    VkSemaphore *semaphores = calloc(image_count, sizeof(VkSemaphore));
+    if (!images || !semaphores) {
+        TL_Fatal(debugger, "MALLOC fault in call to __CreateImages");
+        goto outerr;
+    }
+
+    devfs->vkGetSwapchainImagesKHR(dev, system->vk_swapchain, &image_count, images);
+
+    VkSemaphoreCreateInfo semaphore_info;
+    semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphore_info.pNext = NULL;
+    semaphore_info.flags = 0;
+
+    for (uint32_t i = 0; i < image_count; i++) {
+        if (devfs->vkCreateSemaphore(dev, &semaphore_info, NULL, &semaphores[i])) {
+            TL_Error(debugger, "Failed to create present semaphore in Vulkan swapchain system %p", system);
+
+            __DestroySemaphores(renderersys, semaphores, i);
+            semaphores = NULL;
+
+            goto outerr;
+        }
+    }
+
+    system->col_images = images;
+    system->col_image_count = image_count;
+    system->present_semaphores = semaphores;
+
+    return true;
+outerr:
+    free(images);
+    free(semaphores);
+
+    return false;
+}
+
+static bool __CreateFrames(TLVK_SwapchainSystem_t *const system) {
+    const TLVK_RendererSystem_t *renderersys = system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    VkDevice dev = renderersys->vk_logical_device;
+
+    VkSemaphoreCreateInfo semaphore_info;
+    semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphore_info.pNext = NULL;
+    semaphore_info.flags = 0;
+
+    VkFenceCreateInfo fence_info;
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fence_info.pNext = NULL;
+    fence_info.flags = 0;
+
+    for (uint32_t i = 0; i < TLVK_FRAMES_IN_FLIGHT; i++) {
+        TLVK_SwapchainFrame_t *frame = &system->frames[i];
+
+        if (devfs->vkCreateSemaphore(dev, &semaphore_info, NULL, &frame->vk_acquire_semaphore) ||
+            devfs->vkCreateFence(dev, &fence_info, NULL, &frame->vk_fence))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void __RetireFrame(const TLVK_RendererSystem_t *const renderer_system, TLVK_SwapchainFrame_t *const frame) {
+    if (frame->renderer_frame == UINT32_MAX) {
+        return;
+    }
+
+    TLVK_FrameTimelineRetireFrame((TLVK_RendererSystem_t *) renderer_system, frame->renderer_frame);
+    frame->renderer_frame = UINT32_MAX;
+}
+
+static void __AbandonFrame(TLVK_SwapchainSystem_t *const system, TLVK_SwapchainFrame_t *const frame) {
+    const TLVK_RendererSystem_t *renderersys = system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    // the acquire semaphore will still be signalled by the presentation engine, so it must be waited on before it can be given to another acquire
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo submit_info;
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.pNext = NULL;
+    submit_info.waitSemaphoreCount = 1;
+    submit_info.pWaitSemaphores = &frame->vk_acquire_semaphore;
+    submit_info.pWaitDstStageMask = &wait_stage;
+    submit_info.commandBufferCount = 0;
+    submit_info.pCommandBuffers = NULL;
+    submit_info.signalSemaphoreCount = 0;
+    submit_info.pSignalSemaphores = NULL;
+
+    // the same submission signals the frame fence, which tells the next frame with this index when the semaphore can be reused
+    if (devfs->vkResetFences(dev, 1, &frame->vk_fence) ||
+        devfs->vkQueueSubmit((VkQueue) renderersys->vk_queues.graphics.data[0], 1, &submit_info, frame->vk_fence))
+    {
+        TL_Error(debugger, "Failed to release acquire semaphore of abandoned frame of Vulkan swapchain system %p", system);
+    } else {
+        frame->pending = true;
+    }
+
+    // the acquired image could only be handed back by presenting it, which would show an image that was never rendered to - instead, the swapchain
+    // that owns it is retired, which releases the image once the swapchain is destroyed
+    system->needs_recreate = true;
+    system->frame_number++;
+}
+
+static bool __RecreateSwapchain(TLVK_SwapchainSystem_t *const system) {
+    const TLVK_RendererSystem_t *renderersys = system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkDevice dev = renderersys->vk_logical_device;
+
+    // the retirement list is grown first so that a retired swapchain can never be lost to an allocation failure
+    TLVK_RetiredSwapchain_t *retired = realloc(system->retired, sizeof(TLVK_RetiredSwapchain_t) * (system->retired_count + 1));
+    if (!retired) {
+        TL_Fatal(debugger, "MALLOC fault in call to __RecreateSwapchain");
+        return false;
+    }
+    system->retired = retired;
+
+    // only the capabilities are queried again here unless the cache was invalidated, so rapid resizes do not reallocate the formats and modes
+    if (!__UpdateSurfaceSupport(system)) {
+        TL_Error(debugger, "Failed to query surface support for Vulkan swapchain system %p", system);
+
+        system->needs_recreate = true;
+        return false;
+    }
+
+    // a zero-sized surface (e.g. a minimised window) cannot have a swapchain, so recreation is deferred until it has a size again
+    VkExtent2D extent = __PickSwapExtent(system->support.caps, system->descriptor.resolution.width, system->descriptor.resolution.height);
+    if (extent.width == 0 || extent.height == 0) {
+        system->needs_recreate = true;
+        return false;
+    }
+
+    VkSwapchainKHR old_swapchain = system->vk_swapchain;
+
+    VkSwapchainKHR swapchain = __CreateVkSwapchain(system, dev, devfs, system->vk_surface, &system->support, renderersys->vk_queues,
+        system->descriptor, old_swapchain);
+
+    // the old swapchain is retired even if creating its replacement failed, so it must not be used again either way. frames that were in flight
+    // when it was retired may still be presenting from it, so it is only destroyed once the frames begun after them have finished as well.
+    if (old_swapchain != VK_NULL_HANDLE) {
+        retired[system->retired_count].vk_swapchain = old_swapchain;
+        retired[system->retired_count].present_semaphores = system->present_semaphores;
+        retired[system->retired_count].present_semaphore_count = system->col_image_count;
+        retired[system->retired_count].retire_frame = system->frame_number + system->frames_in_flight;
+        system->retired_count++;
+
+        system->vk_swapchain = VK_NULL_HANDLE;
+        system->present_semaphores = NULL;
+        system->col_image_count = 0;
+
+        // presents of a retired swapchain must not be waited on
+        TLVK_FramePacerSetSwapchain(system->pacer, VK_NULL_HANDLE);
+    }
+
+    free(system->col_images);
+    system->col_images = NULL;
+
+    if (swapchain == VK_NULL_HANDLE) {
+        TL_Error(debugger, "Failed to recreate Vulkan swapchain object in swapchain system %p", system);
+
+        system->needs_recreate = true;
+        return false;
+    }
+    system->vk_swapchain = swapchain;
+    TLVK_FramePacerSetSwapchain(system->pacer, swapchain);
+
+    if (!__CreateImages(system)) {
+        system->needs_recreate = true;
+        return false;
+    }
+
+    system->needs_recreate = false;
+
+    TL_Log(debugger, "Recreated Vulkan swapchain object at %p in Thallium Vulkan swapchain system %p with extent resolution %dx%d", swapchain,
+        system, system->extent.width, system->extent.height);
+
+    return true;
+}
+
+static void __DestroyRetiredSwapchains(TLVK_SwapchainSystem_t *const system, const bool all) {
+    const TLVK_RendererSystem_t *renderersys = system->renderer_system;
+    const TLVK_FuncSet_t *devfs = &(renderersys->devfs);
+
+    uint32_t kept = 0;
+
+    for (uint32_t i = 0; i < system->retired_count; i++) {
+        TLVK_RetiredSwapchain_t retired = system->retired[i];
+
+        // when a frame begins, the fence of the frame numbered `frames_in_flight` before it has just been waited on. the pacing thread may also
+        // still be blocked waiting on a present of the swapchain.
+        if (!all && (system->frame_number < retired.retire_frame + system->frames_in_flight ||
+            TLVK_FramePacerIsWaitingOn(system->pacer, retired.vk_swapchain)))
+        {
+            system->retired[kept++] = retired;
+            continue;
+        }
+
+        devfs->vkDestroySwapchainKHR(renderersys->vk_logical_device, retired.vk_swapchain, NULL);
+        __DestroySemaphores(renderersys, retired.present_semaphores, retired.present_semaphore_count);
+    }
+
+    system->retired_count = kept;
+}
+
+static void __DestroySemaphores(const TLVK_RendererSystem_t *const renderer_system, VkSemaphore *const semaphores, const uint32_t count) {
+    if (!semaphores) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        renderer_system->devfs.vkDestroySemaphore(renderer_system->vk_logical_device, semaphores[i], NULL);
+    }
+
+    free(semaphores);
+}
+
+static bool __UpdateSurfaceSupport(TLVK_SwapchainSystem_t *const system) {
+    const TLVK_RendererSystem_t *renderersys = system->renderer_system;
+    const TL_Debugger_t *debugger = renderersys->renderer->debugger;
+    VkPhysicalDevice physdev = renderersys->vk_physical_device;
+    VkSurfaceKHR surface = system->vk_surface;
+
+    TLVK_SurfaceSupport_t *support = &system->support;
 
     // get surface capabilities
-    vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physical_device, surface, &details.caps);
+    VkResult result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physdev, surface, &support->caps);
+    if (result != VK_SUCCESS) {
+        TL_Error(debugger, "Failed to query capabilities of Vulkan surface of swapchain system %p (VkResult %d)", system, result);
+
+        if (result == VK_ERROR_SURFACE_LOST_KHR) {
+            __InvalidateSurfaceSupport(system);
+        }
+        return false;
+    }
+
+    if (support->valid) {
+        return true;
+    }
 
     // get supported surface formats
-    vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &details.format_count, NULL);
-    if (details.format_count > 0) {
-        details.formats = malloc(sizeof(VkSurfaceFormatKHR) * details.format_count);
-        vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &details.format_count, details.formats);
+    if (vkGetPhysicalDeviceSurfaceFormatsKHR(physdev, surface, &support->format_count, NULL) || !support->format_count) {
+        TL_Error(debugger, "Failed to query formats of Vulkan surface of swapchain system %p", system);
+        goto outerr;
+    }
+
+    support->formats = malloc(sizeof(VkSurfaceFormatKHR) * support->format_count);
+    if (!support->formats) {
+        TL_Fatal(debugger, "MALLOC fault in call to __UpdateSurfaceSupport");
+        goto outerr;
+    }
+
+    result = vkGetPhysicalDeviceSurfaceFormatsKHR(physdev, surface, &support->format_count, support->formats);
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+        TL_Error(debugger, "Failed to query formats of Vulkan surface of swapchain system %p (VkResult %d)", system, result);
+        goto outerr;
     }
 
     // get supported presentation modes
-    vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &details.present_mode_count, NULL);
-    if (details.format_count > 0) {
-        details.present_modes = malloc(sizeof(VkPresentModeKHR) * details.present_mode_count);
-        vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &details.present_mode_count, details.present_modes);
+    if (vkGetPhysicalDeviceSurfacePresentModesKHR(physdev, surface, &support->present_mode_count, NULL) || !support->present_mode_count) {
+        TL_Error(debugger, "Failed to query present modes of Vulkan surface of swapchain system %p", system);
+        goto outerr;
     }
 
-    return details;
+    support->present_modes = malloc(sizeof(VkPresentModeKHR) * support->present_mode_count);
+    if (!support->present_modes) {
+        TL_Fatal(debugger, "MALLOC fault in call to __UpdateSurfaceSupport");
+        goto outerr;
+    }
+
+    result = vkGetPhysicalDeviceSurfacePresentModesKHR(physdev, surface, &support->present_mode_count, support->present_modes);
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+        TL_Error(debugger, "Failed to query present modes of Vulkan surface of swapchain system %p (VkResult %d)", system, result);
+        goto outerr;
+    }
+
+    support->valid = true;
+
+    return true;
+
+outerr:
+    __InvalidateSurfaceSupport(system);
+    return false;
+}
+
+// the cache is refilled by the next call to __UpdateSurfaceSupport().
+static void __InvalidateSurfaceSupport(TLVK_SwapchainSystem_t *const system) {
+    TLVK_SurfaceSupport_t *support = &system->support;
+
+    free(support->formats);
+    free(support->present_modes);
+
+    support->formats = NULL;
+    support->format_count = 0;
+    support->present_modes = NULL;
+    support->present_mode_count = 0;
+    support->valid = false;
 }
 
 // select most optimal available format for the swapchain to use, from the candidates specified.
@@ -369,11 +1055,26 @@ static VkSurfaceFormatKHR __PickSwapSurfaceFormat(const VkSurfaceFormatKHR *cons
 }
 
 // select best presentation mode for the swapchain to use from the candidates specified.
-static VkPresentModeKHR __PickSwapPresentMode(const VkPresentModeKHR *const modes, const uint32_t mode_count) {
-    for (uint32_t i = 0; i < mode_count; i++) {
-        // use mailbox if available
-        if (modes[i] == VK_PRESENT_MODE_MAILBOX_KHR) {
-            return modes[i];
+static VkPresentModeKHR __PickSwapPresentMode(const VkPresentModeKHR *const modes, const uint32_t mode_count,
+    const TL_SwapchainLatencyPolicy_t policy)
+{
+    // mailbox presents the newest frame at each vertical blank without tearing or throttling rendering to the refresh rate. without it, immediate
+    // presentation is only worth its tearing when throughput is all that matters - every other policy falls back to FIFO instead.
+    static const VkPresentModeKHR high_throughput[] = { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR };
+    static const VkPresentModeKHR other[] = { VK_PRESENT_MODE_MAILBOX_KHR };
+
+    const VkPresentModeKHR *preferred = other;
+    uint32_t preferred_count = 1;
+    if (policy == TL_SWAPCHAIN_LATENCY_POLICY_HIGH_THROUGHPUT) {
+        preferred = high_throughput;
+        preferred_count = 2;
+    }
+
+    for (uint32_t p = 0; p < preferred_count; p++) {
+        for (uint32_t i = 0; i < mode_count; i++) {
+            if (modes[i] == preferred[p]) {
+                return modes[i];
+            }
         }
     }
 
@@ -381,6 +1082,44 @@ static VkPresentModeKHR __PickSwapPresentMode(const VkPresentModeKHR *const mode
     return VK_PRESENT_MODE_FIFO_KHR;
 }
 
+// select the amount of images for the swapchain to request, clamped to the limits specified in `caps`.
+static uint32_t __PickSwapImageCount(const VkSurfaceCapabilitiesKHR caps, const TL_SwapchainLatencyPolicy_t policy) {
+    uint32_t count;
+
+    switch (policy) {
+        case TL_SWAPCHAIN_LATENCY_POLICY_LOW_LATENCY:
+            count = caps.minImageCount;
+            break;
+        case TL_SWAPCHAIN_LATENCY_POLICY_HIGH_THROUGHPUT:
+            count = caps.minImageCount + 2;
+            break;
+        case TL_SWAPCHAIN_LATENCY_POLICY_BALANCED:
+        default:
+            count = caps.minImageCount + 1;
+            break;
+    }
+
+    // a maximum of 0 means there is no limit
+    if (caps.maxImageCount > 0 && count > caps.maxImageCount) {
+        count = caps.maxImageCount;
+    }
+
+    return count;
+}
+
+// select the amount of frames that may be in flight at once, which is never more than TLVK_FRAMES_IN_FLIGHT.
+static uint32_t __PickFramesInFlight(const TL_SwapchainLatencyPolicy_t policy) {
+    switch (policy) {
+        case TL_SWAPCHAIN_LATENCY_POLICY_LOW_LATENCY:
+            return 1;
+        case TL_SWAPCHAIN_LATENCY_POLICY_HIGH_THROUGHPUT:
+            return TLVK_FRAMES_IN_FLIGHT;
+        case TL_SWAPCHAIN_LATENCY_POLICY_BALANCED:
+        default:
+            return 2;
+    }
+}
+
 // `width` and `height` are clamped to min/max extents as specified in `caps`.
 static VkExtent2D __PickSwapExtent(const VkSurfaceCapabilitiesKHR caps, const uint32_t width, const uint32_t height) {
     // if current extent width/height is *not* set to uint32_max by the wm, then we match the extent to the window size
@@ -0,0 +1,28 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__core__command_buffer_t_h__
+#define __TL__internal__core__command_buffer_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/core/command_buffer.h"
+
+typedef struct TL_CommandBuffer_t {
+    /// @brief Internal API-aware command buffer system.
+    void *command_buffer_system;
+
+    /// @brief Pointer to the parent renderer object.
+    const TL_Renderer_t *renderer;
+} TL_CommandBuffer_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -14,12 +14,24 @@
 
 #include "thallium/core/pipeline.h"
 
+#include "utils/thread/thread.h"
+
 typedef struct TL_Pipeline_t {
     /// @brief Internal API-aware pipeline system.
     void *pipeline_system;
 
     /// @brief Pointer to the parent renderer object.
     const TL_Renderer_t *renderer;
+
+    /// @brief Creation status of the pipeline - guarded by `lock`.
+    TL_PipelineStatus_t status;
+    /// @brief Lock guarding `status` and `pipeline_system` while the pipeline may still be compiling.
+    TL_Mutex_t lock;
+    /// @brief Signalled once `status` leaves TL_PIPELINE_STATUS_PENDING.
+    TL_Cond_t ready;
+
+    /// @brief Deep copy of the creation descriptor, held only while an asynchronous compilation job is queued or running.
+    TL_PipelineDescriptor_t async_descriptor;
 } TL_Pipeline_t;
 
 #ifdef __cplusplus
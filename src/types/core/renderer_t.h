@@ -14,6 +14,10 @@
 
 #include "thallium/core/renderer.h"
 
+#include "lib/core/pipeline_manifest.h"
+#include "utils/thread/thread.h"
+#include "utils/thread/worker_pool.h"
+
 typedef struct TL_Renderer_t {
     /// @brief Internal API-aware renderer system.
     void *renderer_system;
@@ -28,6 +32,23 @@ typedef struct TL_Renderer_t {
 
     /// @brief Features requested from the renderer at creation time
     TL_RendererFeatures_t features;
+
+    /// @brief Pool of worker threads used for background work such as asynchronous pipeline compilation.
+    TL_WorkerPool_t *worker_pool;
+
+    /// @brief NULL or the recorder of pipeline descriptors, if the renderer was created with a `pipeline_manifest_path`.
+    TL_PipelineManifest_t *pipeline_manifest;
+
+    /// @brief Lock guarding the pipeline pre-warming members below.
+    TL_Mutex_t prewarm_lock;
+    /// @brief Signalled once `prewarm_pending` reaches 0.
+    TL_Cond_t prewarm_done;
+    /// @brief Amount of pre-warming jobs that are queued or running.
+    uint32_t prewarm_pending;
+    /// @brief Amount of pipelines in `prewarmed_pipelines`.
+    uint32_t prewarmed_pipeline_count;
+    /// @brief NULL or an array of the pipelines created by TL_PipelinePrewarm(), which are kept until the renderer is destroyed.
+    TL_Pipeline_t **prewarmed_pipelines;
 } TL_Renderer_t;
 
 #ifdef __cplusplus
@@ -15,8 +15,10 @@
 #include "thallium/core/swapchain.h"
 
 typedef struct TL_Swapchain_t {
-    /// @brief Internal API-aware swapchain system.
+    /// @brief Internal API-aware swapchain system (or render target chain if `offscreen` is true).
     void *swapchain_system;
+    /// @brief True if the swapchain is backed by offscreen images instead of a window surface.
+    bool offscreen;
 
     /// @brief Swapchain extent
     TL_Extent2D_t extent;
@@ -26,6 +26,8 @@ typedef enum TL_WSI_API_t {
     TL_WSI_API_XCB,
     /// @brief X11 (Xlib) window system
     TL_WSI_API_XLIB,
+    /// @brief No window system (headless surface)
+    TL_WSI_API_HEADLESS,
 } TL_WSI_API_t;
 
 typedef struct TL_WindowSurface_t {
@@ -0,0 +1,79 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_bindless_table_t_h__
+#define __TL__internal__vulkan__vk_bindless_table_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/vulkan/vk_bindless_table.h"
+
+#include "types/vulkan/vk_pipeline_layout_t.h"
+#include "utils/thread/thread.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+/// @brief Index of the descriptor set that pipeline layouts reserve for the bindless table when the `bindless_resources` feature is enabled.
+#define TLVK_BINDLESS_SET_INDEX 0
+/// @brief Amount of resource types (and so descriptor arrays) in a bindless table.
+#define TLVK_BINDLESS_RESOURCE_TYPE_COUNT 3
+
+typedef struct TLVK_BindlessRetiredSlot_t {
+    /// @brief Handle of the released slot.
+    uint32_t handle;
+    /// @brief Serial of the most recent frame of the renderer system's frame timeline when the slot was released - the slot may be reused once
+    /// every frame up to this one has retired.
+    uint64_t serial;
+} TLVK_BindlessRetiredSlot_t;
+
+typedef struct TLVK_BindlessSlotList_t {
+    /// @brief Amount of descriptors in the array of this resource type.
+    uint32_t capacity;
+    /// @brief Index of the first slot that has never been used - every slot from here to `capacity` is free.
+    uint32_t next;
+    /// @brief Amount of handles in `free_slots`.
+    uint32_t free_count;
+    /// @brief Stack of slots below `next` that were released and can be reused.
+    uint32_t *free_slots;
+    /// @brief Array of `capacity` flags, each set while its slot holds a descriptor that has not been released.
+    bool *occupied;
+
+    /// @brief Slots that were released while frames that may still access them were in flight, in order of release.
+    TLVK_BindlessRetiredSlot_t *retired;
+    /// @brief Amount of elements in `retired`.
+    uint32_t retired_count;
+    /// @brief Amount of elements allocated for `retired`.
+    uint32_t retired_capacity;
+} TLVK_BindlessSlotList_t;
+
+typedef struct TLVK_BindlessTable_t {
+    /// @brief The parent Vulkan renderer system.
+    TLVK_RendererSystem_t *renderer_system;
+
+    /// @brief Layout of the table's descriptor set, which is used at index `TLVK_BINDLESS_SET_INDEX` by every pipeline layout that has descriptor
+    /// sets. This layout is not registered in the renderer system's deduplication map; the table holds a reference to it.
+    TLVK_DescriptorSetLayout_t *set_layout;
+    /// @brief Descriptor pool that `vk_set` is allocated from, created with `VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT`.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorPool.html
+    VkDescriptorPool vk_pool;
+    /// @brief The descriptor set holding every descriptor array of the table.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorSet.html
+    VkDescriptorSet vk_set;
+
+    /// @brief Slot allocation state of each resource type, indexed by @ref TLVK_BindlessResourceType_t.
+    TLVK_BindlessSlotList_t slots[TLVK_BINDLESS_RESOURCE_TYPE_COUNT];
+    /// @brief Lock guarding `slots` and descriptor writes to `vk_set`.
+    TL_Mutex_t lock;
+} TLVK_BindlessTable_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
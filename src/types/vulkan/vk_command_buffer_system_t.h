@@ -0,0 +1,50 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_command_buffer_system_t_h__
+#define __TL__internal__vulkan__vk_command_buffer_system_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/vulkan/vk_command_buffer_system.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+typedef struct TLVK_CommandBufferSystem_t {
+    /// @brief The parent Vulkan renderer system.
+    const TLVK_RendererSystem_t *renderer_system;
+
+    /// @brief Vulkan command pool that `vk_command_buffer` is allocated from - one pool per command buffer so recording needs no locking.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkCommandPool.html
+    VkCommandPool vk_command_pool;
+    /// @brief Vulkan primary command buffer:
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkCommandBuffer.html
+    VkCommandBuffer vk_command_buffer;
+    /// @brief Fence signalled when the most recent submission of `vk_command_buffer` has finished executing.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkFence.html
+    VkFence vk_fence;
+    /// @brief True if `vk_command_buffer` was submitted and `vk_fence` has not been waited on since.
+    bool pending;
+    /// @brief Serial held on the renderer system's frame timeline from the start of recording until the submission has been waited on, so that
+    /// bindless table slots that the commands may access are not reused before then (0 if none is held).
+    uint64_t serial;
+
+    /// @brief NULL or the pipeline system that was most recently bound during recording.
+    const TLVK_PipelineSystem_t *bound_pipeline;
+    /// @brief NULL or the compute pipeline system that was most recently bound during recording.
+    const TLVK_PipelineSystem_t *bound_compute_pipeline;
+    /// @brief True if the renderer system's descriptor buffer has been bound during recording.
+    bool descriptor_buffer_bound;
+} TLVK_CommandBufferSystem_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
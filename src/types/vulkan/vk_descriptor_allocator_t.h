@@ -0,0 +1,83 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_descriptor_allocator_t_h__
+#define __TL__internal__vulkan__vk_descriptor_allocator_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/platform.h"
+
+#include "utils/thread/thread.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+/// @brief Largest amount of frames that one swapchain or render target chain may have in flight at once (they may use fewer, depending on their
+/// latency policy).
+#define TLVK_FRAMES_IN_FLIGHT 3
+/// @brief Amount of regions of the descriptor buffer, which bounds how many frames of the whole renderer system can write descriptors to the buffer
+/// at once.
+#define TLVK_DESCRIPTOR_BUFFER_REGION_COUNT (TLVK_FRAMES_IN_FLIGHT * 4)
+/// @brief Largest size in bytes of the region of the descriptor buffer that each frame in flight writes its descriptors to.
+#define TLVK_DESCRIPTOR_BUFFER_FRAME_SIZE (256 * 1024)
+
+typedef struct TLVK_DescriptorPoolList_t {
+    /// @brief Array of `capacity` slots, of which the first `count` hold descriptor pools, in order of creation.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorPool.html
+    VkDescriptorPool *pools;
+    /// @brief Amount of pools in `pools`.
+    uint32_t count;
+    /// @brief Amount of slots allocated for `pools`.
+    uint32_t capacity;
+    /// @brief Index of the pool that sets are currently allocated from - pools before it are full, and pools after it are empty.
+    uint32_t current;
+} TLVK_DescriptorPoolList_t;
+
+typedef struct TLVK_DescriptorBuffer_t {
+    /// @brief VK_NULL_HANDLE or a buffer holding descriptors, split into `TLVK_DESCRIPTOR_BUFFER_REGION_COUNT` regions, one for each of the
+    /// lowest frame indices of the renderer system's frame timeline (only created with the `descriptor_buffers` feature).
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkBuffer.html
+    VkBuffer vk_buffer;
+    /// @brief Host-visible memory bound to `vk_buffer`, which stays mapped for the lifetime of the buffer.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDeviceMemory.html
+    VkDeviceMemory vk_memory;
+    /// @brief Device address of `vk_buffer`, given to command buffers when binding it.
+    VkDeviceAddress address;
+    /// @brief Host pointer to the start of `vk_buffer`.
+    unsigned char *mapped;
+
+    /// @brief Size in bytes of the region of each frame.
+    VkDeviceSize frame_size;
+    /// @brief Offset of the first free byte in the region of each frame, relative to the start of the region.
+    VkDeviceSize heads[TLVK_DESCRIPTOR_BUFFER_REGION_COUNT];
+
+    /// @brief Descriptor sizes and alignment requirements of the device.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPhysicalDeviceDescriptorBufferPropertiesEXT.html
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT properties;
+    /// @brief True if push descriptor sets can be used by pipelines whose other sets are stored in the buffer.
+    bool push_descriptors;
+} TLVK_DescriptorBuffer_t;
+
+typedef struct TLVK_DescriptorAllocator_t {
+    /// @brief Array of `frame_count` pool lists, one for each frame index of the renderer system's frame timeline that has allocated sets.
+    TLVK_DescriptorPoolList_t *frames;
+    /// @brief Amount of elements in `frames`.
+    uint32_t frame_count;
+    /// @brief Descriptor buffer that sets of pipeline layouts created for descriptor buffers are written to instead of being allocated from pools.
+    TLVK_DescriptorBuffer_t buffer;
+    /// @brief Lock guarding the pools and buffer regions of every frame, as allocating from a Vulkan descriptor pool must be externally
+    /// synchronised.
+    TL_Mutex_t lock;
+} TLVK_DescriptorAllocator_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
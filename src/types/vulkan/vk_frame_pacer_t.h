@@ -0,0 +1,65 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_frame_pacer_t_h__
+#define __TL__internal__vulkan__vk_frame_pacer_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwdvk.h"
+#include "thallium/platform.h"
+
+#include "utils/thread/thread.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+/// @brief Amount of frames whose begin times are remembered, so that their latency can be measured once they are displayed.
+#define TLVK_FRAME_PACER_HISTORY 8
+
+typedef struct TLVK_FramePacer_t {
+    /// @brief The renderer system whose device presents are waited on with.
+    const TLVK_RendererSystem_t *renderer_system;
+
+    /// @brief Pacing thread, which waits for each queued present to be displayed.
+    TL_Thread_t thread;
+    /// @brief Guards every other member of the pacer.
+    TL_Mutex_t lock;
+    /// @brief Signalled when a present is queued, when the pacing thread finishes waiting on one, or when the pacer is shutting down.
+    TL_Cond_t wake;
+    /// @brief False once the pacing thread has been asked to exit.
+    bool running;
+
+    /// @brief VK_NULL_HANDLE or the swapchain whose presents are being waited on.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkSwapchainKHR.html
+    VkSwapchainKHR vk_swapchain;
+    /// @brief VK_NULL_HANDLE or the swapchain the pacing thread is currently blocked in vkWaitForPresentKHR on, which must not be destroyed.
+    VkSwapchainKHR vk_waiting_swapchain;
+
+    /// @brief Present ID of the most recently queued present of `vk_swapchain`.
+    uint64_t queued_id;
+    /// @brief Present ID of the most recent present known to have been displayed (or given up on).
+    uint64_t completed_id;
+    /// @brief Time in nanoseconds at which `completed_id` was displayed, or 0 if no present has been displayed yet.
+    uint64_t completed_time;
+
+    /// @brief Estimated time in nanoseconds between vertical blanks, or 0 if not yet known.
+    uint64_t refresh_interval;
+    /// @brief Estimated time in nanoseconds from beginning a frame to it being displayed, or 0 if not yet known.
+    uint64_t frame_latency;
+
+    /// @brief Times in nanoseconds at which the frames with the most recent present IDs began, indexed by present ID modulo
+    /// `TLVK_FRAME_PACER_HISTORY`.
+    uint64_t begin_times[TLVK_FRAME_PACER_HISTORY];
+} TLVK_FramePacer_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -0,0 +1,46 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_frame_timeline_t_h__
+#define __TL__internal__vulkan__vk_frame_timeline_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/platform.h"
+
+#include "utils/thread/thread.h"
+
+// internal struct to track the frames in flight of every swapchain and render target chain of a renderer system (as well as command buffers
+// submitted outside of them), so that resources shared between them are only reused once the device has finished with every frame that may still
+// reference them.
+typedef struct TLVK_FrameTimeline_t {
+    /// @brief Array of `slot_count` frame slots, each holding the serial of the frame that claimed it, or 0 if it is free. The index of a slot is
+    /// the frame index handed out for the frame it holds.
+    uint64_t *serials;
+    /// @brief Amount of slots in `serials`.
+    uint32_t slot_count;
+    /// @brief Amount of slots allocated for `serials`.
+    uint32_t slot_capacity;
+    /// @brief Array of `hold_count` serials held by command buffer systems, which take part in deciding the oldest serial in flight like frames
+    /// do but have no frame slot (and so no transient descriptor sets).
+    uint64_t *holds;
+    /// @brief Amount of serials in `holds`.
+    uint32_t hold_count;
+    /// @brief Amount of serials allocated for `holds`.
+    uint32_t hold_capacity;
+    /// @brief Serial of the most recently begun frame (serials start at 1).
+    uint64_t last_serial;
+    /// @brief Lock guarding every other member of the timeline.
+    TL_Mutex_t lock;
+} TLVK_FrameTimeline_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
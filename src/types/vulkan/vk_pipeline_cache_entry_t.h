@@ -0,0 +1,35 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_pipeline_cache_entry_t_h__
+#define __TL__internal__vulkan__vk_pipeline_cache_entry_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/platform.h"
+
+/// @brief Bookkeeping for an object shared through one of the renderer system's deduplication maps.
+typedef struct TLVK_PipelineCacheEntry_t {
+    /// @brief Amount of references to the object - guarded by the renderer system's `pipeline_systems_lock`.
+    uint32_t refcount;
+    /// @brief True if the object is registered in its deduplication map.
+    bool cached;
+
+    /// @brief Hash of the object's state, used as its key in its deduplication map.
+    uint64_t hash;
+    /// @brief Serialized state the object was created from (or a digest of it), compared on lookup to rule out hash collisions.
+    void *key;
+    /// @brief Size of `key` in bytes.
+    size_t key_size;
+} TLVK_PipelineCacheEntry_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -0,0 +1,84 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_pipeline_layout_t_h__
+#define __TL__internal__vulkan__vk_pipeline_layout_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "types/vulkan/vk_pipeline_cache_entry_t.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+/// @brief Maximum amount of descriptor sets that a reflected pipeline layout may use.
+#define TLVK_MAX_DESCRIPTOR_SETS 8
+/// @brief Amount of bytes of push constants that every Vulkan implementation is required to support.
+#define TLVK_PUSH_CONSTANTS_PORTABLE_SIZE 128
+/// @brief Index of the descriptor set that pipeline layouts create as a push descriptor set when the `push_descriptors` feature is enabled.
+#define TLVK_PUSH_DESCRIPTOR_SET_INDEX 1
+/// @brief Amount of descriptors in a push descriptor set that every implementation of `VK_KHR_push_descriptor` is required to support.
+#define TLVK_PUSH_DESCRIPTORS_PORTABLE_COUNT 32
+
+typedef struct TLVK_DescriptorSetLayout_t {
+    /// @brief Deduplication data - must be the first member.
+    TLVK_PipelineCacheEntry_t entry;
+
+    /// @brief Handle to a Vulkan descriptor set layout:
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorSetLayout.html
+    VkDescriptorSetLayout vk_layout;
+
+    /// @brief Flags the layout was created with (e.g. `VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR` for push descriptor sets).
+    VkDescriptorSetLayoutCreateFlags flags;
+
+    /// @brief Amount of bindings in `bindings`.
+    uint32_t binding_count;
+    /// @brief Bindings the layout was created with, sorted by binding index.
+    VkDescriptorSetLayoutBinding *bindings;
+
+    /// @brief VK_NULL_HANDLE or a template that writes every binding of a set with this layout from packed data in one call.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorUpdateTemplate.html
+    VkDescriptorUpdateTemplate vk_update_template;
+    /// @brief Size in bytes of the packed data that sets with this layout are written from (see @ref TLVK_DescriptorSetLayoutWrite()).
+    size_t update_data_size;
+
+    /// @brief Size in bytes of a set with this layout in a descriptor buffer (only for layouts created with
+    /// `VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT`).
+    VkDeviceSize buffer_size;
+    /// @brief NULL or the offset in bytes of each binding in `bindings` from the start of a set with this layout in a descriptor buffer.
+    VkDeviceSize *binding_offsets;
+} TLVK_DescriptorSetLayout_t;
+
+typedef struct TLVK_PipelineLayout_t {
+    /// @brief Deduplication data - must be the first member.
+    TLVK_PipelineCacheEntry_t entry;
+
+    /// @brief Handle to a Vulkan pipeline layout:
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPipelineLayout.html
+    VkPipelineLayout vk_layout;
+
+    /// @brief Amount of descriptor set layouts in `set_layouts`.
+    uint32_t set_count;
+    /// @brief References to the layouts of each descriptor set of the pipeline layout (sets unused by the shaders have empty layouts).
+    TLVK_DescriptorSetLayout_t *set_layouts[TLVK_MAX_DESCRIPTOR_SETS];
+
+    /// @brief Size in bytes of the push constant range of the layout (0 if there is none).
+    uint32_t push_constant_size;
+    /// @brief Shader stages that can access the push constant range.
+    VkShaderStageFlags push_constant_stages;
+
+    /// @brief True if the sets of the layout are stored in the renderer system's descriptor buffer rather than allocated from descriptor pools, in
+    /// which case pipelines using the layout are created with `VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT`.
+    bool descriptor_buffer;
+} TLVK_PipelineLayout_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
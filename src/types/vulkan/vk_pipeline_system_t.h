@@ -14,16 +14,57 @@
 
 #include "thallium/vulkan/vk_pipeline_system.h"
 
+#include "types/vulkan/vk_pipeline_cache_entry_t.h"
+#include "types/vulkan/vk_pipeline_layout_t.h"
+#include "types/vulkan/vk_shader_module_t.h"
+#include "utils/thread/thread.h"
+
 #define VK_NO_PROTOTYPES
 #include <vulkan/vulkan.h>
 
+// amount of graphics pipeline library parts that a complete graphics pipeline is linked from
+#define TLVK_PIPELINE_LIBRARY_PART_COUNT 4
+
+// maximum amount of shader stages in a pipeline
+#define TLVK_PIPELINE_MAX_SHADER_STAGES 2
+
+typedef struct TLVK_PipelineLibrary_t {
+    /// @brief Deduplication data - must be the first member.
+    TLVK_PipelineCacheEntry_t entry;
+
+    /// @brief Handle to a Vulkan graphics pipeline library containing one part of a graphics pipeline's state:
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_graphics_pipeline_library.html
+    VkPipeline vk_library;
+} TLVK_PipelineLibrary_t;
+
 typedef struct TLVK_PipelineSystem_t {
+    /// @brief Deduplication data - must be the first member.
+    TLVK_PipelineCacheEntry_t entry;
+
     /// @brief The parent Vulkan renderer system.
     const TLVK_RendererSystem_t *renderer_system;
 
     /// @brief Handle to a Vulkan pipeline state object:
     /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPipeline.html
-    VkPipeline pso;
+    /// When the pipeline is linked from libraries, this is atomically replaced with a link-time optimised pipeline once one has been compiled in
+    /// the background. Non-dispatchable handles are 64 bits wide on every platform, so the handle is held in a 64-bit atomic.
+    TL_Atomic64_t pso;
+    /// @brief VK_NULL_HANDLE or the fast-linked pipeline that `pso` was created as; kept alive as command buffers may still reference it.
+    VkPipeline vk_fast_pso;
+    /// @brief The point that `pso` is bound to in command buffers.
+    VkPipelineBindPoint bind_point;
+    /// @brief True if `pso` was created with VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT, so it can be the base pipeline of other pipelines.
+    bool derivable;
+    /// @brief Reference to the shared pipeline layout that `pso` was created with, derived from the reflected interfaces of its shaders.
+    TLVK_PipelineLayout_t *layout;
+
+    /// @brief References to the graphics pipeline libraries that `pso` was linked from (all NULL if it was not).
+    TLVK_PipelineLibrary_t *libraries[TLVK_PIPELINE_LIBRARY_PART_COUNT];
+    /// @brief References to the shader modules of each stage, kept so that later pipelines with the same shaders can reuse them (NULL if unused).
+    TLVK_ShaderModule_t *shader_modules[TLVK_PIPELINE_MAX_SHADER_STAGES];
+
+    /// @brief Feedback recorded when `pso` was first created (all invalid unless the `pipeline_creation_feedback` feature is enabled).
+    TL_PipelineCreationFeedback_t feedback;
 } TLVK_PipelineSystem_t;
 
 #ifdef __cplusplus
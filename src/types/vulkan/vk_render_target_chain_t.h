@@ -0,0 +1,87 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_render_target_chain_t_h__
+#define __TL__internal__vulkan__vk_render_target_chain_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/vulkan/vk_render_target_chain.h"
+
+#include "types/vulkan/vk_descriptor_allocator_t.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+// internal struct to hold one image of a render target chain, along with the objects of the frame in flight that renders to it.
+typedef struct TLVK_RenderTarget_t {
+    /// @brief The Vulkan image rendered to by the frame.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkImage.html
+    VkImage vk_image;
+    /// @brief Device memory bound to `vk_image`.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDeviceMemory.html
+    VkDeviceMemory vk_image_memory;
+
+    /// @brief VK_NULL_HANDLE or the host-visible buffer that `vk_image` is copied to at the end of each frame.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkBuffer.html
+    VkBuffer vk_readback_buffer;
+    /// @brief Device memory bound to `vk_readback_buffer`.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDeviceMemory.html
+    VkDeviceMemory vk_readback_memory;
+    /// @brief Persistently mapped pointer to `vk_readback_memory`.
+    void *readback_mapped;
+    /// @brief Command buffer that copies `vk_image` to `vk_readback_buffer`, which is recorded once whenever the image is created.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkCommandBuffer.html
+    VkCommandBuffer vk_readback_command_buffer;
+
+    /// @brief Fence signalled when every submission made for the most recent frame rendering to the image has finished executing.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkFence.html
+    VkFence vk_fence;
+    /// @brief True if the frame was submitted and `vk_fence` has not been waited on since.
+    bool pending;
+    /// @brief Index of the frame claimed on the renderer system's frame timeline, or UINT32_MAX if it has retired.
+    uint32_t renderer_frame;
+    /// @brief True if a frame has been submitted since the image was created, so that `vk_readback_buffer` holds (or will hold) its contents.
+    bool rendered;
+} TLVK_RenderTarget_t;
+
+typedef struct TLVK_RenderTargetChain_t {
+    /// @brief The parent Vulkan renderer system.
+    const TLVK_RendererSystem_t *renderer_system;
+
+    /// @brief Descriptor the chain was created with, whose resolution is updated on resize so it can be used to recreate the images.
+    TLVK_RenderTargetChainDescriptor_t descriptor;
+
+    /// @brief Format of the images.
+    VkFormat format;
+    /// @brief Extent (resolution) of the images.
+    VkExtent2D extent;
+    /// @brief Size in bytes of the tightly packed contents of one image, or 0 if readback is disabled.
+    VkDeviceSize readback_size;
+
+    /// @brief Command pool that the readback command buffers are allocated from.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkCommandPool.html
+    VkCommandPool vk_command_pool;
+
+    /// @brief Images of the chain, one for each frame in flight.
+    TLVK_RenderTarget_t targets[TLVK_FRAMES_IN_FLIGHT];
+    /// @brief Amount of elements of `targets` that are used, as decided by the latency policy of the chain.
+    uint32_t target_count;
+    /// @brief Amount of frames that have been ended.
+    uint64_t frame_number;
+    /// @brief True between beginning and ending a frame.
+    bool frame_active;
+    /// @brief True if the images must be recreated before the next frame begins (i.e. after a resize during a frame).
+    bool needs_recreate;
+} TLVK_RenderTargetChain_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -16,7 +16,11 @@
 
 #include "thallium/core/renderer.h"
 #include "lib/vulkan/vk_loader.h"
+#include "types/vulkan/vk_descriptor_allocator_t.h"
 #include "types/vulkan/vk_device_queues_t.h"
+#include "types/vulkan/vk_frame_timeline_t.h"
+#include "utils/hash/hashmap.h"
+#include "utils/thread/thread.h"
 
 #define VK_NO_PROTOTYPES
 #include <vulkan/vulkan.h>
@@ -46,10 +50,46 @@ typedef struct TLVK_RendererSystem_t {
     /// @brief Enabled device features.
     /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPhysicalDeviceFeatures.html
     VkPhysicalDeviceFeatures vk_device_features;
+    /// @brief Limits of the physical device.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPhysicalDeviceLimits.html
+    VkPhysicalDeviceLimits vk_device_limits;
 
     /// @brief Vulkan queue handles:
     /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkQueue.html
     TLVK_LogicalDeviceQueues_t vk_queues;
+
+    /// @brief Pipeline cache shared by every pipeline created under this renderer system, including those compiled on worker threads.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPipelineCache.html
+    VkPipelineCache vk_pipeline_cache;
+
+    /// @brief Map of descriptor hashes to live pipeline systems, used to share pipeline systems between equivalent pipelines.
+    TL_HashMap_t pipeline_systems;
+    /// @brief Map of pipeline state hashes to live graphics pipeline libraries, used to share pipeline parts between graphics pipelines.
+    TL_HashMap_t pipeline_libraries;
+    /// @brief Map of SPIR-V code hashes to live shader modules, used to share shader modules between pipelines.
+    TL_HashMap_t shader_modules;
+    /// @brief Map of reflected interface hashes to live pipeline layouts, used to share pipeline layouts between pipelines.
+    TL_HashMap_t pipeline_layouts;
+    /// @brief Map of binding list hashes to live descriptor set layouts, used to share descriptor set layouts between pipeline layouts.
+    TL_HashMap_t descriptor_set_layouts;
+    /// @brief Map of sampler parameter hashes to live samplers, used to share samplers between their users.
+    TL_HashMap_t samplers;
+    /// @brief Lock guarding each of the deduplication maps above and the reference counts of the objects in them.
+    TL_Mutex_t pipeline_systems_lock;
+
+    /// @brief Amount of live samplers, checked against `maxSamplerAllocationCount` before creating new ones.
+    TL_Atomic64_t sampler_count;
+    /// @brief Amount of sampler acquisitions that returned an existing sampler.
+    TL_Atomic64_t sampler_cache_hits;
+    /// @brief Amount of sampler acquisitions that created a new sampler.
+    TL_Atomic64_t sampler_cache_misses;
+
+    /// @brief Frames in flight of every swapchain and render target chain of the renderer system.
+    TLVK_FrameTimeline_t frame_timeline;
+    /// @brief Allocator of transient descriptor sets, which are freed in bulk once the frame in flight they were allocated for retires.
+    TLVK_DescriptorAllocator_t descriptor_allocator;
+    /// @brief NULL or the global bindless resource table (only created with the `bindless_resources` feature).
+    TLVK_BindlessTable_t *bindless_table;
 } TLVK_RendererSystem_t;
 
 #ifdef __cplusplus
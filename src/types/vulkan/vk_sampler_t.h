@@ -0,0 +1,37 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_sampler_t_h__
+#define __TL__internal__vulkan__vk_sampler_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/vulkan/vk_sampler_cache.h"
+
+#include "types/vulkan/vk_pipeline_cache_entry_t.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+typedef struct TLVK_Sampler_t {
+    /// @brief Deduplication data - must be the first member.
+    TLVK_PipelineCacheEntry_t entry;
+
+    /// @brief Renderer system the sampler was created under.
+    TLVK_RendererSystem_t *renderer_system;
+
+    /// @brief Handle to a Vulkan sampler:
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkSampler.html
+    VkSampler vk_sampler;
+} TLVK_Sampler_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
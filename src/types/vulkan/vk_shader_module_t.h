@@ -0,0 +1,36 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__vulkan__vk_shader_module_t_h__
+#define __TL__internal__vulkan__vk_shader_module_t_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "types/vulkan/vk_pipeline_cache_entry_t.h"
+#include "utils/spirv/spirv_reflect.h"
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+typedef struct TLVK_ShaderModule_t {
+    /// @brief Deduplication data - must be the first member.
+    TLVK_PipelineCacheEntry_t entry;
+
+    /// @brief Handle to a Vulkan shader module:
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkShaderModule.html
+    VkShaderModule vk_module;
+
+    /// @brief Interface of the module's code, reflected once when the module is created.
+    TL_SpirvReflection_t reflection;
+} TLVK_ShaderModule_t;
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
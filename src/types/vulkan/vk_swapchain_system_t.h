@@ -14,9 +14,60 @@
 
 #include "thallium/vulkan/vk_swapchain_system.h"
 
+#include "types/vulkan/vk_descriptor_allocator_t.h"
+#include "types/vulkan/vk_frame_pacer_t.h"
+
 #define VK_NO_PROTOTYPES
 #include <vulkan/vulkan.h>
 
+// internal struct to hold the synchronisation objects of one frame in flight.
+typedef struct TLVK_SwapchainFrame_t {
+    /// @brief Semaphore signalled when the image acquired for the frame may be rendered to.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkSemaphore.html
+    VkSemaphore vk_acquire_semaphore;
+    /// @brief Fence signalled when every submission made for the frame has finished executing.
+    /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkFence.html
+    VkFence vk_fence;
+    /// @brief True if the frame was submitted and `vk_fence` has not been waited on since.
+    bool pending;
+    /// @brief Index of the frame claimed on the renderer system's frame timeline, or UINT32_MAX if it has retired.
+    uint32_t renderer_frame;
+} TLVK_SwapchainFrame_t;
+
+// internal struct to cache what the surface of a swapchain system supports on its physical device, so that recreating the swapchain does not
+// query (and allocate) the formats and present modes again.
+typedef struct TLVK_SurfaceSupport_t {
+    /// @brief Basic surface capabilities supported - min/max images in swapchain, min/max size of images, etc
+    /// This is re-queried whenever the swapchain is recreated, as the current extent of the surface follows the size of its window.
+    VkSurfaceCapabilitiesKHR caps;
+
+    /// @brief Supported surface formats (pixel format, colour space)
+    VkSurfaceFormatKHR *formats;
+    /// @brief Amount of elements in array `formats`
+    uint32_t format_count;
+
+    /// @brief Available presentation modes (fifo, mailbox, etc)
+    VkPresentModeKHR *present_modes;
+    /// @brief Amount of elements in array `present_modes`
+    uint32_t present_mode_count;
+
+    /// @brief False until `formats` and `present_modes` have been queried, and after the surface was lost or reported the swapchain to be out of
+    /// date (after which they are queried again).
+    bool valid;
+} TLVK_SurfaceSupport_t;
+
+// internal struct to hold a swapchain that was replaced by recreation, which is kept alive until presentation can no longer be using it.
+typedef struct TLVK_RetiredSwapchain_t {
+    /// @brief The retired Vulkan swapchain object.
+    VkSwapchainKHR vk_swapchain;
+    /// @brief Present semaphores of the images of `vk_swapchain`.
+    VkSemaphore *present_semaphores;
+    /// @brief Amount of elements in `present_semaphores`.
+    uint32_t present_semaphore_count;
+    /// @brief The swapchain is destroyed once the frame with this number has finished executing.
+    uint64_t retire_frame;
+} TLVK_RetiredSwapchain_t;
+
 typedef struct TLVK_SwapchainSystem_t {
     /// @brief The parent Vulkan renderer system.
     const TLVK_RendererSystem_t *renderer_system;
@@ -41,6 +92,40 @@ typedef struct TLVK_SwapchainSystem_t {
     VkFormat col_format;
     /// @brief Swapchain extent (resolution).
     VkExtent2D extent;
+
+    /// @brief Cached support of `vk_surface` on the physical device of the parent renderer system.
+    TLVK_SurfaceSupport_t support;
+
+    /// @brief Descriptor the swapchain was created with, whose resolution is updated on resize so it can be used to recreate the swapchain.
+    TLVK_SwapchainSystemDescriptor_t descriptor;
+
+    /// @brief Array of semaphores signalled when rendering to each image has finished, waited on by presentation (one per element of
+    /// `col_images`).
+    VkSemaphore *present_semaphores;
+
+    /// @brief Synchronisation objects of each frame in flight.
+    TLVK_SwapchainFrame_t frames[TLVK_FRAMES_IN_FLIGHT];
+    /// @brief Amount of elements of `frames` that are used, as decided by the latency policy of the swapchain.
+    uint32_t frames_in_flight;
+    /// @brief Amount of frames that have been presented (or attempted to be).
+    uint64_t frame_number;
+    /// @brief Index of the image acquired for the current frame.
+    uint32_t image_index;
+    /// @brief True between beginning and ending a frame.
+    bool frame_active;
+    /// @brief True if the swapchain must be recreated before the next image is acquired (e.g. after it was reported to be suboptimal).
+    bool needs_recreate;
+
+    /// @brief NULL or the frame pacer of the swapchain (only created if requested in `descriptor`).
+    TLVK_FramePacer_t *pacer;
+    /// @brief Present ID of the most recent present, incremented with every present so that the IDs passed to VkPresentIdKHR keep increasing
+    /// across recreations.
+    uint64_t present_id;
+
+    /// @brief Array of swapchains replaced by recreation that are waiting to be destroyed.
+    TLVK_RetiredSwapchain_t *retired;
+    /// @brief Amount of elements in `retired`.
+    uint32_t retired_count;
 } TLVK_SwapchainSystem_t;
 
 #ifdef __cplusplus
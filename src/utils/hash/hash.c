@@ -0,0 +1,66 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "hash.h"
+
+#include <string.h>
+
+// odd 64-bit multipliers with well-mixed bits (same constants as used by xxHash64)
+#define __PRIME_A 0x9E3779B185EBCA87ULL
+#define __PRIME_B 0xC2B2AE3D27D4EB4FULL
+#define __PRIME_C 0x165667B19E3779F9ULL
+
+static inline uint64_t __Rotl(const uint64_t x, const int r);
+
+static inline uint64_t __Mix(uint64_t h);
+
+
+uint64_t TL_Hash64(const void *const data, const size_t size, const uint64_t seed) {
+    const unsigned char *p = (const unsigned char *) data;
+    size_t remaining = size;
+
+    uint64_t h = seed ^ (size * __PRIME_C);
+
+    // bulk of the input is consumed as whole words - memcpy is used so unaligned input is fine
+    while (remaining >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+
+        h ^= __Rotl(w * __PRIME_B, 31) * __PRIME_A;
+        h = __Rotl(h, 27) * __PRIME_A + __PRIME_C;
+
+        p += 8;
+        remaining -= 8;
+    }
+
+    // tail bytes are packed into a final partial word
+    if (remaining) {
+        uint64_t w = 0;
+        memcpy(&w, p, remaining);
+
+        h ^= __Rotl(w * __PRIME_B, 31) * __PRIME_A;
+        h = __Rotl(h, 27) * __PRIME_A + __PRIME_C;
+    }
+
+    return __Mix(h);
+}
+
+
+static inline uint64_t __Rotl(const uint64_t x, const int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// final avalanche so that every input bit affects every output bit
+static inline uint64_t __Mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= __PRIME_B;
+    h ^= h >> 29;
+    h *= __PRIME_C;
+    h ^= h >> 32;
+
+    return h;
+}
@@ -0,0 +1,39 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__utils__hash_h__
+#define __TL__internal__utils__hash_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/platform.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Compute a 64-bit hash of the given bytes.
+ *
+ * This function computes a fast, non-cryptographic 64-bit hash of `size` bytes at `data`. Input is consumed 8 bytes at a time, so hashing large
+ * blobs (e.g. serialized pipeline state or SPIR-V code) stays cheap.
+ *
+ * @param data Pointer to the bytes to hash (may be NULL if `size` is 0)
+ * @param size Amount of bytes to hash
+ * @param seed Initial seed - different seeds give unrelated hashes of the same data
+ * @return The hash value
+ */
+uint64_t TL_Hash64(
+    const void *const data,
+    const size_t size,
+    const uint64_t seed
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
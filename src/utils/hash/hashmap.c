@@ -0,0 +1,170 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "hashmap.h"
+
+#include "utils/io/log.h"
+
+#include <stdlib.h>
+
+// capacity of a map after its first insertion
+#define __INITIAL_CAPACITY 16
+
+static inline uint32_t __HomeSlot(const uint64_t key, const uint32_t capacity);
+
+static bool __Grow(TL_HashMap_t *const map, const TL_Debugger_t *const debugger);
+
+
+void TL_HashMapFree(TL_HashMap_t *const map) {
+    if (!map) {
+        return;
+    }
+
+    free(map->keys);
+    free(map->values);
+
+    map->keys = NULL;
+    map->values = NULL;
+    map->capacity = 0;
+    map->count = 0;
+}
+
+void *TL_HashMapGet(const TL_HashMap_t *const map, const uint64_t key) {
+    if (!map || !map->count) {
+        return NULL;
+    }
+
+    uint32_t mask = map->capacity - 1;
+
+    for (uint32_t i = __HomeSlot(key, map->capacity); map->values[i]; i = (i + 1) & mask) {
+        if (map->keys[i] == key) {
+            return map->values[i];
+        }
+    }
+
+    return NULL;
+}
+
+bool TL_HashMapSet(TL_HashMap_t *const map, const uint64_t key, void *const value, const TL_Debugger_t *const debugger) {
+    if (!map || !value) {
+        return false;
+    }
+
+    // keep the load factor at or below 3/4 so that probe sequences stay short
+    if ((map->count + 1) * 4 > map->capacity * 3) {
+        if (!__Grow(map, debugger)) {
+            return false;
+        }
+    }
+
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = __HomeSlot(key, map->capacity);
+
+    for (; map->values[i]; i = (i + 1) & mask) {
+        if (map->keys[i] == key) {
+            map->values[i] = value;
+            return true;
+        }
+    }
+
+    map->keys[i] = key;
+    map->values[i] = value;
+    map->count++;
+
+    return true;
+}
+
+void *TL_HashMapRemove(TL_HashMap_t *const map, const uint64_t key) {
+    if (!map || !map->count) {
+        return NULL;
+    }
+
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = __HomeSlot(key, map->capacity);
+
+    for (; map->values[i]; i = (i + 1) & mask) {
+        if (map->keys[i] == key) {
+            break;
+        }
+    }
+
+    void *ret = map->values[i];
+    if (!ret) {
+        return NULL;
+    }
+
+    map->values[i] = NULL;
+    map->count--;
+
+    // backward-shift deletion: move later entries of the same probe run into the hole, so lookups never need tombstones
+    for (uint32_t j = (i + 1) & mask; map->values[j]; j = (j + 1) & mask) {
+        uint32_t home = __HomeSlot(map->keys[j], map->capacity);
+
+        // the entry at j may only move into the hole if the hole lies (cyclically) between its home slot and j
+        bool movable = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+        if (!movable) {
+            continue;
+        }
+
+        map->keys[i] = map->keys[j];
+        map->values[i] = map->values[j];
+        map->values[j] = NULL;
+        i = j;
+    }
+
+    return ret;
+}
+
+
+// Fibonacci hashing - the top bits of the product are used as they depend on every bit of the key
+static inline uint32_t __HomeSlot(const uint64_t key, const uint32_t capacity) {
+    uint32_t bits = 0;
+    while ((1u << bits) < capacity) {
+        bits++;
+    }
+
+    return (uint32_t) ((key * 0x9E3779B97F4A7C15ULL) >> (64 - bits)) & (capacity - 1);
+}
+
+static bool __Grow(TL_HashMap_t *const map, const TL_Debugger_t *const debugger) {
+    uint32_t new_capacity = (map->capacity) ? map->capacity * 2 : __INITIAL_CAPACITY;
+
+    uint64_t *new_keys = malloc(sizeof(uint64_t) * new_capacity);
+    void **new_values = calloc(new_capacity, sizeof(void *));
+    if (!new_keys || !new_values) {
+        TL_Fatal(debugger, "MALLOC fault in call to __Grow");
+        free(new_keys);
+        free(new_values);
+        return false;
+    }
+
+    uint32_t new_mask = new_capacity - 1;
+
+    // re-insert every entry at its new position
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (!map->values[i]) {
+            continue;
+        }
+
+        uint32_t j = __HomeSlot(map->keys[i], new_capacity);
+        while (new_values[j]) {
+            j = (j + 1) & new_mask;
+        }
+
+        new_keys[j] = map->keys[i];
+        new_values[j] = map->values[i];
+    }
+
+    free(map->keys);
+    free(map->values);
+
+    map->keys = new_keys;
+    map->values = new_values;
+    map->capacity = new_capacity;
+
+    return true;
+}
@@ -0,0 +1,92 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__utils__hashmap_h__
+#define __TL__internal__utils__hashmap_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwd.h"
+#include "thallium/platform.h"
+
+/**
+ * @brief An open-addressing hash map from 64-bit keys to non-NULL pointers.
+ *
+ * Keys are typically hashes produced by @ref TL_Hash64(), but any 64-bit value may be used as they are mixed again before probing. A zeroed struct
+ * is a valid empty map. The map does not own its values and is not thread-safe.
+ */
+typedef struct TL_HashMap_t {
+    /// @brief Array of `capacity` keys
+    uint64_t *keys;
+    /// @brief Array of `capacity` values - NULL marks an empty slot
+    void **values;
+
+    /// @brief Amount of slots (always 0 or a power of 2)
+    uint32_t capacity;
+    /// @brief Amount of occupied slots
+    uint32_t count;
+} TL_HashMap_t;
+
+/**
+ * @brief Free all memory owned by the given hash map.
+ *
+ * This function frees the slot arrays of `map` and leaves it as a valid, empty map. Values are not freed.
+ *
+ * @param map Hash map to free
+ */
+void TL_HashMapFree(
+    TL_HashMap_t *const map
+);
+
+/**
+ * @brief Look up a key in the given hash map.
+ *
+ * @param map Hash map to search
+ * @param key Key to look up
+ * @return The value stored under `key`, or NULL if there is none
+ */
+void *TL_HashMapGet(
+    const TL_HashMap_t *const map,
+    const uint64_t key
+);
+
+/**
+ * @brief Store a value under a key in the given hash map.
+ *
+ * This function inserts `value` under `key`, replacing any value that was already stored under it. The map grows as needed.
+ *
+ * @param map Hash map to insert into
+ * @param key Key to store the value under
+ * @param value Non-NULL value to store
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if there was an allocation failure
+ */
+bool TL_HashMapSet(
+    TL_HashMap_t *const map,
+    const uint64_t key,
+    void *const value,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Remove a key from the given hash map.
+ *
+ * @param map Hash map to remove from
+ * @param key Key to remove
+ * @return The value that was stored under `key`, or NULL if there was none
+ */
+void *TL_HashMapRemove(
+    TL_HashMap_t *const map,
+    const uint64_t key
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
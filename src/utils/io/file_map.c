@@ -0,0 +1,107 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "file_map.h"
+
+#include "log.h"
+
+#if defined(_WIN32)
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include <string.h>
+
+bool TL_FileMap(const char *const path, TL_FileMapping_t *const out, const TL_Debugger_t *const debugger) {
+    if (!path || !out) {
+        return false;
+    }
+
+    memset(out, 0, sizeof(TL_FileMapping_t));
+
+#   if defined(_WIN32)
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            TL_Error(debugger, "Failed to open file \"%s\" for mapping", path);
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || !size.QuadPart) {
+            TL_Error(debugger, "Failed to map file \"%s\" (could not be read, or is empty)", path);
+            CloseHandle(file);
+            return false;
+        }
+
+        // the file handle may be closed once the mapping object holds its own reference to the file
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if (!mapping) {
+            TL_Error(debugger, "Failed to create mapping of file \"%s\"", path);
+            return false;
+        }
+
+        void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data) {
+            TL_Error(debugger, "Failed to map view of file \"%s\"", path);
+            CloseHandle(mapping);
+            return false;
+        }
+
+        out->data = data;
+        out->size = (size_t) size.QuadPart;
+        out->handle = mapping;
+#   else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            TL_Error(debugger, "Failed to open file \"%s\" for mapping", path);
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) || !st.st_size) {
+            TL_Error(debugger, "Failed to map file \"%s\" (could not be read, or is empty)", path);
+            close(fd);
+            return false;
+        }
+
+        // the mapping holds its own reference to the file, so the descriptor is not needed past this point
+        void *data = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            TL_Error(debugger, "Failed to map file \"%s\"", path);
+            return false;
+        }
+
+        out->data = data;
+        out->size = (size_t) st.st_size;
+#   endif
+
+    TL_Log(debugger, "Mapped file \"%s\" (%llu bytes) at %p", path, (unsigned long long) out->size, out->data);
+
+    return true;
+}
+
+void TL_FileUnmap(TL_FileMapping_t *const mapping) {
+    if (!mapping || !mapping->data) {
+        return;
+    }
+
+#   if defined(_WIN32)
+        UnmapViewOfFile(mapping->data);
+        CloseHandle((HANDLE) mapping->handle);
+#   else
+        munmap((void *) mapping->data, mapping->size);
+#   endif
+
+    memset(mapping, 0, sizeof(TL_FileMapping_t));
+}
@@ -0,0 +1,62 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__utils__file_map_h__
+#define __TL__internal__utils__file_map_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwd.h"
+#include "thallium/platform.h"
+
+/**
+ * @brief A read-only memory mapping of a file.
+ *
+ * A zero-initialised mapping is empty, and may be passed to @ref TL_FileUnmap().
+ */
+typedef struct TL_FileMapping_t {
+    /// @brief NULL or the mapped contents of the file.
+    const void *data;
+    /// @brief Size of `data` in bytes.
+    size_t size;
+
+    /// @brief Platform handle of the mapping object (unused on Unix).
+    void *handle;
+} TL_FileMapping_t;
+
+/**
+ * @brief Map the given file into memory for reading.
+ *
+ * This function maps the entire contents of the file at `path` into the address space of the process, so that it can be read without first
+ * copying it into a buffer. Pages are only read from disk when they are first accessed.
+ *
+ * @param path Path to the file to map
+ * @param out Pointer to the mapping to populate
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if the file could not be mapped (in which case `out` is left empty)
+ */
+bool TL_FileMap(
+    const char *const path,
+    TL_FileMapping_t *const out,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Unmap a file mapped with @ref TL_FileMap().
+ *
+ * @param mapping Mapping to unmap - left empty afterwards
+ */
+void TL_FileUnmap(
+    TL_FileMapping_t *const mapping
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
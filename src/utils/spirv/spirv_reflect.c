@@ -0,0 +1,601 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "spirv_reflect.h"
+
+#include "utils/io/log.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define __SPIRV_MAGIC 0x07230203
+#define __SPIRV_HEADER_WORD_COUNT 5
+
+// maximum nesting depth of types that will be followed when computing sizes
+#define __MAX_TYPE_DEPTH 32
+
+// SPIR-V opcodes that are read by the reflection pass
+#define __OP_ENTRY_POINT 15
+#define __OP_TYPE_BOOL 20
+#define __OP_TYPE_INT 21
+#define __OP_TYPE_FLOAT 22
+#define __OP_TYPE_VECTOR 23
+#define __OP_TYPE_MATRIX 24
+#define __OP_TYPE_IMAGE 25
+#define __OP_TYPE_SAMPLER 26
+#define __OP_TYPE_SAMPLED_IMAGE 27
+#define __OP_TYPE_ARRAY 28
+#define __OP_TYPE_RUNTIME_ARRAY 29
+#define __OP_TYPE_STRUCT 30
+#define __OP_TYPE_POINTER 32
+#define __OP_CONSTANT 43
+#define __OP_SPEC_CONSTANT 50
+#define __OP_VARIABLE 59
+#define __OP_DECORATE 71
+#define __OP_MEMBER_DECORATE 72
+#define __OP_TYPE_ACCELERATION_STRUCTURE 5341
+
+// SPIR-V decorations
+#define __DECORATION_BUFFER_BLOCK 3
+#define __DECORATION_ARRAY_STRIDE 6
+#define __DECORATION_MATRIX_STRIDE 7
+#define __DECORATION_BUILT_IN 11
+#define __DECORATION_LOCATION 30
+#define __DECORATION_BINDING 33
+#define __DECORATION_DESCRIPTOR_SET 34
+#define __DECORATION_OFFSET 35
+
+// SPIR-V storage classes
+#define __STORAGE_CLASS_UNIFORM_CONSTANT 0
+#define __STORAGE_CLASS_INPUT 1
+#define __STORAGE_CLASS_UNIFORM 2
+#define __STORAGE_CLASS_PUSH_CONSTANT 9
+#define __STORAGE_CLASS_STORAGE_BUFFER 12
+
+// SPIR-V image dimensionalities
+#define __DIM_BUFFER 5
+#define __DIM_SUBPASS_DATA 6
+
+// flags recording which decorations were applied to an id
+#define __ID_HAS_SET 0x01
+#define __ID_HAS_BINDING 0x02
+#define __ID_HAS_LOCATION 0x04
+#define __ID_BUILT_IN 0x08
+#define __ID_BUFFER_BLOCK 0x10
+
+typedef struct __SpirvId {
+    // word offset of the instruction that defines the id (0 if it is undefined or not of interest)
+    uint32_t offset;
+
+    uint32_t set;
+    uint32_t binding;
+    uint32_t location;
+    uint32_t array_stride;
+    uint32_t flags;
+
+    // index of the first member of a struct type in the module's `members` array
+    uint32_t first_member;
+} __SpirvId;
+
+typedef struct __SpirvMember {
+    uint32_t offset;
+    // 0 if the member is not a matrix decorated with a stride
+    uint32_t matrix_stride;
+} __SpirvMember;
+
+typedef struct __SpirvModule {
+    const uint32_t *words;
+    size_t word_count;
+
+    __SpirvId *ids;
+    uint32_t id_bound;
+
+    // layout decorations of the members of every struct type, looked up from the index of the struct's first member
+    __SpirvMember *members;
+    uint32_t member_count;
+} __SpirvModule;
+
+
+static uint32_t __GetOpcode(const __SpirvModule *const module, const uint32_t id);
+static uint32_t __GetOperand(const __SpirvModule *const module, const uint32_t id, const uint32_t operand);
+static bool __RecordMemberDecorations(__SpirvModule *const module, const size_t begin, const size_t end);
+static uint32_t __GetTypeSize(const __SpirvModule *const module, const uint32_t type_id, const uint32_t depth);
+static bool __ReflectBinding(const __SpirvModule *const module, const uint32_t variable_id, const uint32_t storage_class,
+    TL_SpirvBinding_t *const out);
+static bool __ReflectInput(const __SpirvModule *const module, const uint32_t variable_id, TL_SpirvInput_t *const out);
+static TL_SpirvStageFlags_t __StageFromExecutionModel(const uint32_t execution_model);
+
+
+bool TL_SpirvReflect(const uint32_t *const code, const size_t code_size, TL_SpirvReflection_t *const out, const TL_Debugger_t *const debugger) {
+    if (!code || !out) {
+        return false;
+    }
+
+    memset(out, 0, sizeof(TL_SpirvReflection_t));
+
+    __SpirvModule module = { 0 };
+    module.words = code;
+    module.word_count = code_size / sizeof(uint32_t);
+
+    if (code_size % sizeof(uint32_t) || module.word_count < __SPIRV_HEADER_WORD_COUNT || code[0] != __SPIRV_MAGIC) {
+        TL_Error(debugger, "Failed to reflect SPIR-V module: code is not a valid SPIR-V module (bad size or magic number)");
+        return false;
+    }
+
+    module.id_bound = code[3];
+
+    module.ids = calloc(module.id_bound, sizeof(__SpirvId));
+    if (!module.ids && module.id_bound) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_SpirvReflect");
+        return false;
+    }
+
+    uint32_t variable_count = 0;
+
+    // range of words holding member decorations, which precede the struct types they decorate and so are only recorded after the first pass
+    size_t member_decorations_begin = 0;
+    size_t member_decorations_end = 0;
+
+    // first pass: locate the definitions of types, constants and variables, and record decorations
+    for (size_t i = __SPIRV_HEADER_WORD_COUNT; i < module.word_count;) {
+        const uint32_t opcode = code[i] & 0xffff;
+        const uint32_t word_count = code[i] >> 16;
+
+        if (!word_count || i + word_count > module.word_count) {
+            TL_Error(debugger, "Failed to reflect SPIR-V module: malformed instruction at word %llu", (unsigned long long) i);
+            goto outerr;
+        }
+
+        switch (opcode) {
+            case __OP_ENTRY_POINT:
+                if (!out->stage && word_count >= 2) {
+                    out->stage = __StageFromExecutionModel(code[i + 1]);
+                }
+
+                break;
+
+            case __OP_TYPE_BOOL:
+            case __OP_TYPE_INT:
+            case __OP_TYPE_FLOAT:
+            case __OP_TYPE_VECTOR:
+            case __OP_TYPE_MATRIX:
+            case __OP_TYPE_IMAGE:
+            case __OP_TYPE_SAMPLER:
+            case __OP_TYPE_SAMPLED_IMAGE:
+            case __OP_TYPE_ARRAY:
+            case __OP_TYPE_RUNTIME_ARRAY:
+            case __OP_TYPE_STRUCT:
+            case __OP_TYPE_POINTER:
+            case __OP_TYPE_ACCELERATION_STRUCTURE:
+                // types define their result id in the first operand
+                if (word_count >= 2 && code[i + 1] < module.id_bound) {
+                    module.ids[code[i + 1]].offset = (uint32_t) i;
+
+                    if (opcode == __OP_TYPE_STRUCT) {
+                        module.ids[code[i + 1]].first_member = module.member_count;
+                        module.member_count += word_count - 2;
+                    }
+                }
+
+                break;
+
+            case __OP_CONSTANT:
+            case __OP_SPEC_CONSTANT:
+            case __OP_VARIABLE:
+                // constants and variables define their result id in the second operand, after their result type
+                if (word_count >= 3 && code[i + 2] < module.id_bound) {
+                    module.ids[code[i + 2]].offset = (uint32_t) i;
+
+                    if (opcode == __OP_VARIABLE) {
+                        variable_count++;
+                    }
+                }
+
+                break;
+
+            case __OP_DECORATE: {
+                if (word_count < 3 || code[i + 1] >= module.id_bound) {
+                    break;
+                }
+
+                __SpirvId *target = &module.ids[code[i + 1]];
+                const uint32_t value = (word_count >= 4) ? code[i + 3] : 0;
+
+                switch (code[i + 2]) {
+                    case __DECORATION_DESCRIPTOR_SET:
+                        target->set = value;
+                        target->flags |= __ID_HAS_SET;
+                        break;
+                    case __DECORATION_BINDING:
+                        target->binding = value;
+                        target->flags |= __ID_HAS_BINDING;
+                        break;
+                    case __DECORATION_LOCATION:
+                        target->location = value;
+                        target->flags |= __ID_HAS_LOCATION;
+                        break;
+                    case __DECORATION_BUILT_IN:
+                        target->flags |= __ID_BUILT_IN;
+                        break;
+                    case __DECORATION_BUFFER_BLOCK:
+                        target->flags |= __ID_BUFFER_BLOCK;
+                        break;
+                    case __DECORATION_ARRAY_STRIDE:
+                        target->array_stride = value;
+                        break;
+                    default:
+                        break;
+                }
+
+                break;
+            }
+
+            case __OP_MEMBER_DECORATE:
+                if (!member_decorations_begin) {
+                    member_decorations_begin = i;
+                }
+                member_decorations_end = i + word_count;
+
+                break;
+
+            default:
+                break;
+        }
+
+        i += word_count;
+    }
+
+    if (!__RecordMemberDecorations(&module, member_decorations_begin, member_decorations_end)) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_SpirvReflect");
+        goto outerr;
+    }
+
+    if (variable_count) {
+        out->bindings = malloc(sizeof(TL_SpirvBinding_t) * variable_count);
+        out->inputs = malloc(sizeof(TL_SpirvInput_t) * variable_count);
+        if (!out->bindings || !out->inputs) {
+            TL_Fatal(debugger, "MALLOC fault in call to TL_SpirvReflect");
+            goto outerr;
+        }
+    }
+
+    // second pass: reflect the interface variables of the module
+    for (uint32_t id = 0; id < module.id_bound; id++) {
+        if (__GetOpcode(&module, id) != __OP_VARIABLE) {
+            continue;
+        }
+
+        const uint32_t storage_class = __GetOperand(&module, id, 2);
+
+        switch (storage_class) {
+            case __STORAGE_CLASS_UNIFORM_CONSTANT:
+            case __STORAGE_CLASS_UNIFORM:
+            case __STORAGE_CLASS_STORAGE_BUFFER:
+                if (!(module.ids[id].flags & __ID_HAS_BINDING)) {
+                    break;
+                }
+
+                if (!__ReflectBinding(&module, id, storage_class, &out->bindings[out->binding_count])) {
+                    TL_Error(debugger, "Failed to reflect SPIR-V module: binding of variable %%%u has an unsupported type", id);
+                    goto outerr;
+                }
+
+                out->binding_count++;
+
+                break;
+
+            case __STORAGE_CLASS_PUSH_CONSTANT: {
+                const uint32_t pointer_type = __GetOperand(&module, id, 0);
+                const uint32_t size = __GetTypeSize(&module, __GetOperand(&module, pointer_type, 2), 0);
+
+                if (size > out->push_constant_size) {
+                    out->push_constant_size = size;
+                }
+
+                break;
+            }
+
+            case __STORAGE_CLASS_INPUT:
+                // built-in inputs (e.g. gl_VertexIndex) are provided by the implementation rather than the application
+                if (!(module.ids[id].flags & __ID_HAS_LOCATION) || (module.ids[id].flags & __ID_BUILT_IN)) {
+                    break;
+                }
+
+                if (!__ReflectInput(&module, id, &out->inputs[out->input_count])) {
+                    TL_Warn(debugger, "SPIR-V input variable %%%u at location %u has an unsupported type and was not reflected", id,
+                        module.ids[id].location);
+                    break;
+                }
+
+                out->input_count++;
+
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    free(module.ids);
+    free(module.members);
+
+    TL_Log(debugger, "Reflected SPIR-V module (stage 0x%x): %u bindings, %u inputs, %u bytes of push constants", (unsigned int) out->stage,
+        out->binding_count, out->input_count, out->push_constant_size);
+
+    return true;
+
+outerr:
+    free(module.ids);
+    free(module.members);
+    TL_SpirvReflectionFree(out);
+
+    return false;
+}
+
+void TL_SpirvReflectionFree(TL_SpirvReflection_t *const reflection) {
+    if (!reflection) {
+        return;
+    }
+
+    free(reflection->bindings);
+    free(reflection->inputs);
+
+    memset(reflection, 0, sizeof(TL_SpirvReflection_t));
+}
+
+
+static uint32_t __GetOpcode(const __SpirvModule *const module, const uint32_t id) {
+    if (id >= module->id_bound || !module->ids[id].offset) {
+        return 0;
+    }
+
+    return module->words[module->ids[id].offset] & 0xffff;
+}
+
+static uint32_t __GetOperand(const __SpirvModule *const module, const uint32_t id, const uint32_t operand) {
+    if (id >= module->id_bound || !module->ids[id].offset) {
+        return 0;
+    }
+
+    const uint32_t offset = module->ids[id].offset;
+
+    // operands are indexed from the first word after the opcode; out-of-range operands read as 0
+    if (operand + 1 >= (module->words[offset] >> 16)) {
+        return 0;
+    }
+
+    return module->words[offset + 1 + operand];
+}
+
+static bool __RecordMemberDecorations(__SpirvModule *const module, const size_t begin, const size_t end) {
+    if (!module->member_count) {
+        return true;
+    }
+
+    module->members = calloc(module->member_count, sizeof(__SpirvMember));
+    if (!module->members) {
+        return false;
+    }
+
+    // the instructions in the range were already validated by the first pass
+    for (size_t i = begin; i < end;) {
+        const uint32_t opcode = module->words[i] & 0xffff;
+        const uint32_t word_count = module->words[i] >> 16;
+
+        const uint32_t struct_id = (word_count >= 5) ? module->words[i + 1] : 0;
+        const uint32_t member = (word_count >= 5) ? module->words[i + 2] : 0;
+
+        if (opcode == __OP_MEMBER_DECORATE && __GetOpcode(module, struct_id) == __OP_TYPE_STRUCT &&
+            member < (module->words[module->ids[struct_id].offset] >> 16) - 2)
+        {
+            __SpirvMember *target = &module->members[module->ids[struct_id].first_member + member];
+
+            switch (module->words[i + 3]) {
+                case __DECORATION_OFFSET:
+                    target->offset = module->words[i + 4];
+                    break;
+                case __DECORATION_MATRIX_STRIDE:
+                    target->matrix_stride = module->words[i + 4];
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        i += word_count;
+    }
+
+    return true;
+}
+
+static uint32_t __GetTypeSize(const __SpirvModule *const module, const uint32_t type_id, const uint32_t depth) {
+    if (depth > __MAX_TYPE_DEPTH) {
+        return 0;
+    }
+
+    switch (__GetOpcode(module, type_id)) {
+        case __OP_TYPE_BOOL:
+            return 4;
+
+        case __OP_TYPE_INT:
+        case __OP_TYPE_FLOAT:
+            return __GetOperand(module, type_id, 1) / 8;
+
+        case __OP_TYPE_VECTOR:
+        case __OP_TYPE_MATRIX:
+            return __GetOperand(module, type_id, 2) * __GetTypeSize(module, __GetOperand(module, type_id, 1), depth + 1);
+
+        case __OP_TYPE_ARRAY: {
+            const uint32_t length_id = __GetOperand(module, type_id, 2);
+            const uint32_t length = (__GetOpcode(module, length_id) == __OP_CONSTANT) ? __GetOperand(module, length_id, 2) : 0;
+            const uint32_t stride = module->ids[type_id].array_stride;
+
+            return length * (stride ? stride : __GetTypeSize(module, __GetOperand(module, type_id, 1), depth + 1));
+        }
+
+        case __OP_TYPE_STRUCT: {
+            uint32_t size = 0;
+
+            const uint32_t member_count = (module->words[module->ids[type_id].offset] >> 16) - 2;
+            for (uint32_t m = 0; m < member_count; m++) {
+                const uint32_t member_type = __GetOperand(module, type_id, m + 1);
+                const __SpirvMember *member = &module->members[module->ids[type_id].first_member + m];
+
+                // matrices in blocks are laid out with an explicit stride between their columns
+                uint32_t member_size;
+                if (__GetOpcode(module, member_type) == __OP_TYPE_MATRIX && member->matrix_stride) {
+                    member_size = __GetOperand(module, member_type, 2) * member->matrix_stride;
+                } else {
+                    member_size = __GetTypeSize(module, member_type, depth + 1);
+                }
+
+                if (member->offset + member_size > size) {
+                    size = member->offset + member_size;
+                }
+            }
+
+            return size;
+        }
+
+        default:
+            // runtime arrays, opaque types and unknown types have no fixed size
+            return 0;
+    }
+}
+
+static bool __ReflectBinding(const __SpirvModule *const module, const uint32_t variable_id, const uint32_t storage_class,
+    TL_SpirvBinding_t *const out)
+{
+    out->set = module->ids[variable_id].set;
+    out->binding = module->ids[variable_id].binding;
+    out->count = 1;
+
+    uint32_t type = __GetOperand(module, __GetOperand(module, variable_id, 0), 2);
+
+    // arrays of resources are bound as a single binding with multiple descriptors
+    for (uint32_t depth = 0; depth < __MAX_TYPE_DEPTH; depth++) {
+        const uint32_t opcode = __GetOpcode(module, type);
+
+        if (opcode == __OP_TYPE_ARRAY) {
+            const uint32_t length_id = __GetOperand(module, type, 2);
+            out->count *= (__GetOpcode(module, length_id) == __OP_CONSTANT || __GetOpcode(module, length_id) == __OP_SPEC_CONSTANT)
+                ? __GetOperand(module, length_id, 2) : 1;
+        } else if (opcode == __OP_TYPE_RUNTIME_ARRAY) {
+            out->count = 0;
+        } else {
+            break;
+        }
+
+        type = __GetOperand(module, type, 1);
+    }
+
+    switch (__GetOpcode(module, type)) {
+        case __OP_TYPE_SAMPLER:
+            out->type = TL_SPIRV_DESCRIPTOR_TYPE_SAMPLER;
+            return true;
+
+        case __OP_TYPE_SAMPLED_IMAGE:
+            out->type = TL_SPIRV_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            return true;
+
+        case __OP_TYPE_IMAGE: {
+            const uint32_t dim = __GetOperand(module, type, 2);
+            const uint32_t sampled = __GetOperand(module, type, 6);
+
+            if (dim == __DIM_SUBPASS_DATA) {
+                out->type = TL_SPIRV_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+            } else if (dim == __DIM_BUFFER) {
+                out->type = (sampled == 1) ? TL_SPIRV_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : TL_SPIRV_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+            } else {
+                out->type = (sampled == 1) ? TL_SPIRV_DESCRIPTOR_TYPE_SAMPLED_IMAGE : TL_SPIRV_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            }
+
+            return true;
+        }
+
+        case __OP_TYPE_STRUCT:
+            // pre-1.3 SPIR-V marks storage buffers as Uniform blocks decorated with BufferBlock
+            if (storage_class == __STORAGE_CLASS_STORAGE_BUFFER || (module->ids[type].flags & __ID_BUFFER_BLOCK)) {
+                out->type = TL_SPIRV_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            } else {
+                out->type = TL_SPIRV_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            }
+
+            return true;
+
+        case __OP_TYPE_ACCELERATION_STRUCTURE:
+            out->type = TL_SPIRV_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static bool __ReflectInput(const __SpirvModule *const module, const uint32_t variable_id, TL_SpirvInput_t *const out) {
+    out->location = module->ids[variable_id].location;
+    out->location_count = 1;
+    out->component_count = 1;
+
+    uint32_t type = __GetOperand(module, __GetOperand(module, variable_id, 0), 2);
+
+    // arrays of inputs occupy one set of locations per element
+    while (__GetOpcode(module, type) == __OP_TYPE_ARRAY) {
+        const uint32_t length_id = __GetOperand(module, type, 2);
+        if (__GetOpcode(module, length_id) != __OP_CONSTANT) {
+            return false;
+        }
+
+        out->location_count *= __GetOperand(module, length_id, 2);
+        type = __GetOperand(module, type, 1);
+    }
+
+    // matrices occupy one location per column
+    if (__GetOpcode(module, type) == __OP_TYPE_MATRIX) {
+        out->location_count *= __GetOperand(module, type, 2);
+        type = __GetOperand(module, type, 1);
+    }
+
+    if (__GetOpcode(module, type) == __OP_TYPE_VECTOR) {
+        out->component_count = __GetOperand(module, type, 2);
+        type = __GetOperand(module, type, 1);
+    }
+
+    switch (__GetOpcode(module, type)) {
+        case __OP_TYPE_FLOAT:
+            out->scalar_type = TL_SPIRV_SCALAR_TYPE_FLOAT;
+            break;
+        case __OP_TYPE_INT:
+            out->scalar_type = __GetOperand(module, type, 2) ? TL_SPIRV_SCALAR_TYPE_SINT : TL_SPIRV_SCALAR_TYPE_UINT;
+            break;
+        default:
+            return false;
+    }
+
+    out->component_width = __GetOperand(module, type, 1);
+
+    return out->location_count && out->component_count >= 1 && out->component_count <= 4;
+}
+
+static TL_SpirvStageFlags_t __StageFromExecutionModel(const uint32_t execution_model) {
+    switch (execution_model) {
+        case 0:
+            return TL_SPIRV_STAGE_VERTEX_BIT;
+        case 1:
+            return TL_SPIRV_STAGE_TESSELLATION_CONTROL_BIT;
+        case 2:
+            return TL_SPIRV_STAGE_TESSELLATION_EVAL_BIT;
+        case 3:
+            return TL_SPIRV_STAGE_GEOMETRY_BIT;
+        case 4:
+            return TL_SPIRV_STAGE_FRAGMENT_BIT;
+        case 5:
+            return TL_SPIRV_STAGE_COMPUTE_BIT;
+        default:
+            return TL_SPIRV_STAGE_NONE;
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__utils__spirv_reflect_h__
+#define __TL__internal__utils__spirv_reflect_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwd.h"
+#include "thallium/platform.h"
+
+/**
+ * @brief Shader stages that a SPIR-V module can be written for.
+ *
+ * The values of these flags equal those of the corresponding `VkShaderStageFlagBits`.
+ */
+typedef enum TL_SpirvStageFlags_t {
+    TL_SPIRV_STAGE_NONE =                   0x00,
+    TL_SPIRV_STAGE_VERTEX_BIT =             0x01,
+    TL_SPIRV_STAGE_TESSELLATION_CONTROL_BIT = 0x02,
+    TL_SPIRV_STAGE_TESSELLATION_EVAL_BIT =  0x04,
+    TL_SPIRV_STAGE_GEOMETRY_BIT =           0x08,
+    TL_SPIRV_STAGE_FRAGMENT_BIT =           0x10,
+    TL_SPIRV_STAGE_COMPUTE_BIT =            0x20,
+} TL_SpirvStageFlags_t;
+
+/**
+ * @brief Types of resources that shaders can bind through descriptors.
+ *
+ * The values of this enumeration equal those of the corresponding `VkDescriptorType`.
+ */
+typedef enum TL_SpirvDescriptorType_t {
+    TL_SPIRV_DESCRIPTOR_TYPE_SAMPLER =                  0,
+    TL_SPIRV_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER =   1,
+    TL_SPIRV_DESCRIPTOR_TYPE_SAMPLED_IMAGE =            2,
+    TL_SPIRV_DESCRIPTOR_TYPE_STORAGE_IMAGE =            3,
+    TL_SPIRV_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER =     4,
+    TL_SPIRV_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER =     5,
+    TL_SPIRV_DESCRIPTOR_TYPE_UNIFORM_BUFFER =           6,
+    TL_SPIRV_DESCRIPTOR_TYPE_STORAGE_BUFFER =           7,
+    TL_SPIRV_DESCRIPTOR_TYPE_INPUT_ATTACHMENT =         10,
+    TL_SPIRV_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE =   1000150000,
+} TL_SpirvDescriptorType_t;
+
+/// @brief Scalar types of shader interface variables.
+typedef enum TL_SpirvScalarType_t {
+    TL_SPIRV_SCALAR_TYPE_FLOAT,
+    TL_SPIRV_SCALAR_TYPE_SINT,
+    TL_SPIRV_SCALAR_TYPE_UINT,
+} TL_SpirvScalarType_t;
+
+/// @brief A resource binding declared by a shader.
+typedef struct TL_SpirvBinding_t {
+    /// @brief Descriptor set index of the binding.
+    uint32_t set;
+    /// @brief Binding index of the binding within its set.
+    uint32_t binding;
+    /// @brief Type of the bound resource.
+    TL_SpirvDescriptorType_t type;
+    /// @brief Amount of array elements bound - 0 if the binding is a runtime-sized array.
+    uint32_t count;
+} TL_SpirvBinding_t;
+
+/// @brief A user-defined input variable of a shader (e.g. a vertex attribute).
+typedef struct TL_SpirvInput_t {
+    /// @brief Location of the first component of the input.
+    uint32_t location;
+    /// @brief Amount of consecutive locations occupied (e.g. 4 for a 4x4 matrix).
+    uint32_t location_count;
+    /// @brief Amount of components in each location (1 to 4).
+    uint32_t component_count;
+    /// @brief Width of each component in bits.
+    uint32_t component_width;
+    /// @brief Type of each component.
+    TL_SpirvScalarType_t scalar_type;
+} TL_SpirvInput_t;
+
+/**
+ * @brief Interface of a SPIR-V module, as extracted by @ref TL_SpirvReflect().
+ */
+typedef struct TL_SpirvReflection_t {
+    /// @brief Stage of the module's (first) entry point.
+    TL_SpirvStageFlags_t stage;
+
+    /// @brief Amount of resource bindings in `bindings`.
+    uint32_t binding_count;
+    /// @brief Array of resource bindings declared by the module.
+    TL_SpirvBinding_t *bindings;
+
+    /// @brief Size in bytes of the module's push constant block (0 if it has none).
+    uint32_t push_constant_size;
+
+    /// @brief Amount of inputs in `inputs`.
+    uint32_t input_count;
+    /// @brief Array of user-defined input variables of the module, in order of declaration (built-in inputs are excluded).
+    TL_SpirvInput_t *inputs;
+} TL_SpirvReflection_t;
+
+/**
+ * @brief Extract the interface of a SPIR-V module.
+ *
+ * This function parses the given SPIR-V code and returns the resource bindings, push constant block size and input variables that it declares.
+ * Only the type and decoration instructions of the module are read; functions are skipped. The returned reflection must be freed with
+ * @ref TL_SpirvReflectionFree().
+ *
+ * @param code SPIR-V code
+ * @param code_size Size of `code` in bytes
+ * @param out Pointer to the reflection to populate
+ * @param debugger NULL or a debugger for function debugging
+ * @return False if the code is malformed or could not be parsed (in which case `out` is left empty)
+ */
+bool TL_SpirvReflect(
+    const uint32_t *const code,
+    const size_t code_size,
+    TL_SpirvReflection_t *const out,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Free the arrays of a reflection created with @ref TL_SpirvReflect().
+ *
+ * @param reflection Reflection to free - left empty afterwards
+ */
+void TL_SpirvReflectionFree(
+    TL_SpirvReflection_t *const reflection
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
@@ -0,0 +1,235 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "thread.h"
+
+#if !defined(_WIN32)
+#   include <errno.h>
+#   include <time.h>
+#   include <unistd.h>
+#endif
+
+#define __NS_PER_SECOND 1000000000ull
+
+#if defined(_WIN32)
+    static DWORD WINAPI __ThreadMain(LPVOID arg);
+#else
+    static void *__ThreadMain(void *arg);
+#endif
+
+
+bool TL_MutexInit(TL_Mutex_t *const mutex) {
+#   if defined(_WIN32)
+        InitializeSRWLock(mutex);
+        return true;
+#   else
+        return !pthread_mutex_init(mutex, NULL);
+#   endif
+}
+
+void TL_MutexDestroy(TL_Mutex_t *const mutex) {
+#   if defined(_WIN32)
+        (void) mutex; // slim reader/writer locks own no resources
+#   else
+        pthread_mutex_destroy(mutex);
+#   endif
+}
+
+void TL_MutexLock(TL_Mutex_t *const mutex) {
+#   if defined(_WIN32)
+        AcquireSRWLockExclusive(mutex);
+#   else
+        pthread_mutex_lock(mutex);
+#   endif
+}
+
+void TL_MutexUnlock(TL_Mutex_t *const mutex) {
+#   if defined(_WIN32)
+        ReleaseSRWLockExclusive(mutex);
+#   else
+        pthread_mutex_unlock(mutex);
+#   endif
+}
+
+bool TL_CondInit(TL_Cond_t *const cond) {
+#   if defined(_WIN32)
+        InitializeConditionVariable(cond);
+        return true;
+#   else
+        return !pthread_cond_init(cond, NULL);
+#   endif
+}
+
+void TL_CondDestroy(TL_Cond_t *const cond) {
+#   if defined(_WIN32)
+        (void) cond; // condition variables own no resources
+#   else
+        pthread_cond_destroy(cond);
+#   endif
+}
+
+void TL_CondWait(TL_Cond_t *const cond, TL_Mutex_t *const mutex) {
+#   if defined(_WIN32)
+        SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+#   else
+        pthread_cond_wait(cond, mutex);
+#   endif
+}
+
+void TL_CondSignal(TL_Cond_t *const cond) {
+#   if defined(_WIN32)
+        WakeConditionVariable(cond);
+#   else
+        pthread_cond_signal(cond);
+#   endif
+}
+
+void TL_CondBroadcast(TL_Cond_t *const cond) {
+#   if defined(_WIN32)
+        WakeAllConditionVariable(cond);
+#   else
+        pthread_cond_broadcast(cond);
+#   endif
+}
+
+uint64_t TL_AtomicLoad64(const TL_Atomic64_t *const atomic) {
+#   if defined(_WIN32)
+        // exchanging zero for zero leaves the value as it was, so only the returned original is of interest
+        return (uint64_t) InterlockedCompareExchange64((TL_Atomic64_t *) atomic, 0, 0);
+#   else
+        return __atomic_load_n(atomic, __ATOMIC_SEQ_CST);
+#   endif
+}
+
+void TL_AtomicStore64(TL_Atomic64_t *const atomic, const uint64_t value) {
+#   if defined(_WIN32)
+        InterlockedExchange64(atomic, (LONG64) value);
+#   else
+        __atomic_store_n(atomic, value, __ATOMIC_SEQ_CST);
+#   endif
+}
+
+uint64_t TL_AtomicAdd64(TL_Atomic64_t *const atomic, const uint64_t value) {
+#   if defined(_WIN32)
+        return (uint64_t) InterlockedExchangeAdd64(atomic, (LONG64) value) + value;
+#   else
+        return __atomic_add_fetch(atomic, value, __ATOMIC_SEQ_CST);
+#   endif
+}
+
+uint64_t TL_AtomicSub64(TL_Atomic64_t *const atomic, const uint64_t value) {
+    return TL_AtomicAdd64(atomic, (uint64_t) 0 - value);
+}
+
+bool TL_ThreadCreate(TL_Thread_t *const thread, const TL_ThreadFn_t fn, void *const arg) {
+    if (!thread || !fn) {
+        return false;
+    }
+
+    thread->fn = fn;
+    thread->arg = arg;
+
+#   if defined(_WIN32)
+        thread->handle = CreateThread(NULL, 0, __ThreadMain, thread, 0, NULL);
+        return thread->handle != NULL;
+#   else
+        return !pthread_create(&thread->handle, NULL, __ThreadMain, thread);
+#   endif
+}
+
+void TL_ThreadJoin(TL_Thread_t *const thread) {
+#   if defined(_WIN32)
+        WaitForSingleObject(thread->handle, INFINITE);
+        CloseHandle(thread->handle);
+#   else
+        pthread_join(thread->handle, NULL);
+#   endif
+}
+
+uint32_t TL_GetProcessorCount(void) {
+#   if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        return (info.dwNumberOfProcessors > 0) ? (uint32_t) info.dwNumberOfProcessors : 1;
+#   else
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        return (cpus > 0) ? (uint32_t) cpus : 1;
+#   endif
+}
+
+uint64_t TL_GetMonotonicTime(void) {
+#   if defined(_WIN32)
+        LARGE_INTEGER frequency, counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+
+        // whole seconds and the remainder are converted separately, as multiplying the full count by a billion could overflow
+        uint64_t freq = (uint64_t) frequency.QuadPart;
+        uint64_t count = (uint64_t) counter.QuadPart;
+
+        return (count / freq) * __NS_PER_SECOND + (count % freq) * __NS_PER_SECOND / freq;
+#   else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+
+        return (uint64_t) ts.tv_sec * __NS_PER_SECOND + (uint64_t) ts.tv_nsec;
+#   endif
+}
+
+void TL_SleepUntil(const uint64_t deadline) {
+#   if defined(_WIN32)
+        // Sleep() only has millisecond granularity (or coarser), so the last millisecond is spent yielding instead to avoid oversleeping
+        for (uint64_t now = TL_GetMonotonicTime(); now < deadline; now = TL_GetMonotonicTime()) {
+            uint64_t remaining = deadline - now;
+
+            if (remaining > 2000000ull) {
+                Sleep((DWORD) (remaining / 1000000ull) - 1);
+            } else {
+                SwitchToThread();
+            }
+        }
+#   elif defined(_APPLE)
+        // there is no clock_nanosleep, so relative sleeps are repeated until the deadline has passed
+        for (uint64_t now = TL_GetMonotonicTime(); now < deadline; now = TL_GetMonotonicTime()) {
+            uint64_t remaining = deadline - now;
+
+            struct timespec ts;
+            ts.tv_sec = (time_t) (remaining / __NS_PER_SECOND);
+            ts.tv_nsec = (long) (remaining % __NS_PER_SECOND);
+
+            nanosleep(&ts, NULL);
+        }
+#   else
+        struct timespec ts;
+        ts.tv_sec = (time_t) (deadline / __NS_PER_SECOND);
+        ts.tv_nsec = (long) (deadline % __NS_PER_SECOND);
+
+        // only an interrupted sleep is resumed - any other error would recur on every attempt
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        }
+#   endif
+}
+
+
+// the platform entry point only forwards to the portable one, so every thread has the same signature on every platform
+#if defined(_WIN32)
+    static DWORD WINAPI __ThreadMain(LPVOID arg) {
+        TL_Thread_t *thread = (TL_Thread_t *) arg;
+        thread->fn(thread->arg);
+
+        return 0;
+    }
+#else
+    static void *__ThreadMain(void *arg) {
+        TL_Thread_t *thread = (TL_Thread_t *) arg;
+        thread->fn(thread->arg);
+
+        return NULL;
+    }
+#endif
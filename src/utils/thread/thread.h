@@ -0,0 +1,243 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__utils__thread_h__
+#define __TL__internal__utils__thread_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium/platform.h"
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+/**
+ * @brief The function pointer type for the entry point of threads started with @ref TL_ThreadCreate().
+ *
+ * @param arg The pointer that was given alongside the function when the thread was started.
+ */
+typedef void (*TL_ThreadFn_t)(
+    void *arg
+);
+
+#if defined(_WIN32)
+    typedef SRWLOCK TL_Mutex_t;
+    typedef CONDITION_VARIABLE TL_Cond_t;
+    typedef volatile LONG64 TL_Atomic64_t;
+#else
+    typedef pthread_mutex_t TL_Mutex_t;
+    typedef pthread_cond_t TL_Cond_t;
+    typedef volatile uint64_t TL_Atomic64_t;
+#endif
+
+/**
+ * @brief A thread started with @ref TL_ThreadCreate(), which must not be moved in memory until it has been joined.
+ */
+typedef struct TL_Thread_t {
+    /// @brief Platform handle of the thread.
+#   if defined(_WIN32)
+        HANDLE handle;
+#   else
+        pthread_t handle;
+#   endif
+
+    /// @brief Entry point of the thread.
+    TL_ThreadFn_t fn;
+    /// @brief Pointer passed to `fn`.
+    void *arg;
+} TL_Thread_t;
+
+/**
+ * @brief Initialise the given mutex.
+ *
+ * @param mutex Mutex to initialise
+ * @return False if the mutex could not be initialised
+ */
+bool TL_MutexInit(
+    TL_Mutex_t *const mutex
+);
+
+/**
+ * @brief Destroy the given mutex, which must not be locked.
+ *
+ * @param mutex Mutex to destroy
+ */
+void TL_MutexDestroy(
+    TL_Mutex_t *const mutex
+);
+
+/**
+ * @brief Lock the given mutex, blocking until it is available.
+ *
+ * @param mutex Mutex to lock
+ */
+void TL_MutexLock(
+    TL_Mutex_t *const mutex
+);
+
+/**
+ * @brief Unlock the given mutex, which must be locked by the calling thread.
+ *
+ * @param mutex Mutex to unlock
+ */
+void TL_MutexUnlock(
+    TL_Mutex_t *const mutex
+);
+
+/**
+ * @brief Initialise the given condition variable.
+ *
+ * @param cond Condition variable to initialise
+ * @return False if the condition variable could not be initialised
+ */
+bool TL_CondInit(
+    TL_Cond_t *const cond
+);
+
+/**
+ * @brief Destroy the given condition variable, which must not be waited on.
+ *
+ * @param cond Condition variable to destroy
+ */
+void TL_CondDestroy(
+    TL_Cond_t *const cond
+);
+
+/**
+ * @brief Atomically unlock `mutex` and wait on `cond`, locking `mutex` again before returning. Waits may end spuriously.
+ *
+ * @param cond Condition variable to wait on
+ * @param mutex Mutex locked by the calling thread
+ */
+void TL_CondWait(
+    TL_Cond_t *const cond,
+    TL_Mutex_t *const mutex
+);
+
+/**
+ * @brief Wake one thread waiting on the given condition variable.
+ *
+ * @param cond Condition variable to signal
+ */
+void TL_CondSignal(
+    TL_Cond_t *const cond
+);
+
+/**
+ * @brief Wake every thread waiting on the given condition variable.
+ *
+ * @param cond Condition variable to broadcast
+ */
+void TL_CondBroadcast(
+    TL_Cond_t *const cond
+);
+
+/**
+ * @brief Atomically read the given 64-bit value.
+ *
+ * @param atomic Value to read
+ * @return The value
+ */
+uint64_t TL_AtomicLoad64(
+    const TL_Atomic64_t *const atomic
+);
+
+/**
+ * @brief Atomically replace the given 64-bit value.
+ *
+ * @param atomic Value to replace
+ * @param value New value
+ */
+void TL_AtomicStore64(
+    TL_Atomic64_t *const atomic,
+    const uint64_t value
+);
+
+/**
+ * @brief Atomically add to the given 64-bit value, wrapping around on overflow.
+ *
+ * @param atomic Value to add to
+ * @param value Amount to add
+ * @return The value after the addition
+ */
+uint64_t TL_AtomicAdd64(
+    TL_Atomic64_t *const atomic,
+    const uint64_t value
+);
+
+/**
+ * @brief Atomically subtract from the given 64-bit value, wrapping around on overflow.
+ *
+ * @param atomic Value to subtract from
+ * @param value Amount to subtract
+ * @return The value after the subtraction
+ */
+uint64_t TL_AtomicSub64(
+    TL_Atomic64_t *const atomic,
+    const uint64_t value
+);
+
+/**
+ * @brief Start a new thread that calls `fn` with `arg`.
+ *
+ * @param thread Thread to populate, which must stay at the same address until it has been joined
+ * @param fn Entry point of the thread
+ * @param arg Pointer passed to `fn`
+ * @return False if the thread could not be started
+ */
+bool TL_ThreadCreate(
+    TL_Thread_t *const thread,
+    const TL_ThreadFn_t fn,
+    void *const arg
+);
+
+/**
+ * @brief Block until the given thread has exited, and release it.
+ *
+ * @param thread Thread to join
+ */
+void TL_ThreadJoin(
+    TL_Thread_t *const thread
+);
+
+/**
+ * @brief Retrieve the amount of processors that are currently online.
+ *
+ * @return Amount of online processors (at least 1)
+ */
+uint32_t TL_GetProcessorCount(void);
+
+/**
+ * @brief Retrieve the current time of a monotonic clock, which is not affected by changes to the system time.
+ *
+ * @return Time in nanoseconds since an unspecified point in the past
+ */
+uint64_t TL_GetMonotonicTime(void);
+
+/**
+ * @brief Block the calling thread until the monotonic clock reaches the given time, returning immediately if it already has.
+ *
+ * Sleeps that are interrupted (e.g. by a signal) are resumed until the deadline.
+ *
+ * @param deadline Time in nanoseconds to sleep until, as returned by @ref TL_GetMonotonicTime()
+ */
+void TL_SleepUntil(
+    const uint64_t deadline
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
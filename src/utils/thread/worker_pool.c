@@ -0,0 +1,213 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "worker_pool.h"
+
+#include "utils/io/log.h"
+#include "utils/thread/thread.h"
+
+#include <stdlib.h>
+
+// Upper bound on the amount of threads chosen automatically for a pool
+#define __MAX_AUTO_THREAD_COUNT 8
+
+typedef struct __WorkerJob_t {
+    TL_WorkerJobfn_t fn;
+    void *data;
+
+    struct __WorkerJob_t *next;
+} __WorkerJob_t;
+
+typedef struct TL_WorkerPool_t {
+    /// @brief Guards every other member of the pool
+    TL_Mutex_t lock;
+    /// @brief Signalled when a job is queued or the pool is shutting down
+    TL_Cond_t wake;
+
+    /// @brief Head and tail of the singly-linked job queue
+    __WorkerJob_t *head;
+    __WorkerJob_t *tail;
+
+    /// @brief Array of `thread_count` thread handles, only valid while `spawned` is true
+    TL_Thread_t *threads;
+    uint32_t thread_count;
+    bool spawned;
+
+    /// @brief Set on destruction - workers exit once the queue is empty
+    bool shutdown;
+
+    const TL_Debugger_t *debugger;
+} TL_WorkerPool_t;
+
+
+static void __WorkerMain(void *arg);
+
+static bool __SpawnWorkers(TL_WorkerPool_t *const pool);
+
+
+TL_WorkerPool_t *TL_WorkerPoolCreate(const uint32_t thread_count, const TL_Debugger_t *const debugger) {
+    TL_WorkerPool_t *pool = malloc(sizeof(TL_WorkerPool_t));
+    if (!pool) {
+        TL_Fatal(debugger, "MALLOC fault in call to TL_WorkerPoolCreate");
+        return NULL;
+    }
+
+    uint32_t count = thread_count;
+    if (!count) {
+        // leave one processor for the thread that is submitting jobs
+        uint32_t cpus = TL_GetProcessorCount();
+        count = (cpus > 1) ? cpus - 1 : 1;
+        count = (count > __MAX_AUTO_THREAD_COUNT) ? __MAX_AUTO_THREAD_COUNT : count;
+    }
+
+    pool->head = NULL;
+    pool->tail = NULL;
+    pool->threads = NULL;
+    pool->thread_count = count;
+    pool->spawned = false;
+    pool->shutdown = false;
+    pool->debugger = debugger;
+
+    if (!TL_MutexInit(&pool->lock)) {
+        free(pool);
+        return NULL;
+    }
+    if (!TL_CondInit(&pool->wake)) {
+        TL_MutexDestroy(&pool->lock);
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void TL_WorkerPoolDestroy(TL_WorkerPool_t *const pool) {
+    if (!pool) {
+        return;
+    }
+
+    TL_MutexLock(&pool->lock);
+    pool->shutdown = true;
+    TL_CondBroadcast(&pool->wake);
+    TL_MutexUnlock(&pool->lock);
+
+    if (pool->spawned) {
+        for (uint32_t i = 0; i < pool->thread_count; i++) {
+            TL_ThreadJoin(&pool->threads[i]);
+        }
+    }
+
+    TL_CondDestroy(&pool->wake);
+    TL_MutexDestroy(&pool->lock);
+
+    free(pool->threads);
+    free(pool);
+}
+
+bool TL_WorkerPoolSubmit(TL_WorkerPool_t *const pool, const TL_WorkerJobfn_t fn, void *const data) {
+    if (!pool || !fn) {
+        return false;
+    }
+
+    __WorkerJob_t *job = malloc(sizeof(__WorkerJob_t));
+    if (!job) {
+        TL_Fatal(pool->debugger, "MALLOC fault in call to TL_WorkerPoolSubmit");
+        return false;
+    }
+
+    job->fn = fn;
+    job->data = data;
+    job->next = NULL;
+
+    TL_MutexLock(&pool->lock);
+
+    if (pool->shutdown || (!pool->spawned && !__SpawnWorkers(pool))) {
+        TL_MutexUnlock(&pool->lock);
+        free(job);
+        return false;
+    }
+
+    if (pool->tail) {
+        pool->tail->next = job;
+    } else {
+        pool->head = job;
+    }
+    pool->tail = job;
+
+    TL_CondSignal(&pool->wake);
+    TL_MutexUnlock(&pool->lock);
+
+    return true;
+}
+
+
+static void __WorkerMain(void *arg) {
+    TL_WorkerPool_t *pool = (TL_WorkerPool_t *) arg;
+
+    TL_MutexLock(&pool->lock);
+
+    for (;;) {
+        while (!pool->head && !pool->shutdown) {
+            TL_CondWait(&pool->wake, &pool->lock);
+        }
+
+        // the queue is drained before exiting so that no submitted job is lost on shutdown
+        if (!pool->head) {
+            break;
+        }
+
+        __WorkerJob_t *job = pool->head;
+        pool->head = job->next;
+        if (!pool->head) {
+            pool->tail = NULL;
+        }
+
+        // run the job without holding the lock so other workers can make progress
+        TL_MutexUnlock(&pool->lock);
+
+        job->fn(job->data);
+        free(job);
+
+        TL_MutexLock(&pool->lock);
+    }
+
+    TL_MutexUnlock(&pool->lock);
+}
+
+// must be called with the pool lock held
+static bool __SpawnWorkers(TL_WorkerPool_t *const pool) {
+    pool->threads = malloc(sizeof(TL_Thread_t) * pool->thread_count);
+    if (!pool->threads) {
+        TL_Fatal(pool->debugger, "MALLOC fault in call to __SpawnWorkers");
+        return false;
+    }
+
+    uint32_t started = 0;
+    for (; started < pool->thread_count; started++) {
+        if (!TL_ThreadCreate(&pool->threads[started], __WorkerMain, pool)) {
+            break;
+        }
+    }
+
+    if (!started) {
+        TL_Error(pool->debugger, "Failed to start any worker threads for worker pool %p", pool);
+        free(pool->threads);
+        pool->threads = NULL;
+        return false;
+    }
+
+    if (started < pool->thread_count) {
+        TL_Warn(pool->debugger, "Worker pool %p only started %u out of %u worker threads", pool, started, pool->thread_count);
+        pool->thread_count = started;
+    }
+
+    pool->spawned = true;
+
+    TL_Log(pool->debugger, "Worker pool %p spawned %u worker threads", pool, pool->thread_count);
+
+    return true;
+}
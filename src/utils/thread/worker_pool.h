@@ -0,0 +1,78 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#pragma once
+#ifndef __TL__internal__utils__worker_pool_h__
+#define __TL__internal__utils__worker_pool_h__
+#ifdef __cplusplus
+    extern "C" {
+#endif // __cplusplus
+
+#include "thallium_decl/fwd.h"
+#include "thallium/platform.h"
+
+/**
+ * @brief The function pointer type for jobs submitted to a worker pool.
+ *
+ * @param data The pointer that was given alongside the job when it was submitted.
+ */
+typedef void (*TL_WorkerJobfn_t)(
+    void *data
+);
+
+/**
+ * @brief An opaque pool of worker threads that execute submitted jobs in FIFO order.
+ *
+ * Worker threads are spawned lazily, i.e. on the first job submission, so a pool that is never used does not cost any threads.
+ */
+typedef struct TL_WorkerPool_t TL_WorkerPool_t;
+
+/**
+ * @brief Create a heap-allocated worker pool.
+ *
+ * This function creates a new worker pool which will spawn up to `thread_count` threads when jobs are first submitted to it.
+ *
+ * @param thread_count Amount of worker threads to run. If 0, a count is chosen based on the amount of online processors.
+ * @param debugger NULL or a debugger for function debugging
+ * @return The new worker pool, or NULL if there were errors
+ */
+TL_WorkerPool_t *TL_WorkerPoolCreate(
+    const uint32_t thread_count,
+    const TL_Debugger_t *const debugger
+);
+
+/**
+ * @brief Destroy the given worker pool.
+ *
+ * This function runs any jobs still remaining in the queue, then joins all worker threads and frees the pool.
+ *
+ * @param pool Worker pool to destroy
+ */
+void TL_WorkerPoolDestroy(
+    TL_WorkerPool_t *const pool
+);
+
+/**
+ * @brief Submit a job to the given worker pool.
+ *
+ * This function queues `fn` to be called with `data` on one of the pool's worker threads, and returns immediately.
+ *
+ * @param pool Worker pool to submit to
+ * @param fn Job function
+ * @param data Pointer passed to `fn`
+ * @return False if the job could not be queued
+ */
+bool TL_WorkerPoolSubmit(
+    TL_WorkerPool_t *const pool,
+    const TL_WorkerJobfn_t fn,
+    void *const data
+);
+
+#ifdef __cplusplus
+    }
+#endif // __cplusplus
+#endif
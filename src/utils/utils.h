@@ -12,9 +12,17 @@
     extern "C" {
 #endif // __cplusplus
 
+#include "hash/hash.h"
+#include "hash/hashmap.h"
+
+#include "io/file_map.h"
 #include "io/log.h"
 #include "io/proc.h"
 
+#include "spirv/spirv_reflect.h"
+
+#include "thread/worker_pool.h"
+
 #if defined(_THALLIUM_VULKAN_INCL)
 #   include "vulkan/vk_pnext_append.h"
 #endif
@@ -0,0 +1,144 @@
+/*
+ *   Copyright (c) 2023 Jack Bennett.
+ *   All Rights Reserved.
+ *
+ *   See the LICENCE file for more information.
+ */
+
+#include "framework/Test.hpp"
+#include "framework/Utils.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace TLTests::Framework;
+
+// Benchmark of creating a family of similar graphics pipelines with and without pipeline derivatives.
+//
+// Usage: pipelinederivatives <vertex shader .spv> <fragment shader .spv>
+//
+// Each run creates one parent pipeline and VARIANT_COUNT - 1 variants of it, one by one. Runs with and without derivatives are alternated, and every
+// run uses a different depth bias so that no run can hit pipelines deduplicated or cached by an earlier one.
+
+static constexpr uint32_t VARIANT_COUNT = 64;
+static constexpr uint32_t RUN_COUNT = 4;
+
+Test &test = Test::GetInstance();
+
+static TL_PipelineDescriptor_t MakeVariant(const char *vertex_path, const char *fragment_path, const TL_Viewport_t &viewport, uint32_t run,
+    uint32_t variant)
+{
+    static const TL_CullModeFlags_t cull_modes[] = {
+        TL_CULL_MODE_NONE_BIT, TL_CULL_MODE_FRONT_BIT, TL_CULL_MODE_BACK_BIT, TL_CULL_MODE_FRONT_AND_BACK_BIT
+    };
+    static const TL_CompareOp_t compare_ops[] = { TL_COMPARE_OP_LESS, TL_COMPARE_OP_LESS_OR_EQUAL, TL_COMPARE_OP_GREATER, TL_COMPARE_OP_ALWAYS };
+
+    TL_PipelineDescriptor_t descriptor = {};
+    descriptor.type = TL_PIPELINE_TYPE_GRAPHICS;
+    descriptor.viewport_count = 1;
+    descriptor.viewports = const_cast<TL_Viewport_t *>(&viewport);
+
+    descriptor.rasterizer.cull_modes = cull_modes[variant % 4];
+    descriptor.rasterizer.clockwise_front_face = (variant / 4) % 2;
+    descriptor.rasterizer.depth_bias = true;
+    descriptor.rasterizer.depth_bias_constant_factor = static_cast<float>(run);
+    descriptor.rasterizer.depth_bias_slope_factor = static_cast<float>(variant / 8);
+    descriptor.rasterizer.line_width = 1.0f;
+
+    descriptor.depth_test.test_enabled = true;
+    descriptor.depth_test.write_enabled = true;
+    descriptor.depth_test.compare_op = compare_ops[(variant / 16) % 4];
+
+    descriptor.vertex_shader.path = vertex_path;
+    descriptor.fragment_shader.path = fragment_path;
+
+    return descriptor;
+}
+
+// returns the time taken to create the whole family in milliseconds, or a negative value on failure
+static double CreateFamily(TL_Renderer_t *renderer, const char *vertex_path, const char *fragment_path, uint32_t run, bool derivatives) {
+    TL_Viewport_t viewport = {};
+    viewport.width = 640.0f;
+    viewport.height = 480.0f;
+    viewport.max_depth = 1.0f;
+
+    std::vector<TL_Pipeline_t *> pipelines;
+    bool failed = false;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < VARIANT_COUNT; i++) {
+        TL_PipelineDescriptor_t descriptor = MakeVariant(vertex_path, fragment_path, viewport, run, i);
+
+        if (derivatives) {
+            descriptor.allow_derivatives = (i == 0);
+            descriptor.base_pipeline = (i == 0) ? nullptr : pipelines[0];
+        }
+
+        TL_Pipeline_t *pipeline = TL_PipelineCreate(renderer, descriptor);
+        if (!pipeline) {
+            failed = true;
+            break;
+        }
+
+        pipelines.push_back(pipeline);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    for (auto p : pipelines) {
+        TL_PipelineDestroy(p);
+    }
+
+    if (failed) {
+        return -1.0;
+    }
+
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+int main(int argc, char **argv) {
+    int ret = 0;
+
+    double totals[2] = { 0.0, 0.0 };
+
+    if (argc < 3) {
+        Utils::Error("Usage: pipelinederivatives <vertex shader .spv> <fragment shader .spv>");
+        return 1;
+    }
+
+    test.AddRenderer<GraphicsAPI::Vulkan>();
+    if (!test.CreateRenderers()) {
+        Utils::Error("Failed to create renderer(s)");
+
+        ret = 1;
+        goto out;
+    }
+
+    for (uint32_t run = 0; run < RUN_COUNT * 2; run++) {
+        bool derivatives = run % 2;
+
+        double ms = CreateFamily(test.GetRenderers()[0], argv[1], argv[2], run, derivatives);
+        if (ms < 0.0) {
+            Utils::Error("Failed to create pipeline family");
+
+            ret = 1;
+            goto out;
+        }
+
+        totals[derivatives] += ms;
+
+        std::cout << "run " << run << (derivatives ? " (derivatives):    " : " (no derivatives): ") << ms << " ms" << std::endl;
+    }
+
+    std::cout << "average over " << RUN_COUNT << " runs of " << VARIANT_COUNT << " pipelines:" << std::endl;
+    std::cout << "  without derivatives: " << totals[0] / RUN_COUNT << " ms" << std::endl;
+    std::cout << "  with derivatives:    " << totals[1] / RUN_COUNT << " ms" << std::endl;
+
+out:
+    test.Destroy();
+
+    return ret;
+}